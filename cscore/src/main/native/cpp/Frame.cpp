@@ -12,6 +12,7 @@
 
 #include "Instance.h"
 #include "Log.h"
+#include "PixelConvert.h"
 #include "SourceImpl.h"
 
 using namespace cs;
@@ -217,42 +218,27 @@ Image* Frame::ConvertImpl(Image* image, VideoMode::PixelFormat pixelFormat,
   // Color convert
   switch (pixelFormat) {
     case VideoMode::kRGB565:
-      // If source is YUYV, UYVY, Gray, or Y16, need to convert to BGR first
-      if (cur->pixelFormat == VideoMode::kYUYV) {
-        // Check to see if BGR version already exists...
+      // If a BGR version already exists, convert from that; otherwise convert
+      // YUYV, UYVY, Gray, and Y16 directly without an intermediate BGR image
+      if (cur->pixelFormat != VideoMode::kBGR) {
         if (Image* newImage =
                 GetExistingImage(cur->width, cur->height, VideoMode::kBGR)) {
           cur = newImage;
-        } else {
-          cur = ConvertYUYVToBGR(cur);
         }
+      }
+      if (cur->pixelFormat == VideoMode::kYUYV) {
+        return ConvertYUYVToRGB565(cur);
       } else if (cur->pixelFormat == VideoMode::kUYVY) {
-        // Check to see if BGR version already exists...
-        if (Image* newImage =
-                GetExistingImage(cur->width, cur->height, VideoMode::kBGR)) {
-          cur = newImage;
-        } else {
-          cur = ConvertUYVYToBGR(cur);
-        }
+        return ConvertUYVYToRGB565(cur);
       } else if (cur->pixelFormat == VideoMode::kGray) {
-        // Check to see if BGR version already exists...
-        if (Image* newImage =
-                GetExistingImage(cur->width, cur->height, VideoMode::kBGR)) {
-          cur = newImage;
-        } else {
-          cur = ConvertGrayToBGR(cur);
-        }
+        return ConvertGrayToRGB565(cur);
       } else if (cur->pixelFormat == VideoMode::kY16) {
-        // Check to see if BGR version already exists...
+        // Check to see if Gray version already exists...
         if (Image* newImage =
-                GetExistingImage(cur->width, cur->height, VideoMode::kBGR)) {
-          cur = newImage;
-        } else if (Image* newImage = GetExistingImage(cur->width, cur->height,
-                                                      VideoMode::kGray)) {
-          cur = ConvertGrayToBGR(newImage);
-        } else {
-          cur = ConvertGrayToBGR(ConvertY16ToGray(cur));
+                GetExistingImage(cur->width, cur->height, VideoMode::kGray)) {
+          return ConvertGrayToRGB565(newImage);
         }
+        return ConvertY16ToRGB565(cur);
       }
       return ConvertBGRToRGB565(cur);
     case VideoMode::kGray:
@@ -265,8 +251,7 @@ Image* Frame::ConvertImpl(Image* image, VideoMode::PixelFormat pixelFormat,
                  cur->pixelFormat == VideoMode::kGray) {
         return ConvertGrayToY16(cur);
       }
-      // If source is YUYV, UYVY, convert directly to Gray
-      // If RGB565, need to convert to BGR first
+      // If source is YUYV, UYVY, or RGB565, convert directly to Gray
       if (cur->pixelFormat == VideoMode::kYUYV) {
         cur = ConvertYUYVToGray(cur);
       } else if (cur->pixelFormat == VideoMode::kUYVY) {
@@ -275,11 +260,10 @@ Image* Frame::ConvertImpl(Image* image, VideoMode::PixelFormat pixelFormat,
         // Check to see if BGR version already exists...
         if (Image* newImage =
                 GetExistingImage(cur->width, cur->height, VideoMode::kBGR)) {
-          cur = newImage;
+          cur = ConvertBGRToGray(newImage);
         } else {
-          cur = ConvertRGB565ToBGR(cur);
+          cur = ConvertRGB565ToGray(cur);
         }
-        cur = ConvertBGRToGray(cur);
       }
       if (pixelFormat == VideoMode::kY16) {
         cur = ConvertGrayToY16(cur);
@@ -304,6 +288,8 @@ Image* Frame::ConvertImpl(Image* image, VideoMode::PixelFormat pixelFormat,
         if (Image* newImage =
                 GetExistingImage(cur->width, cur->height, VideoMode::kGray)) {
           cur = newImage;
+        } else if (pixelFormat == VideoMode::kBGR) {
+          return ConvertY16ToBGR(cur);
         } else {
           cur = ConvertY16ToGray(cur);
         }
@@ -418,6 +404,29 @@ Image* Frame::ConvertYUYVToGray(Image* image) {
   return rv;
 }
 
+Image* Frame::ConvertYUYVToRGB565(Image* image) {
+  if (!image || image->pixelFormat != VideoMode::kYUYV) {
+    return nullptr;
+  }
+
+  // Allocate a RGB565 image
+  auto newImage =
+      m_impl->source.AllocImage(VideoMode::kRGB565, image->width, image->height,
+                                image->width * image->height * 2);
+
+  // Convert in a single pass
+  pixel::YUYVToRGB565(image->vec().data(), newImage->vec().data(),
+                      image->width * image->height);
+
+  // Save the result
+  Image* rv = newImage.release();
+  if (m_impl) {
+    std::scoped_lock lock(m_impl->mutex);
+    m_impl->images.push_back(rv);
+  }
+  return rv;
+}
+
 Image* Frame::ConvertUYVYToBGR(Image* image) {
   if (!image || image->pixelFormat != VideoMode::kUYVY) {
     return nullptr;
@@ -462,6 +471,29 @@ Image* Frame::ConvertUYVYToGray(Image* image) {
   return rv;
 }
 
+Image* Frame::ConvertUYVYToRGB565(Image* image) {
+  if (!image || image->pixelFormat != VideoMode::kUYVY) {
+    return nullptr;
+  }
+
+  // Allocate a RGB565 image
+  auto newImage =
+      m_impl->source.AllocImage(VideoMode::kRGB565, image->width, image->height,
+                                image->width * image->height * 2);
+
+  // Convert in a single pass
+  pixel::UYVYToRGB565(image->vec().data(), newImage->vec().data(),
+                      image->width * image->height);
+
+  // Save the result
+  Image* rv = newImage.release();
+  if (m_impl) {
+    std::scoped_lock lock(m_impl->mutex);
+    m_impl->images.push_back(rv);
+  }
+  return rv;
+}
+
 Image* Frame::ConvertBGRToRGB565(Image* image) {
   if (!image || image->pixelFormat != VideoMode::kBGR) {
     return nullptr;
@@ -506,6 +538,29 @@ Image* Frame::ConvertRGB565ToBGR(Image* image) {
   return rv;
 }
 
+Image* Frame::ConvertRGB565ToGray(Image* image) {
+  if (!image || image->pixelFormat != VideoMode::kRGB565) {
+    return nullptr;
+  }
+
+  // Allocate a Grayscale image
+  auto newImage =
+      m_impl->source.AllocImage(VideoMode::kGray, image->width, image->height,
+                                image->width * image->height);
+
+  // Convert in a single pass
+  pixel::RGB565ToGray(image->vec().data(), newImage->vec().data(),
+                      image->width * image->height);
+
+  // Save the result
+  Image* rv = newImage.release();
+  if (m_impl) {
+    std::scoped_lock lock(m_impl->mutex);
+    m_impl->images.push_back(rv);
+  }
+  return rv;
+}
+
 Image* Frame::ConvertBGRToGray(Image* image) {
   if (!image || image->pixelFormat != VideoMode::kBGR) {
     return nullptr;
@@ -550,6 +605,29 @@ Image* Frame::ConvertGrayToBGR(Image* image) {
   return rv;
 }
 
+Image* Frame::ConvertGrayToRGB565(Image* image) {
+  if (!image || image->pixelFormat != VideoMode::kGray) {
+    return nullptr;
+  }
+
+  // Allocate a RGB565 image
+  auto newImage =
+      m_impl->source.AllocImage(VideoMode::kRGB565, image->width, image->height,
+                                image->width * image->height * 2);
+
+  // Convert
+  pixel::GrayToRGB565(image->vec().data(), newImage->vec().data(),
+                      image->width * image->height);
+
+  // Save the result
+  Image* rv = newImage.release();
+  if (m_impl) {
+    std::scoped_lock lock(m_impl->mutex);
+    m_impl->images.push_back(rv);
+  }
+  return rv;
+}
+
 Image* Frame::ConvertBGRToMJPEG(Image* image, int quality) {
   if (!image || image->pixelFormat != VideoMode::kBGR) {
     return nullptr;
@@ -631,7 +709,8 @@ Image* Frame::ConvertGrayToY16(Image* image) {
                                 image->width * image->height * 2);
 
   // Convert with linear scaling
-  image->AsMat().convertTo(newImage->AsMat(), CV_16U, 256);
+  pixel::GrayToY16(image->vec().data(), newImage->vec().data(),
+                   image->width * image->height);
 
   // Save the result
   Image* rv = newImage.release();
@@ -653,7 +732,54 @@ Image* Frame::ConvertY16ToGray(Image* image) {
                                 image->width * image->height);
 
   // Scale min to 0 and max to 255
-  cv::normalize(image->AsMat(), newImage->AsMat(), 255, 0, cv::NORM_MINMAX);
+  pixel::Y16ToGray(image->vec().data(), newImage->vec().data(),
+                   image->width * image->height);
+
+  // Save the result
+  Image* rv = newImage.release();
+  if (m_impl) {
+    std::scoped_lock lock(m_impl->mutex);
+    m_impl->images.push_back(rv);
+  }
+  return rv;
+}
+
+Image* Frame::ConvertY16ToBGR(Image* image) {
+  if (!image || image->pixelFormat != VideoMode::kY16) {
+    return nullptr;
+  }
+
+  // Allocate a BGR image
+  auto newImage =
+      m_impl->source.AllocImage(VideoMode::kBGR, image->width, image->height,
+                                image->width * image->height * 3);
+
+  // Scale min to 0 and max to 255
+  pixel::Y16ToBGR(image->vec().data(), newImage->vec().data(),
+                  image->width * image->height);
+
+  // Save the result
+  Image* rv = newImage.release();
+  if (m_impl) {
+    std::scoped_lock lock(m_impl->mutex);
+    m_impl->images.push_back(rv);
+  }
+  return rv;
+}
+
+Image* Frame::ConvertY16ToRGB565(Image* image) {
+  if (!image || image->pixelFormat != VideoMode::kY16) {
+    return nullptr;
+  }
+
+  // Allocate a RGB565 image
+  auto newImage =
+      m_impl->source.AllocImage(VideoMode::kRGB565, image->width, image->height,
+                                image->width * image->height * 2);
+
+  // Scale min to 0 and max to 255
+  pixel::Y16ToRGB565(image->vec().data(), newImage->vec().data(),
+                     image->width * image->height);
 
   // Save the result
   Image* rv = newImage.release();
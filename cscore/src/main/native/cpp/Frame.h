@@ -196,16 +196,22 @@ class Frame {
   Image* ConvertMJPEGToGray(Image* image);
   Image* ConvertYUYVToBGR(Image* image);
   Image* ConvertYUYVToGray(Image* image);
+  Image* ConvertYUYVToRGB565(Image* image);
   Image* ConvertUYVYToBGR(Image* image);
   Image* ConvertUYVYToGray(Image* image);
+  Image* ConvertUYVYToRGB565(Image* image);
   Image* ConvertBGRToRGB565(Image* image);
   Image* ConvertRGB565ToBGR(Image* image);
+  Image* ConvertRGB565ToGray(Image* image);
   Image* ConvertBGRToGray(Image* image);
   Image* ConvertGrayToBGR(Image* image);
+  Image* ConvertGrayToRGB565(Image* image);
   Image* ConvertBGRToMJPEG(Image* image, int quality);
   Image* ConvertGrayToMJPEG(Image* image, int quality);
   Image* ConvertGrayToY16(Image* image);
   Image* ConvertY16ToGray(Image* image);
+  Image* ConvertY16ToBGR(Image* image);
+  Image* ConvertY16ToRGB565(Image* image);
 
   Image* GetImage(int width, int height, VideoMode::PixelFormat pixelFormat) {
     if (pixelFormat == VideoMode::kMJPEG) {
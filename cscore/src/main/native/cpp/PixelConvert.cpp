@@ -0,0 +1,156 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "PixelConvert.h"
+
+#include <algorithm>
+
+using namespace cs;
+
+// ITU-R BT.601 YUV to RGB, 20-bit fixed point (as used by OpenCV)
+static constexpr int kYuvShift = 20;
+static constexpr int kCY = 1220542;
+static constexpr int kCUB = 2116026;
+static constexpr int kCUG = -409993;
+static constexpr int kCVG = -852492;
+static constexpr int kCVR = 1673527;
+
+// RGB to gray, 15-bit fixed point (as used by OpenCV)
+static constexpr int kGrayShift = 15;
+static constexpr int kRY = 9798;
+static constexpr int kGY = 19235;
+static constexpr int kBY = 3735;
+
+static inline uint8_t Clamp8(int v) {
+  return static_cast<uint8_t>(std::clamp(v, 0, 255));
+}
+
+// Matches cv::COLOR_RGB2BGR565 applied to a BGR image, which is the layout
+// cscore uses for RGB565: red in the low bits, blue in the high bits
+static inline uint16_t PackRGB565(int b, int g, int r) {
+  return static_cast<uint16_t>((r >> 3) | ((g >> 2) << 5) | ((b >> 3) << 11));
+}
+
+static inline void Store16(uint8_t* dst, uint16_t v) {
+  dst[0] = static_cast<uint8_t>(v);
+  dst[1] = static_cast<uint8_t>(v >> 8);
+}
+
+static inline int Load16(const uint8_t* src) {
+  return src[0] | (src[1] << 8);
+}
+
+// YUV 4:2:2 to RGB565; the offsets give the positions of Y0, U, Y1, V within
+// each 4-byte macropixel
+template <int kY0, int kU, int kY1, int kV>
+static void YUV422ToRGB565(const uint8_t* src, uint8_t* dst, size_t pixels) {
+  for (size_t i = 0; i < pixels / 2; ++i, src += 4, dst += 4) {
+    int u = src[kU] - 128;
+    int v = src[kV] - 128;
+    int ruv = (1 << (kYuvShift - 1)) + kCVR * v;
+    int guv = (1 << (kYuvShift - 1)) + kCVG * v + kCUG * u;
+    int buv = (1 << (kYuvShift - 1)) + kCUB * u;
+
+    int y0 = std::max(0, src[kY0] - 16) * kCY;
+    Store16(dst, PackRGB565(Clamp8((y0 + buv) >> kYuvShift),
+                            Clamp8((y0 + guv) >> kYuvShift),
+                            Clamp8((y0 + ruv) >> kYuvShift)));
+
+    int y1 = std::max(0, src[kY1] - 16) * kCY;
+    Store16(dst + 2, PackRGB565(Clamp8((y1 + buv) >> kYuvShift),
+                                Clamp8((y1 + guv) >> kYuvShift),
+                                Clamp8((y1 + ruv) >> kYuvShift)));
+  }
+}
+
+void pixel::YUYVToRGB565(const uint8_t* src, uint8_t* dst, size_t pixels) {
+  YUV422ToRGB565<0, 1, 2, 3>(src, dst, pixels);
+}
+
+void pixel::UYVYToRGB565(const uint8_t* src, uint8_t* dst, size_t pixels) {
+  YUV422ToRGB565<1, 0, 3, 2>(src, dst, pixels);
+}
+
+void pixel::GrayToRGB565(const uint8_t* src, uint8_t* dst, size_t pixels) {
+  for (size_t i = 0; i < pixels; ++i) {
+    Store16(dst + i * 2, PackRGB565(src[i], src[i], src[i]));
+  }
+}
+
+void pixel::RGB565ToGray(const uint8_t* src, uint8_t* dst, size_t pixels) {
+  for (size_t i = 0; i < pixels; ++i) {
+    // expand as cv::COLOR_BGR5652RGB does, then weight as cv::COLOR_BGR2GRAY
+    int v = Load16(src + i * 2);
+    int r = (v & 0x1f) << 3;
+    int g = ((v >> 5) & 0x3f) << 2;
+    int b = ((v >> 11) & 0x1f) << 3;
+    dst[i] = static_cast<uint8_t>(
+        (b * kBY + g * kGY + r * kRY + (1 << (kGrayShift - 1))) >> kGrayShift);
+  }
+}
+
+namespace {
+
+// Maps Y16 values onto 0-255 so the image minimum is 0 and the maximum is 255
+class Y16Scaler {
+ public:
+  Y16Scaler(const uint8_t* src, size_t pixels) {
+    int lo = 0xffff;
+    int hi = 0;
+    for (size_t i = 0; i < pixels; ++i) {
+      int v = Load16(src + i * 2);
+      lo = std::min(lo, v);
+      hi = std::max(hi, v);
+    }
+    m_min = lo;
+    // 16.16 fixed point; a flat image maps to 0 like cv::normalize()
+    uint32_t range = hi - lo;
+    m_scale = range > 0 ? ((255u << 16) + range / 2) / range : 0;
+  }
+
+  // (v - min) * scale is at most (255 << 16) + range, so this cannot overflow
+  // 32 bits, but rounding the scale up may need a clamp at the top
+  uint8_t operator()(const uint8_t* src) const {
+    uint32_t v = Load16(src) - m_min;
+    return static_cast<uint8_t>(
+        std::min((v * m_scale + 0x8000) >> 16, uint32_t{255}));
+  }
+
+ private:
+  int m_min;
+  uint32_t m_scale;
+};
+
+}  // namespace
+
+void pixel::Y16ToGray(const uint8_t* src, uint8_t* dst, size_t pixels) {
+  Y16Scaler scale{src, pixels};
+  for (size_t i = 0; i < pixels; ++i) {
+    dst[i] = scale(src + i * 2);
+  }
+}
+
+void pixel::Y16ToBGR(const uint8_t* src, uint8_t* dst, size_t pixels) {
+  Y16Scaler scale{src, pixels};
+  for (size_t i = 0; i < pixels; ++i) {
+    uint8_t gray = scale(src + i * 2);
+    dst[i * 3] = gray;
+    dst[i * 3 + 1] = gray;
+    dst[i * 3 + 2] = gray;
+  }
+}
+
+void pixel::Y16ToRGB565(const uint8_t* src, uint8_t* dst, size_t pixels) {
+  Y16Scaler scale{src, pixels};
+  for (size_t i = 0; i < pixels; ++i) {
+    uint8_t gray = scale(src + i * 2);
+    Store16(dst + i * 2, PackRGB565(gray, gray, gray));
+  }
+}
+
+void pixel::GrayToY16(const uint8_t* src, uint8_t* dst, size_t pixels) {
+  for (size_t i = 0; i < pixels; ++i) {
+    Store16(dst + i * 2, static_cast<uint16_t>(src[i] << 8));
+  }
+}
@@ -0,0 +1,37 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef CSCORE_PIXELCONVERT_H_
+#define CSCORE_PIXELCONVERT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace cs::pixel {
+
+// Single-pass pixel format conversions for the paths that would otherwise
+// chain two cv::cvtColor() calls through an intermediate image.
+//
+// Each function converts a packed image of the given number of pixels; for
+// YUYV and UYVY this must be even.  Pixel layouts match cscore's Image:
+// BGR is 3 bytes, RGB565 and Y16 are 2 bytes (little endian), and Gray is
+// 1 byte per pixel.  Color math uses the same BT.601 fixed point coefficients
+// as OpenCV.  The loops are simple enough for GCC to auto-vectorize at -O3
+// (or with -ftree-vectorize); at -O2 (GCC 12's very cheap cost model) they
+// stay scalar, and the gain comes from skipping the intermediate image.
+
+void YUYVToRGB565(const uint8_t* src, uint8_t* dst, size_t pixels);
+void UYVYToRGB565(const uint8_t* src, uint8_t* dst, size_t pixels);
+void GrayToRGB565(const uint8_t* src, uint8_t* dst, size_t pixels);
+void RGB565ToGray(const uint8_t* src, uint8_t* dst, size_t pixels);
+
+// Y16 conversions scale the image minimum to 0 and maximum to 255
+void Y16ToGray(const uint8_t* src, uint8_t* dst, size_t pixels);
+void Y16ToBGR(const uint8_t* src, uint8_t* dst, size_t pixels);
+void Y16ToRGB565(const uint8_t* src, uint8_t* dst, size_t pixels);
+void GrayToY16(const uint8_t* src, uint8_t* dst, size_t pixels);
+
+}  // namespace cs::pixel
+
+#endif  // CSCORE_PIXELCONVERT_H_
@@ -0,0 +1,245 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "PixelConvert.h"  // NOLINT(build/include_order)
+
+#include <stdlib.h>
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+namespace cs {
+
+static uint16_t Load16(const std::vector<uint8_t>& data, size_t i) {
+  return data[i * 2] | (data[i * 2 + 1] << 8);
+}
+
+TEST(PixelConvertTest, YUYVToRGB565) {
+  // black and white, then saturated red, blue, and green pairs
+  const std::array<uint8_t, 16> yuyv{16, 128, 235, 128, 81,  90, 81,  240,
+                                     41, 240, 41,  110, 145, 54, 145, 34};
+  std::vector<uint8_t> out(16);
+  pixel::YUYVToRGB565(yuyv.data(), out.data(), 8);
+  EXPECT_EQ(Load16(out, 0), 0x0000);
+  EXPECT_EQ(Load16(out, 1), 0xffff);
+  // red is in the low bits, blue in the high bits
+  EXPECT_EQ(Load16(out, 2), 0x001f);
+  EXPECT_EQ(Load16(out, 3), 0x001f);
+  EXPECT_EQ(Load16(out, 4), 0xf800);
+  EXPECT_EQ(Load16(out, 5), 0xf800);
+  EXPECT_EQ(Load16(out, 6), 0x07e0);
+  EXPECT_EQ(Load16(out, 7), 0x07e0);
+}
+
+TEST(PixelConvertTest, UYVYToRGB565) {
+  // same colors as YUYVToRGB565
+  const std::array<uint8_t, 16> uyvy{128, 16, 128, 235, 90, 81,  240, 81,
+                                     240, 41, 110, 41,  54, 145, 34,  145};
+  std::vector<uint8_t> out(16);
+  pixel::UYVYToRGB565(uyvy.data(), out.data(), 8);
+  EXPECT_EQ(Load16(out, 0), 0x0000);
+  EXPECT_EQ(Load16(out, 1), 0xffff);
+  EXPECT_EQ(Load16(out, 2), 0x001f);
+  EXPECT_EQ(Load16(out, 3), 0x001f);
+  EXPECT_EQ(Load16(out, 4), 0xf800);
+  EXPECT_EQ(Load16(out, 5), 0xf800);
+  EXPECT_EQ(Load16(out, 6), 0x07e0);
+  EXPECT_EQ(Load16(out, 7), 0x07e0);
+}
+
+TEST(PixelConvertTest, GrayToRGB565) {
+  const std::array<uint8_t, 3> gray{0, 128, 255};
+  std::vector<uint8_t> out(6);
+  pixel::GrayToRGB565(gray.data(), out.data(), gray.size());
+  EXPECT_EQ(Load16(out, 0), 0x0000);
+  EXPECT_EQ(Load16(out, 1), 0x8410);
+  EXPECT_EQ(Load16(out, 2), 0xffff);
+}
+
+TEST(PixelConvertTest, RGB565ToGray) {
+  const std::array<uint8_t, 6> rgb565{0x00, 0x00, 0xff, 0xff, 0x1f, 0x00};
+  std::vector<uint8_t> out(3);
+  pixel::RGB565ToGray(rgb565.data(), out.data(), out.size());
+  EXPECT_EQ(out[0], 0);
+  EXPECT_EQ(out[1], 250);
+  EXPECT_EQ(out[2], 74);
+}
+
+TEST(PixelConvertTest, Y16ToGray) {
+  // 1000, 2000, 3000 (little endian)
+  const std::array<uint8_t, 6> y16{0xe8, 0x03, 0xd0, 0x07, 0xb8, 0x0b};
+  std::vector<uint8_t> out(3);
+  pixel::Y16ToGray(y16.data(), out.data(), out.size());
+  EXPECT_EQ(out[0], 0);
+  EXPECT_EQ(out[1], 128);
+  EXPECT_EQ(out[2], 255);
+}
+
+TEST(PixelConvertTest, Y16ToGrayFlat) {
+  const std::array<uint8_t, 4> y16{0x34, 0x12, 0x34, 0x12};
+  std::vector<uint8_t> out(2, 0x5a);
+  pixel::Y16ToGray(y16.data(), out.data(), out.size());
+  EXPECT_EQ(out[0], 0);
+  EXPECT_EQ(out[1], 0);
+}
+
+TEST(PixelConvertTest, Y16ToGrayFullRange) {
+  const std::array<uint8_t, 6> y16{0x00, 0x00, 0xff, 0x7f, 0xff, 0xff};
+  std::vector<uint8_t> out(3);
+  pixel::Y16ToGray(y16.data(), out.data(), out.size());
+  EXPECT_EQ(out[0], 0);
+  EXPECT_EQ(out[1], 127);
+  EXPECT_EQ(out[2], 255);
+}
+
+TEST(PixelConvertTest, Y16ToBGR) {
+  const std::array<uint8_t, 6> y16{0xe8, 0x03, 0xd0, 0x07, 0xb8, 0x0b};
+  std::vector<uint8_t> out(9);
+  pixel::Y16ToBGR(y16.data(), out.data(), 3);
+  EXPECT_EQ(out, (std::vector<uint8_t>{0, 0, 0, 128, 128, 128, 255, 255, 255}));
+}
+
+TEST(PixelConvertTest, Y16ToRGB565) {
+  const std::array<uint8_t, 6> y16{0xe8, 0x03, 0xd0, 0x07, 0xb8, 0x0b};
+  std::vector<uint8_t> out(6);
+  pixel::Y16ToRGB565(y16.data(), out.data(), 3);
+  EXPECT_EQ(Load16(out, 0), 0x0000);
+  EXPECT_EQ(Load16(out, 1), 0x8410);
+  EXPECT_EQ(Load16(out, 2), 0xffff);
+}
+
+TEST(PixelConvertTest, GrayToY16) {
+  const std::array<uint8_t, 2> gray{0x12, 0xff};
+  std::vector<uint8_t> out(4);
+  pixel::GrayToY16(gray.data(), out.data(), gray.size());
+  EXPECT_EQ(Load16(out, 0), 0x1200);
+  EXPECT_EQ(Load16(out, 1), 0xff00);
+}
+
+namespace {
+
+// The fused kernels must give the same images as the cv::cvtColor() chains
+// Frame used before (see PixelConvert_bench.cpp).  OpenCV's fixed point
+// coefficients and SIMD rounding vary slightly between versions and CPUs, so
+// each channel may differ by one step.
+class PixelConvertOpenCVTest : public ::testing::Test {
+ protected:
+  static constexpr int kWidth = 64;
+  static constexpr int kHeight = 48;
+
+  cv::Mat RandomMat(int type) {
+    cv::Mat mat{kHeight, kWidth, type};
+    m_rng.fill(mat, cv::RNG::UNIFORM, cv::Scalar::all(0),
+               cv::Scalar::all(CV_MAT_DEPTH(type) == CV_16U ? 65536 : 256));
+    return mat;
+  }
+
+  static void ExpectNear(const cv::Mat& expected, const cv::Mat& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    ASSERT_EQ(expected.type(), actual.type());
+    EXPECT_LE(cv::norm(expected, actual, cv::NORM_INF), 1);
+  }
+
+  static void ExpectRGB565Near(const cv::Mat& expected, const cv::Mat& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    ASSERT_EQ(expected.type(), CV_8UC2);
+    ASSERT_EQ(actual.type(), CV_8UC2);
+    for (int i = 0; i < kWidth * kHeight; ++i) {
+      int e = expected.data[i * 2] | (expected.data[i * 2 + 1] << 8);
+      int a = actual.data[i * 2] | (actual.data[i * 2 + 1] << 8);
+      ASSERT_LE(abs((e & 0x1f) - (a & 0x1f)), 1) << "pixel " << i;
+      ASSERT_LE(abs(((e >> 5) & 0x3f) - ((a >> 5) & 0x3f)), 1) << "pixel " << i;
+      ASSERT_LE(abs((e >> 11) - (a >> 11)), 1) << "pixel " << i;
+    }
+  }
+
+  cv::RNG m_rng{1234};
+};
+
+}  // namespace
+
+TEST_F(PixelConvertOpenCVTest, YUYVToRGB565) {
+  cv::Mat src = RandomMat(CV_8UC2);
+  cv::Mat bgr, expected;
+  cv::cvtColor(src, bgr, cv::COLOR_YUV2BGR_YUYV);
+  cv::cvtColor(bgr, expected, cv::COLOR_RGB2BGR565);
+  cv::Mat actual{kHeight, kWidth, CV_8UC2};
+  pixel::YUYVToRGB565(src.data, actual.data, kWidth * kHeight);
+  ExpectRGB565Near(expected, actual);
+}
+
+TEST_F(PixelConvertOpenCVTest, UYVYToRGB565) {
+  cv::Mat src = RandomMat(CV_8UC2);
+  cv::Mat bgr, expected;
+  cv::cvtColor(src, bgr, cv::COLOR_YUV2BGR_UYVY);
+  cv::cvtColor(bgr, expected, cv::COLOR_RGB2BGR565);
+  cv::Mat actual{kHeight, kWidth, CV_8UC2};
+  pixel::UYVYToRGB565(src.data, actual.data, kWidth * kHeight);
+  ExpectRGB565Near(expected, actual);
+}
+
+TEST_F(PixelConvertOpenCVTest, GrayToRGB565) {
+  cv::Mat src = RandomMat(CV_8UC1);
+  cv::Mat bgr, expected;
+  cv::cvtColor(src, bgr, cv::COLOR_GRAY2BGR);
+  cv::cvtColor(bgr, expected, cv::COLOR_RGB2BGR565);
+  cv::Mat actual{kHeight, kWidth, CV_8UC2};
+  pixel::GrayToRGB565(src.data, actual.data, kWidth * kHeight);
+  ExpectRGB565Near(expected, actual);
+}
+
+TEST_F(PixelConvertOpenCVTest, RGB565ToGray) {
+  cv::Mat src = RandomMat(CV_8UC2);
+  cv::Mat bgr, expected;
+  cv::cvtColor(src, bgr, cv::COLOR_BGR5652RGB);
+  cv::cvtColor(bgr, expected, cv::COLOR_BGR2GRAY);
+  cv::Mat actual{kHeight, kWidth, CV_8UC1};
+  pixel::RGB565ToGray(src.data, actual.data, kWidth * kHeight);
+  ExpectNear(expected, actual);
+}
+
+TEST_F(PixelConvertOpenCVTest, Y16ToGray) {
+  cv::Mat src = RandomMat(CV_16UC1);
+  cv::Mat expected;
+  cv::normalize(src, expected, 255, 0, cv::NORM_MINMAX, CV_8U);
+  cv::Mat actual{kHeight, kWidth, CV_8UC1};
+  pixel::Y16ToGray(src.data, actual.data, kWidth * kHeight);
+  ExpectNear(expected, actual);
+}
+
+TEST_F(PixelConvertOpenCVTest, Y16ToBGR) {
+  cv::Mat src = RandomMat(CV_16UC1);
+  cv::Mat gray, expected;
+  cv::normalize(src, gray, 255, 0, cv::NORM_MINMAX, CV_8U);
+  cv::cvtColor(gray, expected, cv::COLOR_GRAY2BGR);
+  cv::Mat actual{kHeight, kWidth, CV_8UC3};
+  pixel::Y16ToBGR(src.data, actual.data, kWidth * kHeight);
+  ExpectNear(expected, actual);
+}
+
+TEST_F(PixelConvertOpenCVTest, Y16ToRGB565) {
+  cv::Mat src = RandomMat(CV_16UC1);
+  cv::Mat gray, bgr, expected;
+  cv::normalize(src, gray, 255, 0, cv::NORM_MINMAX, CV_8U);
+  cv::cvtColor(gray, bgr, cv::COLOR_GRAY2BGR);
+  cv::cvtColor(bgr, expected, cv::COLOR_RGB2BGR565);
+  cv::Mat actual{kHeight, kWidth, CV_8UC2};
+  pixel::Y16ToRGB565(src.data, actual.data, kWidth * kHeight);
+  ExpectRGB565Near(expected, actual);
+}
+
+TEST_F(PixelConvertOpenCVTest, GrayToY16) {
+  cv::Mat src = RandomMat(CV_8UC1);
+  cv::Mat expected;
+  src.convertTo(expected, CV_16U, 256);
+  cv::Mat actual{kHeight, kWidth, CV_16UC1};
+  pixel::GrayToY16(src.data, actual.data, kWidth * kHeight);
+  EXPECT_EQ(cv::norm(expected, actual, cv::NORM_INF), 0);
+}
+
+}  // namespace cs
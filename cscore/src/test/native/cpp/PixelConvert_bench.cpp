@@ -0,0 +1,156 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include "PixelConvert.h"
+
+namespace cs {
+
+namespace {
+constexpr int kRepeats = 100;
+
+struct FrameSize {
+  int width;
+  int height;
+};
+constexpr FrameSize kSizes[] = {{320, 240}, {640, 480}, {1280, 720}};
+
+// Times fn() over kRepeats runs; returns microseconds per run
+double Time(const std::function<void()>& fn) {
+  using std::chrono::duration;
+  using std::chrono::high_resolution_clock;
+  fn();  // warm up caches and allocations
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < kRepeats; ++i) {
+    fn();
+  }
+  return duration<double, std::micro>(high_resolution_clock::now() - start)
+             .count() /
+         kRepeats;
+}
+
+cv::Mat RandomMat(const FrameSize& size, int type) {
+  cv::Mat mat{size.height, size.width, type};
+  cv::randu(mat, cv::Scalar::all(0),
+            cv::Scalar::all(CV_MAT_DEPTH(type) == CV_16U ? 65536 : 256));
+  return mat;
+}
+
+void Print(const char* name, const FrameSize& size, double chained,
+           double fused) {
+  fmt::print("{} {}x{}: chained {:.1f} us, fused {:.1f} us ({:.2f}x)\n", name,
+             size.width, size.height, chained, fused, chained / fused);
+}
+}  // namespace
+
+// Each benchmark compares the previous Frame path, which converted through an
+// intermediate image with cv::cvtColor(), against the single-pass kernel
+
+TEST(PixelConvertBenchmark, YUYVToRGB565) {
+  for (auto&& size : kSizes) {
+    cv::Mat src = RandomMat(size, CV_8UC2);
+    cv::Mat bgr{size.height, size.width, CV_8UC3};
+    cv::Mat dst{size.height, size.width, CV_8UC2};
+    double chained = Time([&] {
+      cv::cvtColor(src, bgr, cv::COLOR_YUV2BGR_YUYV);
+      cv::cvtColor(bgr, dst, cv::COLOR_RGB2BGR565);
+    });
+    double fused = Time([&] {
+      pixel::YUYVToRGB565(src.data, dst.data, size.width * size.height);
+    });
+    Print("YUYV to RGB565", size, chained, fused);
+  }
+}
+
+TEST(PixelConvertBenchmark, UYVYToRGB565) {
+  for (auto&& size : kSizes) {
+    cv::Mat src = RandomMat(size, CV_8UC2);
+    cv::Mat bgr{size.height, size.width, CV_8UC3};
+    cv::Mat dst{size.height, size.width, CV_8UC2};
+    double chained = Time([&] {
+      cv::cvtColor(src, bgr, cv::COLOR_YUV2BGR_UYVY);
+      cv::cvtColor(bgr, dst, cv::COLOR_RGB2BGR565);
+    });
+    double fused = Time([&] {
+      pixel::UYVYToRGB565(src.data, dst.data, size.width * size.height);
+    });
+    Print("UYVY to RGB565", size, chained, fused);
+  }
+}
+
+TEST(PixelConvertBenchmark, GrayToRGB565) {
+  for (auto&& size : kSizes) {
+    cv::Mat src = RandomMat(size, CV_8UC1);
+    cv::Mat bgr{size.height, size.width, CV_8UC3};
+    cv::Mat dst{size.height, size.width, CV_8UC2};
+    double chained = Time([&] {
+      cv::cvtColor(src, bgr, cv::COLOR_GRAY2BGR);
+      cv::cvtColor(bgr, dst, cv::COLOR_RGB2BGR565);
+    });
+    double fused = Time([&] {
+      pixel::GrayToRGB565(src.data, dst.data, size.width * size.height);
+    });
+    Print("Gray to RGB565", size, chained, fused);
+  }
+}
+
+TEST(PixelConvertBenchmark, RGB565ToGray) {
+  for (auto&& size : kSizes) {
+    cv::Mat src = RandomMat(size, CV_8UC2);
+    cv::Mat bgr{size.height, size.width, CV_8UC3};
+    cv::Mat dst{size.height, size.width, CV_8UC1};
+    double chained = Time([&] {
+      cv::cvtColor(src, bgr, cv::COLOR_BGR5652RGB);
+      cv::cvtColor(bgr, dst, cv::COLOR_BGR2GRAY);
+    });
+    double fused = Time([&] {
+      pixel::RGB565ToGray(src.data, dst.data, size.width * size.height);
+    });
+    Print("RGB565 to Gray", size, chained, fused);
+  }
+}
+
+TEST(PixelConvertBenchmark, Y16ToBGR) {
+  for (auto&& size : kSizes) {
+    cv::Mat src = RandomMat(size, CV_16UC1);
+    cv::Mat gray{size.height, size.width, CV_8UC1};
+    cv::Mat dst{size.height, size.width, CV_8UC3};
+    double chained = Time([&] {
+      cv::normalize(src, gray, 255, 0, cv::NORM_MINMAX, CV_8U);
+      cv::cvtColor(gray, dst, cv::COLOR_GRAY2BGR);
+    });
+    double fused = Time([&] {
+      pixel::Y16ToBGR(src.data, dst.data, size.width * size.height);
+    });
+    Print("Y16 to BGR", size, chained, fused);
+  }
+}
+
+TEST(PixelConvertBenchmark, Y16ToRGB565) {
+  for (auto&& size : kSizes) {
+    cv::Mat src = RandomMat(size, CV_16UC1);
+    cv::Mat gray{size.height, size.width, CV_8UC1};
+    cv::Mat bgr{size.height, size.width, CV_8UC3};
+    cv::Mat dst{size.height, size.width, CV_8UC2};
+    double chained = Time([&] {
+      cv::normalize(src, gray, 255, 0, cv::NORM_MINMAX, CV_8U);
+      cv::cvtColor(gray, bgr, cv::COLOR_GRAY2BGR);
+      cv::cvtColor(bgr, dst, cv::COLOR_RGB2BGR565);
+    });
+    double fused = Time([&] {
+      pixel::Y16ToRGB565(src.data, dst.data, size.width * size.height);
+    });
+    Print("Y16 to RGB565", size, chained, fused);
+  }
+}
+
+}  // namespace cs
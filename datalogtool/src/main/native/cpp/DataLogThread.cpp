@@ -6,6 +6,31 @@
 
 #include <fmt/format.h>
 
+using ControlError = wpi::log::DataLogIndex::ControlError;
+
+static void PrintControlError(ControlError error, size_t) {
+  switch (error) {
+    case ControlError::kInvalidStart:
+      fmt::print("Start(INVALID)\n");
+      break;
+    case ControlError::kDuplicateEntry:
+      fmt::print("...DUPLICATE entry ID, overriding\n");
+      break;
+    case ControlError::kInvalidFinish:
+      fmt::print("Finish(INVALID)\n");
+      break;
+    case ControlError::kEntryNotFound:
+      fmt::print("...ID not found\n");
+      break;
+    case ControlError::kInvalidSetMetadata:
+      fmt::print("SetMetadata(INVALID)\n");
+      break;
+    case ControlError::kUnrecognized:
+      fmt::print("Unrecognized control record\n");
+      break;
+  }
+}
+
 DataLogThread::~DataLogThread() {
   if (m_thread.joinable()) {
     m_active = false;
@@ -14,59 +39,32 @@ DataLogThread::~DataLogThread() {
 }
 
 void DataLogThread::ReadMain() {
-  for (auto record : m_reader) {
-    if (!m_active) {
-      break;
-    }
-    ++m_numRecords;
-    if (record.IsStart()) {
-      wpi::log::StartRecordData data;
-      if (record.GetStartData(&data)) {
-        std::scoped_lock lock{m_mutex};
-        if (m_entries.find(data.entry) != m_entries.end()) {
-          fmt::print("...DUPLICATE entry ID, overriding\n");
-        }
-        m_entries[data.entry] = data;
-        m_entryNames.emplace(data.name, data);
-        sigEntryAdded(data);
-      } else {
-        fmt::print("Start(INVALID)\n");
-      }
-    } else if (record.IsFinish()) {
-      int entry;
-      if (record.GetFinishEntry(&entry)) {
-        std::scoped_lock lock{m_mutex};
-        auto it = m_entries.find(entry);
-        if (it == m_entries.end()) {
-          fmt::print("...ID not found\n");
-        } else {
-          m_entries.erase(it);
-        }
-      } else {
-        fmt::print("Finish(INVALID)\n");
-      }
-    } else if (record.IsSetMetadata()) {
-      wpi::log::MetadataRecordData data;
-      if (record.GetSetMetadataData(&data)) {
-        std::scoped_lock lock{m_mutex};
-        auto it = m_entries.find(data.entry);
-        if (it == m_entries.end()) {
-          fmt::print("...ID not found\n");
-        } else {
-          it->second.metadata = data.metadata;
-          auto nameIt = m_entryNames.find(it->second.name);
-          if (nameIt != m_entryNames.end()) {
-            nameIt->second.metadata = data.metadata;
+  // a single pass over the record headers; the record data is only read on
+  // demand (e.g. when exporting).  Entries are published as they are indexed
+  // so they show up in the UI while a large log is still loading.
+  auto index = std::make_unique<wpi::log::DataLogIndex>(
+      m_reader, wpi::log::DataLogIndex::kDefaultTimeInterval, PrintControlError,
+      [this](size_t numRecords, const wpi::log::DataLogRecord& record,
+             const wpi::log::DataLogIndex::Entry* entry) {
+        m_numRecords = numRecords;
+        if (entry) {
+          std::scoped_lock lock{m_mutex};
+          if (record.IsStart()) {
+            wpi::log::StartRecordData data = entry->start;
+            data.metadata = entry->metadata;
+            m_entryNames.emplace(data.name, data);
+            sigEntryAdded(data);
+          } else {
+            auto it = m_entryNames.find(entry->start.name);
+            if (it != m_entryNames.end()) {
+              it->second.metadata = entry->metadata;
+            }
           }
         }
-      } else {
-        fmt::print("SetMetadata(INVALID)\n");
-      }
-    } else if (record.IsControl()) {
-      fmt::print("Unrecognized control record\n");
-    }
-  }
+        return m_active.load();
+      });
 
+  m_index = std::move(index);
   sigDone();
   m_done = true;
 }
@@ -7,13 +7,14 @@
 #include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <utility>
 
+#include <wpi/DataLogIndex.h>
 #include <wpi/DataLogReader.h>
-#include <wpi/DenseMap.h>
 #include <wpi/Signal.h>
 #include <wpi/mutex.h>
 
@@ -53,6 +54,11 @@ class DataLogThread {
 
   const wpi::log::DataLogReader& GetReader() const { return m_reader; }
 
+  // Only valid after IsDone() returns true
+  const wpi::log::DataLogIndex* GetIndex() const {
+    return m_done ? m_index.get() : nullptr;
+  }
+
   // note: these are called on separate thread
   wpi::sig::Signal_mt<const wpi::log::StartRecordData&> sigEntryAdded;
   wpi::sig::Signal_mt<> sigDone;
@@ -66,6 +72,6 @@ class DataLogThread {
   std::atomic_bool m_done{false};
   std::atomic<unsigned int> m_numRecords{0};
   std::map<std::string, wpi::log::StartRecordData, std::less<>> m_entryNames;
-  wpi::DenseMap<int, wpi::log::StartRecordData> m_entries;
+  std::unique_ptr<wpi::log::DataLogIndex> m_index;
   std::thread m_thread;
 };
@@ -331,7 +331,8 @@ void Downloader::ThreadMain() {
               }
             } else if (attr.type == SSH_FILEXFER_TYPE_REGULAR &&
                        (attr.flags & SSH_FILEXFER_ATTR_SIZE) != 0 &&
-                       wpi::ends_with(attr.name, ".wpilog")) {
+                       (wpi::ends_with(attr.name, ".wpilog") ||
+                        wpi::ends_with(attr.name, ".wpilogz"))) {
               m_fileList.emplace_back(attr.name, attr.size);
             }
           }
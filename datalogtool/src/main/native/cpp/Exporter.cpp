@@ -4,6 +4,7 @@
 
 #include "Exporter.h"
 
+#include <algorithm>
 #include <atomic>
 #include <ctime>
 #include <future>
@@ -12,6 +13,7 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include <fmt/chrono.h>
@@ -204,7 +206,7 @@ void DisplayInputFiles() {
     if (ImGui::Button("Open File(s)...")) {
       dataFileSelector = std::make_unique<pfd::open_file>(
           "Select Data Log", "",
-          std::vector<std::string>{"DataLog Files", "*.wpilog"},
+          std::vector<std::string>{"DataLog Files", "*.wpilog *.wpilogz"},
           pfd::opt::multiselect);
     }
     ImGui::BeginTable(
@@ -551,6 +553,43 @@ static void ExportCsvFile(InputFile& f, wpi::raw_ostream& os, int style) {
     os << '\n';
   }
 
+  auto printRecord = [&](Entry* entry, const wpi::log::DataLogRecord& record) {
+    if (style == 0) {
+      fmt::print(os, "{},\"", record.GetTimestamp() / 1000000.0);
+      PrintEscapedCsvString(os, entry->name);
+      os << '"' << ',';
+      ValueToCsv(os, *entry, record);
+      os << '\n';
+    } else if (style == 1 && entry->column != -1) {
+      fmt::print(os, "{},", record.GetTimestamp() / 1000000.0);
+      for (int i = 0; i < entry->column; ++i) {
+        os << ',';
+      }
+      ValueToCsv(os, *entry, record);
+      os << '\n';
+    }
+  };
+
+  if (auto index = f.datalog->GetIndex()) {
+    // gather just the records of the selected entries, in log order
+    std::vector<std::pair<size_t, Entry*>> records;
+    for (auto&& logEntry : index->GetEntries()) {
+      auto it = gEntries.find(logEntry.start.name);
+      if (it == gEntries.end() || !it->second->selected) {
+        continue;
+      }
+      for (size_t pos : logEntry.records) {
+        records.emplace_back(pos, it->second.get());
+      }
+    }
+    std::sort(records.begin(), records.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (auto&& [pos, entry] : records) {
+      printRecord(entry, index->GetRecord(pos));
+    }
+    return;
+  }
+
   wpi::DenseMap<int, Entry*> nameMap;
   for (auto&& record : f.datalog->GetReader()) {
     if (record.IsStart()) {
@@ -568,24 +607,8 @@ static void ExportCsvFile(InputFile& f, wpi::raw_ostream& os, int style) {
       }
     } else if (!record.IsControl()) {
       auto entryIt = nameMap.find(record.GetEntry());
-      if (entryIt == nameMap.end()) {
-        continue;
-      }
-      Entry* entry = entryIt->second;
-
-      if (style == 0) {
-        fmt::print(os, "{},\"", record.GetTimestamp() / 1000000.0);
-        PrintEscapedCsvString(os, entry->name);
-        os << '"' << ',';
-        ValueToCsv(os, *entry, record);
-        os << '\n';
-      } else if (style == 1 && entry->column != -1) {
-        fmt::print(os, "{},", record.GetTimestamp() / 1000000.0);
-        for (int i = 0; i < entry->column; ++i) {
-          os << ',';
-        }
-        ValueToCsv(os, *entry, record);
-        os << '\n';
+      if (entryIt != nameMap.end()) {
+        printRecord(entryIt->second, record);
       }
     }
   }
@@ -4,11 +4,13 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <numeric>
 #include <random>
+#include <span>
 #include <string_view>
 #include <thread>
 
@@ -21,6 +23,8 @@
 
 void bench();
 void bench2();
+void contention();
+void listeners();
 void stress();
 
 int main(int argc, char* argv[]) {
@@ -34,6 +38,14 @@ int main(int argc, char* argv[]) {
     bench2();
     return EXIT_SUCCESS;
   }
+  if (argc == 2 && std::string_view{argv[1]} == "contention") {
+    contention();
+    return EXIT_SUCCESS;
+  }
+  if (argc == 2 && std::string_view{argv[1]} == "listeners") {
+    listeners();
+    return EXIT_SUCCESS;
+  }
   if (argc == 2 && std::string_view{argv[1]} == "stress") {
     stress();
     return EXIT_SUCCESS;
@@ -196,6 +208,120 @@ void bench2() {
   PrintTimes(flushTimes);
 }
 
+// multi-threaded local Set/Get throughput (no network)
+void contention() {
+  auto inst = nt::CreateInstance();
+
+  // create 300 topics, each with a publisher and a subscriber
+  constexpr int kNumTopics = 300;
+  std::vector<NT_Publisher> pubs;
+  std::vector<NT_Subscriber> subs;
+  pubs.reserve(kNumTopics);
+  subs.reserve(kNumTopics);
+  for (int i = 0; i < kNumTopics; ++i) {
+    auto topic = nt::GetTopic(inst, fmt::format("/contention/{}", i));
+    pubs.emplace_back(nt::Publish(topic, NT_DOUBLE, "double"));
+    subs.emplace_back(nt::Subscribe(topic, NT_DOUBLE, "double"));
+    nt::SetDouble(pubs.back(), 0);
+  }
+
+  constexpr int kIterations = 200;
+  for (int numReaders : {0, 1, 2, 4}) {
+    std::atomic<int64_t> gets{0};
+    std::atomic_bool done{false};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < numReaders; ++r) {
+      readers.emplace_back([&] {
+        int64_t count = 0;
+        while (!done) {
+          for (auto sub : subs) {
+            nt::GetDouble(sub, 0);
+          }
+          count += kNumTopics;
+        }
+        gets += count;
+      });
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+      for (auto pub : pubs) {
+        nt::SetDouble(pub, i * 0.01);
+      }
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    done = true;
+    for (auto&& reader : readers) {
+      reader.join();
+    }
+
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start)
+                  .count();
+    fmt::print("readers: {} sets: {} time: {}us sets/s: {:.0f} gets/s: {:.0f}\n",
+               numReaders, kIterations * kNumTopics, us,
+               kIterations * kNumTopics * 1e6 / us, gets * 1e6 / us);
+  }
+
+  nt::DestroyInstance(inst);
+}
+
+// listener callback throughput under a value storm (no network)
+void listeners() {
+  constexpr int kNumTopics = 100;
+  constexpr int kIterations = 1000;
+
+  struct Mode {
+    std::string_view name;
+    unsigned int flags;
+    bool batch;
+  };
+  for (auto&& mode :
+       {Mode{"per-event", 0, false}, Mode{"batch", 0, true},
+        Mode{"coalesce", nt::EventFlags::kValueCoalesce, false},
+        Mode{"batch+coalesce", nt::EventFlags::kValueCoalesce, true}}) {
+    auto inst = nt::CreateInstance();
+    std::vector<NT_Publisher> pubs;
+    pubs.reserve(kNumTopics);
+    for (int i = 0; i < kNumTopics; ++i) {
+      auto topic = nt::GetTopic(inst, fmt::format("/storm/{}", i));
+      pubs.emplace_back(nt::Publish(topic, NT_DOUBLE, "double"));
+    }
+
+    std::atomic<int64_t> events{0};
+    std::atomic<int64_t> calls{0};
+    unsigned int mask = nt::EventFlags::kValueLocal | mode.flags;
+    if (mode.batch) {
+      nt::AddBatchListener(inst, {{"/storm/"}}, mask,
+                           [&](std::span<const nt::Event> batch) {
+                             events += batch.size();
+                             ++calls;
+                           });
+    } else {
+      nt::AddListener(inst, {{"/storm/"}}, mask, [&](const nt::Event&) {
+        ++events;
+        ++calls;
+      });
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+      for (auto pub : pubs) {
+        nt::SetDouble(pub, i);
+      }
+    }
+    nt::WaitForListenerQueue(inst, 10.0);
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    auto us =
+        std::chrono::duration_cast<std::chrono::microseconds>(stop - start)
+            .count();
+    fmt::print("{}: sets: {} events: {} calls: {} time: {}us sets/s: {:.0f}\n",
+               mode.name, kIterations * kNumTopics, events.load(),
+               calls.load(), us, kIterations * kNumTopics * 1e6 / us);
+    nt::DestroyInstance(inst);
+  }
+}
+
 static std::random_device r;
 static std::mt19937 gen(r());
 static std::uniform_real_distribution<double> dist;
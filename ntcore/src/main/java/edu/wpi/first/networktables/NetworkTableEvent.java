@@ -53,7 +53,14 @@ public final class NetworkTableEvent {
     kLogMessage(0x0100),
 
     /** Time synchronized with server. */
-    kTimeSync(0x0200);
+    kTimeSync(0x0200),
+
+    /**
+     * Modifier for value events: only the latest value per topic is queued. If a value event for a
+     * topic has not yet been delivered when a new value arrives, the queued event is replaced
+     * instead of adding another one.
+     */
+    kValueCoalesce(0x0400);
 
     private final int value;
 
@@ -15,7 +15,8 @@ public class PubSubOption {
     disableRemote,
     disableLocal,
     excludePublisher,
-    excludeSelf
+    excludeSelf,
+    fastPublish
   }
 
   PubSubOption(Kind kind, boolean value) {
@@ -149,6 +150,19 @@ public class PubSubOption {
     return new PubSubOption(Kind.excludeSelf, enabled);
   }
 
+  /**
+   * Queue value changes in a lock-free per-publisher buffer that is drained in batches by the
+   * network thread, so set() does not block on the NetworkTables mutex or on listener dispatch.
+   * Local subscribers and listeners see queued values when the buffer is drained. Only has an
+   * effect on publishers.
+   *
+   * @param enabled True to enable, false to disable
+   * @return option
+   */
+  public static PubSubOption fastPublish(boolean enabled) {
+    return new PubSubOption(Kind.fastPublish, enabled);
+  }
+
   final Kind m_kind;
   final boolean m_bValue;
   final int m_iValue;
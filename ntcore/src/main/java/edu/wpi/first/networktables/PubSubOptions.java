@@ -42,6 +42,9 @@ public class PubSubOptions {
         case excludeSelf:
           excludeSelf = option.m_bValue;
           break;
+        case fastPublish:
+          fastPublish = option.m_bValue;
+          break;
         default:
           break;
       }
@@ -58,7 +61,8 @@ public class PubSubOptions {
       boolean prefixMatch,
       boolean disableRemote,
       boolean disableLocal,
-      boolean excludeSelf) {
+      boolean excludeSelf,
+      boolean fastPublish) {
     this.pollStorage = pollStorage;
     this.periodic = periodic;
     this.excludePublisher = excludePublisher;
@@ -69,6 +73,7 @@ public class PubSubOptions {
     this.disableRemote = disableRemote;
     this.disableLocal = disableLocal;
     this.excludeSelf = excludeSelf;
+    this.fastPublish = fastPublish;
   }
 
   /** Default value of periodic. */
@@ -123,4 +128,11 @@ public class PubSubOptions {
 
   /** For entries, don't queue (for readQueue) value updates for the entry's internal publisher. */
   public boolean excludeSelf;
+
+  /**
+   * For publishers, queue value changes in a lock-free per-publisher buffer that is drained in
+   * batches by the network thread. Local subscribers and listeners see queued values when the
+   * buffer is drained.
+   */
+  public boolean fastPublish;
 }
@@ -0,0 +1,158 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Handle.h"
+#include "networktables/NetworkTableValue.h"
+
+namespace nt {
+
+// Bounded single-producer, single-consumer queue of values for fastPublish
+// publishers. The producer (the thread calling Set) and the consumer (the
+// thread draining the queue into local storage) never block each other.
+class FastPublishQueue {
+ public:
+  explicit FastPublishQueue(size_t size)
+      : m_slots(std::bit_ceil(size)), m_mask{m_slots.size() - 1} {}
+
+  FastPublishQueue(const FastPublishQueue&) = delete;
+  FastPublishQueue& operator=(const FastPublishQueue&) = delete;
+
+  // Producer side. Returns false if the queue is full.
+  bool Push(const Value& value) {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+      return false;
+    }
+    m_slots[head & m_mask] = value;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Calls func(Value&&) for each queued value, oldest first.
+  template <typename F>
+  void Drain(F&& func) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t head = m_head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail) {
+      func(std::move(m_slots[tail & m_mask]));
+      m_slots[tail & m_mask] = Value{};
+    }
+    m_tail.store(tail, std::memory_order_release);
+  }
+
+  bool empty() const {
+    return m_head.load(std::memory_order_acquire) ==
+           m_tail.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::vector<Value> m_slots;
+  size_t m_mask;
+  alignas(64) std::atomic<size_t> m_head{0};
+  alignas(64) std::atomic<size_t> m_tail{0};
+};
+
+// Map from publisher handle index to fastPublish publisher that producers
+// can read without taking a lock. Slots are allocated in blocks that are
+// never moved or freed while the table exists, so a lookup is two atomic
+// loads. Set(), Clear() and WaitIdle() must be serialized by the caller
+// (they are called with the LocalStorage mutex held).
+template <typename T>
+class FastPublisherTable {
+ public:
+  FastPublisherTable() = default;
+  FastPublisherTable(const FastPublisherTable&) = delete;
+  FastPublisherTable& operator=(const FastPublisherTable&) = delete;
+
+  ~FastPublisherTable() {
+    for (auto&& block : m_blocks) {
+      delete block.load(std::memory_order_relaxed);
+    }
+  }
+
+  void Set(unsigned int index, T* value) {
+    auto& blockPtr = m_blocks[index >> kBlockBits];
+    Block* block = blockPtr.load(std::memory_order_relaxed);
+    if (!block) {
+      block = new Block;
+      blockPtr.store(block, std::memory_order_release);
+    }
+    (*block)[index & kBlockMask].value.store(value);
+  }
+
+  // Removes the entry and waits for any producer still using it.
+  void Clear(unsigned int index) {
+    if (Slot* slot = GetSlot(index)) {
+      slot->value.store(nullptr);
+      WaitIdle(*slot);
+    }
+  }
+
+  // Waits for any producer currently inside Use() for this index.
+  void WaitIdle(unsigned int index) {
+    if (Slot* slot = GetSlot(index)) {
+      WaitIdle(*slot);
+    }
+  }
+
+  // Calls func(T*) if there is an entry for index and returns its result;
+  // returns false otherwise. Clear() and WaitIdle() do not return while
+  // func is running.
+  template <typename F>
+  bool Use(unsigned int index, F&& func) {
+    Slot* slot = GetSlot(index);
+    if (!slot) {
+      return false;
+    }
+    slot->users.fetch_add(1);
+    T* value = slot->value.load();
+    bool rv = value && func(value);
+    slot->users.fetch_sub(1, std::memory_order_release);
+    return rv;
+  }
+
+ private:
+  static constexpr unsigned int kBlockBits = 8;
+  static constexpr unsigned int kBlockMask = (1u << kBlockBits) - 1;
+
+  // each slot is on its own cache line so producers for different
+  // publishers don't contend
+  struct alignas(64) Slot {
+    std::atomic<T*> value{nullptr};
+    std::atomic<int> users{0};
+  };
+  using Block = std::array<Slot, 1u << kBlockBits>;
+
+  Slot* GetSlot(unsigned int index) {
+    if (index > Handle::kIndexMax) {
+      return nullptr;
+    }
+    Block* block =
+        m_blocks[index >> kBlockBits].load(std::memory_order_acquire);
+    return block ? &(*block)[index & kBlockMask] : nullptr;
+  }
+
+  static void WaitIdle(Slot& slot) {
+    while (slot.users.load(std::memory_order_acquire) != 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  std::array<std::atomic<Block*>, (Handle::kIndexMax >> kBlockBits) + 1>
+      m_blocks{};
+};
+
+}  // namespace nt
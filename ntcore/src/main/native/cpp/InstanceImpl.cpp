@@ -4,6 +4,8 @@
 
 #include "InstanceImpl.h"
 
+#include <wpinet/WebSocket.h>
+
 using namespace nt;
 
 std::atomic<int> InstanceImpl::s_default{-1};
@@ -109,6 +111,15 @@ void InstanceImpl::StartServer(std::string_view persistFilename,
         std::scoped_lock lock{m_mutex};
         networkMode &= ~NT_NET_MODE_STARTING;
       });
+  if (m_serverBandwidthLimit != 0) {
+    m_networkServer->SetBandwidthLimit(m_serverBandwidthLimit);
+  }
+  if (m_networkCompression) {
+    m_networkServer->SetCompression(true);
+  }
+  if (m_networkDeltaArrays) {
+    m_networkServer->SetDeltaArrays(true);
+  }
   networkMode = NT_NET_MODE_SERVER | NT_NET_MODE_STARTING;
   listenerStorage.NotifyTimeSync({}, NT_EVENT_TIMESYNC, 0, 0, true);
   m_serverTimeOffset = 0;
@@ -148,7 +159,7 @@ void InstanceImpl::StartClient4(std::string_view identity) {
   if (networkMode != NT_NET_MODE_NONE) {
     return;
   }
-  m_networkClient = std::make_shared<NetworkClient>(
+  auto client = std::make_shared<NetworkClient>(
       m_inst, identity, localStorage, connectionList, logger,
       [this](int64_t serverTimeOffset, int64_t rtt2, bool valid) {
         std::scoped_lock lock{m_mutex};
@@ -162,6 +173,13 @@ void InstanceImpl::StartClient4(std::string_view identity) {
           m_rtt2 = 0;
         }
       });
+  if (m_networkCompression) {
+    client->SetCompression(true);
+  }
+  if (m_networkDeltaArrays) {
+    client->SetDeltaArrays(true);
+  }
+  m_networkClient = std::move(client);
   if (!m_servers.empty()) {
     m_networkClient->SetServers(m_servers);
   }
@@ -196,6 +214,30 @@ void InstanceImpl::SetServers(
   }
 }
 
+void InstanceImpl::SetServerBandwidthLimit(unsigned int bytesPerSec) {
+  std::scoped_lock lock{m_mutex};
+  m_serverBandwidthLimit = bytesPerSec;
+  if (m_networkServer) {
+    m_networkServer->SetBandwidthLimit(bytesPerSec);
+  }
+}
+
+void InstanceImpl::SetNetworkCompression(bool enabled) {
+  std::scoped_lock lock{m_mutex};
+  if (enabled && !wpi::WebSocket::IsDeflateAvailable()) {
+    WPI_WARNING(logger,
+                "network compression is not available in this build (no zlib "
+                "support); connections will not be compressed");
+    enabled = false;
+  }
+  m_networkCompression = enabled;
+}
+
+void InstanceImpl::SetNetworkDeltaArrays(bool enabled) {
+  std::scoped_lock lock{m_mutex};
+  m_networkDeltaArrays = enabled;
+}
+
 std::shared_ptr<NetworkServer> InstanceImpl::GetServer() {
   std::scoped_lock lock{m_mutex};
   return m_networkServer;
@@ -230,6 +272,9 @@ void InstanceImpl::Reset() {
   m_networkServer.reset();
   m_networkClient.reset();
   m_servers.clear();
+  m_serverBandwidthLimit = 0;
+  m_networkCompression = false;
+  m_networkDeltaArrays = false;
   networkMode = NT_NET_MODE_NONE;
   m_serverTimeOffset.reset();
   m_rtt2 = 0;
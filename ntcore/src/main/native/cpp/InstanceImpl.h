@@ -53,6 +53,9 @@ class InstanceImpl {
   void StopClient();
   void SetServers(
       std::span<const std::pair<std::string, unsigned int>> servers);
+  void SetServerBandwidthLimit(unsigned int bytesPerSec);
+  void SetNetworkCompression(bool enabled);
+  void SetNetworkDeltaArrays(bool enabled);
 
   std::shared_ptr<NetworkServer> GetServer();
   std::shared_ptr<INetworkClient> GetClient();
@@ -81,6 +84,9 @@ class InstanceImpl {
   std::shared_ptr<NetworkServer> m_networkServer;
   std::shared_ptr<INetworkClient> m_networkClient;
   std::vector<std::pair<std::string, unsigned int>> m_servers;
+  unsigned int m_serverBandwidthLimit = 0;
+  bool m_networkCompression = false;
+  bool m_networkDeltaArrays = false;
   std::optional<int64_t> m_serverTimeOffset;
   int64_t m_rtt2 = 0;
   int m_inst;
@@ -24,13 +24,38 @@ void ListenerStorage::Thread::Main() {
     // call all the way back out to the C++ API to ensure valid handle
     auto events = nt::ReadListenerQueue(m_poller);
     if (!events.empty()) {
+      // batch listeners are called once with all of their events, after the
+      // per-event listeners
+      wpi::SmallVector<std::pair<NT_Listener, std::vector<Event>>, 4> batches;
       std::unique_lock lock{m_mutex};
       for (auto&& event : events) {
         auto callbackIt = m_callbacks.find(event.listener);
+        if (callbackIt == m_callbacks.end()) {
+          continue;
+        }
+        if (callbackIt->second->batchFunc) {
+          auto batchIt = std::find_if(
+              batches.begin(), batches.end(),
+              [&](const auto& batch) { return batch.first == event.listener; });
+          if (batchIt == batches.end()) {
+            batches.emplace_back(event.listener, std::vector<Event>{});
+            batchIt = batches.end() - 1;
+          }
+          batchIt->second.emplace_back(std::move(event));
+        } else {
+          auto callback = callbackIt->second;
+          lock.unlock();
+          callback->func(event);
+          lock.lock();
+        }
+      }
+      for (auto&& [listener, batch] : batches) {
+        // the listener may have been removed by a callback
+        auto callbackIt = m_callbacks.find(listener);
         if (callbackIt != m_callbacks.end()) {
           auto callback = callbackIt->second;
           lock.unlock();
-          callback(event);
+          callback->batchFunc(batch);
           lock.lock();
         }
       }
@@ -49,6 +74,9 @@ void ListenerStorage::Activate(NT_Listener listenerHandle, unsigned int mask,
     listener->sources.emplace_back(std::move(finishEvent), mask);
     unsigned int deltaMask = mask & (~listener->eventMask);
     listener->eventMask |= mask;
+    if ((mask & NT_EVENT_VALUE_COALESCE) != 0) {
+      listener->coalesce = true;
+    }
 
     if ((deltaMask & NT_EVENT_CONNECTION) != 0) {
       m_connListeners.Add(listener);
@@ -163,13 +191,23 @@ void ListenerStorage::Notify(std::span<const NT_Listener> handles,
       int count = 0;
       for (auto&& [finishEvent, mask] : listener.sources) {
         if ((flags & mask) != 0) {
-          listener.poller->queue.emplace_back(listener.handle, flags, topic,
-                                              subentry, value);
-          if (finishEvent &&
-              !finishEvent(mask, &listener.poller->queue.back())) {
-            listener.poller->queue.pop_back();
+          auto& queue = listener.poller->queue;
+          queue.emplace_back(listener.handle, flags, topic, subentry, value);
+          if (finishEvent && !finishEvent(mask, &queue.back())) {
+            queue.pop_back();
           } else {
             ++count;
+            if (listener.coalesce) {
+              // replace the pending event for this topic, if any
+              auto [it, isNew] = listener.poller->coalesced.try_emplace(
+                  (static_cast<uint64_t>(listener.handle.GetHandle()) << 32) |
+                      topic,
+                  queue.size() - 1);
+              if (!isNew) {
+                queue[it->second] = std::move(queue.back());
+                queue.pop_back();
+              }
+            }
           }
         }
       }
@@ -261,6 +299,22 @@ void ListenerStorage::NotifyTimeSync(std::span<const NT_Listener> handles,
 
 NT_Listener ListenerStorage::AddListener(ListenerCallback callback) {
   std::scoped_lock lock{m_mutex};
+  return DoAddListener(
+      std::make_shared<Callback>(Callback{std::move(callback), {}}));
+}
+
+NT_Listener ListenerStorage::AddListener(ListenerBatchCallback callback) {
+  std::scoped_lock lock{m_mutex};
+  return DoAddListener(
+      std::make_shared<Callback>(Callback{{}, std::move(callback)}));
+}
+
+NT_Listener ListenerStorage::AddListener(NT_ListenerPoller pollerHandle) {
+  std::scoped_lock lock{m_mutex};
+  return DoAddListener(pollerHandle);
+}
+
+NT_Listener ListenerStorage::DoAddListener(std::shared_ptr<Callback> callback) {
   if (!m_thread) {
     m_thread.Start(m_pollers.Add(m_inst)->handle);
   }
@@ -275,11 +329,6 @@ NT_Listener ListenerStorage::AddListener(ListenerCallback callback) {
   }
 }
 
-NT_Listener ListenerStorage::AddListener(NT_ListenerPoller pollerHandle) {
-  std::scoped_lock lock{m_mutex};
-  return DoAddListener(pollerHandle);
-}
-
 NT_Listener ListenerStorage::DoAddListener(NT_ListenerPoller pollerHandle) {
   if (auto poller = m_pollers.Get(pollerHandle)) {
     return m_listeners.Add(m_inst, poller)->handle;
@@ -316,6 +365,7 @@ std::vector<Event> ListenerStorage::ReadListenerQueue(
   if (auto poller = m_pollers.Get(pollerHandle)) {
     std::vector<Event> rv;
     rv.swap(poller->queue);
+    poller->coalesced.clear();
     return rv;
   } else {
     return {};
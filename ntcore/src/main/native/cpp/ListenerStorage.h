@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <functional>
 #include <memory>
 #include <span>
@@ -47,6 +49,7 @@ class ListenerStorage final : public IListenerStorage {
 
   // user-facing functions
   NT_Listener AddListener(ListenerCallback callback);
+  NT_Listener AddListener(ListenerBatchCallback callback);
   NT_Listener AddListener(NT_ListenerPoller pollerHandle);
   NT_ListenerPoller CreateListenerPoller();
 
@@ -67,7 +70,13 @@ class ListenerStorage final : public IListenerStorage {
   void Reset();
 
  private:
+  struct Callback {
+    ListenerCallback func;
+    ListenerBatchCallback batchFunc;  // used instead of func if set
+  };
+
   // these assume the mutex is already held
+  NT_Listener DoAddListener(std::shared_ptr<Callback> callback);
   NT_Listener DoAddListener(NT_ListenerPoller pollerHandle);
   std::vector<std::pair<NT_Listener, unsigned int>> DoRemoveListeners(
       std::span<const NT_Listener> handles);
@@ -82,6 +91,9 @@ class ListenerStorage final : public IListenerStorage {
 
     wpi::SignalObject<NT_ListenerPoller> handle;
     std::vector<Event> queue;
+    // queue index of the pending value event for each (listener, topic) pair
+    // of coalescing listeners; cleared when the queue is read
+    wpi::DenseMap<uint64_t, size_t> coalesced;
   };
   HandleMap<PollerData, 8> m_pollers;
 
@@ -95,6 +107,7 @@ class ListenerStorage final : public IListenerStorage {
     PollerData* poller;
     wpi::SmallVector<std::pair<FinishEventFunc, unsigned int>, 2> sources;
     unsigned int eventMask{0};
+    bool coalesce{false};
   };
   HandleMap<ListenerData, 8> m_listeners;
 
@@ -111,7 +124,7 @@ class ListenerStorage final : public IListenerStorage {
     void Main() final;
 
     NT_ListenerPoller m_poller;
-    wpi::DenseMap<NT_Listener, ListenerCallback> m_callbacks;
+    wpi::DenseMap<NT_Listener, std::shared_ptr<Callback>> m_callbacks;
     wpi::Event m_waitQueueWakeup;
     wpi::Event m_waitQueueWaiter;
   };
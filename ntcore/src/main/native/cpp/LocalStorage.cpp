@@ -24,11 +24,22 @@ static constexpr size_t kMaxSubscribers = 512;
 static constexpr size_t kMaxMultiSubscribers = 512;
 static constexpr size_t kMaxListeners = 512;
 
+// number of values buffered per fastPublish publisher between drains
+static constexpr size_t kFastPublishQueueSize = 128;
+
 static constexpr bool PrefixMatch(std::string_view name,
                                   std::string_view prefix, bool special) {
   return (!special || !prefix.empty()) && wpi::starts_with(name, prefix);
 }
 
+// sorts into handle (creation) order and removes duplicates
+template <typename T>
+static void SortHandleOrder(wpi::SmallVectorImpl<T*>& v) {
+  std::sort(v.begin(), v.end(),
+            [](const T* a, const T* b) { return a->handle < b->handle; });
+  v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+
 std::string LocalStorage::DataLoggerEntry::MakeMetadata(
     std::string_view properties) {
   return fmt::format("{{\"properties\":{},\"source\":\"NT\"}}", properties);
@@ -501,6 +512,9 @@ std::unique_ptr<LocalStorage::PublisherData>
 LocalStorage::Impl::RemoveLocalPublisher(NT_Publisher pubHandle) {
   auto publisher = m_publishers.Remove(pubHandle);
   if (publisher) {
+    if (publisher->fastQueue) {
+      RemoveFastPublisher(publisher.get());
+    }
     auto topic = publisher->topic;
     bool didExist = topic->Exists();
     topic->localPublishers.Remove(publisher.get());
@@ -603,15 +617,18 @@ LocalStorage::MultiSubscriberData* LocalStorage::Impl::AddMultiSubscriber(
     std::span<const std::string_view> prefixes, const PubSubOptions& options) {
   DEBUG4("AddMultiSubscriber({})", fmt::join(prefixes, ","));
   auto subscriber = m_multiSubscribers.Add(m_inst, prefixes, options);
-  // subscribe to any already existing topics
-  for (auto&& topic : m_topics) {
-    for (auto&& prefix : prefixes) {
-      if (PrefixMatch(topic->name, prefix, topic->special)) {
-        topic->multiSubscribers.Add(subscriber);
-        break;
-      }
+  for (auto&& prefix : subscriber->prefixes) {
+    auto& subscribers = m_multiSubscriberPrefixes[prefix];
+    if (subscribers.empty() || subscribers.back() != subscriber) {
+      subscribers.Add(subscriber);
     }
   }
+  // subscribe to any already existing topics
+  wpi::SmallVector<TopicData*, 32> topics;
+  GetMatchingTopics(subscriber, topics);
+  for (auto topic : topics) {
+    topic->multiSubscribers.Add(subscriber);
+  }
   if (m_network) {
     DEBUG4("-> NetworkSubscribe");
     m_network->Subscribe(subscriber->handle, subscriber->prefixes,
@@ -624,9 +641,19 @@ std::unique_ptr<LocalStorage::MultiSubscriberData>
 LocalStorage::Impl::RemoveMultiSubscriber(NT_MultiSubscriber subHandle) {
   auto subscriber = m_multiSubscribers.Remove(subHandle);
   if (subscriber) {
-    for (auto&& topic : m_topics) {
+    wpi::SmallVector<TopicData*, 32> topics;
+    GetMatchingTopics(subscriber.get(), topics);
+    for (auto topic : topics) {
       topic->multiSubscribers.Remove(subscriber.get());
     }
+    for (auto&& prefix : subscriber->prefixes) {
+      if (auto subscribers = m_multiSubscriberPrefixes.Find(prefix)) {
+        subscribers->Remove(subscriber.get());
+        if (subscribers->empty()) {
+          m_multiSubscriberPrefixes.Erase(prefix);
+        }
+      }
+    }
     for (auto&& listener : m_listeners) {
       if (listener.getSecond()->multiSubscriber == subscriber.get()) {
         listener.getSecond()->multiSubscriber = nullptr;
@@ -694,7 +721,9 @@ void LocalStorage::Impl::AddListenerImpl(NT_Listener listenerHandle,
       return;
     }
     m_listenerStorage.Activate(
-        listenerHandle, eventMask & (NT_EVENT_VALUE_ALL | NT_EVENT_IMMEDIATE),
+        listenerHandle,
+        eventMask &
+            (NT_EVENT_VALUE_ALL | NT_EVENT_IMMEDIATE | NT_EVENT_VALUE_COALESCE),
         [subentryHandle](unsigned int mask, Event* event) {
           if (auto valueData = event->GetValueEventData()) {
             valueData->subentry = subentryHandle;
@@ -730,11 +759,11 @@ void LocalStorage::Impl::AddListenerImpl(NT_Listener listenerHandle,
   wpi::SmallVector<TopicData*, 32> topics;
   if ((eventMask & NT_EVENT_IMMEDIATE) != 0 &&
       (eventMask & (NT_EVENT_PUBLISH | NT_EVENT_VALUE_ALL)) != 0) {
-    for (auto&& topic : m_topics) {
-      if (topic->Exists() && subscriber->Matches(topic->name, topic->special)) {
-        topics.emplace_back(topic.get());
-      }
-    }
+    GetMatchingTopics(subscriber, topics);
+    topics.erase(
+        std::remove_if(topics.begin(), topics.end(),
+                       [](TopicData* topic) { return !topic->Exists(); }),
+        topics.end());
   }
 
   if ((eventMask & NT_EVENT_TOPIC) != 0) {
@@ -770,7 +799,9 @@ void LocalStorage::Impl::AddListenerImpl(NT_Listener listenerHandle,
     }
 
     m_listenerStorage.Activate(
-        listenerHandle, eventMask & (NT_EVENT_VALUE_ALL | NT_EVENT_IMMEDIATE),
+        listenerHandle,
+        eventMask &
+            (NT_EVENT_VALUE_ALL | NT_EVENT_IMMEDIATE | NT_EVENT_VALUE_COALESCE),
         [subentryHandle = subscriber->handle.GetHandle()](unsigned int mask,
                                                           Event* event) {
           if (auto valueData = event->GetValueEventData()) {
@@ -795,6 +826,20 @@ void LocalStorage::Impl::AddListenerImpl(NT_Listener listenerHandle,
   }
 }
 
+void LocalStorage::Impl::GetMatchingTopics(
+    const MultiSubscriberData* subscriber,
+    wpi::SmallVectorImpl<TopicData*>& topics) {
+  topics.clear();
+  for (auto&& prefix : subscriber->prefixes) {
+    m_nameTopics.ForEachWithPrefix(prefix, [&](TopicData* topic) {
+      if (PrefixMatch(topic->name, prefix, topic->special)) {
+        topics.emplace_back(topic);
+      }
+    });
+  }
+  SortHandleOrder(topics);
+}
+
 LocalStorage::TopicData* LocalStorage::Impl::GetOrCreateTopic(
     std::string_view name) {
   auto& topic = m_nameTopics[name];
@@ -802,9 +847,18 @@ LocalStorage::TopicData* LocalStorage::Impl::GetOrCreateTopic(
   if (!topic) {
     topic = m_topics.Add(m_inst, name);
     // attach multi-subscribers
-    for (auto&& sub : m_multiSubscribers) {
-      if (sub->Matches(name, topic->special)) {
-        topic->multiSubscribers.Add(sub.get());
+    if (!m_multiSubscriberPrefixes.empty()) {
+      wpi::SmallVector<MultiSubscriberData*, 16> subscribers;
+      m_multiSubscriberPrefixes.ForEachPrefixOf(
+          name, [&](std::string_view prefix, auto& prefixSubscribers) {
+            if (PrefixMatch(name, prefix, topic->special)) {
+              subscribers.append(prefixSubscribers.begin(),
+                                 prefixSubscribers.end());
+            }
+          });
+      SortHandleOrder(subscribers);
+      for (auto sub : subscribers) {
+        topic->multiSubscribers.Add(sub);
       }
     }
   }
@@ -914,6 +968,65 @@ bool LocalStorage::Impl::PublishLocalValue(PublisherData* publisher,
   }
 }
 
+void LocalStorage::Impl::AddFastPublisher(PublisherData* publisher) {
+  publisher->fastQueue =
+      std::make_unique<FastPublishQueue>(kFastPublishQueueSize);
+  m_fastPublishers.Add(publisher);
+  m_fastPublisherTable.Set(Handle{publisher->handle}.GetIndex(), publisher);
+}
+
+void LocalStorage::Impl::RemoveFastPublisher(PublisherData* publisher) {
+  // waits for any Set() still pushing to the queue
+  m_fastPublisherTable.Clear(Handle{publisher->handle}.GetIndex());
+  m_fastPublishers.Remove(publisher);
+  // publish anything that was queued before the publisher was removed
+  DrainFastPublisher(publisher);
+}
+
+bool LocalStorage::Impl::PushFastValue(NT_Handle pubHandle,
+                                       const Value& value) {
+  Handle h{pubHandle};
+  if (!h.IsType(Handle::kPublisher)) {
+    return false;
+  }
+  return m_fastPublisherTable.Use(h.GetIndex(), [&](PublisherData* publisher) {
+    // checked while in use so StopFastPublishers() can wait for pushes that
+    // passed the check
+    if (!m_fastEnabled.load() || publisher->handle != pubHandle) {
+      return false;
+    }
+    // the publisher type and queue are invariant while in the table; values
+    // that need numeric conversion (or are invalid) go through the normal
+    // path
+    if (!value || value.type() != publisher->config.type) {
+      return false;
+    }
+    return publisher->fastQueue->Push(value);
+  });
+}
+
+void LocalStorage::Impl::DrainFastPublisher(PublisherData* publisher) {
+  publisher->fastQueue->Drain(
+      [&](Value&& value) { PublishLocalValue(publisher, value); });
+}
+
+void LocalStorage::Impl::DrainFastPublishers() {
+  for (auto&& publisher : m_fastPublishers) {
+    DrainFastPublisher(publisher);
+  }
+}
+
+void LocalStorage::Impl::StopFastPublishers() {
+  m_fastEnabled = false;
+  // a Set() that saw m_fastEnabled before it was cleared may still be
+  // pushing; wait for it so its value is drained here rather than left
+  // queued until the network restarts
+  for (auto&& publisher : m_fastPublishers) {
+    m_fastPublisherTable.WaitIdle(Handle{publisher->handle}.GetIndex());
+    DrainFastPublisher(publisher);
+  }
+}
+
 bool LocalStorage::Impl::SetEntryValue(NT_Handle pubentryHandle,
                                        const Value& value) {
   if (!value) {
@@ -928,6 +1041,10 @@ bool LocalStorage::Impl::SetEntryValue(NT_Handle pubentryHandle,
       return false;
     }
   }
+  // keep ordering with any values still in the fast queue (e.g. it's full)
+  if (publisher->fastQueue) {
+    DrainFastPublisher(publisher);
+  }
   return PublishLocalValue(publisher, value);
 }
 
@@ -1016,9 +1133,8 @@ void LocalStorage::NetworkUnannounce(std::string_view name) {
 void LocalStorage::NetworkPropertiesUpdate(std::string_view name,
                                            const wpi::json& update, bool ack) {
   std::scoped_lock lock{m_mutex};
-  auto it = m_impl.m_nameTopics.find(name);
-  if (it != m_impl.m_nameTopics.end()) {
-    m_impl.NetworkPropertiesUpdate(it->second, update, ack);
+  if (auto topic = m_impl.m_nameTopics.Find(name)) {
+    m_impl.NetworkPropertiesUpdate(*topic, update, ack);
   }
 }
 
@@ -1038,6 +1154,11 @@ void LocalStorage::StartNetwork(net::NetworkInterface* network) {
   m_impl.StartNetwork(network);
 }
 
+void LocalStorage::DrainFastPublishers() {
+  std::scoped_lock lock{m_mutex};
+  m_impl.DrainFastPublishers();
+}
+
 void LocalStorage::Impl::StartNetwork(net::NetworkInterface* network) {
   DEBUG4("StartNetwork()");
   m_network = network;
@@ -1064,11 +1185,15 @@ void LocalStorage::Impl::StartNetwork(net::NetworkInterface* network) {
     network->Subscribe(subscriber->handle, subscriber->prefixes,
                        subscriber->options);
   }
+  // fastPublish queues are only drained while the network is running
+  DrainFastPublishers();
+  m_fastEnabled = true;
 }
 
 void LocalStorage::ClearNetwork() {
   WPI_DEBUG4(m_impl.m_logger, "ClearNetwork()");
   std::scoped_lock lock{m_mutex};
+  m_impl.StopFastPublishers();
   m_impl.m_network = nullptr;
   // treat as an unannounce all from the network side
   for (auto&& topic : m_impl.m_topics) {
@@ -1076,72 +1201,66 @@ void LocalStorage::ClearNetwork() {
   }
 }
 
+// calls func for each existing topic starting with prefix, in handle order
 template <typename T, typename F>
-static void ForEachTopic(T& topics, std::string_view prefix, unsigned int types,
+static void ForEachTopic(PrefixIndex<T*>& nameTopics, std::string_view prefix,
                          F func) {
-  for (auto&& topic : topics) {
-    if (!topic->Exists()) {
-      continue;
-    }
-    if (!wpi::starts_with(topic->name, prefix)) {
-      continue;
-    }
-    if (types != 0 && (types & topic->type) == 0) {
-      continue;
+  wpi::SmallVector<T*, 64> topics;
+  nameTopics.ForEachWithPrefix(prefix, [&](auto topic) {
+    if (topic->Exists()) {
+      topics.emplace_back(topic);
     }
+  });
+  SortHandleOrder(topics);
+  for (auto topic : topics) {
     func(*topic);
   }
 }
 
 template <typename T, typename F>
-static void ForEachTopic(T& topics, std::string_view prefix,
-                         std::span<const std::string_view> types, F func) {
-  for (auto&& topic : topics) {
-    if (!topic->Exists()) {
-      continue;
+static void ForEachTopic(PrefixIndex<T*>& nameTopics, std::string_view prefix,
+                         unsigned int types, F func) {
+  ForEachTopic(nameTopics, prefix, [&](T& topic) {
+    if (types == 0 || (types & topic.type) != 0) {
+      func(topic);
     }
-    if (!wpi::starts_with(topic->name, prefix)) {
-      continue;
-    }
-    if (!types.empty()) {
-      bool match = false;
-      for (auto&& type : types) {
-        if (topic->typeStr == type) {
-          match = true;
-          break;
-        }
-      }
-      if (!match) {
-        continue;
-      }
+  });
+}
+
+template <typename T, typename F>
+static void ForEachTopic(PrefixIndex<T*>& nameTopics, std::string_view prefix,
+                         std::span<const std::string_view> types, F func) {
+  ForEachTopic(nameTopics, prefix, [&](T& topic) {
+    if (types.empty() ||
+        std::find(types.begin(), types.end(), topic.typeStr) != types.end()) {
+      func(topic);
     }
-    func(*topic);
-  }
+  });
 }
 
 std::vector<NT_Topic> LocalStorage::GetTopics(std::string_view prefix,
                                               unsigned int types) {
-  std::scoped_lock lock(m_mutex);
+  std::shared_lock lock{m_mutex};
   std::vector<NT_Topic> rv;
-  ForEachTopic(m_impl.m_topics, prefix, types,
+  ForEachTopic(m_impl.m_nameTopics, prefix, types,
                [&](TopicData& topic) { rv.push_back(topic.handle); });
   return rv;
 }
 
 std::vector<NT_Topic> LocalStorage::GetTopics(
     std::string_view prefix, std::span<const std::string_view> types) {
-  std::scoped_lock lock(m_mutex);
+  std::shared_lock lock{m_mutex};
   std::vector<NT_Topic> rv;
-  ForEachTopic(m_impl.m_topics, prefix, types,
+  ForEachTopic(m_impl.m_nameTopics, prefix, types,
                [&](TopicData& topic) { rv.push_back(topic.handle); });
   return rv;
 }
 
 std::vector<TopicInfo> LocalStorage::GetTopicInfo(std::string_view prefix,
                                                   unsigned int types) {
-  std::scoped_lock lock(m_mutex);
+  std::shared_lock lock{m_mutex};
   std::vector<TopicInfo> rv;
-  ForEachTopic(m_impl.m_topics, prefix, types, [&](TopicData& topic) {
+  ForEachTopic(m_impl.m_nameTopics, prefix, types, [&](TopicData& topic) {
     rv.emplace_back(topic.GetTopicInfo());
   });
   return rv;
@@ -1149,9 +1268,9 @@ std::vector<TopicInfo> LocalStorage::GetTopicInfo(std::string_view prefix,
 
 std::vector<TopicInfo> LocalStorage::GetTopicInfo(
     std::string_view prefix, std::span<const std::string_view> types) {
-  std::scoped_lock lock(m_mutex);
+  std::shared_lock lock{m_mutex};
   std::vector<TopicInfo> rv;
-  ForEachTopic(m_impl.m_topics, prefix, types, [&](TopicData& topic) {
+  ForEachTopic(m_impl.m_nameTopics, prefix, types, [&](TopicData& topic) {
     rv.emplace_back(topic.GetTopicInfo());
   });
   return rv;
@@ -1262,10 +1381,12 @@ NT_Publisher LocalStorage::Publish(NT_Topic topicHandle, NT_Type type,
     return 0;
   }
 
-  return m_impl
-      .AddLocalPublisher(topic, properties,
-                         PubSubConfig{type, typeStr, options})
-      ->handle;
+  auto publisher = m_impl.AddLocalPublisher(
+      topic, properties, PubSubConfig{type, typeStr, options});
+  if (options.fastPublish) {
+    m_impl.AddFastPublisher(publisher);
+  }
+  return publisher->handle;
 }
 
 void LocalStorage::Unpublish(NT_Handle pubentryHandle) {
@@ -1331,7 +1452,7 @@ void LocalStorage::Release(NT_Handle pubsubentryHandle) {
 }
 
 Value LocalStorage::GetEntryValue(NT_Handle subentryHandle) {
-  std::scoped_lock lock{m_mutex};
+  std::shared_lock lock{m_mutex};
   if (auto subscriber = m_impl.GetSubEntry(subentryHandle)) {
     if (subscriber->config.type == NT_UNASSIGNED ||
         !subscriber->topic->lastValue ||
@@ -1378,7 +1499,8 @@ NT_Entry LocalStorage::GetEntry(std::string_view name) {
 void LocalStorage::AddListener(NT_Listener listenerHandle,
                                std::span<const std::string_view> prefixes,
                                unsigned int mask) {
-  mask &= (NT_EVENT_TOPIC | NT_EVENT_VALUE_ALL | NT_EVENT_IMMEDIATE);
+  mask &= (NT_EVENT_TOPIC | NT_EVENT_VALUE_ALL | NT_EVENT_IMMEDIATE |
+           NT_EVENT_VALUE_COALESCE);
   std::scoped_lock lock{m_mutex};
   if (m_impl.m_multiSubscribers.size() >= kMaxMultiSubscribers) {
     WPI_ERROR(
@@ -1394,7 +1516,8 @@ void LocalStorage::AddListener(NT_Listener listenerHandle,
 
 void LocalStorage::AddListener(NT_Listener listenerHandle, NT_Handle handle,
                                unsigned int mask) {
-  mask &= (NT_EVENT_TOPIC | NT_EVENT_VALUE_ALL | NT_EVENT_IMMEDIATE);
+  mask &= (NT_EVENT_TOPIC | NT_EVENT_VALUE_ALL | NT_EVENT_IMMEDIATE |
+           NT_EVENT_VALUE_COALESCE);
   std::scoped_lock lock{m_mutex};
   if (auto topic = m_impl.m_topics.Get(handle)) {
     m_impl.AddListenerImpl(listenerHandle, topic, mask);
@@ -1446,12 +1569,15 @@ NT_DataLogger LocalStorage::StartDataLog(wpi::log::DataLog& log,
 
   // start logging any matching topics
   auto now = nt::Now();
-  for (auto&& topic : m_impl.m_topics) {
-    if (!wpi::starts_with(topic->name, prefix) ||
-        topic->type == NT_UNASSIGNED || topic->typeStr.empty()) {
+  wpi::SmallVector<TopicData*, 64> topics;
+  m_impl.m_nameTopics.ForEachWithPrefix(
+      prefix, [&](TopicData* topic) { topics.emplace_back(topic); });
+  SortHandleOrder(topics);
+  for (auto topic : topics) {
+    if (topic->type == NT_UNASSIGNED || topic->typeStr.empty()) {
       continue;
     }
-    topic->datalogs.emplace_back(log, datalogger->Start(topic.get(), now),
+    topic->datalogs.emplace_back(log, datalogger->Start(topic, now),
                                  datalogger->handle);
     topic->datalogType = topic->type;
 
@@ -1483,6 +1609,11 @@ void LocalStorage::StopDataLog(NT_DataLogger logger) {
 
 void LocalStorage::Reset() {
   std::scoped_lock lock{m_mutex};
+  m_impl.m_fastEnabled = false;
+  for (auto&& publisher : m_impl.m_fastPublishers) {
+    m_impl.m_fastPublisherTable.Clear(Handle{publisher->handle}.GetIndex());
+  }
+  m_impl.m_fastPublishers.clear();
   m_impl.m_network = nullptr;
   m_impl.m_topics.clear();
   m_impl.m_publishers.clear();
@@ -1491,6 +1622,7 @@ void LocalStorage::Reset() {
   m_impl.m_multiSubscribers.clear();
   m_impl.m_dataloggers.clear();
   m_impl.m_nameTopics.clear();
+  m_impl.m_multiSubscriberPrefixes.clear();
   m_impl.m_listeners.clear();
   m_impl.m_topicPrefixListeners.clear();
 }
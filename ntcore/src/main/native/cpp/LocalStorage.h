@@ -6,8 +6,11 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <span>
 #include <string>
 #include <string_view>
@@ -15,13 +18,15 @@
 #include <vector>
 
 #include <wpi/DenseMap.h>
-#include <wpi/StringMap.h>
+#include <wpi/SmallVector.h>
 #include <wpi/Synchronization.h>
 #include <wpi/json.h>
 #include <wpi/mutex.h>
 
+#include "FastPublishQueue.h"
 #include "Handle.h"
 #include "HandleMap.h"
+#include "PrefixIndex.h"
 #include "PubSubOptions.h"
 #include "Types_internal.h"
 #include "ValueCircularBuffer.h"
@@ -56,6 +61,7 @@ class LocalStorage final : public net::ILocalStorage {
 
   void StartNetwork(net::NetworkInterface* network) final;
   void ClearNetwork() final;
+  void DrainFastPublishers() final;
 
   // User functions.  These are the actual implementations of the corresponding
   // user API functions in ntcore_cpp.
@@ -73,12 +79,20 @@ class LocalStorage final : public net::ILocalStorage {
     if (name.empty()) {
       return {};
     }
+    {
+      // fast path: most lookups are for topics that already exist
+      std::shared_lock lock{m_mutex};
+      auto topic = m_impl.m_nameTopics.Find(name);
+      if (topic && *topic) {
+        return (*topic)->handle;
+      }
+    }
     std::scoped_lock lock{m_mutex};
     return m_impl.GetOrCreateTopic(name)->handle;
   }
 
   std::string GetTopicName(NT_Topic topicHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto topic = m_impl.m_topics.Get(topicHandle)) {
       return topic->name;
     } else {
@@ -87,7 +101,7 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   NT_Type GetTopicType(NT_Topic topicHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto topic = m_impl.m_topics.Get(topicHandle)) {
       return topic->type;
     } else {
@@ -96,7 +110,7 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   std::string GetTopicTypeString(NT_Topic topicHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto topic = m_impl.m_topics.Get(topicHandle)) {
       return topic->typeStr;
     } else {
@@ -112,7 +126,7 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   bool GetTopicPersistent(NT_Topic topicHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto topic = m_impl.m_topics.Get(topicHandle)) {
       return (topic->flags & NT_PERSISTENT) != 0;
     } else {
@@ -128,7 +142,7 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   bool GetTopicRetained(NT_Topic topicHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto topic = m_impl.m_topics.Get(topicHandle)) {
       return (topic->flags & NT_RETAINED) != 0;
     } else {
@@ -137,13 +151,13 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   bool GetTopicExists(NT_Handle handle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     TopicData* topic = m_impl.GetTopic(handle);
     return topic && topic->Exists();
   }
 
   wpi::json GetTopicProperty(NT_Topic topicHandle, std::string_view name) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto topic = m_impl.m_topics.Get(topicHandle)) {
       return topic->properties.value(name, wpi::json{});
     } else {
@@ -157,7 +171,7 @@ class LocalStorage final : public net::ILocalStorage {
   void DeleteTopicProperty(NT_Topic topic, std::string_view name);
 
   wpi::json GetTopicProperties(NT_Topic topicHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto topic = m_impl.m_topics.Get(topicHandle)) {
       return topic->properties;
     } else {
@@ -168,7 +182,7 @@ class LocalStorage final : public net::ILocalStorage {
   bool SetTopicProperties(NT_Topic topic, const wpi::json& update);
 
   TopicInfo GetTopicInfo(NT_Topic topicHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto topic = m_impl.m_topics.Get(topicHandle)) {
       return topic->GetTopicInfo();
     } else {
@@ -210,7 +224,7 @@ class LocalStorage final : public net::ILocalStorage {
   void Release(NT_Handle pubsubentry);
 
   NT_Topic GetTopicFromHandle(NT_Handle pubsubentryHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto topic = m_impl.GetTopic(pubsubentryHandle)) {
       return topic->handle;
     } else {
@@ -219,6 +233,12 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   bool SetEntryValue(NT_Handle pubentryHandle, const Value& value) {
+    // fastPublish publishers bypass the main mutex while the network is
+    // running
+    if (m_impl.m_fastEnabled.load(std::memory_order_acquire) &&
+        m_impl.PushFastValue(pubentryHandle, value)) {
+      return true;
+    }
     std::scoped_lock lock{m_mutex};
     return m_impl.SetEntryValue(pubentryHandle, value);
   }
@@ -265,7 +285,7 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   unsigned int GetEntryFlags(NT_Entry entryHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto entry = m_impl.m_entries.Get(entryHandle)) {
       return entry->subscriber->topic->flags;
     } else {
@@ -277,7 +297,7 @@ class LocalStorage final : public net::ILocalStorage {
   NT_Entry GetEntry(std::string_view name);
 
   std::string GetEntryName(NT_Entry subentryHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto subscriber = m_impl.GetSubEntry(subentryHandle)) {
       return subscriber->topic->name;
     } else {
@@ -286,7 +306,7 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   NT_Type GetEntryType(NT_Entry subentryHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto subscriber = m_impl.GetSubEntry(subentryHandle)) {
       return subscriber->topic->type;
     } else {
@@ -295,7 +315,7 @@ class LocalStorage final : public net::ILocalStorage {
   }
 
   int64_t GetEntryLastChange(NT_Entry subentryHandle) {
-    std::scoped_lock lock{m_mutex};
+    std::shared_lock lock{m_mutex};
     if (auto subscriber = m_impl.GetSubEntry(subentryHandle)) {
       return subscriber->topic->lastValue.time();
     } else {
@@ -412,6 +432,9 @@ class LocalStorage final : public net::ILocalStorage {
 
     // whether or not the publisher should actually publish values
     bool active{false};
+
+    // value queue for fastPublish publishers
+    std::unique_ptr<FastPublishQueue> fastQueue;
   };
 
   struct SubscriberData {
@@ -541,7 +564,9 @@ class LocalStorage final : public net::ILocalStorage {
     HandleMap<DataLoggerData, 16> m_dataloggers;
 
     // name mappings
-    wpi::StringMap<TopicData*> m_nameTopics;
+    PrefixIndex<TopicData*> m_nameTopics;
+    // multi-subscriber prefixes, for matching new topics
+    PrefixIndex<VectorSet<MultiSubscriberData*>> m_multiSubscriberPrefixes;
 
     // listeners
     wpi::DenseMap<NT_Listener, std::unique_ptr<ListenerData>> m_listeners;
@@ -549,6 +574,12 @@ class LocalStorage final : public net::ILocalStorage {
     // string-based listeners
     VectorSet<ListenerData*> m_topicPrefixListeners;
 
+    // fastPublish publishers; m_fastPublisherTable is read without the main
+    // mutex so that Set() can find the queue without blocking
+    VectorSet<PublisherData*> m_fastPublishers;
+    std::atomic_bool m_fastEnabled{false};
+    FastPublisherTable<PublisherData> m_fastPublisherTable;
+
     // topic functions
     void NotifyTopic(TopicData* topic, unsigned int eventFlags);
 
@@ -609,6 +640,10 @@ class LocalStorage final : public net::ILocalStorage {
                          std::span<const std::string_view> prefixes,
                          unsigned int eventMask);
 
+    // gets existing topics matched by a multi-subscriber, in handle order
+    void GetMatchingTopics(const MultiSubscriberData* subscriber,
+                           wpi::SmallVectorImpl<TopicData*>& topics);
+
     TopicData* GetOrCreateTopic(std::string_view name);
     TopicData* GetTopic(NT_Handle handle);
     SubscriberData* GetSubEntry(NT_Handle subentryHandle);
@@ -625,20 +660,47 @@ class LocalStorage final : public net::ILocalStorage {
     bool PublishLocalValue(PublisherData* publisher, const Value& value,
                            bool force = false);
 
+    // fastPublish support; PushFastValue() is called without the main mutex
+    void AddFastPublisher(PublisherData* publisher);
+    void RemoveFastPublisher(PublisherData* publisher);
+    bool PushFastValue(NT_Handle pubHandle, const Value& value);
+    void DrainFastPublisher(PublisherData* publisher);
+    void DrainFastPublishers();
+    void StopFastPublishers();
+
     bool SetEntryValue(NT_Handle pubentryHandle, const Value& value);
     bool SetDefaultEntryValue(NT_Handle pubsubentryHandle, const Value& value);
 
     void RemoveSubEntry(NT_Handle subentryHandle);
   };
 
-  wpi::mutex m_mutex;
+#ifdef WPI_HAVE_PRIORITY_MUTEX
+  // Reader-writer locks can't provide priority inheritance, which the robot
+  // program's high priority threads rely on to not be blocked indefinitely by
+  // lower priority threads (e.g. dashboard updates), so where wpi::mutex has
+  // priority inheritance shared locks are exclusive too.
+  class SharedMutex : public wpi::mutex {
+   public:
+    void lock_shared() { lock(); }
+    bool try_lock_shared() { return try_lock(); }
+    void unlock_shared() { unlock(); }
+  };
+#else
+  using SharedMutex = std::shared_mutex;
+#endif
+
+  // Reader-writer lock. Operations that only read topic/pubsub state (value
+  // and metadata getters) take a shared lock so that multiple reader threads
+  // do not serialize against each other; anything that mutates state or
+  // dispatches to listeners/network takes an exclusive lock.
+  SharedMutex m_mutex;
   Impl m_impl;
 };
 
 template <ValidType T>
 Timestamped<typename TypeInfo<T>::Value> LocalStorage::GetAtomic(
     NT_Handle subentry, typename TypeInfo<T>::View defaultValue) {
-  std::scoped_lock lock{m_mutex};
+  std::shared_lock lock{m_mutex};
   Value* value = m_impl.GetSubEntryValue(subentry);
   if (value && (IsNumericConvertibleTo<T>(*value) || IsType<T>(*value))) {
     return GetTimestamped<T, true>(*value);
@@ -652,7 +714,7 @@ Timestamped<typename TypeInfo<T>::SmallRet> LocalStorage::GetAtomic(
     NT_Handle subentry,
     wpi::SmallVectorImpl<typename TypeInfo<T>::SmallElem>& buf,
     typename TypeInfo<T>::View defaultValue) {
-  std::scoped_lock lock{m_mutex};
+  std::shared_lock lock{m_mutex};
   Value* value = m_impl.GetSubEntryValue(subentry);
   if (value && (IsNumericConvertibleTo<T>(*value) || IsType<T>(*value))) {
     return GetTimestamped<T, true>(*value, buf);
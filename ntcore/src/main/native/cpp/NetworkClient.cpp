@@ -8,6 +8,8 @@
 
 #include <atomic>
 #include <memory>
+#include <span>
+#include <string_view>
 #include <vector>
 
 #include <fmt/format.h>
@@ -191,6 +193,7 @@ NetworkClient3::~NetworkClient3() {
 }
 
 void NetworkClient3::HandleLocal() {
+  m_localStorage.DrainFastPublishers();
   m_localQueue.ReadQueue(&m_localMsgs);
   if (m_clientImpl) {
     m_clientImpl->HandleLocal(m_localMsgs);
@@ -348,7 +351,18 @@ NetworkClient::~NetworkClient() {
   m_loopRunner.Stop();
 }
 
+void NetworkClient::SetCompression(bool enabled) {
+  m_loopRunner.ExecAsync(
+      [this, enabled](uv::Loop&) { m_compression = enabled; });
+}
+
+void NetworkClient::SetDeltaArrays(bool enabled) {
+  m_loopRunner.ExecAsync(
+      [this, enabled](uv::Loop&) { m_deltaArrays = enabled; });
+}
+
 void NetworkClient::HandleLocal() {
+  m_localStorage.DrainFastPublishers();
   m_localQueue.ReadQueue(&m_localMsgs);
   if (m_clientImpl) {
     m_clientImpl->HandleLocal(std::move(m_localMsgs));
@@ -366,10 +380,15 @@ void NetworkClient::TcpConnected(uv::Tcp& tcp) {
   }
   wpi::WebSocket::ClientOptions options;
   options.handshakeTimeout = kWebsocketHandshakeTimeout;
+  // topic announcements and properties are highly repetitive JSON
+  options.deflate = m_compression;
+  static constexpr std::string_view kProtocols[] = {
+      "v4.1-delta.networktables.first.wpi.edu",
+      "v4.1.networktables.first.wpi.edu", "networktables.first.wpi.edu"};
   wpi::SmallString<128> idBuf;
   auto ws = wpi::WebSocket::CreateClient(
       tcp, fmt::format("/nt/{}", wpi::EscapeURI(m_id, idBuf)), "",
-      {"v4.1.networktables.first.wpi.edu", "networktables.first.wpi.edu"},
+      m_deltaArrays ? std::span{kProtocols} : std::span{kProtocols}.subspan(1),
       options);
   ws->SetMaxMessageSize(kMaxMessageSize);
   ws->open.connect([this, &tcp, ws = ws.get()](std::string_view protocol) {
@@ -389,14 +408,16 @@ void NetworkClient::WsConnected(wpi::WebSocket& ws, uv::Tcp& tcp,
 
   ConnectionInfo connInfo;
   uv::AddrToName(tcp.GetPeer(), &connInfo.remote_ip, &connInfo.remote_port);
+  bool deltaArrays = protocol == "v4.1-delta.networktables.first.wpi.edu";
   connInfo.protocol_version =
-      protocol == "v4.1.networktables.first.wpi.edu" ? 0x0401 : 0x0400;
+      deltaArrays || protocol == "v4.1.networktables.first.wpi.edu" ? 0x0401
+                                                                    : 0x0400;
 
   INFO("CONNECTED NT4 to {} port {}", connInfo.remote_ip, connInfo.remote_port);
   m_connHandle = m_connList.AddConnection(connInfo);
 
-  m_wire =
-      std::make_shared<net::WebSocketConnection>(ws, connInfo.protocol_version);
+  m_wire = std::make_shared<net::WebSocketConnection>(
+      ws, connInfo.protocol_version, deltaArrays);
   m_clientImpl = std::make_unique<net::ClientImpl>(
       m_loop.Now().count(), m_inst, *m_wire, m_logger, m_timeSyncUpdated,
       [this](uint32_t repeatMs) {
@@ -135,6 +135,9 @@ class NetworkClient final : public NetworkClientBase {
     DoSetServers(servers, NT_DEFAULT_PORT4);
   }
 
+  void SetCompression(bool enabled);
+  void SetDeltaArrays(bool enabled);
+
  private:
   void HandleLocal();
   void TcpConnected(wpi::uv::Tcp& tcp) final;
@@ -147,6 +150,8 @@ class NetworkClient final : public NetworkClientBase {
       m_timeSyncUpdated;
   std::shared_ptr<net::WebSocketConnection> m_wire;
   std::unique_ptr<net::ClientImpl> m_clientImpl;
+  bool m_compression = false;  // offer permessage-deflate to the server
+  bool m_deltaArrays = false;  // offer the v4.1-delta subprotocol
 };
 
 }  // namespace nt
@@ -28,6 +28,7 @@
 #include "IConnectionList.h"
 #include "InstanceImpl.h"
 #include "Log.h"
+#include "net/PersistentJournal.h"
 #include "net/WebSocketConnection.h"
 #include "net/WireDecoder.h"
 #include "net/WireEncoder.h"
@@ -85,15 +86,21 @@ class NetworkServer::ServerConnection4 final
                     std::string_view addr, unsigned int port,
                     wpi::Logger& logger)
       : ServerConnection{server, addr, port, logger},
-        HttpWebSocketServerConnection(
-            stream,
-            {"v4.1.networktables.first.wpi.edu", "networktables.first.wpi.edu",
-             "rtt.networktables.first.wpi.edu"}) {
+        HttpWebSocketServerConnection(stream,
+                                      server.m_deltaArrays
+                                          ? std::span{kProtocols}
+                                          : std::span{kProtocols}.subspan(1)) {
     m_info.protocol_version = 0x0400;
   }
 
  private:
+  static constexpr std::string_view kProtocols[] = {
+      "v4.1-delta.networktables.first.wpi.edu",
+      "v4.1.networktables.first.wpi.edu", "networktables.first.wpi.edu",
+      "rtt.networktables.first.wpi.edu"};
+
   void ProcessRequest() final;
+  bool AcceptDeflate() final { return m_server.m_compression; }
   void ProcessWsUpgrade() final;
 
   std::shared_ptr<net::WebSocketConnection> m_wire;
@@ -238,10 +245,12 @@ void NetworkServer::ServerConnection4::ProcessWsUpgrade() {
 
   m_websocket->open.connect([this, name = std::string{name}](
                                 std::string_view protocol) {
+    bool deltaArrays = protocol == "v4.1-delta.networktables.first.wpi.edu";
     m_info.protocol_version =
-        protocol == "v4.1.networktables.first.wpi.edu" ? 0x0401 : 0x0400;
+        deltaArrays || protocol == "v4.1.networktables.first.wpi.edu" ? 0x0401
+                                                                      : 0x0400;
     m_wire = std::make_shared<net::WebSocketConnection>(
-        *m_websocket, m_info.protocol_version);
+        *m_websocket, m_info.protocol_version, deltaArrays);
 
     if (protocol == "rtt.networktables.first.wpi.edu") {
       INFO("CONNECTED RTT client (from {})", m_connInfo);
@@ -311,6 +320,7 @@ NetworkServer::NetworkServer(std::string_view persistentFilename,
       m_listenAddress{wpi::trim(listenAddress)},
       m_port3{port3},
       m_port4{port4},
+      m_persistentJournal{wpi::ends_with(m_persistentFilename, ".journal")},
       m_serverImpl{logger},
       m_localQueue{logger},
       m_loop(*m_loopRunner.GetLoop()) {
@@ -345,7 +355,24 @@ void NetworkServer::Flush() {
   }
 }
 
+void NetworkServer::SetBandwidthLimit(unsigned int bytesPerSec) {
+  m_loopRunner.ExecAsync([this, bytesPerSec](uv::Loop&) {
+    m_serverImpl.SetBandwidthLimit(bytesPerSec);
+  });
+}
+
+void NetworkServer::SetCompression(bool enabled) {
+  m_loopRunner.ExecAsync(
+      [this, enabled](uv::Loop&) { m_compression = enabled; });
+}
+
+void NetworkServer::SetDeltaArrays(bool enabled) {
+  m_loopRunner.ExecAsync(
+      [this, enabled](uv::Loop&) { m_deltaArrays = enabled; });
+}
+
 void NetworkServer::HandleLocal() {
+  m_localStorage.DrainFastPublishers();
   m_localQueue.ReadQueue(&m_localMsgs);
   m_serverImpl.HandleLocal(m_localMsgs);
 }
@@ -360,23 +387,32 @@ void NetworkServer::LoadPersistent() {
         "(this can be ignored if you aren't expecting persistent values)",
         m_persistentFilename, ec.message());
     // try to write an empty file so it doesn't happen again
-    wpi::raw_fd_ostream os{m_persistentFilename, ec, fs::F_Text};
-    if (ec.value() == 0) {
-      os << "[]\n";
-      os.close();
+    if (m_persistentJournal) {
+      wpi::raw_fd_ostream os{m_persistentFilename, ec, fs::F_None};
+      if (ec.value() == 0) {
+        net::WritePersistentJournalHeader(os);
+        os.close();
+      }
+    } else {
+      wpi::raw_fd_ostream os{m_persistentFilename, ec, fs::F_Text};
+      if (ec.value() == 0) {
+        os << "[]\n";
+        os.close();
+      }
     }
     return;
   }
   m_persistentData = std::string{fileBuffer->begin(), fileBuffer->end()};
-  DEBUG4("read data: {}", m_persistentData);
+  DEBUG4("read {} bytes of persistent data", m_persistentData.size());
 }
 
 void NetworkServer::SavePersistent(std::string_view filename,
-                                   std::string_view data) {
+                                   std::string_view data,
+                                   fs::OpenFlags flags) {
   // write to temporary file
   auto tmp = fmt::format("{}.tmp", filename);
   std::error_code ec;
-  wpi::raw_fd_ostream os{tmp, ec, fs::F_Text};
+  wpi::raw_fd_ostream os{tmp, ec, flags};
   if (ec.value() != 0) {
     INFO("could not open persistent file '{}' for write: {}", tmp,
          ec.message());
@@ -400,11 +436,71 @@ void NetworkServer::SavePersistent(std::string_view filename,
   }
 }
 
+void NetworkServer::AppendPersistent(std::string_view filename,
+                                     std::string_view data) {
+  std::error_code ec;
+  wpi::raw_fd_ostream os{filename, ec, fs::F_Append};
+  if (ec.value() != 0) {
+    INFO("could not open persistent file '{}' for append: {}", filename,
+         ec.message());
+    return;
+  }
+  os << data;
+}
+
+void NetworkServer::SaveJournal() {
+  if (m_journalSaving) {
+    return;  // changes will be picked up on the next call
+  }
+  bool changed = m_serverImpl.PersistentChanged();
+  if (!changed && !m_journalCompact) {
+    return;
+  }
+  if (m_journalSize > kJournalCompactMinSize &&
+      m_journalSize > 2 * m_journalCompactSize) {
+    m_journalCompact = true;
+  }
+  bool compact = m_journalCompact;
+  auto data = m_serverImpl.DumpPersistentJournal(compact);
+  if (data.empty()) {
+    return;
+  }
+  if (compact) {
+    m_journalSize = data.size();
+    m_journalCompactSize = data.size();
+    m_journalCompact = false;
+  } else {
+    m_journalSize += data.size();
+  }
+  m_journalSaving = true;
+  uv::QueueWork(
+      m_loop,
+      [this, fn = m_persistentFilename, data = std::move(data), compact] {
+        if (compact) {
+          SavePersistent(fn, data, fs::F_None);
+        } else {
+          AppendPersistent(fn, data);
+        }
+      },
+      [this] { m_journalSaving = false; });
+}
+
 void NetworkServer::Init() {
   if (m_shutdown) {
     return;
   }
-  auto errs = m_serverImpl.LoadPersistent(m_persistentData);
+  std::string errs;
+  if (m_persistentJournal) {
+    errs = m_serverImpl.LoadPersistentJournal(
+        {reinterpret_cast<const uint8_t*>(m_persistentData.data()),
+         m_persistentData.size()});
+    m_journalSize = m_persistentData.size();
+    m_journalCompactSize = m_journalSize;
+    // can't append to a damaged or missing journal
+    m_journalCompact = !errs.empty() || m_persistentData.empty();
+  } else {
+    errs = m_serverImpl.LoadPersistent(m_persistentData);
+  }
   if (!errs.empty()) {
     WARN("error reading persistent file: {}", errs);
   }
@@ -422,7 +518,9 @@ void NetworkServer::Init() {
   m_savePersistentTimer = uv::Timer::Create(m_loop);
   if (m_savePersistentTimer) {
     m_savePersistentTimer->timeout.connect([this] {
-      if (m_serverImpl.PersistentChanged()) {
+      if (m_persistentJournal) {
+        SaveJournal();
+      } else if (m_serverImpl.PersistentChanged()) {
         uv::QueueWork(
             m_loop,
             [this, fn = m_persistentFilename,
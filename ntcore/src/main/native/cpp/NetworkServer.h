@@ -11,6 +11,7 @@
 #include <string_view>
 #include <vector>
 
+#include <wpi/fs.h>
 #include <wpinet/EventLoopRunner.h>
 #include <wpinet/uv/Async.h>
 #include <wpinet/uv/Timer.h>
@@ -43,6 +44,9 @@ class NetworkServer {
 
   void FlushLocal();
   void Flush();
+  void SetBandwidthLimit(unsigned int bytesPerSec);
+  void SetCompression(bool enabled);
+  void SetDeltaArrays(bool enabled);
 
  private:
   class ServerConnection;
@@ -51,7 +55,10 @@ class NetworkServer {
 
   void HandleLocal();
   void LoadPersistent();
-  void SavePersistent(std::string_view filename, std::string_view data);
+  void SavePersistent(std::string_view filename, std::string_view data,
+                      fs::OpenFlags flags = fs::F_Text);
+  void AppendPersistent(std::string_view filename, std::string_view data);
+  void SaveJournal();
   void Init();
   void AddConnection(ServerConnection* conn, const ConnectionInfo& info);
   void RemoveConnection(ServerConnection* conn);
@@ -65,6 +72,7 @@ class NetworkServer {
   std::string m_listenAddress;
   unsigned int m_port3;
   unsigned int m_port4;
+  bool m_persistentJournal;
 
   // used only from loop
   std::shared_ptr<wpi::uv::Timer> m_readLocalTimer;
@@ -72,6 +80,16 @@ class NetworkServer {
   std::shared_ptr<wpi::uv::Async<>> m_flushLocal;
   std::shared_ptr<wpi::uv::Async<>> m_flush;
   bool m_shutdown = false;
+  bool m_compression = false;  // accept permessage-deflate from clients
+  bool m_deltaArrays = false;  // accept the v4.1-delta subprotocol
+
+  // persistent journal state; the journal is rewritten (compacted) when it
+  // grows to twice its size after the last compaction
+  size_t m_journalSize = 0;
+  size_t m_journalCompactSize = 0;
+  bool m_journalCompact = false;  // next save must rewrite the journal
+  bool m_journalSaving = false;
+  static constexpr size_t kJournalCompactMinSize = 64 * 1024;
 
   std::vector<net::ClientMessage> m_localMsgs;
 
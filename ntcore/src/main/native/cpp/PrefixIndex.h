@@ -0,0 +1,215 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace nt {
+
+// String-keyed map implemented as a radix tree (a trie with single-child
+// chains collapsed into one edge).  In addition to exact lookups, this
+// supports finding all values with keys starting with a prefix, and all
+// values with keys that are a prefix of a name, in time proportional to the
+// key length plus the number of matches rather than the number of keys.
+//
+// The structure must not be modified during the ForEach* functions; the
+// values themselves may be.  Concurrent const calls are safe.
+template <typename T>
+class PrefixIndex {
+ public:
+  // Returns the value for key, inserting a default-constructed value if
+  // not present
+  T& operator[](std::string_view key) {
+    Node* node = &m_root;
+    while (!key.empty()) {
+      auto it = node->LowerBound(key[0]);
+      if (it == node->children.end() || (*it)->label[0] != key[0]) {
+        // no edge starting with this character; add a leaf
+        node = node->children.emplace(it, std::make_unique<Node>(key))->get();
+        break;
+      }
+      Node* child = it->get();
+      size_t common = std::mismatch(child->label.begin(), child->label.end(),
+                                    key.begin(), key.end())
+                          .first -
+                      child->label.begin();
+      if (common < child->label.size()) {
+        // split the edge
+        auto mid = std::make_unique<Node>(
+            std::string_view{child->label}.substr(0, common));
+        child->label.erase(0, common);
+        mid->children.emplace_back(std::move(*it));
+        *it = std::move(mid);
+        child = it->get();
+      }
+      node = child;
+      key.remove_prefix(common);
+    }
+    if (!node->value) {
+      node->value.emplace();
+      ++m_size;
+    }
+    return *node->value;
+  }
+
+  // Returns nullptr if not present
+  T* Find(std::string_view key) {
+    return const_cast<T*>(std::as_const(*this).Find(key));
+  }
+
+  const T* Find(std::string_view key) const {
+    const Node* node = FindNode(key, false);
+    return node && node->value ? &*node->value : nullptr;
+  }
+
+  // Returns true if the key was present
+  bool Erase(std::string_view key) {
+    if (!EraseImpl(m_root, key)) {
+      return false;
+    }
+    --m_size;
+    return true;
+  }
+
+  void clear() {
+    m_root.children.clear();
+    m_root.value.reset();
+    m_size = 0;
+  }
+
+  bool empty() const { return m_size == 0; }
+  size_t size() const { return m_size; }
+
+  // Calls func(T&) for each value whose key starts with prefix, in key order
+  template <typename F>
+  void ForEachWithPrefix(std::string_view prefix, F&& func) {
+    if (Node* node = FindNode(prefix, true)) {
+      ForEachValue(*node, func);
+    }
+  }
+
+  // Calls func(std::string_view key, T&) for each value whose key is a prefix
+  // of (or equal to) name, shortest key first
+  template <typename F>
+  void ForEachPrefixOf(std::string_view name, F&& func) {
+    Node* node = &m_root;
+    size_t depth = 0;
+    for (;;) {
+      if (node->value) {
+        func(name.substr(0, depth), *node->value);
+      }
+      if (depth == name.size()) {
+        break;
+      }
+      auto it = node->LowerBound(name[depth]);
+      if (it == node->children.end() ||
+          !name.substr(depth).starts_with((*it)->label)) {
+        break;
+      }
+      depth += (*it)->label.size();
+      node = it->get();
+    }
+  }
+
+ private:
+  struct Node {
+    Node() = default;
+    explicit Node(std::string_view label) : label{label} {}
+
+    // children are sorted by (and unique in) the first character of label
+    auto LowerBound(char ch) {
+      return std::lower_bound(
+          children.begin(), children.end(), ch,
+          [](const auto& child, char c) { return child->label[0] < c; });
+    }
+    auto LowerBound(char ch) const {
+      return std::lower_bound(
+          children.begin(), children.end(), ch,
+          [](const auto& child, char c) { return child->label[0] < c; });
+    }
+
+    std::string label;  // edge label from the parent (empty only for root)
+    std::vector<std::unique_ptr<Node>> children;
+    std::optional<T> value;
+  };
+
+  // If partial is true, returns the node for the shortest key starting with
+  // key (key may end partway through the edge to that node)
+  Node* FindNode(std::string_view key, bool partial) {
+    return const_cast<Node*>(std::as_const(*this).FindNode(key, partial));
+  }
+
+  const Node* FindNode(std::string_view key, bool partial) const {
+    const Node* node = &m_root;
+    while (!key.empty()) {
+      auto it = node->LowerBound(key[0]);
+      if (it == node->children.end() || (*it)->label[0] != key[0]) {
+        return nullptr;
+      }
+      const Node* child = it->get();
+      if (key.starts_with(child->label)) {
+        key.remove_prefix(child->label.size());
+      } else if (partial && std::string_view{child->label}.starts_with(key)) {
+        key = {};
+      } else {
+        return nullptr;
+      }
+      node = child;
+    }
+    return node;
+  }
+
+  template <typename F>
+  static void ForEachValue(Node& node, F& func) {
+    if (node.value) {
+      func(*node.value);
+    }
+    for (auto&& child : node.children) {
+      ForEachValue(*child, func);
+    }
+  }
+
+  static bool EraseImpl(Node& node, std::string_view key) {
+    if (key.empty()) {
+      if (!node.value) {
+        return false;
+      }
+      node.value.reset();
+      return true;
+    }
+    auto it = node.LowerBound(key[0]);
+    if (it == node.children.end() || !key.starts_with((*it)->label)) {
+      return false;
+    }
+    Node& child = **it;
+    if (!EraseImpl(child, key.substr(child.label.size()))) {
+      return false;
+    }
+    // remove or collapse the child if it no longer needs its own node
+    if (!child.value) {
+      if (child.children.empty()) {
+        node.children.erase(it);
+      } else if (child.children.size() == 1) {
+        auto grandchild = std::move(child.children[0]);
+        grandchild->label.insert(0, child.label);
+        *it = std::move(grandchild);
+      }
+    }
+    return true;
+  }
+
+  Node m_root;
+  size_t m_size = 0;
+};
+
+}  // namespace nt
@@ -139,6 +139,7 @@ static nt::PubSubOptions FromJavaPubSubOptions(JNIEnv* env, jobject joptions) {
   FIELD(disableRemote, "Z");
   FIELD(disableLocal, "Z");
   FIELD(excludeSelf, "Z");
+  FIELD(fastPublish, "Z");
 
 #undef FIELD
 
@@ -154,7 +155,8 @@ static nt::PubSubOptions FromJavaPubSubOptions(JNIEnv* env, jobject joptions) {
           FIELD(bool, Boolean, prefixMatch),
           FIELD(bool, Boolean, disableRemote),
           FIELD(bool, Boolean, disableLocal),
-          FIELD(bool, Boolean, excludeSelf)};
+          FIELD(bool, Boolean, excludeSelf),
+          FIELD(bool, Boolean, fastPublish)};
 
 #undef GET
 #undef FIELD
@@ -1175,6 +1177,42 @@ Java_edu_wpi_first_networktables_NetworkTablesJNI_stopServer
   nt::StopServer(inst);
 }
 
+/*
+ * Class:     edu_wpi_first_networktables_NetworkTablesJNI
+ * Method:    setServerBandwidthLimit
+ * Signature: (II)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_networktables_NetworkTablesJNI_setServerBandwidthLimit
+  (JNIEnv*, jclass, jint inst, jint bytesPerSec)
+{
+  nt::SetServerBandwidthLimit(inst, bytesPerSec < 0 ? 0 : bytesPerSec);
+}
+
+/*
+ * Class:     edu_wpi_first_networktables_NetworkTablesJNI
+ * Method:    setNetworkCompression
+ * Signature: (IZ)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_networktables_NetworkTablesJNI_setNetworkCompression
+  (JNIEnv*, jclass, jint inst, jboolean enabled)
+{
+  nt::SetNetworkCompression(inst, enabled);
+}
+
+/*
+ * Class:     edu_wpi_first_networktables_NetworkTablesJNI
+ * Method:    setNetworkDeltaArrays
+ * Signature: (IZ)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_networktables_NetworkTablesJNI_setNetworkDeltaArrays
+  (JNIEnv*, jclass, jint inst, jboolean enabled)
+{
+  nt::SetNetworkDeltaArrays(inst, enabled);
+}
+
 /*
  * Class:     edu_wpi_first_networktables_NetworkTablesJNI
  * Method:    startClient3
@@ -61,7 +61,8 @@ void ClientImpl::ProcessIncomingBinary(uint64_t curTimeMs,
     Value value;
     std::string error;
     if (!WireDecodeBinary(&data, &id, &value, &error,
-                          -m_outgoing.GetTimeOffset())) {
+                          -m_outgoing.GetTimeOffset(),
+                          m_wire.HasDeltaArrays() ? &m_deltaState : nullptr)) {
       ERR("binary decode error: {}", error);
       break;  // FIXME
     }
@@ -109,6 +109,9 @@ class ClientImpl final : private ServerMessageHandler {
 
   // outgoing queue
   NetworkOutgoingQueue<ClientMessage> m_outgoing;
+
+  // incoming delta array references
+  WireDeltaState m_deltaState;
 };
 
 }  // namespace nt::net
@@ -17,6 +17,16 @@
 
 namespace nt::net {
 
+// binary message type flag marking a delta array (only used on connections
+// that negotiated delta arrays); the remaining bits are the array type
+inline constexpr uint8_t kDeltaArrayTypeFlag = 0x20;
+
+// true for value types that can be sent as delta arrays
+constexpr bool IsDeltaArrayType(NT_Type type) {
+  return type == NT_BOOLEAN_ARRAY || type == NT_DOUBLE_ARRAY ||
+         type == NT_INTEGER_ARRAY || type == NT_FLOAT_ARRAY;
+}
+
 #if __GNUC__ >= 13
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
@@ -55,6 +55,10 @@ class ILocalStorage : public LocalInterface {
  public:
   virtual void StartNetwork(NetworkInterface* network) = 0;
   virtual void ClearNetwork() = 0;
+
+  // Publishes values queued by fastPublish publishers. Called by the network
+  // thread before reading the local message queue.
+  virtual void DrainFastPublishers() = 0;
 };
 
 }  // namespace nt::net
@@ -63,6 +63,11 @@ concept NetworkMessage =
 
 enum class ValueSendMode { kDisabled = 0, kAll, kNormal, kImm };
 
+// share of the bandwidth budget a queue gets relative to other ready queues
+inline unsigned int PriorityWeight(int priority) {
+  return 1 + std::clamp(priority, 0, 15);
+}
+
 template <NetworkMessage MessageType>
 class NetworkOutgoingQueue {
  public:
@@ -71,9 +76,34 @@ class NetworkOutgoingQueue {
     m_queues.emplace_back(100);  // default queue is 100 ms period
   }
 
-  void SetPeriod(NT_Handle handle, uint32_t periodMs);
+  // Higher priority handles are sent first and get a larger share of the
+  // bandwidth budget (see SetBandwidthLimit); lower priorities still get a
+  // proportional share so they are not starved.
+  void SetPeriod(NT_Handle handle, uint32_t periodMs, int priority = 0);
+
+  // Limits the average transmit rate; 0 means unlimited
+  void SetBandwidthLimit(uint32_t bytesPerSec) {
+    m_bandwidthLimit = bytesPerSec;
+    m_budget = static_cast<int64_t>(bytesPerSec) * kMaxBurstMs / 1000;
+  }
+  uint32_t GetBandwidthLimit() const { return m_bandwidthLimit; }
+
+  struct Stats {
+    uint64_t bytesSent = 0;  // approximate total bytes sent
+    uint64_t msgsSent = 0;   // total messages sent
+    uint64_t deferred = 0;   // times a queue was cut short by the budget
+    size_t queuedBytes = 0;  // approximate bytes waiting to be sent
+  };
+  Stats GetStats() const {
+    Stats stats = m_stats;
+    stats.queuedBytes = m_totalSize;
+    return stats;
+  }
 
-  void EraseHandle(NT_Handle handle) { m_handleMap.erase(handle); }
+  void EraseHandle(NT_Handle handle) {
+    m_handleMap.erase(handle);
+    m_lastSent.erase(Handle{handle}.GetIndex());
+  }
 
   template <typename T>
   void SendMessage(NT_Handle handle, T&& msg) {
@@ -108,7 +138,8 @@ class NetworkOutgoingQueue {
   };
 
   struct Queue {
-    explicit Queue(uint32_t periodMs) : periodMs{periodMs} {}
+    explicit Queue(uint32_t periodMs, int priority = 0)
+        : periodMs{periodMs}, priority{priority} {}
     template <typename T>
     void Append(NT_Handle handle, T&& msg) {
       msgs.emplace_back(std::forward<T>(msg), handle);
@@ -116,6 +147,7 @@ class NetworkOutgoingQueue {
     std::vector<Message> msgs;
     uint64_t nextSendMs = 0;
     uint32_t periodMs;
+    int priority;
   };
 
   std::vector<Queue> m_queues;
@@ -125,37 +157,60 @@ class NetworkOutgoingQueue {
     int valuePos = -1;  // -1 if not in queue
   };
   wpi::DenseMap<NT_Handle, HandleInfo> m_handleMap;
+
+  // delta arrays: last array value sent for each id, and the previous
+  // entries for messages written in the current batch (to roll back the ones
+  // that end up not being sent)
+  struct DeltaUndo {
+    int64_t id;
+    std::optional<Value> prev;
+  };
+  wpi::DenseMap<int64_t, Value> m_lastSent;
+  std::vector<DeltaUndo> m_deltaUndo;
+
   size_t m_totalSize{0};
   uint64_t m_lastSendMs{0};
   int64_t m_timeOffsetUs{0};
   unsigned int m_lastSetPeriodQueueIndex = 0;
   unsigned int m_lastSetPeriod = 100;
+  int m_lastSetPriority = 0;
   bool m_local;
 
+  // bandwidth budget (token bucket, may go negative by up to one message)
+  uint32_t m_bandwidthLimit{0};
+  int64_t m_budget{0};
+  uint64_t m_budgetUpdateMs{0};
+  Stats m_stats;
+
   // maximum total size of outgoing queues in bytes (approximate)
   static constexpr size_t kOutgoingLimit = 1024 * 1024;
+
+  // maximum burst allowed by the bandwidth budget, in milliseconds of budget
+  static constexpr uint32_t kMaxBurstMs = 100;
 };
 
 template <NetworkMessage MessageType>
 void NetworkOutgoingQueue<MessageType>::SetPeriod(NT_Handle handle,
-                                                  uint32_t periodMs) {
+                                                  uint32_t periodMs,
+                                                  int priority) {
   // it's quite common to set a lot of things in a row with the same period
   unsigned int queueIndex;
-  if (m_lastSetPeriod == periodMs) {
+  if (m_lastSetPeriod == periodMs && m_lastSetPriority == priority) {
     queueIndex = m_lastSetPeriodQueueIndex;
   } else {
-    // find and possibly create queue for this period
-    auto it =
-        std::find_if(m_queues.begin(), m_queues.end(),
-                     [&](const auto& q) { return q.periodMs == periodMs; });
+    // find and possibly create queue for this period and priority
+    auto it = std::find_if(m_queues.begin(), m_queues.end(), [&](const auto& q) {
+      return q.periodMs == periodMs && q.priority == priority;
+    });
     if (it == m_queues.end()) {
       queueIndex = m_queues.size();
-      m_queues.emplace_back(periodMs);
+      m_queues.emplace_back(periodMs, priority);
     } else {
       queueIndex = it - m_queues.begin();
     }
     m_lastSetPeriodQueueIndex = queueIndex;
     m_lastSetPeriod = periodMs;
+    m_lastSetPriority = priority;
   }
 
   // map the handle to the queue
@@ -192,6 +247,7 @@ void NetworkOutgoingQueue<MessageType>::SendValue(NT_Handle handle,
       break;
     case ValueSendMode::kImm:  // send immediately
       m_wire.SendBinary([&](auto& os) { EncodeValue(os, handle, value); });
+      m_deltaUndo.clear();  // always sent
       break;
     case ValueSendMode::kAll: {  // append to outgoing
       auto& info = m_handleMap[handle];
@@ -243,6 +299,23 @@ void NetworkOutgoingQueue<MessageType>::SendOutgoing(uint64_t curTimeMs,
     return;  // don't bother, still sending the last batch
   }
 
+  // refill bandwidth budget
+  if (m_bandwidthLimit != 0) {
+    int64_t maxBudget =
+        static_cast<int64_t>(m_bandwidthLimit) * kMaxBurstMs / 1000;
+    if (curTimeMs > m_budgetUpdateMs) {
+      m_budget += static_cast<int64_t>(curTimeMs - m_budgetUpdateMs) *
+                  m_bandwidthLimit / 1000;
+      if (m_budget > maxBudget) {
+        m_budget = maxBudget;
+      }
+    }
+    m_budgetUpdateMs = curTimeMs;
+    if (m_budget <= 0) {
+      return;  // over budget
+    }
+  }
+
   // what queues are ready to send?
   wpi::SmallVector<unsigned int, 16> queues;
   for (unsigned int i = 0; i < m_queues.size(); ++i) {
@@ -255,36 +328,85 @@ void NetworkOutgoingQueue<MessageType>::SendOutgoing(uint64_t curTimeMs,
     return;  // nothing needs to be sent yet
   }
 
-  // Sort transmission order by what queue has been waiting the longest time.
-  // XXX: byte-weighted fair queueing might be better, but is much more complex
-  // to implement.
+  // Sort transmission order by priority, then by what queue has been waiting
+  // the longest time.
   std::sort(queues.begin(), queues.end(), [&](const auto& a, const auto& b) {
+    if (m_queues[a].priority != m_queues[b].priority) {
+      return m_queues[a].priority > m_queues[b].priority;
+    }
     return m_queues[a].nextSendMs < m_queues[b].nextSendMs;
   });
 
+  // with a bandwidth limit, each ready queue gets a weighted share of the
+  // remaining budget; budget a queue doesn't use is available to later queues
+  unsigned int totalWeight = 0;
+  for (unsigned int queueIndex : queues) {
+    totalWeight += PriorityWeight(m_queues[queueIndex].priority);
+  }
+
   for (unsigned int queueIndex : queues) {
     auto& queue = m_queues[queueIndex];
     auto& msgs = queue.msgs;
     auto it = msgs.begin();
     auto end = msgs.end();
     int unsent = 0;
-    for (; it != end && unsent == 0; ++it) {
+    int64_t share = INT64_MAX;
+    if (m_bandwidthLimit != 0) {
+      unsigned int weight = PriorityWeight(queue.priority);
+      share = m_budget <= 0 ? 0 : m_budget * weight / totalWeight;
+      totalWeight -= weight;
+    }
+    int64_t spent = 0;
+    m_deltaUndo.clear();
+    // always try to send at least one message so large messages progress
+    for (; it != end && unsent == 0 && (spent == 0 || spent < share); ++it) {
       if (auto m = std::get_if<ValueMsg>(&it->msg.contents)) {
-        unsent = m_wire.WriteBinary(
-            [&](auto& os) { EncodeValue(os, it->handle, m->value); });
+        unsent = m_wire.WriteBinary([&](auto& os) {
+          auto start = os.tell();
+          EncodeValue(os, it->handle, m->value);
+          spent += os.tell() - start;
+        });
       } else {
         unsent = m_wire.WriteText([&](auto& os) {
+          auto start = os.tell();
           if (!WireEncodeText(os, it->msg)) {
             os << "{}";
           }
+          spent += os.tell() - start;
         });
+        if (m_wire.HasDeltaArrays()) {
+          m_deltaUndo.push_back({-1, std::nullopt});
+        }
       }
     }
     if (unsent == 0) {
       // finish writing any partial buffers
       unsent = m_wire.Flush();
     }
+    // the remote end never saw unsent values, so they can't be delta bases
+    for (int i = 0; i < unsent && !m_deltaUndo.empty(); ++i) {
+      auto& u = m_deltaUndo.back();
+      if (u.id >= 0) {
+        if (u.prev) {
+          m_lastSent[u.id] = std::move(*u.prev);
+        } else {
+          m_lastSent.erase(u.id);
+        }
+      }
+      m_deltaUndo.pop_back();
+    }
+    bool throttled = unsent == 0 && it != end;
+    if (throttled) {
+      ++m_stats.deferred;
+    }
+    if (m_bandwidthLimit != 0) {
+      m_budget -= spent;
+    }
     int delta = it - msgs.begin() - unsent;
+    if (delta > 0) {
+      m_stats.bytesSent += spent;
+      m_stats.msgsSent += delta;
+    }
     for (auto&& msg : std::span{msgs}.subspan(0, delta)) {
       if (auto m = std::get_if<ValueMsg>(&msg.msg.contents)) {
         m_totalSize -= sizeof(Message) + m->value.size();
@@ -304,8 +426,9 @@ void NetworkOutgoingQueue<MessageType>::SendOutgoing(uint64_t curTimeMs,
       }
     }
 
-    // try to stay on periodic timing, unless it's falling behind current time
-    if (unsent == 0) {
+    // try to stay on periodic timing, unless it's falling behind current time;
+    // a throttled queue stays ready so it continues as budget becomes available
+    if (unsent == 0 && !throttled) {
       queue.nextSendMs += queue.periodMs;
       if (queue.nextSendMs < curTimeMs) {
         queue.nextSendMs = curTimeMs + queue.periodMs;
@@ -330,7 +453,29 @@ void NetworkOutgoingQueue<MessageType>::EncodeValue(wpi::raw_ostream& os,
       }
     }
   }
-  WireEncodeBinary(os, Handle{handle}.GetIndex(), time, value);
+  int64_t id = Handle{handle}.GetIndex();
+  if (m_wire.HasDeltaArrays()) {
+    bool isArray = IsDeltaArrayType(value.type());
+    auto it = m_lastSent.find(id);
+    if (it != m_lastSent.end()) {
+      m_deltaUndo.push_back({id, it->second});
+      if (!isArray ||
+          !WireEncodeBinaryDelta(os, id, time, value, it->second)) {
+        WireEncodeBinary(os, id, time, value);
+      }
+      if (isArray) {
+        it->second = value;
+      } else {
+        m_lastSent.erase(it);
+      }
+      return;
+    }
+    m_deltaUndo.push_back({id, std::nullopt});
+    if (isArray) {
+      m_lastSent.try_emplace(id, value);
+    }
+  }
+  WireEncodeBinary(os, id, time, value);
 }
 
 }  // namespace nt::net
@@ -0,0 +1,139 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "PersistentJournal.h"
+
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+#include <wpi/MessagePack.h>
+#include <wpi/SmallVector.h>
+#include <wpi/json.h>
+#include <wpi/raw_ostream.h>
+
+#include "WireDecoder.h"
+#include "WireEncoder.h"
+
+using namespace nt;
+using namespace nt::net;
+using namespace mpack;
+
+namespace {
+struct Writer : public mpack_writer_t {
+  explicit Writer(wpi::raw_ostream& os) {
+    mpack_writer_init(this, buf, sizeof(buf));
+    mpack_writer_set_context(this, &os);
+    mpack_writer_set_flush(
+        this, [](mpack_writer_t* w, const char* buffer, size_t count) {
+          static_cast<wpi::raw_ostream*>(w->context)->write(buffer, count);
+        });
+  }
+
+  char buf[128];
+};
+}  // namespace
+
+static std::string_view ReadStr(mpack_reader_t* reader) {
+  auto length = mpack_expect_str(reader);
+  auto data = mpack_read_bytes_inplace(reader, length);
+  mpack_done_str(reader);
+  if (mpack_reader_error(reader) != mpack_ok) {
+    return {};
+  }
+  return {data, length};
+}
+
+bool nt::net::IsPersistentJournal(std::span<const uint8_t> in) {
+  return in.size() >= kPersistentJournalHeader.size() &&
+         std::string_view{reinterpret_cast<const char*>(in.data()),
+                          kPersistentJournalHeader.size()} ==
+             kPersistentJournalHeader;
+}
+
+void nt::net::WritePersistentJournalHeader(wpi::raw_ostream& os) {
+  os << kPersistentJournalHeader;
+}
+
+void nt::net::WritePersistentJournalRecord(wpi::raw_ostream& os,
+                                           std::string_view name,
+                                           std::string_view typeStr,
+                                           const wpi::json& properties,
+                                           const Value& value) {
+  wpi::SmallVector<uint8_t, 64> valueBuf;
+  wpi::raw_usvector_ostream valueOs{valueBuf};
+  WireEncodeBinary(valueOs, 0, 0, value);
+
+  Writer w{os};
+  mpack_start_array(&w, 4);
+  mpack_write_str(&w, name.data(), name.size());
+  mpack_write_str(&w, typeStr.data(), typeStr.size());
+  mpack_write_str(&w, properties.dump());
+  mpack_write_bin(&w, reinterpret_cast<const char*>(valueBuf.data()),
+                  valueBuf.size());
+  mpack_finish_array(&w);
+  mpack_writer_destroy(&w);
+}
+
+void nt::net::WritePersistentJournalRemove(wpi::raw_ostream& os,
+                                           std::string_view name) {
+  Writer w{os};
+  mpack_start_array(&w, 4);
+  mpack_write_str(&w, name.data(), name.size());
+  mpack_write_str(&w, "");
+  mpack_write_str(&w, "");
+  mpack_write_nil(&w);
+  mpack_finish_array(&w);
+  mpack_writer_destroy(&w);
+}
+
+bool nt::net::ReadPersistentJournal(
+    std::span<const uint8_t> in,
+    wpi::function_ref<void(PersistentJournalRecord&& record)> func,
+    std::string* error) {
+  if (!IsPersistentJournal(in)) {
+    *error = "missing journal header";
+    return false;
+  }
+  in = in.subspan(kPersistentJournalHeader.size());
+
+  mpack_reader_t reader;
+  mpack_reader_init_data(&reader, reinterpret_cast<const char*>(in.data()),
+                         in.size());
+  for (int i = 0; mpack_reader_remaining(&reader, nullptr) > 0; ++i) {
+    PersistentJournalRecord record;
+    mpack_expect_array_match(&reader, 4);
+    record.name = ReadStr(&reader);
+    record.typeStr = ReadStr(&reader);
+    record.properties = ReadStr(&reader);
+    if (mpack_peek_tag(&reader).type == mpack_type_nil) {
+      mpack_expect_nil(&reader);
+    } else {
+      auto length = mpack_expect_bin(&reader);
+      auto data = mpack_read_bytes_inplace(&reader, length);
+      mpack_done_bin(&reader);
+      if (mpack_reader_error(&reader) == mpack_ok) {
+        std::span<const uint8_t> valueData{
+            reinterpret_cast<const uint8_t*>(data), length};
+        int64_t id;
+        std::string valueError;
+        if (!WireDecodeBinary(&valueData, &id, &record.value, &valueError,
+                              0)) {
+          *error = fmt::format("record {}: {}", i, valueError);
+          mpack_reader_destroy(&reader);
+          return false;
+        }
+      }
+    }
+    mpack_done_array(&reader);
+    if (auto err = mpack_reader_error(&reader); err != mpack_ok) {
+      *error = fmt::format("record {}: {}", i, mpack_error_to_string(err));
+      mpack_reader_destroy(&reader);
+      return false;
+    }
+    func(std::move(record));
+  }
+  mpack_reader_destroy(&reader);
+  return true;
+}
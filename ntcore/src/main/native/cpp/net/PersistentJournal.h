@@ -0,0 +1,60 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <wpi/function_ref.h>
+#include <wpi/json_fwd.h>
+
+#include "networktables/NetworkTableValue.h"
+
+namespace wpi {
+class raw_ostream;
+}  // namespace wpi
+
+namespace nt::net {
+
+// Append-only persistent storage format.  The file starts with a header,
+// followed by any number of MessagePack records, each an array of:
+// topic name, type string, properties (JSON text), and value (binary, encoded
+// as a NT4 binary message) or nil if the topic is no longer persistent.
+// Later records for the same name replace earlier ones; a file written in one
+// pass with one record per topic is a compacted journal.
+inline constexpr std::string_view kPersistentJournalHeader = "NTJ1";
+
+// Returns true if the data starts with a persistent journal header
+bool IsPersistentJournal(std::span<const uint8_t> in);
+
+void WritePersistentJournalHeader(wpi::raw_ostream& os);
+
+// value must be valid (use WritePersistentJournalRemove for removal)
+void WritePersistentJournalRecord(wpi::raw_ostream& os, std::string_view name,
+                                  std::string_view typeStr,
+                                  const wpi::json& properties,
+                                  const Value& value);
+void WritePersistentJournalRemove(wpi::raw_ostream& os, std::string_view name);
+
+struct PersistentJournalRecord {
+  std::string_view name;
+  std::string_view typeStr;
+  std::string_view properties;  // JSON text
+  Value value;                  // invalid if removed
+};
+
+// Calls func for each record in order (string views are only valid during the
+// call).  Returns false and sets error if the data is not a journal or a
+// record is corrupt or truncated (e.g. by a crash during an append); records
+// prior to the error are still passed to func.
+bool ReadPersistentJournal(
+    std::span<const uint8_t> in,
+    wpi::function_ref<void(PersistentJournalRecord&& record)> func,
+    std::string* error);
+
+}  // namespace nt::net
@@ -4,6 +4,7 @@
 
 #include "ServerImpl.h"
 
+#include <limits.h>
 #include <stdint.h>
 
 #include <algorithm>
@@ -25,6 +26,7 @@
 #include "Log.h"
 #include "NetworkInterface.h"
 #include "Types_internal.h"
+#include "net/PersistentJournal.h"
 #include "net/WireEncoder.h"
 #include "net3/WireConnection3.h"
 #include "net3/WireEncoder3.h"
@@ -250,16 +252,15 @@ void ServerImpl::ClientData4Base::ClientUnpublish(int64_t pubuid) {
 void ServerImpl::ClientData4Base::ClientSetProperties(std::string_view name,
                                                       const wpi::json& update) {
   DEBUG4("ClientSetProperties({}, {}, {})", m_id, name, update.dump());
-  auto topicIt = m_server.m_nameTopics.find(name);
-  if (topicIt == m_server.m_nameTopics.end() ||
-      !topicIt->second->IsPublished()) {
+  auto topicIt = m_server.m_nameTopics.Find(name);
+  if (!topicIt || !(*topicIt)->IsPublished()) {
     WARN(
         "server ignoring SetProperties({}) from client {} on unpublished topic "
         "'{}'; publish or set a value first",
         update.dump(), m_id, name);
     return;  // nothing to do
   }
-  auto topic = topicIt->second;
+  auto topic = *topicIt;
   if (topic->special) {
     WARN("server ignoring SetProperties({}) from client {} on meta topic '{}'",
          update.dump(), m_id, name);
@@ -299,9 +300,19 @@ void ServerImpl::ClientData4Base::ClientSubscribe(
   // for transmit efficiency, we want to batch announcements and values, so
   // send announcements in first loop and remember what we want to send in
   // second loop.
+  // a new subscription only affects the topics it matches; a replaced one may
+  // also need to be removed from topics it no longer matches
+  wpi::SmallVector<TopicData*, 32> topics;
+  if (replace) {
+    for (auto&& topic : m_server.m_topics) {
+      topics.emplace_back(topic.get());
+    }
+  } else {
+    m_server.GetMatchingTopics(sub.get(), topics);
+  }
   std::vector<TopicData*> dataToSend;
-  dataToSend.reserve(m_server.m_topics.size());
-  for (auto&& topic : m_server.m_topics) {
+  dataToSend.reserve(topics.size());
+  for (auto topic : topics) {
     auto tcdIt = topic->clients.find(this);
     bool removed = tcdIt != topic->clients.end() && replace &&
                    tcdIt->second.subscribers.erase(sub.get());
@@ -323,20 +334,20 @@ void ServerImpl::ClientData4Base::ClientSubscribe(
     }
 
     if (added ^ removed) {
-      UpdatePeriod(tcdIt->second, topic.get());
-      m_server.UpdateMetaTopicSub(topic.get());
+      UpdatePeriod(tcdIt->second, topic);
+      m_server.UpdateMetaTopicSub(topic);
     }
 
     // announce topic to client if not previously announced
     if (added && !removed && !wasSubscribed) {
       DEBUG4("client {}: announce {}", m_id, topic->name);
-      SendAnnounce(topic.get(), std::nullopt);
+      SendAnnounce(topic, std::nullopt);
     }
 
     // send last value
     if (added && !sub->options.topicsOnly && !wasSubscribedValue &&
         topic->lastValue) {
-      dataToSend.emplace_back(topic.get());
+      dataToSend.emplace_back(topic);
     }
   }
 
@@ -487,7 +498,8 @@ void ServerImpl::ClientData4::ProcessIncomingBinary(
     int64_t pubuid;
     Value value;
     std::string error;
-    if (!WireDecodeBinary(&data, &pubuid, &value, &error, 0)) {
+    if (!WireDecodeBinary(&data, &pubuid, &value, &error, 0,
+                          m_wire.HasDeltaArrays() ? &m_deltaState : nullptr)) {
       m_wire.Disconnect(fmt::format("binary decode error: {}", error));
       break;
     }
@@ -557,6 +569,14 @@ void ServerImpl::ClientData4::SendUnannounce(TopicData* topic) {
 void ServerImpl::ClientData4::SendPropertiesUpdate(TopicData* topic,
                                                    const wpi::json& update,
                                                    bool ack) {
+  // priority changes move the topic to a different outgoing queue
+  if (update.contains("priority")) {
+    auto tcdIt = topic->clients.find(this);
+    if (tcdIt != topic->clients.end() && !tcdIt->second.subscribers.empty()) {
+      UpdatePeriod(tcdIt->second, topic);
+    }
+  }
+
   if (!m_announceSent.lookup(topic)) {
     return;
   }
@@ -581,14 +601,46 @@ void ServerImpl::ClientData4::SendOutgoing(uint64_t curTimeMs, bool flush) {
     }
   }
   m_outgoing.SendOutgoing(curTimeMs, flush);
+
+  if (curTimeMs >= m_nextMetaQueueMs) {
+    m_nextMetaQueueMs = curTimeMs + kMetaQueueIntervalMs;
+    UpdateMetaClientQueue();
+  }
 }
 
 void ServerImpl::ClientData4::UpdatePeriod(TopicData::TopicClientData& tcd,
                                            TopicData* topic) {
   uint32_t period =
       CalculatePeriod(tcd.subscribers, [](auto& x) { return x->periodMs; });
-  DEBUG4("updating {} period to {} ms", topic->name, period);
-  m_outgoing.SetPeriod(topic->GetIdHandle(), period);
+  DEBUG4("updating {} period to {} ms priority {}", topic->name, period,
+         topic->priority);
+  m_outgoing.SetPeriod(topic->GetIdHandle(), period, topic->priority);
+}
+
+void ServerImpl::ClientData4::UpdateMetaClientQueue() {
+  if (!m_metaQueue) {
+    return;
+  }
+  auto stats = m_outgoing.GetStats();
+  Writer w;
+  mpack_start_map(&w, 5);
+  mpack_write_str(&w, "limit");
+  mpack_write_u32(&w, m_outgoing.GetBandwidthLimit());
+  mpack_write_str(&w, "sent");
+  mpack_write_u64(&w, stats.bytesSent);
+  mpack_write_str(&w, "msgs");
+  mpack_write_u64(&w, stats.msgsSent);
+  mpack_write_str(&w, "deferred");
+  mpack_write_u64(&w, stats.deferred);
+  mpack_write_str(&w, "queued");
+  mpack_write_u64(&w, stats.queuedBytes);
+  mpack_finish_map(&w);
+  // an idle client's stats don't change; don't republish them every interval
+  if (mpack_writer_destroy(&w) == mpack_ok && w.bytes != m_lastMetaQueue) {
+    m_lastMetaQueue = w.bytes;
+    m_server.SetValue(nullptr, m_metaQueue,
+                      Value::MakeRaw(std::move(w.bytes)));
+  }
 }
 
 bool ServerImpl::ClientData3::TopicData3::UpdateFlags(TopicData* topic) {
@@ -1086,6 +1138,7 @@ bool ServerImpl::TopicData::SetProperties(const wpi::json& update) {
 void ServerImpl::TopicData::RefreshProperties() {
   persistent = false;
   retained = false;
+  priority = 0;
 
   auto persistentIt = properties.find("persistent");
   if (persistentIt != properties.end()) {
@@ -1100,6 +1153,16 @@ void ServerImpl::TopicData::RefreshProperties() {
       retained = *val;
     }
   }
+
+  auto priorityIt = properties.find("priority");
+  if (priorityIt != properties.end() && priorityIt->is_number()) {
+    // the property can be any number; clamp so converting it can't overflow
+    double val = priorityIt->get<double>();
+    priority = std::isnan(val) ? 0
+                               : static_cast<int>(std::clamp(
+                                     val, static_cast<double>(INT_MIN),
+                                     static_cast<double>(INT_MAX)));
+  }
 }
 
 bool ServerImpl::TopicData::SetFlags(unsigned int flags_) {
@@ -1165,6 +1228,10 @@ std::pair<std::string, int> ServerImpl::AddClient(
       CreateMetaTopic(fmt::format("$clientpub${}", dedupName));
   clientData->m_metaSub =
       CreateMetaTopic(fmt::format("$clientsub${}", dedupName));
+  clientData->m_metaQueue =
+      CreateMetaTopic(fmt::format("$clientqueue${}", dedupName));
+
+  clientData->SetBandwidthLimit(m_bandwidthLimit);
 
   // update meta topics
   clientData->UpdateMetaClientPub();
@@ -1233,6 +1300,7 @@ void ServerImpl::RemoveClient(int clientId) {
   }
   DeleteTopic(client->m_metaPub);
   DeleteTopic(client->m_metaSub);
+  DeleteTopic(client->m_metaQueue);
 
   // delete the client
   client.reset();
@@ -1244,6 +1312,13 @@ bool ServerImpl::PersistentChanged() {
   return rv;
 }
 
+void ServerImpl::PersistentChanged(TopicData* topic) {
+  m_persistentChanged = true;
+  if (m_persistentJournal) {
+    m_persistentJournalChanged.try_emplace(topic->name, true);
+  }
+}
+
 static void DumpValue(wpi::raw_ostream& os, const Value& value,
                       wpi::json::serializer& s) {
   switch (value.type()) {
@@ -1617,6 +1692,25 @@ std::string ServerImpl::LoadPersistent(std::string_view in) {
   return allerrors;
 }
 
+void ServerImpl::GetMatchingTopics(SubscriberData* sub,
+                                   wpi::SmallVectorImpl<TopicData*>& topics) {
+  for (auto&& topicName : sub->topicNames) {
+    if (sub->options.prefixMatch) {
+      m_nameTopics.ForEachWithPrefix(topicName, [&](TopicData* topic) {
+        if (!topic->special || !topicName.empty()) {
+          topics.emplace_back(topic);
+        }
+      });
+    } else if (auto topic = m_nameTopics.Find(topicName)) {
+      topics.emplace_back(*topic);
+    }
+  }
+  // keep topic creation order and remove duplicates
+  std::sort(topics.begin(), topics.end(),
+            [](auto a, auto b) { return a->id < b->id; });
+  topics.erase(std::unique(topics.begin(), topics.end()), topics.end());
+}
+
 ServerImpl::TopicData* ServerImpl::CreateTopic(ClientData* client,
                                                std::string_view name,
                                                std::string_view typeStr,
@@ -1703,7 +1797,7 @@ void ServerImpl::DeleteTopic(TopicData* topic) {
   }
 
   // erase the topic
-  m_nameTopics.erase(topic->name);
+  m_nameTopics.Erase(topic->name);
   m_topics.erase(topic->id);
 }
 
@@ -1713,9 +1807,9 @@ void ServerImpl::SetProperties(ClientData* client, TopicData* topic,
          topic->name, update.dump());
   bool wasPersistent = topic->persistent;
   if (topic->SetProperties(update)) {
-    // update persistentChanged flag
-    if (topic->persistent != wasPersistent) {
-      m_persistentChanged = true;
+    // update persistentChanged flag (properties are saved with the value)
+    if (topic->persistent || wasPersistent) {
+      PersistentChanged(topic);
     }
     PropertiesChanged(client, topic, update);
   }
@@ -1727,7 +1821,7 @@ void ServerImpl::SetFlags(ClientData* client, TopicData* topic,
   if (topic->SetFlags(flags)) {
     // update persistentChanged flag
     if (topic->persistent != wasPersistent) {
-      m_persistentChanged = true;
+      PersistentChanged(topic);
       wpi::json update;
       if (topic->persistent) {
         update = {{"persistent", true}};
@@ -1751,7 +1845,7 @@ void ServerImpl::SetValue(ClientData* client, TopicData* topic,
 
     // if persistent, update flag
     if (topic->persistent) {
-      m_persistentChanged = true;
+      PersistentChanged(topic);
     }
   }
 
@@ -1762,6 +1856,15 @@ void ServerImpl::SetValue(ClientData* client, TopicData* topic,
   }
 }
 
+void ServerImpl::SetBandwidthLimit(uint32_t bytesPerSec) {
+  m_bandwidthLimit = bytesPerSec;
+  for (auto&& client : m_clients) {
+    if (client) {
+      client->SetBandwidthLimit(bytesPerSec);
+    }
+  }
+}
+
 void ServerImpl::UpdateMetaClients(const std::vector<ConnectionInfo>& conns) {
   Writer w;
   mpack_start_array(&w, conns.size());
@@ -1890,6 +1993,93 @@ void ServerImpl::ConnectionsChanged(const std::vector<ConnectionInfo>& conns) {
   UpdateMetaClients(conns);
 }
 
+std::string ServerImpl::DumpPersistentJournal(bool full) {
+  std::string rv;
+  wpi::raw_string_ostream os{rv};
+  if (full) {
+    WritePersistentJournalHeader(os);
+    for (const auto& topic : m_topics) {
+      if (topic->persistent && topic->lastValue) {
+        WritePersistentJournalRecord(os, topic->name, topic->typeStr,
+                                     topic->properties, topic->lastValue);
+      }
+    }
+  } else {
+    for (auto&& changed : m_persistentJournalChanged) {
+      auto it = m_nameTopics.Find(changed.getKey());
+      if (it && (*it)->persistent && (*it)->lastValue) {
+        auto topic = *it;
+        WritePersistentJournalRecord(os, topic->name, topic->typeStr,
+                                     topic->properties, topic->lastValue);
+      } else {
+        WritePersistentJournalRemove(os, changed.getKey());
+      }
+    }
+  }
+  m_persistentJournalChanged.clear();
+  os.flush();
+  return rv;
+}
+
+std::string ServerImpl::LoadPersistentJournal(std::span<const uint8_t> in) {
+  m_persistentJournal = true;
+  if (in.empty()) {
+    return {};
+  }
+
+  // replay the journal so only the final state of each topic is created;
+  // topics are created in the order they first appear in the journal
+  struct Entry {
+    std::string name;
+    std::string typeStr;
+    std::string properties;
+    Value value;
+  };
+  std::vector<Entry> entries;
+  wpi::StringMap<size_t> entryIndex;
+  std::string allerrors;
+  if (!ReadPersistentJournal(
+          in,
+          [&](PersistentJournalRecord&& record) {
+            auto [it, isNew] =
+                entryIndex.try_emplace(record.name, entries.size());
+            if (isNew) {
+              entries.emplace_back().name = record.name;
+            }
+            auto& entry = entries[it->second];
+            entry.typeStr = record.typeStr;
+            entry.properties = record.properties;
+            entry.value = std::move(record.value);  // empty if removed
+          },
+          &allerrors)) {
+    allerrors += '\n';
+  }
+
+  bool persistentChanged = m_persistentChanged;
+
+  auto time = nt::Now();
+  for (auto&& e : entries) {
+    if (!e.value) {
+      continue;
+    }
+    wpi::json props = wpi::json::parse(e.properties, nullptr, false);
+    if (!props.is_object()) {
+      allerrors += fmt::format("{}: invalid properties\n", e.name);
+      continue;
+    }
+    // match the timestamps of values loaded from JSON
+    e.value.SetTime(time);
+    e.value.SetServerTime(1);
+    auto topic = CreateTopic(nullptr, e.name, e.typeStr, props);
+    SetValue(nullptr, topic, e.value);
+  }
+
+  m_persistentChanged = persistentChanged;  // restore flag
+  m_persistentJournalChanged.clear();
+
+  return allerrors;
+}
+
 std::string ServerImpl::DumpPersistent() {
   std::string rv;
   wpi::raw_string_ostream os{rv};
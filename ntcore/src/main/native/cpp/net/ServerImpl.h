@@ -17,6 +17,7 @@
 
 #include <wpi/DenseMap.h>
 #include <wpi/SmallPtrSet.h>
+#include <wpi/SmallVector.h>
 #include <wpi/StringMap.h>
 #include <wpi/UidVector.h>
 #include <wpi/json.h>
@@ -27,6 +28,7 @@
 #include "NetworkInterface.h"
 #include "NetworkOutgoingQueue.h"
 #include "NetworkPing.h"
+#include "PrefixIndex.h"
 #include "PubSubOptions.h"
 #include "VectorSet.h"
 #include "WireConnection.h"
@@ -84,12 +86,23 @@ class ServerImpl final {
 
   void ConnectionsChanged(const std::vector<ConnectionInfo>& conns);
 
+  // Limits the per-client transmit rate (bytes per second); 0 is unlimited
+  void SetBandwidthLimit(uint32_t bytesPerSec);
+
   // if any persistent values changed since the last call to this function
   bool PersistentChanged();
   std::string DumpPersistent();
   // returns newline-separated errors
   std::string LoadPersistent(std::string_view in);
 
+  // Persistent journal (see PersistentJournal.h). Loading a journal enables
+  // change tracking. If full is true, dumps a complete compacted journal
+  // (including header); otherwise, dumps only records for topics changed
+  // since the last call, to be appended to the journal.
+  std::string DumpPersistentJournal(bool full);
+  // returns newline-separated errors
+  std::string LoadPersistentJournal(std::span<const uint8_t> in);
+
  private:
   static constexpr uint32_t kMinPeriodMs = 5;
 
@@ -127,6 +140,7 @@ class ServerImpl final {
     bool persistent{false};
     bool retained{false};
     bool special{false};
+    int priority{0};
     NT_Topic localHandle{0};
 
     void AddPublisher(ClientData* client, PublisherData* pub) {
@@ -189,6 +203,7 @@ class ServerImpl final {
                                       bool ack) = 0;
     virtual void SendOutgoing(uint64_t curTimeMs, bool flush) = 0;
     virtual void Flush() = 0;
+    virtual void SetBandwidthLimit(uint32_t bytesPerSec) {}
 
     void UpdateMetaClientPub();
     void UpdateMetaClientSub();
@@ -221,6 +236,7 @@ class ServerImpl final {
     // meta topics
     TopicData* m_metaPub = nullptr;
     TopicData* m_metaSub = nullptr;
+    TopicData* m_metaQueue = nullptr;
   };
 
   class ClientData4Base : public ClientData, protected ClientMessageHandler {
@@ -295,14 +311,26 @@ class ServerImpl final {
 
     void Flush() final {}
 
+    void SetBandwidthLimit(uint32_t bytesPerSec) final {
+      m_outgoing.SetBandwidthLimit(bytesPerSec);
+    }
+
     void UpdatePeriod(TopicData::TopicClientData& tcd, TopicData* topic) final;
 
+    void UpdateMetaClientQueue();
+
    public:
     WireConnection& m_wire;
 
    private:
     NetworkPing m_ping;
     NetworkOutgoingQueue<ServerMessage> m_outgoing;
+    WireDeltaState m_deltaState;
+    uint64_t m_nextMetaQueueMs = 0;
+    std::vector<uint8_t> m_lastMetaQueue;  // last published $clientqueue$
+
+    // how often to update the $clientqueue meta topic
+    static constexpr uint32_t kMetaQueueIntervalMs = 1000;
   };
 
   class ClientData3 final : public ClientData, private net3::MessageHandler3 {
@@ -443,16 +471,25 @@ class ServerImpl final {
   ClientDataLocal* m_localClient;
   std::vector<std::unique_ptr<ClientData>> m_clients;
   wpi::UidVector<std::unique_ptr<TopicData>, 16> m_topics;
-  wpi::StringMap<TopicData*> m_nameTopics;
+  PrefixIndex<TopicData*> m_nameTopics;
   bool m_persistentChanged{false};
+  // names of persistent topics changed since the last journal dump (only
+  // tracked when using a journal)
+  bool m_persistentJournal{false};
+  wpi::StringMap<bool> m_persistentJournalChanged;
+  uint32_t m_bandwidthLimit{0};
 
   // global meta topics (other meta topics are linked to from the specific
   // client or topic)
   TopicData* m_metaClients;
 
   void DumpPersistent(wpi::raw_ostream& os);
+  void PersistentChanged(TopicData* topic);
 
   // helper functions
+  // gets existing topics matching a subscriber, in creation order
+  void GetMatchingTopics(SubscriberData* sub,
+                         wpi::SmallVectorImpl<TopicData*>& topics);
   TopicData* CreateTopic(ClientData* client, std::string_view name,
                          std::string_view typeStr, const wpi::json& properties,
                          bool special = false);
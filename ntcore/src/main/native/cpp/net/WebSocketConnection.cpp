@@ -12,6 +12,7 @@
 #include <wpi/timestamp.h>
 #include <wpinet/WebSocket.h>
 #include <wpinet/raw_uv_ostream.h>
+#include <wpinet/uv/BufferPool.h>
 
 using namespace nt;
 using namespace nt::net;
@@ -24,7 +25,6 @@ static constexpr size_t kAllocSize = kMTU - 10;
 static constexpr size_t kNewFrameThresholdBytes = kAllocSize - 50;
 static constexpr size_t kFlushThresholdFrames = 32;
 static constexpr size_t kFlushThresholdBytes = 16384;
-static constexpr size_t kMaxPoolSize = 32;
 
 class WebSocketConnection::Stream final : public wpi::raw_ostream {
  public:
@@ -83,8 +83,9 @@ void WebSocketConnection::Stream::write_impl(const char* data, size_t len) {
 }
 
 WebSocketConnection::WebSocketConnection(wpi::WebSocket& ws,
-                                         unsigned int version)
-    : m_ws{ws}, m_version{version} {
+                                         unsigned int version,
+                                         bool deltaArrays)
+    : m_ws{ws}, m_version{version}, m_deltaArrays{deltaArrays} {
   m_ws.pong.connect([this](auto data) {
     if (data.size() != 8) {
       return;
@@ -95,12 +96,7 @@ WebSocketConnection::WebSocketConnection(wpi::WebSocket& ws,
 }
 
 WebSocketConnection::~WebSocketConnection() {
-  for (auto&& buf : m_bufs) {
-    buf.Deallocate();
-  }
-  for (auto&& buf : m_buf_pool) {
-    buf.Deallocate();
-  }
+  wpi::uv::BufferPool::Release(m_bufs);
 }
 
 void WebSocketConnection::SendPing(uint64_t time) {
@@ -110,12 +106,8 @@ void WebSocketConnection::SendPing(uint64_t time) {
   m_ws.SendPing({buf}, [selfweak = weak_from_this()](auto bufs, auto err) {
     if (auto self = selfweak.lock()) {
       self->m_err = err;
-      self->ReleaseBufs(bufs);
-    } else {
-      for (auto&& buf : bufs) {
-        buf.Deallocate();
-      }
     }
+    wpi::uv::BufferPool::Release(bufs);
   });
 }
 
@@ -193,12 +185,8 @@ int WebSocketConnection::Flush() {
       m_ws_frames, [selfweak = weak_from_this()](auto bufs, auto err) {
         if (auto self = selfweak.lock()) {
           self->m_err = err;
-          self->ReleaseBufs(bufs);
-        } else {
-          for (auto&& buf : bufs) {
-            buf.Deallocate();
-          }
         }
+        wpi::uv::BufferPool::Release(bufs);
       });
   m_ws_frames.clear();
   if (m_err) {
@@ -229,14 +217,8 @@ void WebSocketConnection::Send(
     os << ']';
   }
   wpi::WebSocket::Frame frame{opcode, os.bufs()};
-  m_ws.SendFrames({{frame}}, [selfweak = weak_from_this()](auto bufs, auto) {
-    if (auto self = selfweak.lock()) {
-      self->ReleaseBufs(bufs);
-    } else {
-      for (auto&& buf : bufs) {
-        buf.Deallocate();
-      }
-    }
+  m_ws.SendFrames({{frame}}, [](auto bufs, auto) {
+    wpi::uv::BufferPool::Release(bufs);
   });
 }
 
@@ -246,18 +228,5 @@ void WebSocketConnection::Disconnect(std::string_view reason) {
 }
 
 wpi::uv::Buffer WebSocketConnection::AllocBuf() {
-  if (!m_buf_pool.empty()) {
-    auto buf = m_buf_pool.back();
-    m_buf_pool.pop_back();
-    return buf;
-  }
-  return wpi::uv::Buffer::Allocate(kAllocSize + 1);  // leave space for ']'
-}
-
-void WebSocketConnection::ReleaseBufs(std::span<wpi::uv::Buffer> bufs) {
-  size_t numToPool = (std::min)(bufs.size(), kMaxPoolSize - m_buf_pool.size());
-  m_buf_pool.insert(m_buf_pool.end(), bufs.begin(), bufs.begin() + numToPool);
-  for (auto&& buf : bufs.subspan(numToPool)) {
-    buf.Deallocate();
-  }
+  return wpi::uv::BufferPool::Allocate(kAllocSize + 1);  // leave space for ']'
 }
@@ -21,13 +21,16 @@ class WebSocketConnection final
     : public WireConnection,
       public std::enable_shared_from_this<WebSocketConnection> {
  public:
-  WebSocketConnection(wpi::WebSocket& ws, unsigned int version);
+  WebSocketConnection(wpi::WebSocket& ws, unsigned int version,
+                      bool deltaArrays = false);
   ~WebSocketConnection() override;
   WebSocketConnection(const WebSocketConnection&) = delete;
   WebSocketConnection& operator=(const WebSocketConnection&) = delete;
 
   unsigned int GetVersion() const final { return m_version; }
 
+  bool HasDeltaArrays() const final { return m_deltaArrays; }
+
   void SendPing(uint64_t time) final;
 
   bool Ready() const final { return !m_ws.IsWriteInProgress(); }
@@ -65,7 +68,6 @@ class WebSocketConnection final
   void StartFrame(uint8_t opcode);
   void FinishText();
   wpi::uv::Buffer AllocBuf();
-  void ReleaseBufs(std::span<wpi::uv::Buffer> bufs);
 
   wpi::WebSocket& m_ws;
 
@@ -83,7 +85,6 @@ class WebSocketConnection final
   std::vector<wpi::WebSocket::Frame> m_ws_frames;  // to reduce allocs
   std::vector<Frame> m_frames;
   std::vector<wpi::uv::Buffer> m_bufs;
-  std::vector<wpi::uv::Buffer> m_buf_pool;
   size_t m_framePos = 0;
   size_t m_written = 0;
   wpi::uv::Error m_err;
@@ -92,6 +93,7 @@ class WebSocketConnection final
   uint64_t m_lastFlushTime = 0;
   uint64_t m_lastPingResponse = 0;
   unsigned int m_version;
+  bool m_deltaArrays;
 };
 
 }  // namespace nt::net
@@ -22,6 +22,10 @@ class WireConnection {
 
   virtual unsigned int GetVersion() const = 0;
 
+  // True if the delta array extension was negotiated for this connection
+  // (see WireEncodeBinaryDelta)
+  virtual bool HasDeltaArrays() const = 0;
+
   virtual void SendPing(uint64_t time) = 0;
 
   virtual bool Ready() const = 0;
@@ -427,9 +427,35 @@ void nt::net::WireDecodeText(std::string_view in, ServerMessageHandler& out,
   ::WireDecodeTextImpl(in, out, logger);
 }
 
+// applies a delta array (pairs of index, value) on top of the reference array
+template <typename T, typename F>
+static std::vector<T> DecodeArrayDelta(mpack_reader_t* reader,
+                                       std::span<const T> ref, F&& readElem) {
+  std::vector<T> arr{ref.begin(), ref.end()};
+  auto length = mpack_expect_array(reader);
+  if ((length % 2) != 0) {
+    mpack_reader_flag_error(reader, mpack_error_data);
+  }
+  for (uint32_t i = 0; i < length / 2; ++i) {
+    auto index = mpack_expect_u32(reader);
+    T val = readElem(reader);
+    if (mpack_reader_error(reader) != mpack_ok) {
+      break;
+    }
+    if (index >= arr.size()) {
+      mpack_reader_flag_error(reader, mpack_error_data);
+      break;
+    }
+    arr[index] = val;
+  }
+  mpack_done_array(reader);
+  return arr;
+}
+
 bool nt::net::WireDecodeBinary(std::span<const uint8_t>* in, int64_t* outId,
                                Value* outValue, std::string* error,
-                               int64_t localTimeOffset) {
+                               int64_t localTimeOffset,
+                               WireDeltaState* deltaState) {
   mpack_reader_t reader;
   mpack_reader_init_data(&reader, reinterpret_cast<const char*>(in->data()),
                          in->size());
@@ -553,6 +579,63 @@ bool nt::net::WireDecodeBinary(std::span<const uint8_t>* in, int64_t* outId,
       mpack_done_array(&reader);
       break;
     }
+    case 16 | kDeltaArrayTypeFlag:
+    case 17 | kDeltaArrayTypeFlag:
+    case 18 | kDeltaArrayTypeFlag:
+    case 19 | kDeltaArrayTypeFlag: {
+      if (!deltaState) {
+        *error = fmt::format("unrecognized type {}", type);
+        return false;
+      }
+      auto it = deltaState->find(*outId);
+      if (it == deltaState->end()) {
+        *error = fmt::format("delta array for id {} without reference value",
+                             *outId);
+        return false;
+      }
+      const Value& ref = it->second;
+      *outValue = Value{};
+      switch (type & ~kDeltaArrayTypeFlag) {
+        case 16:
+          if (ref.IsBooleanArray()) {
+            auto arr = DecodeArrayDelta(
+                &reader, ref.GetBooleanArray(),
+                [](mpack_reader_t* r) -> int { return mpack_expect_bool(r); });
+            *outValue = Value::MakeBooleanArray(std::move(arr), 1);
+          }
+          break;
+        case 17:
+          if (ref.IsDoubleArray()) {
+            auto arr = DecodeArrayDelta(
+                &reader, ref.GetDoubleArray(),
+                [](mpack_reader_t* r) { return mpack_expect_double(r); });
+            *outValue = Value::MakeDoubleArray(std::move(arr), 1);
+          }
+          break;
+        case 18:
+          if (ref.IsIntegerArray()) {
+            auto arr = DecodeArrayDelta(
+                &reader, ref.GetIntegerArray(),
+                [](mpack_reader_t* r) { return mpack_expect_i64(r); });
+            *outValue = Value::MakeIntegerArray(std::move(arr), 1);
+          }
+          break;
+        case 19:
+          if (ref.IsFloatArray()) {
+            auto arr = DecodeArrayDelta(
+                &reader, ref.GetFloatArray(),
+                [](mpack_reader_t* r) { return mpack_expect_float(r); });
+            *outValue = Value::MakeFloatArray(std::move(arr), 1);
+          }
+          break;
+      }
+      if (!outValue->IsValid()) {
+        *error = fmt::format("delta array type {} does not match reference",
+                             type);
+        return false;
+      }
+      break;
+    }
     default:
       *error = fmt::format("unrecognized type {}", type);
       return false;
@@ -563,6 +646,14 @@ bool nt::net::WireDecodeBinary(std::span<const uint8_t>* in, int64_t* outId,
     *error = mpack_error_to_string(err);
     return false;
   }
+  // remember the last array value for each id as the next delta reference
+  if (deltaState && *outId >= 0) {
+    if (IsDeltaArrayType(outValue->type())) {
+      (*deltaState)[*outId] = *outValue;
+    } else {
+      deltaState->erase(*outId);
+    }
+  }
   // set time
   outValue->SetServerTime(time);
   outValue->SetTime(time == 0 ? 0 : time + localTimeOffset);
@@ -11,6 +11,7 @@
 #include <string>
 #include <string_view>
 
+#include <wpi/DenseMap.h>
 #include <wpi/json_fwd.h>
 
 namespace wpi {
@@ -58,9 +59,15 @@ bool WireDecodeText(std::string_view in, ClientMessageHandler& out,
 void WireDecodeText(std::string_view in, ServerMessageHandler& out,
                     wpi::Logger& logger);
 
-// returns true if successfully decoded a message
+// last array value received for each id; used as the reference for delta
+// array messages on connections that negotiated delta arrays
+using WireDeltaState = wpi::DenseMap<int64_t, Value>;
+
+// returns true if successfully decoded a message; deltaState must be non-null
+// to accept delta array messages
 bool WireDecodeBinary(std::span<const uint8_t>* in, int64_t* outId,
                       Value* outValue, std::string* error,
-                      int64_t localTimeOffset);
+                      int64_t localTimeOffset,
+                      WireDeltaState* deltaState = nullptr);
 
 }  // namespace nt::net
@@ -4,6 +4,8 @@
 
 #include "WireEncoder.h"
 
+#include <bit>
+#include <concepts>
 #include <optional>
 
 #include <wpi/json.h>
@@ -213,16 +215,21 @@ bool nt::net::WireEncodeText(wpi::raw_ostream& os, const ServerMessage& msg) {
   return true;
 }
 
+static void InitWriter(mpack_writer_t* writer, char* buf, size_t size,
+                       wpi::raw_ostream& os) {
+  mpack_writer_init(writer, buf, size);
+  mpack_writer_set_context(writer, &os);
+  mpack_writer_set_flush(
+      writer, [](mpack_writer_t* writer, const char* buffer, size_t count) {
+        static_cast<wpi::raw_ostream*>(writer->context)->write(buffer, count);
+      });
+}
+
 bool nt::net::WireEncodeBinary(wpi::raw_ostream& os, int64_t id, int64_t time,
                                const Value& value) {
   char buf[128];
   mpack_writer_t writer;
-  mpack_writer_init(&writer, buf, sizeof(buf));
-  mpack_writer_set_context(&writer, &os);
-  mpack_writer_set_flush(
-      &writer, [](mpack_writer_t* writer, const char* buffer, size_t count) {
-        static_cast<wpi::raw_ostream*>(writer->context)->write(buffer, count);
-      });
+  InitWriter(&writer, buf, sizeof(buf), os);
   mpack_start_array(&writer, 4);
   mpack_write_int(&writer, id);
   mpack_write_int(&writer, time);
@@ -313,3 +320,80 @@ bool nt::net::WireEncodeBinary(wpi::raw_ostream& os, int64_t id, int64_t time,
   mpack_finish_array(&writer);
   return mpack_writer_destroy(&writer) == mpack_ok;
 }
+
+// elements are compared bitwise so that NaN and -0.0 changes are not lost
+template <typename T>
+static bool ElementChanged(T a, T b) {
+  if constexpr (std::same_as<T, double>) {
+    return std::bit_cast<uint64_t>(a) != std::bit_cast<uint64_t>(b);
+  } else if constexpr (std::same_as<T, float>) {
+    return std::bit_cast<uint32_t>(a) != std::bit_cast<uint32_t>(b);
+  } else {
+    return a != b;
+  }
+}
+
+template <typename T, typename F>
+static bool EncodeArrayDelta(wpi::raw_ostream& os, int64_t id, int64_t time,
+                             uint8_t type, std::span<const T> value,
+                             std::span<const T> prev, F&& writeElem) {
+  if (value.empty() || value.size() != prev.size()) {
+    return false;
+  }
+  size_t changed = 0;
+  for (size_t i = 0; i < value.size(); ++i) {
+    if (ElementChanged(value[i], prev[i])) {
+      ++changed;
+    }
+  }
+  // each changed element costs an index in addition to the value
+  if (changed * 2 > value.size()) {
+    return false;
+  }
+
+  char buf[128];
+  mpack_writer_t writer;
+  InitWriter(&writer, buf, sizeof(buf), os);
+  mpack_start_array(&writer, 4);
+  mpack_write_int(&writer, id);
+  mpack_write_int(&writer, time);
+  mpack_write_u8(&writer, type | kDeltaArrayTypeFlag);
+  mpack_start_array(&writer, changed * 2);
+  for (size_t i = 0; i < value.size(); ++i) {
+    if (ElementChanged(value[i], prev[i])) {
+      mpack_write_uint(&writer, i);
+      writeElem(&writer, value[i]);
+    }
+  }
+  mpack_finish_array(&writer);
+  mpack_finish_array(&writer);
+  return mpack_writer_destroy(&writer) == mpack_ok;
+}
+
+bool nt::net::WireEncodeBinaryDelta(wpi::raw_ostream& os, int64_t id,
+                                    int64_t time, const Value& value,
+                                    const Value& prev) {
+  if (value.type() != prev.type()) {
+    return false;
+  }
+  switch (value.type()) {
+    case NT_BOOLEAN_ARRAY:
+      return EncodeArrayDelta(
+          os, id, time, 16, value.GetBooleanArray(), prev.GetBooleanArray(),
+          [](mpack_writer_t* w, int v) { mpack_write_bool(w, v); });
+    case NT_DOUBLE_ARRAY:
+      return EncodeArrayDelta(
+          os, id, time, 17, value.GetDoubleArray(), prev.GetDoubleArray(),
+          [](mpack_writer_t* w, double v) { mpack_write_double(w, v); });
+    case NT_INTEGER_ARRAY:
+      return EncodeArrayDelta(
+          os, id, time, 18, value.GetIntegerArray(), prev.GetIntegerArray(),
+          [](mpack_writer_t* w, int64_t v) { mpack_write_int(w, v); });
+    case NT_FLOAT_ARRAY:
+      return EncodeArrayDelta(
+          os, id, time, 19, value.GetFloatArray(), prev.GetFloatArray(),
+          [](mpack_writer_t* w, float v) { mpack_write_float(w, v); });
+    default:
+      return false;
+  }
+}
@@ -59,4 +59,13 @@ bool WireEncodeText(wpi::raw_ostream& os, const ServerMessage& msg);
 bool WireEncodeBinary(wpi::raw_ostream& os, int64_t id, int64_t time,
                       const Value& value);
 
+// encoder for delta array binary messages (only valid on connections that
+// negotiated delta arrays); encodes the elements of value that differ from
+// prev, which must be the last value sent for id on this connection.
+// Returns false (and writes nothing) if value is not a numeric or boolean
+// array, prev has a different type or length, or the delta would not be
+// smaller than the full encoding.
+bool WireEncodeBinaryDelta(wpi::raw_ostream& os, int64_t id, int64_t time,
+                           const Value& value, const Value& prev);
+
 }  // namespace nt::net
@@ -5,20 +5,17 @@
 #include "UvStreamConnection3.h"
 
 #include <wpi/timestamp.h>
+#include <wpinet/uv/BufferPool.h>
 #include <wpinet/uv/Stream.h>
 
 using namespace nt;
 using namespace nt::net3;
 
-static constexpr size_t kMaxPoolSize = 16;
-
 UvStreamConnection3::UvStreamConnection3(wpi::uv::Stream& stream)
     : m_stream{stream}, m_os{m_buffers, [this] { return AllocBuf(); }} {}
 
 UvStreamConnection3::~UvStreamConnection3() {
-  for (auto&& buf : m_buf_pool) {
-    buf.Deallocate();
-  }
+  wpi::uv::BufferPool::Release(m_buffers);
 }
 
 void UvStreamConnection3::Flush() {
@@ -27,14 +24,8 @@ void UvStreamConnection3::Flush() {
   }
   ++m_sendsActive;
   m_stream.Write(m_buffers, [selfweak = weak_from_this()](auto bufs, auto) {
+    wpi::uv::BufferPool::Release(bufs);
     if (auto self = selfweak.lock()) {
-      size_t numToPool =
-          (std::min)(bufs.size(), kMaxPoolSize - self->m_buf_pool.size());
-      self->m_buf_pool.insert(self->m_buf_pool.end(), bufs.begin(),
-                              bufs.begin() + numToPool);
-      for (auto&& buf : bufs.subspan(numToPool)) {
-        buf.Deallocate();
-      }
       if (self->m_sendsActive > 0) {
         --self->m_sendsActive;
       }
@@ -53,10 +44,5 @@ void UvStreamConnection3::Disconnect(std::string_view reason) {
 void UvStreamConnection3::FinishSend() {}
 
 wpi::uv::Buffer UvStreamConnection3::AllocBuf() {
-  if (!m_buf_pool.empty()) {
-    auto buf = m_buf_pool.back();
-    m_buf_pool.pop_back();
-    return buf;
-  }
-  return wpi::uv::Buffer::Allocate(kAllocSize);
+  return wpi::uv::BufferPool::Allocate(kAllocSize);
 }
@@ -7,7 +7,6 @@
 #include <memory>
 #include <string>
 #include <string_view>
-#include <vector>
 
 #include <wpi/SmallVector.h>
 #include <wpinet/raw_uv_ostream.h>
@@ -53,7 +52,6 @@ class UvStreamConnection3 final
 
   wpi::uv::Stream& m_stream;
   wpi::SmallVector<wpi::uv::Buffer, 4> m_buffers;
-  std::vector<wpi::uv::Buffer> m_buf_pool;
   wpi::raw_uv_ostream m_os;
   std::string m_reason;
   uint64_t m_lastFlushTime = 0;
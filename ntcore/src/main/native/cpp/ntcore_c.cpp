@@ -126,6 +126,7 @@ static PubSubOptions ConvertToCpp(const NT_PubSubOptions* in) {
   out.disableRemote = in->disableRemote;
   out.disableLocal = in->disableLocal;
   out.excludeSelf = in->excludeSelf;
+  out.fastPublish = in->fastPublish;
   return out;
 }
 
@@ -507,6 +508,18 @@ void NT_StopServer(NT_Inst inst) {
   nt::StopServer(inst);
 }
 
+void NT_SetServerBandwidthLimit(NT_Inst inst, unsigned int bytesPerSec) {
+  nt::SetServerBandwidthLimit(inst, bytesPerSec);
+}
+
+void NT_SetNetworkCompression(NT_Inst inst, NT_Bool enabled) {
+  nt::SetNetworkCompression(inst, enabled);
+}
+
+void NT_SetNetworkDeltaArrays(NT_Inst inst, NT_Bool enabled) {
+  nt::SetNetworkDeltaArrays(inst, enabled);
+}
+
 void NT_StartClient3(NT_Inst inst, const char* identity) {
   nt::StartClient3(inst, identity);
 }
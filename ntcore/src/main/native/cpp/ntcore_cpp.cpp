@@ -490,6 +490,30 @@ NT_Listener AddListener(NT_Handle handle, unsigned int mask,
   }
 }
 
+NT_Listener AddBatchListener(NT_Inst inst,
+                             std::span<const std::string_view> prefixes,
+                             unsigned int mask, ListenerBatchCallback callback) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
+    if ((mask & (NT_EVENT_TOPIC | NT_EVENT_VALUE_ALL)) != 0) {
+      auto listener = ii->listenerStorage.AddListener(std::move(callback));
+      ii->localStorage.AddListener(listener, prefixes, mask);
+      return listener;
+    }
+  }
+  return {};
+}
+
+NT_Listener AddBatchListener(NT_Handle handle, unsigned int mask,
+                             ListenerBatchCallback callback) {
+  if (auto ii = InstanceImpl::GetHandle(handle)) {
+    auto listener = ii->listenerStorage.AddListener(std::move(callback));
+    DoAddListener(*ii, listener, handle, mask);
+    return listener;
+  } else {
+    return {};
+  }
+}
+
 NT_Listener AddPolledListener(NT_ListenerPoller poller,
                               std::span<const std::string_view> prefixes,
                               unsigned int mask) {
@@ -623,6 +647,24 @@ void StopServer(NT_Inst inst) {
   }
 }
 
+void SetServerBandwidthLimit(NT_Inst inst, unsigned int bytesPerSec) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
+    ii->SetServerBandwidthLimit(bytesPerSec);
+  }
+}
+
+void SetNetworkCompression(NT_Inst inst, bool enabled) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
+    ii->SetNetworkCompression(enabled);
+  }
+}
+
+void SetNetworkDeltaArrays(NT_Inst inst, bool enabled) {
+  if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
+    ii->SetNetworkDeltaArrays(enabled);
+  }
+}
+
 void StartClient3(NT_Inst inst, std::string_view identity) {
   if (auto ii = InstanceImpl::GetTyped(inst, Handle::kInstance)) {
     ii->StartClient3(identity);
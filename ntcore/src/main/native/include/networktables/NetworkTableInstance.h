@@ -511,6 +511,9 @@ class NetworkTableInstance final {
 
   /**
    * Starts a server using the specified filename, listening address, and port.
+   * If the persist filename ends in ".journal", persistent values are stored
+   * in an append-only journal (which is periodically compacted) instead of
+   * rewriting a JSON file on every change.
    *
    * @param persist_filename  the name of the persist file to use (UTF-8 string,
    *                          null terminated)
@@ -529,6 +532,44 @@ class NetworkTableInstance final {
    */
   void StopServer();
 
+  /**
+   * Limits the average rate at which the server sends to each client.  When a
+   * client connection is over budget, topics with a higher "priority" property
+   * are sent first, and lower priority topics get a smaller (but nonzero)
+   * share of the budget.  This may be called before or after the server is
+   * started.
+   *
+   * @param bytesPerSec maximum bytes per second per client (0 for unlimited)
+   */
+  void SetServerBandwidthLimit(unsigned int bytesPerSec);
+
+  /**
+   * Enables or disables compression of NT4 connections with the WebSocket
+   * permessage-deflate extension.  Both the server and the client must enable
+   * it for a connection to be compressed.  Compression is off by default; it
+   * trades CPU time for less bandwidth, which mostly helps topic
+   * announcements.  This takes effect the next time the server or client is
+   * started.
+   *
+   * Compression requires zlib, which only CMake builds link.  If it is not
+   * available, enabling compression logs a warning and has no effect.
+   *
+   * @param enabled true to enable compression
+   */
+  void SetNetworkCompression(bool enabled);
+
+  /**
+   * Enables or disables delta encoding of array values (the v4.1-delta NT4
+   * subprotocol).  Both the server and the client must enable it for a
+   * connection to use it.  Delta arrays are off by default; when enabled,
+   * boolean, integer, float and double arrays are sent as only the elements
+   * that changed since the last value.  This takes effect the next time the
+   * server or client is started.
+   *
+   * @param enabled true to enable delta arrays
+   */
+  void SetNetworkDeltaArrays(bool enabled);
+
   /**
    * Starts a NT3 client.  Use SetServer or SetServerTeam to set the server name
    * and port.
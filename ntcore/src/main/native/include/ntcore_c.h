@@ -119,6 +119,12 @@ enum NT_EventFlags {
   NT_EVENT_LOGMESSAGE = 0x100,
   /** Time synchronized with server. */
   NT_EVENT_TIMESYNC = 0x200,
+  /**
+   * Modifier for value events: only the latest value per topic is queued.
+   * If a value event for a topic has not yet been delivered when a new value
+   * arrives, the queued event is replaced instead of adding another one.
+   */
+  NT_EVENT_VALUE_COALESCE = 0x400,
 };
 
 /*
@@ -363,6 +369,13 @@ struct NT_PubSubOptions {
    * internal publisher.
    */
   NT_Bool excludeSelf;
+
+  /**
+   * For publishers, queue value changes in a lock-free per-publisher buffer
+   * that is drained in batches by the network thread. See
+   * nt::PubSubOptions::fastPublish.
+   */
+  NT_Bool fastPublish;
 };
 
 /**
@@ -1072,6 +1085,9 @@ void NT_StopLocal(NT_Inst inst);
 
 /**
  * Starts a server using the specified filename, listening address, and port.
+ * If the persist filename ends in ".journal", persistent values are stored
+ * in an append-only journal (which is periodically compacted) instead of
+ * rewriting a JSON file on every change.
  *
  * @param inst              instance handle
  * @param persist_filename  the name of the persist file to use (UTF-8 string,
@@ -1092,6 +1108,45 @@ void NT_StartServer(NT_Inst inst, const char* persist_filename,
  */
 void NT_StopServer(NT_Inst inst);
 
+/**
+ * Limits the average rate at which the server sends to each client.  When a
+ * client connection is over budget, topics with a higher "priority" property
+ * are sent first, and lower priority topics get a smaller (but nonzero) share
+ * of the budget.  This may be called before or after the server is started.
+ *
+ * @param inst         instance handle
+ * @param bytesPerSec  maximum bytes per second per client (0 for unlimited)
+ */
+void NT_SetServerBandwidthLimit(NT_Inst inst, unsigned int bytesPerSec);
+
+/**
+ * Enables or disables compression of NT4 connections with the WebSocket
+ * permessage-deflate extension.  Both the server and the client must enable
+ * it for a connection to be compressed.  Compression is off by default; it
+ * trades CPU time for less bandwidth, which mostly helps topic announcements.
+ * This takes effect the next time the server or client is started.
+ *
+ * Compression requires zlib, which only CMake builds link.  If it is not
+ * available, enabling compression logs a warning and has no effect.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to enable compression
+ */
+void NT_SetNetworkCompression(NT_Inst inst, NT_Bool enabled);
+
+/**
+ * Enables or disables delta encoding of array values (the v4.1-delta NT4
+ * subprotocol).  Both the server and the client must enable it for a
+ * connection to use it.  Delta arrays are off by default; when enabled,
+ * boolean, integer, float and double arrays are sent as only the elements that
+ * changed since the last value.  This takes effect the next time the server or
+ * client is started.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to enable delta arrays
+ */
+void NT_SetNetworkDeltaArrays(NT_Inst inst, NT_Bool enabled);
+
 /**
  * Starts a NT3 client.  Use NT_SetServer or NT_SetServerTeam to set the server
  * name and port.
@@ -84,6 +84,12 @@ struct EventFlags {
   static constexpr unsigned int kLogMessage = NT_EVENT_LOGMESSAGE;
   /** Time synchronized with server. */
   static constexpr unsigned int kTimeSync = NT_EVENT_TIMESYNC;
+  /**
+   * Modifier for value events: only the latest value per topic is queued.
+   * If a value event for a topic has not yet been delivered when a new value
+   * arrives, the queued event is replaced instead of adding another one.
+   */
+  static constexpr unsigned int kValueCoalesce = NT_EVENT_VALUE_COALESCE;
 };
 
 /** NetworkTables Topic Information */
@@ -374,6 +380,17 @@ struct PubSubOptions {
    * internal publisher.
    */
   bool excludeSelf = false;
+
+  /**
+   * For publishers, queue value changes in a lock-free per-publisher buffer
+   * instead of immediately updating local storage. The buffer is drained in
+   * batches by the network thread, so Set() does not block on the
+   * NetworkTables mutex or on listener dispatch. Local subscribers and
+   * listeners see queued values when the buffer is drained (periodically or
+   * on FlushLocal()). If the buffer is full or the network is not running,
+   * values are published immediately as with a normal publisher.
+   */
+  bool fastPublish = false;
 };
 
 /**
@@ -859,6 +876,7 @@ void UnsubscribeMultiple(NT_MultiSubscriber sub);
  */
 
 using ListenerCallback = std::function<void(const Event&)>;
+using ListenerBatchCallback = std::function<void(std::span<const Event>)>;
 
 /**
  * Creates a listener poller.
@@ -945,6 +963,34 @@ NT_Listener AddListener(NT_Inst inst,
 NT_Listener AddListener(NT_Handle handle, unsigned int mask,
                         ListenerCallback callback);
 
+/**
+ * Create a batch listener for changes to topics with names that start with any
+ * of the given prefixes. This is the same as AddListener(), except the
+ * callback is called once with all of the events that have accumulated for
+ * this listener since the last call, instead of once per event.
+ *
+ * @param inst Instance handle
+ * @param prefixes Topic name string prefixes
+ * @param mask Bitmask of NT_EventFlags values (only topic and value events will
+ *             be generated)
+ * @param callback Listener function
+ */
+NT_Listener AddBatchListener(NT_Inst inst,
+                             std::span<const std::string_view> prefixes,
+                             unsigned int mask, ListenerBatchCallback callback);
+
+/**
+ * Create a batch listener. This is the same as AddListener(), except the
+ * callback is called once with all of the events that have accumulated for
+ * this listener since the last call, instead of once per event.
+ *
+ * @param handle Instance, topic, subscriber, multi-subscriber, or entry handle
+ * @param mask Bitmask of NT_EventFlags values
+ * @param callback Listener function
+ */
+NT_Listener AddBatchListener(NT_Handle handle, unsigned int mask,
+                             ListenerBatchCallback callback);
+
 /**
  * Creates a polled listener. This creates a corresponding internal subscriber
  * with the lifetime of the listener.
@@ -1013,6 +1059,9 @@ void StopLocal(NT_Inst inst);
 
 /**
  * Starts a server using the specified filename, listening address, and port.
+ * If the persist filename ends in ".journal", persistent values are stored
+ * in an append-only journal (which is periodically compacted) instead of
+ * rewriting a JSON file on every change.
  *
  * @param inst              instance handle
  * @param persist_filename  the name of the persist file to use (UTF-8 string,
@@ -1033,6 +1082,47 @@ void StartServer(NT_Inst inst, std::string_view persist_filename,
  */
 void StopServer(NT_Inst inst);
 
+/**
+ * Limits the average rate at which the server sends to each client.  When a
+ * client connection is over budget, topics with a higher "priority" property
+ * are sent first, and lower priority topics get a smaller (but nonzero) share
+ * of the budget.  Per-client statistics are published to the
+ * $clientqueue$&lt;client&gt; meta topic.  This may be called before or after
+ * the server is started.
+ *
+ * @param inst         instance handle
+ * @param bytesPerSec  maximum bytes per second per client (0 for unlimited)
+ */
+void SetServerBandwidthLimit(NT_Inst inst, unsigned int bytesPerSec);
+
+/**
+ * Enables or disables compression of NT4 connections with the WebSocket
+ * permessage-deflate extension.  Both the server and the client must enable
+ * it for a connection to be compressed.  Compression is off by default; it
+ * trades CPU time for less bandwidth, which mostly helps topic announcements.
+ * This takes effect the next time the server or client is started.
+ *
+ * Compression requires zlib, which only CMake builds link.  If it is not
+ * available, enabling compression logs a warning and has no effect.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to enable compression
+ */
+void SetNetworkCompression(NT_Inst inst, bool enabled);
+
+/**
+ * Enables or disables delta encoding of array values (the v4.1-delta NT4
+ * subprotocol).  Both the server and the client must enable it for a
+ * connection to use it.  Delta arrays are off by default; when enabled,
+ * boolean, integer, float and double arrays are sent as only the elements that
+ * changed since the last value.  This takes effect the next time the server or
+ * client is started.
+ *
+ * @param inst     instance handle
+ * @param enabled  true to enable delta arrays
+ */
+void SetNetworkDeltaArrays(NT_Inst inst, bool enabled);
+
 /**
  * Starts a NT3 client.  Use SetServer or SetServerTeam to set the server name
  * and port.
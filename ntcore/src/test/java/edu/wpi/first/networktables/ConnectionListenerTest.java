@@ -12,18 +12,21 @@ import static org.junit.jupiter.api.Assertions.assertTrue;
 import static org.junit.jupiter.api.Assertions.fail;
 
 import edu.wpi.first.util.WPIUtilJNI;
+import java.nio.file.Path;
 import java.util.ArrayList;
 import java.util.EnumSet;
 import java.util.List;
 import org.junit.jupiter.api.AfterEach;
 import org.junit.jupiter.api.BeforeEach;
 import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
 import org.junit.jupiter.params.ParameterizedTest;
 import org.junit.jupiter.params.provider.ValueSource;
 
 class ConnectionListenerTest {
   private NetworkTableInstance m_serverInst;
   private NetworkTableInstance m_clientInst;
+  @TempDir Path m_tempDir;
 
   @BeforeEach
   void setUp() {
@@ -39,7 +42,8 @@ class ConnectionListenerTest {
 
   /** Connect to the server. */
   private void connect(int port) {
-    m_serverInst.startServer("connectionlistenertest.json", "127.0.0.1", 0, port);
+    m_serverInst.startServer(
+        m_tempDir.resolve("connectionlistenertest.json").toString(), "127.0.0.1", 0, port);
     m_clientInst.startClient4("client");
     m_clientInst.setServer("127.0.0.1", port);
 
@@ -113,7 +117,8 @@ class ConnectionListenerTest {
   @ParameterizedTest
   @ValueSource(strings = {"127.0.0.1", "127.0.0.1 ", " 127.0.0.1 "})
   void testThreaded(String address) {
-    m_serverInst.startServer("connectionlistenertest.json", address, 0, threadedPort);
+    m_serverInst.startServer(
+        m_tempDir.resolve("connectionlistenertest.json").toString(), address, 0, threadedPort);
     List<NetworkTableEvent> events = new ArrayList<>();
     final int handle =
         m_serverInst.addConnectionListener(
@@ -9,12 +9,15 @@ import static org.junit.jupiter.api.Assertions.assertFalse;
 import static org.junit.jupiter.api.Assertions.assertNotNull;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 
+import java.nio.file.Path;
 import org.junit.jupiter.api.AfterEach;
 import org.junit.jupiter.api.BeforeEach;
 import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
 
 class TimeSyncTest {
   private NetworkTableInstance m_inst;
+  @TempDir Path m_tempDir;
 
   @BeforeEach
   void setUp() {
@@ -37,7 +40,8 @@ class TimeSyncTest {
     try (var poller = new NetworkTableListenerPoller(m_inst)) {
       poller.addTimeSyncListener(false);
 
-      m_inst.startServer("timesynctest.json", "127.0.0.1", 0, 10030);
+      m_inst.startServer(
+          m_tempDir.resolve("timesynctest.json").toString(), "127.0.0.1", 0, 10030);
       var offset = m_inst.getServerTimeOffset();
       assertTrue(offset.isPresent());
       assertEquals(0L, offset.getAsLong());
@@ -10,15 +10,18 @@ import static org.junit.jupiter.api.Assertions.assertTrue;
 import static org.junit.jupiter.api.Assertions.fail;
 
 import edu.wpi.first.util.WPIUtilJNI;
+import java.nio.file.Path;
 import java.util.EnumSet;
 import org.junit.jupiter.api.AfterEach;
 import org.junit.jupiter.api.BeforeEach;
 import org.junit.jupiter.api.Disabled;
 import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
 
 class TopicListenerTest {
   private NetworkTableInstance m_serverInst;
   private NetworkTableInstance m_clientInst;
+  @TempDir Path m_tempDir;
 
   @BeforeEach
   void setUp() {
@@ -33,7 +36,8 @@ class TopicListenerTest {
   }
 
   private void connect() {
-    m_serverInst.startServer("topiclistenertest.json", "127.0.0.1", 0, 10010);
+    m_serverInst.startServer(
+        m_tempDir.resolve("topiclistenertest.json").toString(), "127.0.0.1", 0, 10010);
     m_clientInst.startClient4("client");
     m_clientInst.setServer("127.0.0.1", 10010);
 
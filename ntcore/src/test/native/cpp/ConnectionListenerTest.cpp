@@ -3,6 +3,7 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <chrono>
+#include <filesystem>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -31,8 +32,11 @@ class ConnectionListenerTest : public ::testing::Test {
 
 void ConnectionListenerTest::Connect(const char* address, unsigned int port3,
                                      unsigned int port4) {
-  nt::StartServer(server_inst, "connectionlistenertest.ini", address, port3,
-                  port4);
+  nt::StartServer(server_inst,
+                  (std::filesystem::temp_directory_path() /
+                   "connectionlistenertest.ini")
+                      .string(),
+                  address, port3, port4);
   nt::StartClient4(client_inst, "client");
   nt::SetServer(client_inst, address, port4);
 
@@ -2,6 +2,10 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <wpi/SpanMatcher.h>
 
@@ -1046,4 +1050,125 @@ TEST_F(LocalStorageTest, ReadQueueInitialRemote) {
   EXPECT_THAT(storage.ReadQueue<double>(subLocal), IsEmpty());
 }
 
+TEST_F(LocalStorageTest, FastPublish) {
+  EXPECT_CALL(network, Publish(_, _, _, _, _, _));
+  EXPECT_CALL(network, Subscribe(_, _, _));
+
+  auto pub =
+      storage.Publish(fooTopic, NT_DOUBLE, "double", {}, {.fastPublish = true});
+  auto sub =
+      storage.Subscribe(fooTopic, NT_DOUBLE, "double", {.pollStorage = 10});
+
+  // values are queued, not published
+  EXPECT_TRUE(storage.SetEntryValue(pub, Value::MakeDouble(1.0, 50)));
+  EXPECT_TRUE(storage.SetEntryValue(pub, Value::MakeDouble(2.0, 60)));
+  EXPECT_FALSE(storage.GetEntryValue(sub));
+
+  // draining publishes them in order
+  {
+    ::testing::InSequence seq;
+    EXPECT_CALL(network, SetValue(pub, Value::MakeDouble(1.0, 50)));
+    EXPECT_CALL(network, SetValue(pub, Value::MakeDouble(2.0, 60)));
+  }
+  storage.DrainFastPublishers();
+  EXPECT_THAT(storage.ReadQueue<double>(sub),
+              ElementsAre(TSEq<TimestampedDouble>(1.0, 50),
+                          TSEq<TimestampedDouble>(2.0, 60)));
+
+  // unpublish publishes anything still queued
+  EXPECT_TRUE(storage.SetEntryValue(pub, Value::MakeDouble(3.0, 70)));
+  EXPECT_CALL(network, SetValue(pub, Value::MakeDouble(3.0, 70)));
+  EXPECT_CALL(network, Unpublish(pub, fooTopic));
+  storage.Unpublish(pub);
+  EXPECT_THAT(storage.ReadQueue<double>(sub),
+              ElementsAre(TSEq<TimestampedDouble>(3.0, 70)));
+}
+
+TEST_F(LocalStorageTest, FastPublishNoNetwork) {
+  EXPECT_CALL(network, Publish(_, _, _, _, _, _));
+  EXPECT_CALL(network, Subscribe(_, _, _));
+  auto pub =
+      storage.Publish(fooTopic, NT_DOUBLE, "double", {}, {.fastPublish = true});
+  auto sub = storage.Subscribe(fooTopic, NT_DOUBLE, "double", {});
+
+  // without a network, values are published immediately
+  storage.ClearNetwork();
+  EXPECT_TRUE(storage.SetEntryValue(pub, Value::MakeDouble(1.0, 50)));
+  EXPECT_EQ(storage.GetEntryValue(sub), Value::MakeDouble(1.0, 50));
+}
+
+TEST_F(LocalStorageTest, FastPublishConcurrentClearNetwork) {
+  static constexpr int kNumValues = 10000;
+  EXPECT_CALL(network, Publish(_, _, _, _, _, _));
+  EXPECT_CALL(network, Subscribe(_, _, _));
+  EXPECT_CALL(network, SetValue(_, _)).Times(::testing::AnyNumber());
+
+  auto pub =
+      storage.Publish(fooTopic, NT_DOUBLE, "double", {}, {.fastPublish = true});
+  auto sub = storage.Subscribe(fooTopic, NT_DOUBLE, "double",
+                               {.pollStorage = kNumValues});
+
+  // no value set while the network is being cleared may be left queued
+  std::atomic_bool started{false};
+  std::thread producer{[&] {
+    for (int i = 1; i <= kNumValues; ++i) {
+      storage.SetEntryValue(pub, Value::MakeDouble(i, i));
+      if (i == kNumValues / 2) {
+        started = true;
+      }
+    }
+  }};
+  while (!started) {
+    std::this_thread::yield();
+  }
+  storage.ClearNetwork();
+  producer.join();
+
+  auto values = storage.ReadQueue<double>(sub);
+  ASSERT_EQ(values.size(), static_cast<size_t>(kNumValues));
+  for (int i = 0; i < kNumValues; ++i) {
+    EXPECT_EQ(values[i].value, i + 1);
+  }
+}
+
+TEST_F(LocalStorageTest, ConcurrentGetSet) {
+  EXPECT_CALL(network, Publish(_, _, _, _, _, _));
+  EXPECT_CALL(network, Subscribe(_, _, _));
+  EXPECT_CALL(network, SetValue(_, _)).Times(1000);
+
+  auto pub = storage.Publish(fooTopic, NT_DOUBLE, "double", {}, {});
+  auto sub =
+      storage.Subscribe(fooTopic, NT_DOUBLE, "double", kDefaultPubSubOptions);
+
+  // readers must always observe a complete, monotonically increasing value
+  std::atomic_bool done{false};
+  std::atomic_bool ok{true};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 2; ++i) {
+    readers.emplace_back([&] {
+      double prev = 0;
+      while (!done) {
+        auto val = storage.GetAtomic<double>(sub, 0);
+        if (val.value < prev || (val.value != 0 && val.time != val.value)) {
+          ok = false;
+        }
+        prev = val.value;
+        storage.GetTopicName(fooTopic);
+        storage.GetTopic("foo");
+      }
+    });
+  }
+
+  for (int i = 1; i <= 1000; ++i) {
+    storage.SetEntryValue(pub, Value::MakeDouble(i, i));
+  }
+  done = true;
+  for (auto&& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(storage.GetAtomic<double>(sub, 0).value, 1000);
+}
+
 }  // namespace nt
@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 #include <wpi/Synchronization.h>
+#include <wpinet/WebSocket.h>
 
 #include "Handle.h"
 #include "TestPrinters.h"
@@ -94,3 +95,20 @@ TEST_F(LoggerTest, Error) {
 
   Check(events, handle, false, true);
 }
+
+TEST_F(LoggerTest, CompressionUnavailable) {
+  auto poller = nt::CreateListenerPoller(m_inst);
+  nt::AddPolledLogger(poller, NT_LOG_WARNING, NT_LOG_WARNING);
+
+  nt::SetNetworkCompression(m_inst, true);
+
+  auto events = nt::ReadListenerQueue(poller);
+  if (wpi::WebSocket::IsDeflateAvailable()) {
+    ASSERT_TRUE(events.empty());
+  } else {
+    ASSERT_EQ(events.size(), 1u);
+    auto log = events[0].GetLogMessage();
+    ASSERT_TRUE(log);
+    ASSERT_EQ(log->level, NT_LOG_WARNING);
+  }
+}
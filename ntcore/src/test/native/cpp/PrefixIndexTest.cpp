@@ -0,0 +1,111 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "PrefixIndex.h"
+#include "gmock/gmock.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+namespace nt {
+
+class PrefixIndexTest : public ::testing::Test {
+ public:
+  PrefixIndexTest() {
+    for (auto name : {"/foo/bar", "/foo/baz", "/foo", "/fob", "/", "$meta"}) {
+      index[name] = name;
+    }
+  }
+
+  std::vector<std::string> WithPrefix(std::string_view prefix) {
+    std::vector<std::string> rv;
+    index.ForEachWithPrefix(
+        prefix, [&](const std::string& value) { rv.push_back(value); });
+    return rv;
+  }
+
+  std::vector<std::string> PrefixesOf(std::string_view name) {
+    std::vector<std::string> rv;
+    index.ForEachPrefixOf(name, [&](std::string_view key, std::string& value) {
+      EXPECT_EQ(key, value);
+      rv.push_back(value);
+    });
+    return rv;
+  }
+
+  PrefixIndex<std::string> index;
+};
+
+TEST_F(PrefixIndexTest, Find) {
+  EXPECT_EQ(index.size(), 6u);
+  ASSERT_TRUE(index.Find("/foo"));
+  EXPECT_EQ(*index.Find("/foo"), "/foo");
+  ASSERT_TRUE(index.Find("/foo/baz"));
+  EXPECT_EQ(*index.Find("/foo/baz"), "/foo/baz");
+  EXPECT_FALSE(index.Find(""));
+  EXPECT_FALSE(index.Find("/fo"));
+  EXPECT_FALSE(index.Find("/foo/"));
+  EXPECT_FALSE(index.Find("/foo/barr"));
+}
+
+TEST_F(PrefixIndexTest, InsertExisting) {
+  index["/foo"] = "x";
+  EXPECT_EQ(index.size(), 6u);
+  EXPECT_EQ(*index.Find("/foo"), "x");
+}
+
+TEST_F(PrefixIndexTest, ForEachWithPrefix) {
+  EXPECT_THAT(WithPrefix(""), ElementsAre("$meta", "/", "/fob", "/foo",
+                                          "/foo/bar", "/foo/baz"));
+  EXPECT_THAT(WithPrefix("/fo"),
+              ElementsAre("/fob", "/foo", "/foo/bar", "/foo/baz"));
+  EXPECT_THAT(WithPrefix("/foo"), ElementsAre("/foo", "/foo/bar", "/foo/baz"));
+  EXPECT_THAT(WithPrefix("/foo/"), ElementsAre("/foo/bar", "/foo/baz"));
+  EXPECT_THAT(WithPrefix("/foo/ba"), ElementsAre("/foo/bar", "/foo/baz"));
+  EXPECT_THAT(WithPrefix("/foo/bar"), ElementsAre("/foo/bar"));
+  EXPECT_THAT(WithPrefix("/foo/barr"), IsEmpty());
+  EXPECT_THAT(WithPrefix("/x"), IsEmpty());
+}
+
+TEST_F(PrefixIndexTest, ForEachPrefixOf) {
+  EXPECT_THAT(PrefixesOf("/foo/bar/baz"),
+              ElementsAre("/", "/foo", "/foo/bar"));
+  EXPECT_THAT(PrefixesOf("/foo/ba"), ElementsAre("/", "/foo"));
+  EXPECT_THAT(PrefixesOf("/fob"), ElementsAre("/", "/fob"));
+  EXPECT_THAT(PrefixesOf("$meta"), ElementsAre("$meta"));
+  EXPECT_THAT(PrefixesOf("x"), IsEmpty());
+  index[""] = "";
+  EXPECT_THAT(PrefixesOf("x"), ElementsAre(""));
+}
+
+TEST_F(PrefixIndexTest, Erase) {
+  EXPECT_FALSE(index.Erase("/fo"));
+  EXPECT_FALSE(index.Erase("/foo/"));
+  EXPECT_TRUE(index.Erase("/foo"));
+  EXPECT_FALSE(index.Erase("/foo"));
+  EXPECT_EQ(index.size(), 5u);
+  EXPECT_FALSE(index.Find("/foo"));
+  EXPECT_THAT(WithPrefix("/foo"), ElementsAre("/foo/bar", "/foo/baz"));
+
+  EXPECT_TRUE(index.Erase("/foo/bar"));
+  EXPECT_THAT(WithPrefix("/fo"), ElementsAre("/fob", "/foo/baz"));
+  EXPECT_THAT(PrefixesOf("/foo/baz"), ElementsAre("/", "/foo/baz"));
+
+  // re-add after collapsing
+  index["/foo/bar"] = "/foo/bar";
+  index["/foo"] = "/foo";
+  EXPECT_THAT(WithPrefix("/foo"), ElementsAre("/foo", "/foo/bar", "/foo/baz"));
+
+  index.clear();
+  EXPECT_TRUE(index.empty());
+  EXPECT_THAT(WithPrefix(""), IsEmpty());
+}
+
+}  // namespace nt
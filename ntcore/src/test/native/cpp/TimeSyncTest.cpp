@@ -2,6 +2,8 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <filesystem>
+
 #include <gtest/gtest.h>
 
 #include "networktables/NetworkTableInstance.h"
@@ -26,7 +28,9 @@ TEST_F(TimeSyncTest, TestServer) {
   nt::NetworkTableListenerPoller poller{m_inst};
   poller.AddTimeSyncListener(false);
 
-  m_inst.StartServer("timesynctest.json", "127.0.0.1", 0, 10030);
+  m_inst.StartServer(
+      (std::filesystem::temp_directory_path() / "timesynctest.json").string(),
+      "127.0.0.1", 0, 10030);
   auto offset = m_inst.GetServerTimeOffset();
   ASSERT_TRUE(offset);
   ASSERT_EQ(0, *offset);
@@ -3,6 +3,7 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <chrono>
+#include <filesystem>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -48,7 +49,11 @@ class TopicListenerTest : public ::testing::Test {
 };
 
 void TopicListenerTest::Connect(unsigned int port) {
-  nt::StartServer(m_serverInst, "topiclistenertest.json", "127.0.0.1", 0, port);
+  nt::StartServer(
+      m_serverInst,
+      (std::filesystem::temp_directory_path() / "topiclistenertest.json")
+          .string(),
+      "127.0.0.1", 0, port);
   nt::StartClient4(m_clientInst, "client");
   nt::SetServer(m_clientInst, "127.0.0.1", port);
 
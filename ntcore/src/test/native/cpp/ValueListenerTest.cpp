@@ -2,6 +2,9 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <span>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <wpi/StringExtras.h>
 #include <wpi/Synchronization.h>
@@ -406,4 +409,92 @@ TEST_F(ValueListenerTest, TwoSubOneMultiListener) {
   EXPECT_EQ(valueData->value, nt::Value::MakeDouble(0.0));
 }
 
+TEST_F(ValueListenerTest, PollCoalesce) {
+  auto topic1 = nt::GetTopic(m_inst, "foo");
+  auto topic2 = nt::GetTopic(m_inst, "bar");
+  auto pub1 = nt::Publish(topic1, NT_DOUBLE, "double");
+  auto pub2 = nt::Publish(topic2, NT_DOUBLE, "double");
+
+  auto poller = nt::CreateListenerPoller(m_inst);
+  auto h1 = nt::AddPolledListener(
+      poller, {{""}},
+      nt::EventFlags::kValueLocal | nt::EventFlags::kValueCoalesce);
+  auto h2 =
+      nt::AddPolledListener(poller, {{"foo"}}, nt::EventFlags::kValueLocal);
+
+  nt::SetDouble(pub1, 1);
+  nt::SetDouble(pub2, 2);
+  nt::SetDouble(pub1, 3);
+
+  bool timedOut = false;
+  ASSERT_TRUE(wpi::WaitForObject(poller, 1.0, &timedOut));
+  ASSERT_FALSE(timedOut);
+  auto results = nt::ReadListenerQueue(poller);
+
+  // the coalescing listener only gets the latest foo value, in the position
+  // of the first one
+  ASSERT_EQ(results.size(), 4u);
+  EXPECT_EQ(results[0].listener, h1);
+  auto valueData = results[0].GetValueEventData();
+  ASSERT_TRUE(valueData);
+  EXPECT_EQ(valueData->topic, topic1);
+  EXPECT_EQ(valueData->value, nt::Value::MakeDouble(3.0));
+  EXPECT_EQ(results[1].listener, h2);
+  valueData = results[1].GetValueEventData();
+  ASSERT_TRUE(valueData);
+  EXPECT_EQ(valueData->value, nt::Value::MakeDouble(1.0));
+  EXPECT_EQ(results[2].listener, h1);
+  valueData = results[2].GetValueEventData();
+  ASSERT_TRUE(valueData);
+  EXPECT_EQ(valueData->topic, topic2);
+  EXPECT_EQ(valueData->value, nt::Value::MakeDouble(2.0));
+  EXPECT_EQ(results[3].listener, h2);
+  valueData = results[3].GetValueEventData();
+  ASSERT_TRUE(valueData);
+  EXPECT_EQ(valueData->value, nt::Value::MakeDouble(3.0));
+
+  // a new value after the queue is read is delivered again
+  nt::SetDouble(pub1, 4);
+  ASSERT_TRUE(wpi::WaitForObject(poller, 1.0, &timedOut));
+  ASSERT_FALSE(timedOut);
+  results = nt::ReadListenerQueue(poller);
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0].listener, h1);
+  valueData = results[0].GetValueEventData();
+  ASSERT_TRUE(valueData);
+  EXPECT_EQ(valueData->value, nt::Value::MakeDouble(4.0));
+}
+
+TEST_F(ValueListenerTest, BatchListener) {
+  auto topic = nt::GetTopic(m_inst, "foo");
+  auto pub = nt::Publish(topic, NT_DOUBLE, "double");
+
+  std::vector<double> values;
+  int calls = 0;
+  auto h = nt::AddBatchListener(
+      m_inst, {{"foo"}}, nt::EventFlags::kValueLocal,
+      [&](std::span<const nt::Event> events) {
+        ++calls;
+        for (auto&& event : events) {
+          if (auto valueData = event.GetValueEventData()) {
+            values.push_back(valueData->value.GetDouble());
+          }
+        }
+      });
+  ASSERT_NE(h, 0u);
+
+  for (int i = 0; i < 100; ++i) {
+    nt::SetDouble(pub, i);
+  }
+  ASSERT_TRUE(nt::WaitForListenerQueue(m_inst, 1.0));
+
+  ASSERT_EQ(values.size(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+  EXPECT_GE(calls, 1);
+  EXPECT_LE(calls, 100);
+  nt::RemoveListener(h);
+}
+
 }  // namespace nt
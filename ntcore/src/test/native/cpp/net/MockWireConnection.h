@@ -22,6 +22,8 @@ class MockWireConnection : public WireConnection {
  public:
   MOCK_METHOD(unsigned int, GetVersion, (), (const, override));
 
+  bool HasDeltaArrays() const override { return deltaArrays; }
+
   MOCK_METHOD(void, SendPing, (uint64_t time), (override));
 
   MOCK_METHOD(bool, Ready, (), (const, override));
@@ -66,6 +68,8 @@ class MockWireConnection : public WireConnection {
   MOCK_METHOD(uint64_t, GetLastPingResponse, (), (const, override));
 
   MOCK_METHOD(void, Disconnect, (std::string_view reason), (override));
+
+  bool deltaArrays = false;
 };
 
 }  // namespace nt::net
@@ -0,0 +1,209 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/SpanMatcher.h>
+#include <wpi/raw_ostream.h>
+
+#include "../TestPrinters.h"
+#include "Handle.h"
+#include "MockWireConnection.h"
+#include "gmock/gmock.h"
+#include "net/Message.h"
+#include "net/NetworkOutgoingQueue.h"
+#include "net/WireEncoder.h"
+#include "networktables/NetworkTableValue.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+namespace nt {
+
+class NetworkOutgoingQueueTest : public ::testing::Test {
+ public:
+  NetworkOutgoingQueueTest() {
+    EXPECT_CALL(wire, Ready()).WillRepeatedly(Return(true));
+  }
+
+  static std::vector<uint8_t> Encode(NT_Handle handle, const Value& value) {
+    std::vector<uint8_t> out;
+    wpi::raw_uvector_ostream os{out};
+    net::WireEncodeBinary(os, Handle{handle}.GetIndex(), value.time(), value);
+    return out;
+  }
+
+  static std::vector<uint8_t> EncodeDelta(NT_Handle handle, const Value& value,
+                                          const Value& prev) {
+    std::vector<uint8_t> out;
+    wpi::raw_uvector_ostream os{out};
+    EXPECT_TRUE(net::WireEncodeBinaryDelta(os, Handle{handle}.GetIndex(),
+                                           value.time(), value, prev));
+    return out;
+  }
+
+  ::testing::StrictMock<net::MockWireConnection> wire;
+  net::NetworkOutgoingQueue<net::ServerMessage> queue{wire, false};
+  NT_Handle handle1 = Handle(0, 1, Handle::kTopic);
+  NT_Handle handle2 = Handle(0, 2, Handle::kTopic);
+};
+
+TEST_F(NetworkOutgoingQueueTest, PriorityOrder) {
+  queue.SetPeriod(handle1, 100, 0);
+  queue.SetPeriod(handle2, 100, 5);
+  auto value1 = Value::MakeDouble(1.0, 10);
+  auto value2 = Value::MakeDouble(2.0, 10);
+  queue.SendValue(handle1, value1, net::ValueSendMode::kNormal);
+  queue.SendValue(handle2, value2, net::ValueSendMode::kNormal);
+
+  {
+    ::testing::InSequence seq;
+    EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(Encode(handle2, value2))))
+        .WillOnce(Return(0));
+    EXPECT_CALL(wire, Flush()).WillOnce(Return(0));
+    EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(Encode(handle1, value1))))
+        .WillOnce(Return(0));
+    EXPECT_CALL(wire, Flush()).WillOnce(Return(0));
+  }
+  queue.SendOutgoing(100, false);
+
+  auto stats = queue.GetStats();
+  EXPECT_EQ(stats.msgsSent, 2u);
+  EXPECT_EQ(stats.deferred, 0u);
+  EXPECT_EQ(stats.queuedBytes, 0u);
+}
+
+TEST_F(NetworkOutgoingQueueTest, BandwidthLimit) {
+  // 1000 bytes/sec allows a 100 byte burst; each message is 46 bytes
+  queue.SetBandwidthLimit(1000);
+  std::vector<uint8_t> raw(40, 0);
+  for (int i = 0; i < 5; ++i) {
+    raw[0] = i;
+    queue.SendValue(handle1, Value::MakeRaw(raw, 10),
+                    net::ValueSendMode::kAll);
+  }
+
+  EXPECT_CALL(wire, DoWriteBinary(_)).Times(3).WillRepeatedly(Return(0));
+  EXPECT_CALL(wire, Flush()).WillOnce(Return(0));
+  queue.SendOutgoing(100, false);
+  ::testing::Mock::VerifyAndClearExpectations(&wire);
+  EXPECT_CALL(wire, Ready()).WillRepeatedly(Return(true));
+
+  auto stats = queue.GetStats();
+  EXPECT_EQ(stats.msgsSent, 3u);
+  EXPECT_EQ(stats.bytesSent, 138u);
+  EXPECT_EQ(stats.deferred, 1u);
+  EXPECT_NE(stats.queuedBytes, 0u);
+
+  // still over budget
+  queue.SendOutgoing(110, false);
+
+  // budget refilled
+  EXPECT_CALL(wire, DoWriteBinary(_)).Times(2).WillRepeatedly(Return(0));
+  EXPECT_CALL(wire, Flush()).WillOnce(Return(0));
+  queue.SendOutgoing(200, false);
+
+  stats = queue.GetStats();
+  EXPECT_EQ(stats.msgsSent, 5u);
+  EXPECT_EQ(stats.deferred, 1u);
+  EXPECT_EQ(stats.queuedBytes, 0u);
+}
+
+TEST_F(NetworkOutgoingQueueTest, LargeBandwidthLimit) {
+  // the burst budget (limit * 100 ms) does not fit in 32 bits
+  queue.SetBandwidthLimit(42949673);
+  std::vector<uint8_t> raw(40, 0);
+  for (int i = 0; i < 5; ++i) {
+    raw[0] = i;
+    queue.SendValue(handle1, Value::MakeRaw(raw, 10),
+                    net::ValueSendMode::kAll);
+  }
+
+  EXPECT_CALL(wire, DoWriteBinary(_)).Times(5).WillRepeatedly(Return(0));
+  EXPECT_CALL(wire, Flush()).WillOnce(Return(0));
+  queue.SendOutgoing(100, false);
+  ::testing::Mock::VerifyAndClearExpectations(&wire);
+  EXPECT_CALL(wire, Ready()).WillRepeatedly(Return(true));
+
+  // the refilled budget is capped at the same burst size
+  for (int i = 0; i < 5; ++i) {
+    raw[0] = i;
+    queue.SendValue(handle1, Value::MakeRaw(raw, 20),
+                    net::ValueSendMode::kAll);
+  }
+  EXPECT_CALL(wire, DoWriteBinary(_)).Times(5).WillRepeatedly(Return(0));
+  EXPECT_CALL(wire, Flush()).WillOnce(Return(0));
+  queue.SendOutgoing(200, false);
+
+  auto stats = queue.GetStats();
+  EXPECT_EQ(stats.msgsSent, 10u);
+  EXPECT_EQ(stats.deferred, 0u);
+  EXPECT_EQ(stats.queuedBytes, 0u);
+}
+
+TEST_F(NetworkOutgoingQueueTest, DeltaArrays) {
+  wire.deltaArrays = true;
+  auto value1 = Value::MakeDoubleArray({1, 2, 3, 4}, 10);
+  auto value2 = Value::MakeDoubleArray({1, 2, 5, 4}, 20);
+  auto delta2 = EncodeDelta(handle1, value2, value1);
+  ASSERT_LT(delta2.size(), Encode(handle1, value2).size());
+
+  // the first value has no reference, so it is sent in full
+  queue.SendValue(handle1, value1, net::ValueSendMode::kNormal);
+  EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(Encode(handle1, value1))))
+      .WillOnce(Return(0));
+  EXPECT_CALL(wire, Flush()).WillOnce(Return(0));
+  queue.SendOutgoing(100, false);
+
+  queue.SendValue(handle1, value2, net::ValueSendMode::kNormal);
+  EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(delta2))).WillOnce(Return(0));
+  EXPECT_CALL(wire, Flush()).WillOnce(Return(0));
+  queue.SendOutgoing(200, false);
+
+  auto stats = queue.GetStats();
+  EXPECT_EQ(stats.msgsSent, 2u);
+  EXPECT_EQ(stats.bytesSent, Encode(handle1, value1).size() + delta2.size());
+}
+
+TEST_F(NetworkOutgoingQueueTest, DeltaArraysUnsentRollback) {
+  wire.deltaArrays = true;
+  queue.SetBandwidthLimit(1000);
+  auto value1 = Value::MakeDoubleArray({1, 2, 3, 4}, 10);
+  auto value2 = Value::MakeDoubleArray({1, 2, 5, 4}, 20);
+  auto delta2 = EncodeDelta(handle1, value2, value1);
+
+  queue.SendValue(handle1, value1, net::ValueSendMode::kNormal);
+  EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(Encode(handle1, value1))))
+      .WillOnce(Return(0));
+  EXPECT_CALL(wire, Flush()).WillOnce(Return(0));
+  queue.SendOutgoing(100, false);
+  ::testing::Mock::VerifyAndClearExpectations(&wire);
+  EXPECT_CALL(wire, Ready()).WillRepeatedly(Return(true));
+
+  // the connection doesn't send the delta, so the remote end never sees
+  // value2; it must not become the reference for the retry
+  queue.SendValue(handle1, value2, net::ValueSendMode::kNormal);
+  EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(delta2))).WillOnce(Return(1));
+  queue.SendOutgoing(200, false);
+  ::testing::Mock::VerifyAndClearExpectations(&wire);
+  EXPECT_CALL(wire, Ready()).WillRepeatedly(Return(true));
+
+  auto stats = queue.GetStats();
+  EXPECT_EQ(stats.msgsSent, 1u);
+  EXPECT_NE(stats.queuedBytes, 0u);
+
+  // the retry is still a delta against value1, not an empty delta
+  EXPECT_CALL(wire, DoWriteBinary(wpi::SpanEq(delta2))).WillOnce(Return(0));
+  EXPECT_CALL(wire, Flush()).WillOnce(Return(0));
+  queue.SendOutgoing(300, false);
+
+  stats = queue.GetStats();
+  EXPECT_EQ(stats.msgsSent, 2u);
+  EXPECT_EQ(stats.queuedBytes, 0u);
+}
+
+}  // namespace nt
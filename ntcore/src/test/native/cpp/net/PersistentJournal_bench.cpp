@@ -0,0 +1,93 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <chrono>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "../MockLogger.h"
+#include "Handle.h"
+#include "net/Message.h"
+#include "net/ServerImpl.h"
+#include "networktables/NetworkTableValue.h"
+
+namespace nt {
+
+static std::span<const uint8_t> AsBytes(std::string_view str) {
+  return {reinterpret_cast<const uint8_t*>(str.data()), str.size()};
+}
+
+static void PublishPersistent(net::ServerImpl& server, int index,
+                              std::string_view name, const Value& value) {
+  NT_Publisher pubHandle = nt::Handle{0, index, nt::Handle::kPublisher};
+  NT_Topic topicHandle = nt::Handle{0, index, nt::Handle::kTopic};
+  std::vector<net::ClientMessage> msgs;
+  msgs.emplace_back(net::ClientMessage{
+      net::PublishMsg{pubHandle, topicHandle, std::string{name}, "double",
+                      {{"persistent", true}}, {}}});
+  msgs.emplace_back(net::ClientMessage{net::ClientValueMsg{pubHandle, value}});
+  server.HandleLocal(msgs);
+}
+
+TEST(PersistentJournalBenchmark, DumpAndLoad) {
+  wpi::MockLogger logger;
+  net::ServerImpl server{logger};
+  using clock = std::chrono::steady_clock;
+  constexpr int kNumTopics = 10000;
+  EXPECT_EQ(server.LoadPersistentJournal({}), "");
+  for (int i = 0; i < kNumTopics; ++i) {
+    PublishPersistent(server, i + 1, fmt::format("/persistent/topic{}", i),
+                      Value::MakeDouble(i, 10));
+  }
+
+  auto start = clock::now();
+  auto json = server.DumpPersistent();
+  auto jsonDumpTime = clock::now() - start;
+
+  start = clock::now();
+  auto journal = server.DumpPersistentJournal(true);
+  auto journalDumpTime = clock::now() - start;
+
+  {
+    std::vector<net::ClientMessage> msgs;
+    msgs.emplace_back(net::ClientMessage{net::ClientValueMsg{
+        nt::Handle{0, 1, nt::Handle::kPublisher}, Value::MakeDouble(-1, 20)}});
+    server.HandleLocal(msgs);
+  }
+  start = clock::now();
+  auto append = server.DumpPersistentJournal(false);
+  auto appendTime = clock::now() - start;
+
+  wpi::MockLogger logger2;
+  net::ServerImpl server2{logger2};
+  start = clock::now();
+  EXPECT_EQ(server2.LoadPersistent(json), "");
+  auto jsonLoadTime = clock::now() - start;
+
+  wpi::MockLogger logger3;
+  net::ServerImpl server3{logger3};
+  start = clock::now();
+  EXPECT_EQ(server3.LoadPersistentJournal(AsBytes(journal)), "");
+  auto journalLoadTime = clock::now() - start;
+
+  using us = std::chrono::microseconds;
+  fmt::print("{} topics: JSON {} bytes, dump {} us, load {} us\n", kNumTopics,
+             json.size(), std::chrono::duration_cast<us>(jsonDumpTime).count(),
+             std::chrono::duration_cast<us>(jsonLoadTime).count());
+  fmt::print("journal {} bytes, dump {} us, load {} us\n", journal.size(),
+             std::chrono::duration_cast<us>(journalDumpTime).count(),
+             std::chrono::duration_cast<us>(journalLoadTime).count());
+  fmt::print("single change: append {} bytes, {} us\n", append.size(),
+             std::chrono::duration_cast<us>(appendTime).count());
+  EXPECT_LT(append.size(), 100u);
+}
+
+}  // namespace nt
@@ -9,6 +9,7 @@
 #include <string_view>
 #include <vector>
 
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 #include <wpi/SpanMatcher.h>
 
@@ -21,6 +22,7 @@
 #include "MockWireConnection.h"
 #include "gmock/gmock.h"
 #include "net/Message.h"
+#include "net/PersistentJournal.h"
 #include "net/ServerImpl.h"
 #include "net/WireEncoder.h"
 #include "ntcore_c.h"
@@ -190,13 +192,13 @@ TEST_F(ServerImplTest, PublishLocal) {
         .WillOnce(Return(0));
     EXPECT_CALL(
         wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
-                  "test2", 8, "double", std::nullopt, wpi::json::object()}}))))
+                  "test2", 9, "double", std::nullopt, wpi::json::object()}}))))
         .WillOnce(Return(0));
     EXPECT_CALL(wire, Flush()).WillOnce(Return(0));     // SendControl()
     EXPECT_CALL(wire, Ready()).WillOnce(Return(true));  // SendControl()
     EXPECT_CALL(
         wire, DoWriteText(StrEq(EncodeText1(net::ServerMessage{net::AnnounceMsg{
-                  "test3", 11, "double", std::nullopt, wpi::json::object()}}))))
+                  "test3", 12, "double", std::nullopt, wpi::json::object()}}))))
         .WillOnce(Return(0));
     EXPECT_CALL(wire, Flush()).WillOnce(Return(0));  // SendControl()
   }
@@ -361,4 +363,133 @@ TEST_F(ServerImplTest, ZeroTimestampNegativeTime) {
   }
 }
 
+static std::span<const uint8_t> AsBytes(std::string_view str) {
+  return {reinterpret_cast<const uint8_t*>(str.data()), str.size()};
+}
+
+static void PublishPersistent(net::ServerImpl& server, int index,
+                              std::string_view name, const Value& value) {
+  NT_Publisher pubHandle = nt::Handle{0, index, nt::Handle::kPublisher};
+  NT_Topic topicHandle = nt::Handle{0, index, nt::Handle::kTopic};
+  std::vector<net::ClientMessage> msgs;
+  msgs.emplace_back(net::ClientMessage{
+      net::PublishMsg{pubHandle, topicHandle, std::string{name}, "double",
+                      {{"persistent", true}}, {}}});
+  msgs.emplace_back(net::ClientMessage{net::ClientValueMsg{pubHandle, value}});
+  server.HandleLocal(msgs);
+}
+
+TEST_F(ServerImplTest, ClientQueueOnlyOnChange) {
+  server.SetLocal(&local);
+  NT_Subscriber subHandle = nt::Handle{0, 1, nt::Handle::kSubscriber};
+  NT_Topic queueHandle = nt::Handle{0, 1, nt::Handle::kTopic};
+  EXPECT_CALL(local, NetworkAnnounce(_, _, _, _)).WillRepeatedly(Return(0));
+  EXPECT_CALL(local, NetworkAnnounce(std::string_view{"$clientqueue$test@1"},
+                                     _, _, _))
+      .WillOnce(Return(queueHandle));
+  {
+    std::vector<net::ClientMessage> msgs;
+    msgs.emplace_back(net::ClientMessage{net::SubscribeMsg{
+        subHandle, {{"$clientqueue$"}}, PubSubOptions{.prefixMatch = true}}});
+    server.HandleLocal(msgs);
+  }
+
+  ::testing::NiceMock<net::MockWireConnection> wire;
+  ON_CALL(wire, GetVersion()).WillByDefault(Return(0x0400));
+  MockSetPeriodicFunc setPeriodic;
+  server.AddClient("test", "connInfo", false, wire,
+                   setPeriodic.AsStdFunction());
+
+  // an idle client's queue stats only get published once
+  EXPECT_CALL(local, NetworkSetValue(queueHandle, _)).Times(1);
+  server.SendAllOutgoing(100, false);
+  server.SendAllOutgoing(1200, false);
+  server.SendAllOutgoing(2300, false);
+  ::testing::Mock::VerifyAndClearExpectations(&local);
+
+  // and again when they change
+  server.SetBandwidthLimit(1000);
+  EXPECT_CALL(local, NetworkSetValue(queueHandle, _)).Times(1);
+  server.SendAllOutgoing(3400, false);
+  server.SendAllOutgoing(4500, false);
+}
+
+TEST_F(ServerImplTest, PersistentJournalRoundTrip) {
+  EXPECT_EQ(server.LoadPersistentJournal({}), "");
+  PublishPersistent(server, 1, "a", Value::MakeDouble(1.0, 10));
+  PublishPersistent(server, 2, "b", Value::MakeDouble(2.0, 10));
+  auto journal = server.DumpPersistentJournal(true);
+  EXPECT_TRUE(net::IsPersistentJournal(AsBytes(journal)));
+
+  wpi::MockLogger logger2;
+  net::ServerImpl server2{logger2};
+  EXPECT_EQ(server2.LoadPersistentJournal(AsBytes(journal)), "");
+  EXPECT_EQ(server2.DumpPersistent(), server.DumpPersistent());
+  EXPECT_FALSE(server2.PersistentChanged());
+}
+
+TEST_F(ServerImplTest, PersistentJournalAppend) {
+  EXPECT_EQ(server.LoadPersistentJournal({}), "");
+  PublishPersistent(server, 1, "a", Value::MakeDouble(1.0, 10));
+  PublishPersistent(server, 2, "b", Value::MakeDouble(2.0, 10));
+  auto journal = server.DumpPersistentJournal(true);
+  // nothing changed since the full dump
+  EXPECT_EQ(server.DumpPersistentJournal(false), "");
+
+  // change one value; only that topic is appended
+  {
+    std::vector<net::ClientMessage> msgs;
+    msgs.emplace_back(net::ClientMessage{net::ClientValueMsg{
+        nt::Handle{0, 2, nt::Handle::kPublisher}, Value::MakeDouble(3.0, 20)}});
+    server.HandleLocal(msgs);
+  }
+  auto append = server.DumpPersistentJournal(false);
+  std::vector<std::string> names;
+  std::string error;
+  EXPECT_TRUE(net::ReadPersistentJournal(
+      AsBytes(fmt::format("{}{}", net::kPersistentJournalHeader, append)),
+      [&](net::PersistentJournalRecord&& record) {
+        names.emplace_back(record.name);
+        EXPECT_EQ(record.value, Value::MakeDouble(3.0, 20));
+      },
+      &error));
+  EXPECT_THAT(names, ElementsAre("b"));
+
+  // make the other one non-persistent; a removal record is appended
+  {
+    std::vector<net::ClientMessage> msgs;
+    msgs.emplace_back(net::ClientMessage{net::SetPropertiesMsg{
+        nt::Handle{0, 1, nt::Handle::kTopic}, "a", {{"persistent", false}}}});
+    server.HandleLocal(msgs);
+  }
+  append += server.DumpPersistentJournal(false);
+
+  wpi::MockLogger logger2;
+  net::ServerImpl server2{logger2};
+  EXPECT_EQ(server2.LoadPersistentJournal(AsBytes(journal + append)), "");
+  EXPECT_EQ(server2.DumpPersistent(), server.DumpPersistent());
+}
+
+TEST_F(ServerImplTest, PersistentJournalTruncated) {
+  EXPECT_EQ(server.LoadPersistentJournal({}), "");
+  PublishPersistent(server, 1, "a", Value::MakeDouble(1.0, 10));
+  PublishPersistent(server, 2, "b", Value::MakeDouble(2.0, 10));
+  auto journal = server.DumpPersistentJournal(true);
+  journal.resize(journal.size() - 1);
+
+  // records prior to the truncation are still loaded
+  wpi::MockLogger logger2;
+  net::ServerImpl server2{logger2};
+  EXPECT_NE(server2.LoadPersistentJournal(AsBytes(journal)), "");
+  std::vector<std::string> names;
+  std::string error;
+  EXPECT_TRUE(net::ReadPersistentJournal(
+      AsBytes(server2.DumpPersistentJournal(true)),
+      [&](net::PersistentJournalRecord&& record) {
+        names.emplace_back(record.name);
+      },
+      &error));
+  EXPECT_THAT(names, ElementsAre("a"));
+}
+
 }  // namespace nt
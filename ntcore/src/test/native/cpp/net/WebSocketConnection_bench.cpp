@@ -0,0 +1,118 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <memory>
+#include <span>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+#include <wpi/raw_ostream.h>
+#include <wpinet/WebSocket.h>
+#include <wpinet/WebSocketServer.h>
+#include <wpinet/uv/BufferPool.h>
+#include <wpinet/uv/Idle.h>
+#include <wpinet/uv/Loop.h>
+#include <wpinet/uv/Tcp.h>
+#include <wpinet/uv/Timer.h>
+
+#include "net/WebSocketConnection.h"
+
+namespace {
+// A typical MessagePack value update
+constexpr size_t kMessageSize = 16;
+constexpr int kMessages = 200000;
+// Messages written per outgoing queue pass
+constexpr int kBatch = 100;
+constexpr unsigned int kPort = 10050;
+}  // namespace
+
+// Server to client value updates, as sent for dashboards and loggers
+TEST(WebSocketConnectionBenchmark, ServerSend) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  auto loop = wpi::uv::Loop::Create();
+  auto serverTcp = wpi::uv::Tcp::Create(loop);
+  auto clientTcp = wpi::uv::Tcp::Create(loop);
+  auto idle = wpi::uv::Idle::Create(loop);
+
+  auto failTimer = wpi::uv::Timer::Create(loop);
+  failTimer->timeout.connect([&] {
+    loop->Stop();
+    FAIL() << "loop failed to terminate";
+  });
+  failTimer->Start(wpi::uv::Timer::Time{10000});
+  failTimer->Unreference();
+
+  const uint8_t payload[kMessageSize] = {0x94, 0x01, 0xd3, 0x00, 0x00, 0x00,
+                                         0x00, 0x00, 0x01, 0x02, 0x03, 0x01,
+                                         0xcb, 0x3f, 0xf0, 0x00};
+  std::shared_ptr<nt::net::WebSocketConnection> wire;
+  int sent = 0;
+  size_t received = 0;
+  auto start = high_resolution_clock::now();
+  auto end = start;
+  auto startStats = wpi::uv::BufferPool::GetStats();
+  auto endStats = startStats;
+
+  serverTcp->Bind("127.0.0.1", kPort);
+  serverTcp->Listen([&] {
+    auto conn = serverTcp->Accept();
+    auto server = wpi::WebSocketServer::Create(*conn);
+    server->connected.connect([&](std::string_view, wpi::WebSocket& ws) {
+      wire = std::make_shared<nt::net::WebSocketConnection>(ws, 0x0401);
+      start = high_resolution_clock::now();
+      startStats = wpi::uv::BufferPool::GetStats();
+      idle->Start();
+    });
+  });
+
+  // like the server outgoing queue, write a batch whenever the last is done
+  idle->idle.connect([&] {
+    if (!wire || !wire->Ready()) {
+      return;
+    }
+    int unsent = 0;
+    for (int i = 0; i < kBatch && sent < kMessages && unsent == 0; ++i) {
+      unsent = wire->WriteBinary(
+          [&](auto& os) { os.write(payload, kMessageSize); });
+      ++sent;
+    }
+    if (unsent == 0) {
+      unsent = wire->Flush();
+    }
+    if (unsent > 0) {
+      sent -= unsent;
+    }
+    if (sent >= kMessages) {
+      idle->Stop();
+    }
+  });
+
+  clientTcp->Connect("127.0.0.1", kPort, [&] {
+    auto ws = wpi::WebSocket::CreateClient(*clientTcp, "/", "127.0.0.1");
+    ws->binary.connect([&](std::span<const uint8_t> data, bool) {
+      received += data.size();
+      if (received >= kMessages * kMessageSize) {
+        end = high_resolution_clock::now();
+        endStats = wpi::uv::BufferPool::GetStats();
+        wire.reset();
+        loop->Walk([](wpi::uv::Handle& it) { it.Close(); });
+      }
+    });
+  });
+
+  loop->Run();
+
+  auto time = duration_cast<microseconds>(end - start);
+  fmt::print(
+      "WebSocketConnection send {} messages: {} us ({:.0f} messages/s), {} "
+      "buffer allocations, {} from heap\n",
+      received / kMessageSize, time.count(),
+      received / kMessageSize * 1e6 / time.count(),
+      endStats.allocations - startStats.allocations,
+      endStats.heapAllocations - startStats.heapAllocations);
+}
@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 #include <wpi/SmallString.h>
+#include <wpi/SpanMatcher.h>
 #include <wpi/raw_ostream.h>
 
 #include "../MockLogger.h"
@@ -211,4 +212,60 @@ TEST_F(WireDecodeTextClientTest, UnpublishError) {
       logger);
 }
 
+class WireDecodeBinaryDeltaTest : public ::testing::Test {
+ protected:
+  net::WireDeltaState deltaState;
+  int64_t id;
+  Value value;
+  std::string error;
+};
+
+TEST_F(WireDecodeBinaryDeltaTest, DoubleArray) {
+  deltaState[5] = Value::MakeDoubleArray({1, 2, 5, 4});
+  std::span<const uint8_t> in = "\x94\x05\x06\x31\x92\x02"
+                                "\xcb\x40\x08\x00\x00\x00\x00\x00\x00"_us;
+  ASSERT_TRUE(
+      net::WireDecodeBinary(&in, &id, &value, &error, 0, &deltaState));
+  EXPECT_TRUE(in.empty());
+  EXPECT_EQ(id, 5);
+  EXPECT_EQ(value, Value::MakeDoubleArray({1, 2, 3, 4}));
+  EXPECT_EQ(value.server_time(), 6);
+  EXPECT_EQ(deltaState[5], Value::MakeDoubleArray({1, 2, 3, 4}));
+}
+
+TEST_F(WireDecodeBinaryDeltaTest, FullArrayUpdatesReference) {
+  std::span<const uint8_t> in = "\x94\x05\x06\x10\x92\xc3\xc2"_us;
+  ASSERT_TRUE(
+      net::WireDecodeBinary(&in, &id, &value, &error, 0, &deltaState));
+  EXPECT_EQ(deltaState[5], Value::MakeBooleanArray({1, 0}));
+
+  // non-array value removes the reference
+  in = "\x94\x05\x06\x00\xc3"_us;
+  ASSERT_TRUE(
+      net::WireDecodeBinary(&in, &id, &value, &error, 0, &deltaState));
+  EXPECT_EQ(deltaState.count(5), 0u);
+}
+
+TEST_F(WireDecodeBinaryDeltaTest, Errors) {
+  std::span<const uint8_t> in = "\x94\x05\x06\x31\x92\x02\xcb"
+                                "\x40\x08\x00\x00\x00\x00\x00\x00"_us;
+  // not negotiated
+  EXPECT_FALSE(net::WireDecodeBinary(&in, &id, &value, &error, 0));
+  EXPECT_EQ(error, "unrecognized type 49");
+
+  // no reference
+  EXPECT_FALSE(
+      net::WireDecodeBinary(&in, &id, &value, &error, 0, &deltaState));
+
+  // wrong reference type
+  deltaState[5] = Value::MakeIntegerArray({1, 2, 5, 4});
+  EXPECT_FALSE(
+      net::WireDecodeBinary(&in, &id, &value, &error, 0, &deltaState));
+
+  // index out of range
+  deltaState[5] = Value::MakeDoubleArray({1, 2});
+  EXPECT_FALSE(
+      net::WireDecodeBinary(&in, &id, &value, &error, 0, &deltaState));
+}
+
 }  // namespace nt
@@ -291,4 +291,39 @@ TEST_F(WireEncoderBinaryTest, StringArray) {
                                "bye"_us));
 }
 
+TEST_F(WireEncoderBinaryTest, DoubleArrayDelta) {
+  ASSERT_TRUE(net::WireEncodeBinaryDelta(os, 5, 6,
+                                         Value::MakeDoubleArray({1, 2, 3, 4}),
+                                         Value::MakeDoubleArray({1, 2, 5, 4})));
+  ASSERT_THAT(out, wpi::SpanEq("\x94\x05\x06\x31\x92\x02"
+                               "\xcb\x40\x08\x00\x00\x00\x00\x00\x00"_us));
+}
+
+TEST_F(WireEncoderBinaryTest, BooleanArrayDeltaUnchanged) {
+  ASSERT_TRUE(net::WireEncodeBinaryDelta(os, 5, 6,
+                                         Value::MakeBooleanArray({1, 0}),
+                                         Value::MakeBooleanArray({1, 0})));
+  ASSERT_THAT(out, wpi::SpanEq("\x94\x05\x06\x30\x90"_us));
+}
+
+TEST_F(WireEncoderBinaryTest, DeltaNotApplicable) {
+  // too many changes
+  EXPECT_FALSE(net::WireEncodeBinaryDelta(os, 5, 6,
+                                          Value::MakeIntegerArray({1, 2, 3}),
+                                          Value::MakeIntegerArray({4, 5, 3})));
+  // different length
+  EXPECT_FALSE(net::WireEncodeBinaryDelta(os, 5, 6,
+                                          Value::MakeIntegerArray({1, 2, 3}),
+                                          Value::MakeIntegerArray({1, 2})));
+  // different type
+  EXPECT_FALSE(net::WireEncodeBinaryDelta(os, 5, 6,
+                                          Value::MakeIntegerArray({1, 2}),
+                                          Value::MakeFloatArray({1, 2})));
+  // not a delta array type
+  EXPECT_FALSE(net::WireEncodeBinaryDelta(os, 5, 6,
+                                          Value::MakeStringArray({"a", "b"}),
+                                          Value::MakeStringArray({"a", "c"})));
+  ASSERT_TRUE(out.empty());
+}
+
 }  // namespace nt
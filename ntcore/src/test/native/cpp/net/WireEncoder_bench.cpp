@@ -0,0 +1,63 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <wpi/raw_ostream.h>
+
+#include "net/WireEncoder.h"
+#include "networktables/NetworkTableValue.h"
+
+namespace nt {
+
+TEST(WireEncoderBenchmark, DeltaBandwidth) {
+  std::vector<uint8_t> out;
+  wpi::raw_uvector_ostream os{out};
+  // typical robot telemetry: swerve module states (moving half the time),
+  // a vision target corner array (occasionally updated), and a block of
+  // status flags (rarely changing)
+  std::vector<double> modules(8, 0.0);
+  std::vector<double> corners(32, 0.0);
+  std::vector<int> flags(16, 0);
+  Value prevModules, prevCorners, prevFlags;
+  size_t fullBytes = 0;
+  size_t deltaBytes = 0;
+  auto send = [&](const Value& value, Value& prev) {
+    out.clear();
+    net::WireEncodeBinary(os, 1, 1000, value);
+    fullBytes += out.size();
+    out.clear();
+    if (!prev.IsValid() ||
+        !net::WireEncodeBinaryDelta(os, 1, 1000, value, prev)) {
+      net::WireEncodeBinary(os, 1, 1000, value);
+    }
+    deltaBytes += out.size();
+    prev = value;
+  };
+  for (int i = 0; i < 1000; ++i) {
+    if ((i / 100) % 2 == 0) {
+      for (auto& m : modules) {
+        m += 0.01;
+      }
+    }
+    if (i % 10 == 0) {
+      corners[(i / 10) % corners.size()] = i;
+    }
+    if (i % 50 == 0) {
+      flags[(i / 50) % flags.size()] ^= 1;
+    }
+    send(Value::MakeDoubleArray(modules), prevModules);
+    send(Value::MakeDoubleArray(corners), prevCorners);
+    send(Value::MakeBooleanArray(flags), prevFlags);
+  }
+  fmt::print("full: {} bytes, delta: {} bytes ({:.1f}%)\n", fullBytes,
+             deltaBytes, 100.0 * deltaBytes / fullBytes);
+  ASSERT_LT(deltaBytes, fullBytes / 2);
+}
+
+}  // namespace nt
@@ -71,7 +71,7 @@ public class MerweScaledSigmaPoints<S extends Num> {
    * of the filter.
    *
    * @param x An array of the means.
-   * @param s Square-root covariance of the filter.
+   * @param s Square-root covariance of the filter. S is upper triangular such that P = SᵀS.
    * @return Two-dimensional array of sigma points. Each column contains all the sigmas for one
    *     dimension in the problem space. Ordered by Xi_0, Xi_{1..n}, Xi_{n+1..2n}.
    */
@@ -79,7 +79,8 @@ public class MerweScaledSigmaPoints<S extends Num> {
     double lambda = Math.pow(m_alpha, 2) * (m_states.getNum() + m_kappa) - m_states.getNum();
     double eta = Math.sqrt(lambda + m_states.getNum());
 
-    Matrix<S, S> U = s.times(eta);
+    // The sigma points are spread along the columns of Sᵀ, since P = SᵀS
+    Matrix<S, S> U = s.transpose().times(eta);
 
     // 2 * states + 1 by states
     Matrix<S, ?> sigmas =
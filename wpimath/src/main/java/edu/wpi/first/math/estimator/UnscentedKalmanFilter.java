@@ -14,6 +14,7 @@ import edu.wpi.first.math.system.Discretization;
 import edu.wpi.first.math.system.NumericalIntegration;
 import edu.wpi.first.math.system.NumericalJacobian;
 import java.util.function.BiFunction;
+import org.ejml.dense.row.decomposition.TriangularSolver_DDRM;
 import org.ejml.dense.row.decomposition.qr.QRDecompositionHouseholder_DDRM;
 import org.ejml.simple.SimpleMatrix;
 
@@ -218,6 +219,8 @@ public class UnscentedKalmanFilter<States extends Num, Inputs extends Num, Outpu
   /**
    * Returns the square-root error covariance matrix S.
    *
+   * <p>S is upper triangular such that P = SᵀS.
+   *
    * @return the square-root error covariance matrix S.
    */
   public Matrix<States, States> getS() {
@@ -238,7 +241,7 @@ public class UnscentedKalmanFilter<States extends Num, Inputs extends Num, Outpu
   /**
    * Sets the entire square-root error covariance matrix S.
    *
-   * @param newS The new value of S to use.
+   * @param newS The new value of S to use. It must be upper triangular such that P = SᵀS.
    */
   public void setS(Matrix<States, States> newS) {
     m_S = newS;
@@ -466,25 +469,40 @@ public class UnscentedKalmanFilter<States extends Num, Inputs extends Num, Outpu
     // Compute cross covariance of the state and the measurements
     Matrix<States, R> Pxy = new Matrix<>(m_states, rows);
     for (int i = 0; i < m_pts.getNumSigmas(); i++) {
-      // Pxy += (sigmas_f[:, i] - x̂)(sigmas_h[:, i] - ŷ)ᵀ W_c[i]
-      var dx = residualFuncX.apply(m_sigmasF.extractColumnVector(i), m_xHat);
+      // Pxy += (sigmas[:, i] - x̂)(sigmas_h[:, i] - ŷ)ᵀ W_c[i]
+      var dx = residualFuncX.apply(sigmas.extractColumnVector(i), m_xHat);
       var dy = residualFuncY.apply(sigmasH.extractColumnVector(i), yHat).transpose();
 
       Pxy = Pxy.plus(dx.times(dy).times(m_pts.getWc(i)));
     }
 
-    // K = (P_{xy} / S_yᵀ) / S_y
-    // K = (S_y \ P_{xy}ᵀ)ᵀ / S_y
-    // K = (S_yᵀ \ (S_y \ P_{xy}ᵀ))ᵀ
-    Matrix<States, R> K =
-        Sy.transpose()
-            .solveFullPivHouseholderQr(Sy.solveFullPivHouseholderQr(Pxy.transpose()))
-            .transpose();
+    // S_y is upper triangular with P_y = S_yᵀS_y, so the gain only needs two
+    // triangular solves.
+    //
+    // K = P_{xy} P_y⁻¹
+    // Kᵀ = (S_yᵀS_y)⁻¹ P_{xy}ᵀ
+    // Kᵀ = S_y \ (S_yᵀ \ P_{xy}ᵀ)
+    final double[] SyT = Sy.transpose().getData();
+    Matrix<R, States> Kt = Pxy.transpose();
+    final double[] col = new double[rows.getNum()];
+    for (int j = 0; j < m_states.getNum(); j++) {
+      for (int i = 0; i < rows.getNum(); i++) {
+        col[i] = Kt.get(i, j);
+      }
+      TriangularSolver_DDRM.solveL(SyT, col, rows.getNum());
+      TriangularSolver_DDRM.solveTranL(SyT, col, rows.getNum());
+      for (int i = 0; i < rows.getNum(); i++) {
+        Kt.set(i, j, col[i]);
+      }
+    }
+    Matrix<States, R> K = Kt.transpose();
 
     // x̂ₖ₊₁⁺ = x̂ₖ₊₁⁻ + K(y − ŷ)
     m_xHat = addFuncX.apply(m_xHat, K.times(residualFuncY.apply(y, yHat)));
 
-    Matrix<States, R> U = K.times(Sy);
+    // P⁺ = P⁻ − KP_yKᵀ = SᵀS − UUᵀ where U = KS_yᵀ, so downdate S by each
+    // column of U
+    Matrix<States, R> U = K.times(Sy.transpose());
     for (int i = 0; i < rows.getNum(); i++) {
       m_S.rankUpdate(U.extractColumnVector(i), -1, false);
     }
@@ -81,13 +81,23 @@ LTVDifferentialDriveController::LTVDifferentialDriveController(
 
   auto R_llt = R.llt();
 
-  for (auto velocity = -maxV; velocity < maxV; velocity += 0.01_mps) {
+  // Negating the velocity is the same as mirroring the y axis. If T negates
+  // the y state, A(−v) = TA(v)T, B = TB, and Q = TQT, so S(−v) = TS(v)T and
+  // K(−v) = K(v)T. The gains for negative velocities are mirrored from the
+  // gains for positive velocities, which halves the number of DARE solves.
+  constexpr double kVelocityStep = 0.01;
+  int gridPoints = static_cast<int>(std::ceil(maxV.value() / kVelocityStep));
+  m_table = GainTable<5, 2>{-gridPoints * kVelocityStep,
+                             gridPoints * kVelocityStep,
+                             static_cast<size_t>(2 * gridPoints + 1)};
+
+  for (int i = 0; i <= gridPoints; ++i) {
     // The DARE is ill-conditioned if the velocity is close to zero, so don't
     // let the system stop.
-    if (units::math::abs(velocity) < 1e-4_mps) {
+    if (i == 0) {
       A(State::kY, State::kHeading) = 1e-4;
     } else {
-      A(State::kY, State::kHeading) = velocity.value();
+      A(State::kY, State::kHeading) = i * kVelocityStep;
     }
 
     Matrixd<5, 5> discA;
@@ -97,9 +107,14 @@ LTVDifferentialDriveController::LTVDifferentialDriveController(
     Matrixd<5, 5> S = detail::DARE<5, 2>(discA, discB, Q, R_llt);
 
     // K = (BᵀSB + R)⁻¹BᵀSA
-    m_table.insert(velocity, (discB.transpose() * S * discB + R)
-                                 .llt()
-                                 .solve(discB.transpose() * S * discA));
+    Matrixd<2, 5> K = (discB.transpose() * S * discB + R)
+                          .llt()
+                          .solve(discB.transpose() * S * discA);
+
+    Matrixd<2, 5> mirroredK = K;
+    mirroredK.col(State::kY) *= -1.0;
+    m_table.Set(gridPoints - i, mirroredK);
+    m_table.Set(gridPoints + i, K);
   }
 }
 
@@ -146,7 +161,7 @@ DifferentialDriveWheelVoltages LTVDifferentialDriveController::Calculate(
       frc::AngleModulus(units::radian_t{m_error(State::kHeading)}).value();
 
   units::meters_per_second_t velocity{(leftVelocity + rightVelocity) / 2.0};
-  const auto& K = m_table[velocity];
+  Matrixd<2, 5> K = m_table(velocity.value());
 
   Vectord<2> u = K * inRobotFrame * m_error;
 
@@ -4,6 +4,7 @@
 
 #include "frc/controller/LTVUnicycleController.h"
 
+#include <cmath>
 #include <stdexcept>
 
 #include <Eigen/Cholesky>
@@ -88,14 +89,24 @@ LTVUnicycleController::LTVUnicycleController(
 
   auto R_llt = R.llt();
 
-  for (auto velocity = -maxVelocity; velocity < maxVelocity;
-       velocity += 0.01_mps) {
+  // Negating the velocity is the same as mirroring the y axis. If T negates
+  // the y state, A(−v) = TA(v)T, B = TB, and Q = TQT, so S(−v) = TS(v)T and
+  // K(−v) = K(v)T. The gains for negative velocities are mirrored from the
+  // gains for positive velocities, which halves the number of DARE solves.
+  constexpr double kVelocityStep = 0.01;
+  int gridPoints =
+      static_cast<int>(std::ceil(maxVelocity.value() / kVelocityStep));
+  m_table = GainTable<3, 2>{-gridPoints * kVelocityStep,
+                             gridPoints * kVelocityStep,
+                             static_cast<size_t>(2 * gridPoints + 1)};
+
+  for (int i = 0; i <= gridPoints; ++i) {
     // The DARE is ill-conditioned if the velocity is close to zero, so don't
     // let the system stop.
-    if (units::math::abs(velocity) < 1e-4_mps) {
+    if (i == 0) {
       A(State::kY, State::kHeading) = 1e-4;
     } else {
-      A(State::kY, State::kHeading) = velocity.value();
+      A(State::kY, State::kHeading) = i * kVelocityStep;
     }
 
     Matrixd<3, 3> discA;
@@ -105,9 +116,14 @@ LTVUnicycleController::LTVUnicycleController(
     Matrixd<3, 3> S = detail::DARE<3, 2>(discA, discB, Q, R_llt);
 
     // K = (BᵀSB + R)⁻¹BᵀSA
-    m_table.insert(velocity, (discB.transpose() * S * discB + R)
-                                 .llt()
-                                 .solve(discB.transpose() * S * discA));
+    Matrixd<2, 3> K = (discB.transpose() * S * discB + R)
+                          .llt()
+                          .solve(discB.transpose() * S * discA);
+
+    Matrixd<2, 3> mirroredK = K;
+    mirroredK.col(State::kY) *= -1.0;
+    m_table.Set(gridPoints - i, mirroredK);
+    m_table.Set(gridPoints + i, K);
   }
 }
 
@@ -135,7 +151,7 @@ ChassisSpeeds LTVUnicycleController::Calculate(
 
   m_poseError = poseRef.RelativeTo(currentPose);
 
-  const auto& K = m_table[linearVelocityRef];
+  Matrixd<2, 3> K = m_table(linearVelocityRef.value());
   Vectord<3> e{m_poseError.X().value(), m_poseError.Y().value(),
                m_poseError.Rotation().Radians().value()};
   Vectord<2> u = K * e;
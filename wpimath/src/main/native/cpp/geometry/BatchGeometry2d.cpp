@@ -0,0 +1,157 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/geometry/BatchGeometry2d.h"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace frc;
+
+namespace {
+void CheckSize(size_t inputSize, size_t outputSize) {
+  if (inputSize != outputSize) {
+    throw std::invalid_argument("Output size must match input size.");
+  }
+}
+}  // namespace
+
+void frc::BatchTransformTranslations(
+    const Pose2d& pose, std::span<const Translation2d> translations,
+    std::span<Translation2d> out) {
+  CheckSize(translations.size(), out.size());
+
+  const double x0 = pose.X().value();
+  const double y0 = pose.Y().value();
+  const double c = pose.Rotation().Cos();
+  const double s = pose.Rotation().Sin();
+
+  for (size_t i = 0; i < translations.size(); ++i) {
+    const double x = translations[i].X().value();
+    const double y = translations[i].Y().value();
+    out[i] = Translation2d{units::meter_t{x0 + (x * c - y * s)},
+                           units::meter_t{y0 + (x * s + y * c)}};
+  }
+}
+
+void frc::BatchTransformTranslations(const Pose2d& pose,
+                                     std::span<const double> x,
+                                     std::span<const double> y,
+                                     std::span<double> outX,
+                                     std::span<double> outY) {
+  CheckSize(x.size(), y.size());
+  CheckSize(x.size(), outX.size());
+  CheckSize(x.size(), outY.size());
+
+  const double x0 = pose.X().value();
+  const double y0 = pose.Y().value();
+  const double c = pose.Rotation().Cos();
+  const double s = pose.Rotation().Sin();
+
+  for (size_t i = 0; i < x.size(); ++i) {
+    const double xi = x[i];
+    const double yi = y[i];
+    outX[i] = x0 + (xi * c - yi * s);
+    outY[i] = y0 + (xi * s + yi * c);
+  }
+}
+
+void frc::BatchRelativeTo(std::span<const Pose2d> poses, const Pose2d& origin,
+                          std::span<Pose2d> out) {
+  CheckSize(poses.size(), out.size());
+
+  // Rotating by -origin.Rotation() is the transpose of rotating by
+  // origin.Rotation()
+  const double x0 = origin.X().value();
+  const double y0 = origin.Y().value();
+  const double c = origin.Rotation().Cos();
+  const double s = origin.Rotation().Sin();
+
+  for (size_t i = 0; i < poses.size(); ++i) {
+    const double dx = poses[i].X().value() - x0;
+    const double dy = poses[i].Y().value() - y0;
+    const double cos = poses[i].Rotation().Cos();
+    const double sin = poses[i].Rotation().Sin();
+    out[i] = Pose2d{units::meter_t{dx * c + dy * s},
+                    units::meter_t{-dx * s + dy * c},
+                    Rotation2d{cos * c + sin * s, sin * c - cos * s}};
+  }
+}
+
+void frc::BatchExp(const Pose2d& start, std::span<const Twist2d> twists,
+                   std::span<Pose2d> out) {
+  CheckSize(twists.size(), out.size());
+
+  const double x0 = start.X().value();
+  const double y0 = start.Y().value();
+  const double c0 = start.Rotation().Cos();
+  const double s0 = start.Rotation().Sin();
+
+  for (size_t i = 0; i < twists.size(); ++i) {
+    const double dx = twists[i].dx.value();
+    const double dy = twists[i].dy.value();
+    const double dtheta = twists[i].dtheta.value();
+
+    const double sinTheta = std::sin(dtheta);
+    const double cosTheta = std::cos(dtheta);
+
+    double s, c;
+    if (std::abs(dtheta) < 1E-9) {
+      s = 1.0 - 1.0 / 6.0 * dtheta * dtheta;
+      c = 0.5 * dtheta;
+    } else {
+      s = sinTheta / dtheta;
+      c = (1 - cosTheta) / dtheta;
+    }
+
+    // Translation of the twist in the starting pose's frame
+    const double tx = dx * s - dy * c;
+    const double ty = dx * c + dy * s;
+
+    out[i] = Pose2d{units::meter_t{x0 + (tx * c0 - ty * s0)},
+                    units::meter_t{y0 + (tx * s0 + ty * c0)},
+                    Rotation2d{cosTheta * c0 - sinTheta * s0,
+                               cosTheta * s0 + sinTheta * c0}};
+  }
+}
+
+void frc::BatchLog(const Pose2d& start, std::span<const Pose2d> ends,
+                   std::span<Twist2d> out) {
+  CheckSize(ends.size(), out.size());
+
+  const double x0 = start.X().value();
+  const double y0 = start.Y().value();
+  const double c0 = start.Rotation().Cos();
+  const double s0 = start.Rotation().Sin();
+
+  for (size_t i = 0; i < ends.size(); ++i) {
+    // The end pose relative to the starting pose
+    const double dx = ends[i].X().value() - x0;
+    const double dy = ends[i].Y().value() - y0;
+    const double tx = dx * c0 + dy * s0;
+    const double ty = -dx * s0 + dy * c0;
+    const double cos = ends[i].Rotation().Cos();
+    const double sin = ends[i].Rotation().Sin();
+    const double cosTheta = cos * c0 + sin * s0;
+    const double sinTheta = sin * c0 - cos * s0;
+
+    const double dtheta = std::atan2(sinTheta, cosTheta);
+    const double halfDtheta = dtheta / 2.0;
+    const double cosMinusOne = cosTheta - 1;
+
+    double halfThetaByTanOfHalfDtheta;
+    if (std::abs(cosMinusOne) < 1E-9) {
+      halfThetaByTanOfHalfDtheta = 1.0 - 1.0 / 12.0 * dtheta * dtheta;
+    } else {
+      halfThetaByTanOfHalfDtheta = -(halfDtheta * sinTheta) / cosMinusOne;
+    }
+
+    // Rotating by the unnormalized vector (halfThetaByTanOfHalfDtheta,
+    // -halfDtheta) also scales by its norm, as Pose2d::Log() does
+    out[i] = Twist2d{
+        units::meter_t{tx * halfThetaByTanOfHalfDtheta + ty * halfDtheta},
+        units::meter_t{-tx * halfDtheta + ty * halfThetaByTanOfHalfDtheta},
+        units::radian_t{dtheta}};
+  }
+}
@@ -0,0 +1,94 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/ResampledTrajectory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <wpi/MathExtras.h>
+
+using namespace frc;
+
+ResampledTrajectory::ResampledTrajectory(const Trajectory& trajectory,
+                                         units::second_t dt)
+    : m_dt{dt.value()} {
+  if (dt <= 0_s) {
+    throw std::invalid_argument("Resampling time step must be positive.");
+  }
+
+  // One sample per whole time step before the end, plus one at the end. The
+  // tolerance keeps floating point error from adding a near-empty interval.
+  double totalTime = trajectory.TotalTime().value();
+  size_t count = static_cast<size_t>(std::ceil(totalTime / m_dt - 1e-9)) + 1;
+
+  for (auto* field : {&m_t, &m_x, &m_y, &m_cos, &m_sin, &m_velocity,
+                      &m_acceleration, &m_curvature}) {
+    field->reserve(count);
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    auto t = i + 1 < count ? units::second_t{i * m_dt} : trajectory.TotalTime();
+    auto state = trajectory.Sample(t);
+    m_t.push_back(t.value());
+    m_x.push_back(state.pose.X().value());
+    m_y.push_back(state.pose.Y().value());
+    m_cos.push_back(state.pose.Rotation().Cos());
+    m_sin.push_back(state.pose.Rotation().Sin());
+    m_velocity.push_back(state.velocity.value());
+    m_acceleration.push_back(state.acceleration.value());
+    m_curvature.push_back(state.curvature.value());
+  }
+}
+
+size_t ResampledTrajectory::Index(units::second_t t) const {
+  // Written so NaN also lands here instead of reaching the cast below
+  if (!(t.value() > 0.0)) {
+    return 0;
+  }
+  if (t.value() >= m_t.back()) {
+    return m_t.size() - 1;
+  }
+  return std::min(static_cast<size_t>(t.value() / m_dt), m_t.size() - 2);
+}
+
+Trajectory::State ResampledTrajectory::GetState(size_t index) const {
+  return {units::second_t{m_t[index]},
+          units::meters_per_second_t{m_velocity[index]},
+          units::meters_per_second_squared_t{m_acceleration[index]},
+          Pose2d{units::meter_t{m_x[index]}, units::meter_t{m_y[index]},
+                 Rotation2d{m_cos[index], m_sin[index]}},
+          units::curvature_t{m_curvature[index]}};
+}
+
+Trajectory::State ResampledTrajectory::Sample(units::second_t t) const {
+  size_t i = Index(t);
+  if (!(t.value() > m_t[i]) || i + 1 == m_t.size()) {
+    return GetState(i);
+  }
+
+  // Acceleration is piecewise constant, so it's held from the previous sample
+  // like Trajectory::Sample() does
+  double frac = (t.value() - m_t[i]) / (m_t[i + 1] - m_t[i]);
+  return {t,
+          units::meters_per_second_t{
+              wpi::Lerp(m_velocity[i], m_velocity[i + 1], frac)},
+          units::meters_per_second_squared_t{m_acceleration[i]},
+          Pose2d{units::meter_t{wpi::Lerp(m_x[i], m_x[i + 1], frac)},
+                 units::meter_t{wpi::Lerp(m_y[i], m_y[i + 1], frac)},
+                 Rotation2d{wpi::Lerp(m_cos[i], m_cos[i + 1], frac),
+                            wpi::Lerp(m_sin[i], m_sin[i + 1], frac)}},
+          units::curvature_t{
+              wpi::Lerp(m_curvature[i], m_curvature[i + 1], frac)}};
+}
+
+Trajectory ResampledTrajectory::ToTrajectory() const {
+  std::vector<Trajectory::State> states;
+  states.reserve(m_t.size());
+  for (size_t i = 0; i < m_t.size(); ++i) {
+    states.push_back(GetState(i));
+  }
+  return Trajectory{states};
+}
@@ -0,0 +1,262 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/trajectory/TrajectoryCache.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <typeinfo>
+#include <utility>
+
+#include <fmt/format.h>
+#include <wpi/Endian.h>
+#include <wpi/MemoryBuffer.h>
+#include <wpi/raw_ostream.h>
+#include <wpi/xxhash.h>
+
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/TrajectoryUtil.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+#include "frc/trajectory/constraint/DifferentialDriveKinematicsConstraint.h"
+#include "frc/trajectory/constraint/DifferentialDriveVoltageConstraint.h"
+#include "frc/trajectory/constraint/MaxVelocityConstraint.h"
+
+using namespace frc;
+
+namespace {
+// Written at the start of every cache file. Bump the digit when the key or
+// file layout changes.
+constexpr std::string_view kMagic = "WPITRAJ2";
+
+// Part of every key. Bump it when a change to trajectory generation changes
+// the generated trajectories, so trajectories cached by older code are
+// regenerated.
+constexpr uint32_t kGeneratorVersion = 1;
+
+void AppendDouble(std::string& key, double value) {
+  char buf[8];
+  wpi::support::endian::write64le(buf, std::bit_cast<uint64_t>(value));
+  key.append(buf, sizeof(buf));
+}
+
+void AppendSize(std::string& key, size_t size) {
+  char buf[4];
+  wpi::support::endian::write32le(buf, size);
+  key.append(buf, sizeof(buf));
+}
+
+void AppendString(std::string& key, std::string_view str) {
+  AppendSize(key, str.size());
+  key.append(str);
+}
+
+// Appends the constraint's type and parameters. Returns false if the cache
+// can't read the constraint's parameters; trajectories with such constraints
+// aren't cached. Subclasses of the supported types aren't supported either,
+// since they may override their behavior.
+bool AppendConstraint(std::string& key,
+                      const TrajectoryConstraint& constraint) {
+  const auto& type = typeid(constraint);
+  if (type == typeid(MaxVelocityConstraint)) {
+    auto& c = static_cast<const MaxVelocityConstraint&>(constraint);
+    AppendString(key, "MaxVelocity");
+    AppendDouble(key, c.GetMaxVelocity().value());
+  } else if (type == typeid(CentripetalAccelerationConstraint)) {
+    auto& c = static_cast<const CentripetalAccelerationConstraint&>(constraint);
+    AppendString(key, "CentripetalAcceleration");
+    AppendDouble(key, c.GetMaxCentripetalAcceleration().value());
+  } else if (type == typeid(DifferentialDriveKinematicsConstraint)) {
+    auto& c =
+        static_cast<const DifferentialDriveKinematicsConstraint&>(constraint);
+    AppendString(key, "DifferentialDriveKinematics");
+    AppendDouble(key, c.GetKinematics().trackWidth.value());
+    AppendDouble(key, c.GetMaxSpeed().value());
+  } else if (type == typeid(DifferentialDriveVoltageConstraint)) {
+    auto& c =
+        static_cast<const DifferentialDriveVoltageConstraint&>(constraint);
+    AppendString(key, "DifferentialDriveVoltage");
+    AppendDouble(key, c.GetFeedforward().kS.value());
+    AppendDouble(key, c.GetFeedforward().kV.value());
+    AppendDouble(key, c.GetFeedforward().kA.value());
+    AppendDouble(key, c.GetKinematics().trackWidth.value());
+    AppendDouble(key, c.GetMaxVoltage().value());
+  } else {
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+TrajectoryCache::TrajectoryCache(std::string_view directory,
+                                 std::string_view version)
+    : m_directory{directory}, m_version{version} {
+  std::error_code ec;
+  std::filesystem::create_directories(m_directory, ec);
+}
+
+Trajectory TrajectoryCache::GenerateTrajectory(
+    const std::vector<Pose2d>& waypoints,
+    const TrajectoryConfig& config) const {
+  auto key = MakeKey(waypoints, config);
+  if (!key) {
+    return TrajectoryGenerator::GenerateTrajectory(waypoints, config);
+  }
+  if (auto trajectory = Load(*key)) {
+    return std::move(*trajectory);
+  }
+
+  auto trajectory = TrajectoryGenerator::GenerateTrajectory(waypoints, config);
+  Store(*key, trajectory);
+  return trajectory;
+}
+
+std::vector<Trajectory> TrajectoryCache::GenerateTrajectories(
+    std::span<const std::vector<Pose2d>> waypoints,
+    const TrajectoryConfig& config) const {
+  if (!IsCacheable(config)) {
+    return TrajectoryGenerator::GenerateTrajectories(waypoints, config);
+  }
+
+  std::vector<Trajectory> trajectories(waypoints.size());
+  std::vector<std::string> missKeys;
+  std::vector<size_t> missIndices;
+  std::vector<std::vector<Pose2d>> missWaypoints;
+
+  for (size_t i = 0; i < waypoints.size(); ++i) {
+    auto key = *MakeKey(waypoints[i], config);
+    if (auto trajectory = Load(key)) {
+      trajectories[i] = std::move(*trajectory);
+    } else {
+      missKeys.emplace_back(std::move(key));
+      missIndices.emplace_back(i);
+      missWaypoints.emplace_back(waypoints[i]);
+    }
+  }
+
+  if (!missWaypoints.empty()) {
+    auto generated =
+        TrajectoryGenerator::GenerateTrajectories(missWaypoints, config);
+    for (size_t i = 0; i < generated.size(); ++i) {
+      Store(missKeys[i], generated[i]);
+      trajectories[missIndices[i]] = std::move(generated[i]);
+    }
+  }
+
+  return trajectories;
+}
+
+bool TrajectoryCache::IsCacheable(const TrajectoryConfig& config) {
+  std::string key;
+  for (const auto& constraint : config.Constraints()) {
+    if (!AppendConstraint(key, *constraint)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<std::string> TrajectoryCache::MakeKey(
+    const std::vector<Pose2d>& waypoints,
+    const TrajectoryConfig& config) const {
+  std::string key;
+  AppendSize(key, kGeneratorVersion);
+  AppendString(key, m_version);
+
+  AppendSize(key, waypoints.size());
+  for (const auto& waypoint : waypoints) {
+    AppendDouble(key, waypoint.X().value());
+    AppendDouble(key, waypoint.Y().value());
+    AppendDouble(key, waypoint.Rotation().Radians().value());
+  }
+
+  AppendDouble(key, config.StartVelocity().value());
+  AppendDouble(key, config.EndVelocity().value());
+  AppendDouble(key, config.MaxVelocity().value());
+  AppendDouble(key, config.MaxAcceleration().value());
+  key.push_back(config.IsReversed() ? 1 : 0);
+
+  AppendSize(key, config.Constraints().size());
+  for (const auto& constraint : config.Constraints()) {
+    if (!AppendConstraint(key, *constraint)) {
+      return std::nullopt;
+    }
+  }
+
+  return key;
+}
+
+std::string TrajectoryCache::MakePath(std::string_view key) const {
+  return fmt::format("{}/{:016x}.traj", m_directory, wpi::xxh3_64bits(key));
+}
+
+std::optional<Trajectory> TrajectoryCache::Load(std::string_view key) const {
+  std::error_code ec;
+  auto fileBuffer = wpi::MemoryBuffer::GetFile(MakePath(key), ec);
+  if (fileBuffer == nullptr || ec) {
+    return std::nullopt;
+  }
+
+  // The full key is stored in the file to detect hash collisions
+  auto data = fileBuffer->GetBuffer();
+  if (data.size() < kMagic.size() + 4 ||
+      !std::equal(kMagic.begin(), kMagic.end(), data.begin())) {
+    return std::nullopt;
+  }
+  data = data.subspan(kMagic.size());
+  size_t keySize = wpi::support::endian::read32le(data.data());
+  data = data.subspan(4);
+  if (data.size() < keySize ||
+      std::string_view{reinterpret_cast<const char*>(data.data()), keySize} !=
+          key) {
+    return std::nullopt;
+  }
+
+  try {
+    return TrajectoryUtil::DeserializeTrajectoryBinary(data.subspan(keySize));
+  } catch (const std::runtime_error&) {
+    return std::nullopt;
+  }
+}
+
+void TrajectoryCache::Store(std::string_view key,
+                            const Trajectory& trajectory) const {
+  // TrajectoryGenerator returns a single-state trajectory on failure, which
+  // shouldn't be cached
+  if (trajectory.States().size() < 2) {
+    return;
+  }
+
+  // Write to a temporary file first so a partially written file is never
+  // loaded
+  auto path = MakePath(key);
+  auto tmpPath = path + ".tmp";
+  std::error_code ec;
+  {
+    wpi::raw_fd_ostream os{tmpPath, ec};
+    if (ec) {
+      return;
+    }
+
+    char keySize[4];
+    wpi::support::endian::write32le(keySize, key.size());
+    auto data = TrajectoryUtil::SerializeTrajectoryBinary(trajectory);
+    os << kMagic;
+    os.write(keySize, sizeof(keySize));
+    os << key;
+    os.write(data.data(), data.size());
+    os.close();
+    if (os.has_error()) {
+      os.clear_error();
+      std::filesystem::remove(tmpPath, ec);
+      return;
+    }
+  }
+
+  std::filesystem::rename(tmpPath, path, ec);
+}
@@ -4,6 +4,11 @@
 
 #include "frc/trajectory/TrajectoryGenerator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 #include <fmt/format.h>
@@ -18,7 +23,12 @@ const Trajectory TrajectoryGenerator::kDoNothingTrajectory(
     std::vector<Trajectory::State>{Trajectory::State()});
 std::function<void(const char*)> TrajectoryGenerator::s_errorFunc;
 
+// Errors may be reported from GenerateTrajectories() worker threads, so calls
+// to the handler (and changes to it) are serialized
+static std::mutex errorMutex;
+
 void TrajectoryGenerator::ReportError(const char* error) {
+  std::scoped_lock lock{errorMutex};
   if (s_errorFunc) {
     s_errorFunc(error);
   } else {
@@ -142,7 +152,47 @@ Trajectory TrajectoryGenerator::GenerateTrajectory(
       config.IsReversed());
 }
 
+std::vector<Trajectory> TrajectoryGenerator::GenerateTrajectories(
+    std::span<const std::vector<Pose2d>> waypoints,
+    const TrajectoryConfig& config) {
+  std::vector<Trajectory> trajectories(waypoints.size());
+
+  // Each worker claims the next ungenerated trajectory until none are left
+  std::atomic<size_t> next = 0;
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+  auto worker = [&] {
+    for (size_t i = next++; i < waypoints.size(); i = next++) {
+      try {
+        trajectories[i] = GenerateTrajectory(waypoints[i], config);
+      } catch (...) {
+        std::scoped_lock lock{exceptionMutex};
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+    }
+  };
+
+  size_t numThreads = std::min<size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u), waypoints.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < numThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+  return trajectories;
+}
+
 void TrajectoryGenerator::SetErrorHandler(
     std::function<void(const char*)> func) {
+  std::scoped_lock lock{errorMutex};
   s_errorFunc = std::move(func);
 }
@@ -4,9 +4,11 @@
 
 #include "frc/trajectory/TrajectoryUtil.h"
 
+#include <bit>
 #include <system_error>
 
 #include <fmt/format.h>
+#include <wpi/Endian.h>
 #include <wpi/MemoryBuffer.h>
 #include <wpi/json.h>
 #include <wpi/raw_ostream.h>
@@ -49,3 +51,65 @@ Trajectory TrajectoryUtil::DeserializeTrajectory(std::string_view jsonStr) {
   wpi::json json = wpi::json::parse(jsonStr);
   return Trajectory{json.get<std::vector<Trajectory::State>>()};
 }
+
+namespace {
+// Doubles per state: t, velocity, acceleration, x, y, heading, curvature
+constexpr size_t kStateSize = 7 * sizeof(double);
+}  // namespace
+
+std::vector<uint8_t> TrajectoryUtil::SerializeTrajectoryBinary(
+    const Trajectory& trajectory) {
+  const auto& states = trajectory.States();
+  std::vector<uint8_t> data(4 + states.size() * kStateSize);
+  wpi::support::endian::write32le(data.data(), states.size());
+
+  uint8_t* out = data.data() + 4;
+  for (const auto& state : states) {
+    for (double value :
+         {state.t.value(), state.velocity.value(), state.acceleration.value(),
+          state.pose.X().value(), state.pose.Y().value(),
+          state.pose.Rotation().Radians().value(), state.curvature.value()}) {
+      wpi::support::endian::write64le(out, std::bit_cast<uint64_t>(value));
+      out += sizeof(double);
+    }
+  }
+  return data;
+}
+
+Trajectory TrajectoryUtil::DeserializeTrajectoryBinary(
+    std::span<const uint8_t> data) {
+  if (data.size() < 4) {
+    throw std::runtime_error("Trajectory data is truncated");
+  }
+  size_t count = wpi::support::endian::read32le(data.data());
+  if (count == 0) {
+    throw std::runtime_error("Trajectory data has no states");
+  }
+  if (data.size() - 4 != count * kStateSize) {
+    throw std::runtime_error(
+        fmt::format("Trajectory data has {} bytes, expected {}", data.size(),
+                    4 + count * kStateSize));
+  }
+
+  auto read = [in = data.data() + 4]() mutable {
+    double value = std::bit_cast<double>(wpi::support::endian::read64le(in));
+    in += sizeof(double);
+    return value;
+  };
+
+  std::vector<Trajectory::State> states;
+  states.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    Trajectory::State state;
+    state.t = units::second_t{read()};
+    state.velocity = units::meters_per_second_t{read()};
+    state.acceleration = units::meters_per_second_squared_t{read()};
+    units::meter_t x{read()};
+    units::meter_t y{read()};
+    units::radian_t heading{read()};
+    state.pose = Pose2d{x, y, heading};
+    state.curvature = units::curvature_t{read()};
+    states.push_back(state);
+  }
+  return Trajectory{states};
+}
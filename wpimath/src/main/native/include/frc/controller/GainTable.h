@@ -0,0 +1,150 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <concepts>
+#include <stdexcept>
+#include <vector>
+
+#include "frc/EigenCore.h"
+
+namespace frc {
+
+/**
+ * A lookup table of controller gains precomputed on a uniform grid of a
+ * scheduling variable (e.g., drivetrain velocity), with linear interpolation
+ * between grid points.
+ *
+ * Gain scheduling by solving the DARE (e.g., by constructing a
+ * LinearQuadraticRegulator) every loop iteration is expensive. This class
+ * instead computes the gains once up front. Since the grid is uniform, lookup
+ * is O(1), and the gains are stored contiguously.
+ *
+ * <pre><code>
+ * frc::GainTable<2, 1> table{-3.0, 3.0, 601, [&](double v) {
+ *   return frc::LinearQuadraticRegulator<2, 1>{A(v), B, Q, R, dt}.K();
+ * }};
+ * Eigen::Vector<double, 1> u = table(velocity) * (r - x);
+ * </code></pre>
+ *
+ * @tparam States Number of states.
+ * @tparam Inputs Number of inputs.
+ */
+template <int States, int Inputs>
+class GainTable {
+ public:
+  /// Type of each gain.
+  using Gain = Matrixd<Inputs, States>;
+
+  /**
+   * Constructs an empty table. A nonempty table must be assigned to it before
+   * looking up gains.
+   */
+  GainTable() = default;
+
+  /**
+   * Constructs a table with count grid points spaced uniformly from min to max
+   * inclusive. All gains are initialized to zero.
+   *
+   * @param min   The first grid point.
+   * @param max   The last grid point.
+   * @param count The number of grid points.
+   * @throws std::invalid_argument if count < 2 or max <= min.
+   */
+  GainTable(double min, double max, size_t count)
+      : m_min{min},
+        m_max{max},
+        m_step{(max - min) / (count - 1)},
+        m_gains(count, Gain::Zero()) {
+    if (count < 2) {
+      throw std::invalid_argument(
+          "Gain table must have at least two grid points.");
+    }
+    if (!(max > min)) {
+      throw std::invalid_argument(
+          "Gain table's max must be greater than its min.");
+    }
+  }
+
+  /**
+   * Constructs a table with count grid points spaced uniformly from min to max
+   * inclusive, computing the gain at each grid point.
+   *
+   * @param min     The first grid point.
+   * @param max     The last grid point.
+   * @param count   The number of grid points.
+   * @param compute A callable that takes a grid point and returns its gain.
+   * @throws std::invalid_argument if count < 2 or max <= min.
+   */
+  template <typename F>
+    requires std::invocable<F&, double>
+  GainTable(double min, double max, size_t count, F&& compute)
+      : GainTable{min, max, count} {
+    for (size_t i = 0; i < count; ++i) {
+      m_gains[i] = compute(Point(i));
+    }
+  }
+
+  /**
+   * Returns the number of grid points.
+   */
+  size_t Size() const { return m_gains.size(); }
+
+  /**
+   * Returns the grid point at an index.
+   *
+   * @param index The index. Must be less than Size().
+   */
+  double Point(size_t index) const {
+    // Return the max exactly instead of accumulating rounding error
+    return index + 1 == m_gains.size() ? m_max : m_min + m_step * index;
+  }
+
+  /**
+   * Returns the gain at a grid point index.
+   *
+   * @param index The index. Must be less than Size().
+   */
+  const Gain& At(size_t index) const { return m_gains[index]; }
+
+  /**
+   * Sets the gain at a grid point index.
+   *
+   * @param index The index. Must be less than Size().
+   * @param gain  The gain.
+   */
+  void Set(size_t index, const Gain& gain) { m_gains[index] = gain; }
+
+  /**
+   * Returns the gain at a value of the scheduling variable, linearly
+   * interpolated between the nearest grid points. Values outside the grid are
+   * clamped to the first or last grid point.
+   *
+   * @param x The value of the scheduling variable.
+   */
+  Gain operator()(double x) const {
+    double t = (x - m_min) / m_step;
+    if (!(t > 0.0)) {
+      return m_gains.front();
+    }
+    if (t >= static_cast<double>(m_gains.size() - 1)) {
+      return m_gains.back();
+    }
+
+    size_t i = static_cast<size_t>(t);
+    double frac = t - i;
+    return m_gains[i] + frac * (m_gains[i + 1] - m_gains[i]);
+  }
+
+ private:
+  double m_min = 0.0;
+  double m_max = 0.0;
+  double m_step = 0.0;
+  std::vector<Gain> m_gains;
+};
+
+}  // namespace frc
@@ -6,9 +6,9 @@
 
 #include <wpi/SymbolExports.h>
 #include <wpi/array.h>
-#include <wpi/interpolating_map.h>
 
 #include "frc/EigenCore.h"
+#include "frc/controller/GainTable.h"
 #include "frc/controller/DifferentialDriveWheelVoltages.h"
 #include "frc/geometry/Pose2d.h"
 #include "frc/system/LinearSystem.h"
@@ -130,7 +130,7 @@ class WPILIB_DLLEXPORT LTVDifferentialDriveController {
   units::meter_t m_trackwidth;
 
   // LUT from drivetrain linear velocity to LQR gain
-  wpi::interpolating_map<units::meters_per_second_t, Matrixd<2, 5>> m_table;
+  GainTable<5, 2> m_table;
 
   Vectord<5> m_error;
   Vectord<5> m_tolerance;
@@ -4,11 +4,9 @@
 
 #pragma once
 
-#include <algorithm>
-#include <array>
-#include <functional>
 #include <utility>
-#include <vector>
+
+#include <wpi/static_circular_buffer.h>
 
 #include "frc/EigenCore.h"
 #include "units/math.h"
@@ -19,24 +17,62 @@ namespace frc {
 template <int States, int Inputs, int Outputs, typename KalmanFilterType>
 class KalmanFilterLatencyCompensator {
  public:
+  /**
+   * A snapshot of the observer state. The error covariance is stored in the
+   * form the observer keeps it: the square-root error covariance S for
+   * observers with S() (UnscentedKalmanFilter), the error covariance P for
+   * observers with P() (ExtendedKalmanFilter), and nothing for steady-state
+   * observers (KalmanFilter). squareRootErrorCovariances holds whichever one
+   * applies.
+   */
   struct ObserverSnapshot {
     Vectord<States> xHat;
-    Matrixd<States, States> squareRootErrorCovariances;
+    Matrixd<States, States> squareRootErrorCovariances =
+        Matrixd<States, States>::Zero();
     Vectord<Inputs> inputs;
     Vectord<Outputs> localMeasurements;
 
+    ObserverSnapshot() = default;
+
     ObserverSnapshot(const KalmanFilterType& observer, const Vectord<Inputs>& u,
                      const Vectord<Outputs>& localY)
-        : xHat(observer.Xhat()),
-          squareRootErrorCovariances(observer.S()),
-          inputs(u),
-          localMeasurements(localY) {}
+        : inputs(u), localMeasurements(localY) {
+      Save(observer);
+    }
+
+    /**
+     * Copies the observer state into this snapshot.
+     *
+     * @param observer The observer.
+     */
+    void Save(const KalmanFilterType& observer) {
+      xHat = observer.Xhat();
+      if constexpr (requires { observer.S(); }) {
+        squareRootErrorCovariances = observer.S();
+      } else if constexpr (requires { observer.P(); }) {
+        squareRootErrorCovariances = observer.P();
+      }
+    }
+
+    /**
+     * Resets the observer to the state in this snapshot.
+     *
+     * @param observer The observer.
+     */
+    void Restore(KalmanFilterType* observer) const {
+      if constexpr (requires { observer->S(); }) {
+        observer->SetS(squareRootErrorCovariances);
+      } else if constexpr (requires { observer->P(); }) {
+        observer->SetP(squareRootErrorCovariances);
+      }
+      observer->SetXhat(xHat);
+    }
   };
 
   /**
    * Clears the observer snapshot buffer.
    */
-  void Reset() { m_pastObserverSnapshots.clear(); }
+  void Reset() { m_pastObserverSnapshots.reset(); }
 
   /**
    * Add past observer states to the observer snapshots list.
@@ -46,16 +82,13 @@ class KalmanFilterLatencyCompensator {
    * @param localY    The local output at the timestamp
    * @param timestamp The timesnap of the state.
    */
-  void AddObserverState(const KalmanFilterType& observer, Vectord<Inputs> u,
-                        Vectord<Outputs> localY, units::second_t timestamp) {
-    // Add the new state into the vector.
-    m_pastObserverSnapshots.emplace_back(timestamp,
-                                         ObserverSnapshot{observer, u, localY});
-
-    // Remove the oldest snapshot if the vector exceeds our maximum size.
-    if (m_pastObserverSnapshots.size() > kMaxPastObserverStates) {
-      m_pastObserverSnapshots.erase(m_pastObserverSnapshots.begin());
-    }
+  void AddObserverState(const KalmanFilterType& observer,
+                        const Vectord<Inputs>& u,
+                        const Vectord<Outputs>& localY,
+                        units::second_t timestamp) {
+    // The oldest snapshot is overwritten if the buffer is full.
+    m_pastObserverSnapshots.push_back(
+        {timestamp, ObserverSnapshot{observer, u, localY}});
   }
 
   /**
@@ -66,15 +99,16 @@ class KalmanFilterLatencyCompensator {
    * @param nominalDt                The nominal timestep.
    * @param y                        The measurement.
    * @param globalMeasurementCorrect The function take calls correct() on the
-   *                                 observer.
+   *                                 observer, called as
+   *                                 globalMeasurementCorrect(u, y).
    * @param timestamp                The timestamp of the measurement.
    */
-  template <int Rows>
-  void ApplyPastGlobalMeasurement(
-      KalmanFilterType* observer, units::second_t nominalDt, Vectord<Rows> y,
-      std::function<void(const Vectord<Inputs>& u, const Vectord<Rows>& y)>
-          globalMeasurementCorrect,
-      units::second_t timestamp) {
+  template <int Rows, typename F>
+  void ApplyPastGlobalMeasurement(KalmanFilterType* observer,
+                                  units::second_t nominalDt,
+                                  const Vectord<Rows>& y,
+                                  F&& globalMeasurementCorrect,
+                                  units::second_t timestamp) {
     if (m_pastObserverSnapshots.size() == 0) {
       // State map was empty, which means that we got a measurement right at
       // startup. The only thing we can do is ignore the measurement.
@@ -83,36 +117,30 @@ class KalmanFilterLatencyCompensator {
 
     // Perform a binary search to find the index of first snapshot whose
     // timestamp is greater than or equal to the global measurement timestamp
-    auto it = std::lower_bound(
-        m_pastObserverSnapshots.cbegin(), m_pastObserverSnapshots.cend(),
-        timestamp,
-        [](const auto& entry, const auto& ts) { return entry.first < ts; });
+    size_t nextIdx = LowerBound(timestamp);
 
     size_t indexOfClosestEntry;
 
-    if (it == m_pastObserverSnapshots.cbegin()) {
+    if (nextIdx == 0) {
       // If the global measurement is older than any snapshot, throw out the
       // measurement because there's no state estimate into which to incorporate
       // the measurement
-      if (timestamp < it->first) {
+      if (timestamp < m_pastObserverSnapshots[0].first) {
         return;
       }
 
       // If the first snapshot has same timestamp as the global measurement, use
       // that snapshot
       indexOfClosestEntry = 0;
-    } else if (it == m_pastObserverSnapshots.cend()) {
+    } else if (nextIdx == m_pastObserverSnapshots.size()) {
       // If all snapshots are older than the global measurement, use the newest
       // snapshot
       indexOfClosestEntry = m_pastObserverSnapshots.size() - 1;
     } else {
-      // Index of snapshot taken after the global measurement
-      int nextIdx = std::distance(m_pastObserverSnapshots.cbegin(), it);
-
       // Index of snapshot taken before the global measurement. Since we already
       // handled the case where the index points to the first snapshot, this
       // computation is guaranteed to be nonnegative.
-      int prevIdx = nextIdx - 1;
+      size_t prevIdx = nextIdx - 1;
 
       // Find the snapshot closest in time to global measurement
       units::second_t prevTimeDiff =
@@ -129,14 +157,13 @@ class KalmanFilterLatencyCompensator {
     // the measurement was captured. We will reset the observer to that state,
     // and apply correction based on the measurement. Then, we will go back
     // through all observer states until the present and apply past inputs to
-    // get the present estimated state.
+    // get the present estimated state. The snapshots are updated in place.
     for (size_t i = indexOfClosestEntry; i < m_pastObserverSnapshots.size();
          ++i) {
       auto& [key, snapshot] = m_pastObserverSnapshots[i];
 
       if (i == indexOfClosestEntry) {
-        observer->SetS(snapshot.squareRootErrorCovariances);
-        observer->SetXhat(snapshot.xHat);
+        snapshot.Restore(observer);
       }
 
       observer->Predict(snapshot.inputs, key - lastTimestamp);
@@ -152,14 +179,33 @@ class KalmanFilterLatencyCompensator {
       }
 
       lastTimestamp = key;
-      snapshot = ObserverSnapshot{*observer, snapshot.inputs,
-                                  snapshot.localMeasurements};
+      snapshot.Save(*observer);
     }
   }
 
  private:
   static constexpr size_t kMaxPastObserverStates = 300;
-  std::vector<std::pair<units::second_t, ObserverSnapshot>>
+
+  // Returns the index of the first snapshot with a timestamp not less than
+  // time.
+  size_t LowerBound(units::second_t time) const {
+    size_t first = 0;
+    size_t count = m_pastObserverSnapshots.size();
+    while (count > 0) {
+      size_t step = count / 2;
+      if (m_pastObserverSnapshots[first + step].first < time) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+  // Snapshots are stored in time order in a fixed-size ring buffer.
+  wpi::static_circular_buffer<std::pair<units::second_t, ObserverSnapshot>,
+                              kMaxPastObserverStates>
       m_pastObserverSnapshots;
 };
 }  // namespace frc
@@ -54,7 +54,8 @@ class MerweScaledSigmaPoints {
    * (x) and square-root covariance(S) of the filter.
    *
    * @param x An array of the means.
-   * @param S Square-root covariance of the filter.
+   * @param S Square-root covariance of the filter. S is upper triangular such
+   *          that P = SᵀS.
    *
    * @return Two dimensional array of sigma points. Each column contains all of
    *         the sigmas for one dimension in the problem space. Ordered by
@@ -65,7 +66,8 @@ class MerweScaledSigmaPoints {
       const Vectord<States>& x, const Matrixd<States, States>& S) {
     double lambda = std::pow(m_alpha, 2) * (States + m_kappa) - States;
     double eta = std::sqrt(lambda + States);
-    Matrixd<States, States> U = eta * S;
+    // The sigma points are spread along the columns of Sᵀ, since P = SᵀS
+    Matrixd<States, States> U = eta * S.transpose();
 
     Matrixd<States, 2 * States + 1> sigmas;
     sigmas.template block<States, 1>(0, 0) = x;
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <optional>
+#include <span>
+#include <vector>
+
 #include <Eigen/Core>
 #include <wpi/SymbolExports.h>
 #include <wpi/array.h>
@@ -144,6 +148,36 @@ class WPILIB_DLLEXPORT PoseEstimator {
     AddVisionMeasurement(visionRobotPose, timestamp);
   }
 
+  /**
+   * A timestamped vision measurement, for AddVisionMeasurements().
+   */
+  struct VisionMeasurement {
+    /// The pose of the robot as measured by the vision camera.
+    Pose2d visionRobotPose;
+
+    /// The timestamp of the vision measurement in seconds.
+    units::second_t timestamp;
+
+    /// Standard deviations of the vision pose measurement. If empty, the
+    /// current standard deviations are used.
+    std::optional<wpi::array<double, 3>> visionMeasurementStdDevs;
+  };
+
+  /**
+   * Adds multiple vision measurements to the Kalman Filter, e.g. from several
+   * cameras in the same robot loop.
+   *
+   * The measurements are applied in timestamp order (measurements with the
+   * same timestamp are applied in the order given), with a single replay of
+   * the odometry history. The result is identical to calling
+   * AddVisionMeasurement() for each measurement in that order, including
+   * which vision measurement standard deviations remain set afterwards.
+   *
+   * @param measurements The vision measurements. See AddVisionMeasurement()
+   *     for the timestamp requirements.
+   */
+  void AddVisionMeasurements(std::span<const VisionMeasurement> measurements);
+
   /**
    * Updates the pose estimator with wheel encoder and gyro information. This
    * should be called every loop.
@@ -210,6 +244,32 @@ class WPILIB_DLLEXPORT PoseEstimator {
         InterpolationRecord endValue, double i) const;
   };
 
+  /**
+   * Returns true if a vision measurement at the given time can't be applied,
+   * because it is older than the pose buffer's timespan or the pose buffer is
+   * empty.
+   */
+  bool IsStale(units::second_t timestamp) const;
+
+  /**
+   * Resets odometry to the vision-corrected pose at the measurement time and
+   * records it in the pose buffer. The buffer entries after the measurement
+   * must be replayed afterwards.
+   */
+  void CorrectPastPose(const Pose2d& visionRobotPose,
+                       units::second_t timestamp);
+
+  /**
+   * Replays the odometry inputs recorded in the pose buffer from the given
+   * time, updating the recorded poses and the odometry.
+   *
+   * @param start The time to replay from.
+   * @param end If set, stop after the last pose buffer entry needed to sample
+   *     the buffer at this time.
+   */
+  void ReplayOdometry(units::second_t start,
+                      std::optional<units::second_t> end = std::nullopt);
+
   static constexpr units::second_t kBufferDuration = 1.5_s;
 
   Kinematics<WheelSpeeds, WheelPositions>& m_kinematics;
@@ -217,6 +277,12 @@ class WPILIB_DLLEXPORT PoseEstimator {
   wpi::array<double, 3> m_q{wpi::empty_array};
   Eigen::Matrix3d m_visionK = Eigen::Matrix3d::Zero();
 
+  // Scratch space for ReplayOdometry(), reused so replays don't allocate once
+  // the buffer has filled
+  std::vector<Rotation2d> m_replayGyroAngles;
+  std::vector<WheelPositions> m_replayWheelPositions;
+  std::vector<Pose2d> m_replayPoses;
+
   TimeInterpolatableBuffer<InterpolationRecord> m_poseBuffer{
       kBufferDuration, [this](const InterpolationRecord& start,
                               const InterpolationRecord& end, double t) {
@@ -124,6 +124,8 @@ class UnscentedKalmanFilter {
 
   /**
    * Returns the square-root error covariance matrix S.
+   *
+   * S is upper triangular such that P = SᵀS.
    */
   const StateMatrix& S() const { return m_S; }
 
@@ -138,6 +140,8 @@ class UnscentedKalmanFilter {
   /**
    * Set the current square-root error covariance matrix S.
    *
+   * S must be upper triangular such that P = SᵀS.
+   *
    * @param S The square-root error covariance matrix S.
    */
   void SetS(const StateMatrix& S) { m_S = S; }
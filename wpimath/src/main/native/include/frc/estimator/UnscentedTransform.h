@@ -32,20 +32,19 @@ namespace frc {
  *                     vectors (i.e. it subtracts them.)
  * @param squareRootR  Square-root of the noise covaraince of the sigma points.
  *
- * @return Tuple of x, mean of sigma points; S, square-root covariance of
- * sigmas.
+ * @return Tuple of x, mean of sigma points; S, upper triangular square-root
+ * covariance of sigmas such that P = SᵀS.
  */
 template <int CovDim, int States>
 std::tuple<Vectord<CovDim>, Matrixd<CovDim, CovDim>>
 SquareRootUnscentedTransform(
     const Matrixd<CovDim, 2 * States + 1>& sigmas,
     const Vectord<2 * States + 1>& Wm, const Vectord<2 * States + 1>& Wc,
-    std::function<Vectord<CovDim>(const Matrixd<CovDim, 2 * States + 1>&,
-                                  const Vectord<2 * States + 1>&)>
+    const std::function<Vectord<CovDim>(const Matrixd<CovDim, 2 * States + 1>&,
+                                        const Vectord<2 * States + 1>&)>&
         meanFunc,
-    std::function<Vectord<CovDim>(const Vectord<CovDim>&,
-                                  const Vectord<CovDim>&)>
-        residualFunc,
+    const std::function<Vectord<CovDim>(const Vectord<CovDim>&,
+                                        const Vectord<CovDim>&)>& residualFunc,
     const Matrixd<CovDim, CovDim>& squareRootR) {
   // New mean is usually just the sum of the sigmas * weight:
   //       n
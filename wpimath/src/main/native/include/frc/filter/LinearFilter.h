@@ -21,6 +21,85 @@
 
 namespace frc {
 
+namespace detail {
+
+/**
+ * Factorial of n.
+ *
+ * @param n Argument of which to take factorial.
+ */
+constexpr int Factorial(int n) {
+  if (n < 2) {
+    return 1;
+  } else {
+    return n * Factorial(n - 1);
+  }
+}
+
+/**
+ * Computes the FIR gains of a finite difference filter that computes the nth
+ * derivative of the input given the specified stencil points. See
+ * LinearFilter::FiniteDifference() for details.
+ *
+ * @tparam Derivative The order of the derivative to compute.
+ * @tparam Samples    The number of samples to use to compute the given
+ *                    derivative.
+ * @param stencil     List of stencil points.
+ * @param period      The period in seconds between samples taken by the user.
+ * @return The FIR gains, newest sample first.
+ */
+template <int Derivative, int Samples>
+wpi::array<double, Samples> FiniteDifferenceGains(
+    const wpi::array<int, Samples>& stencil, units::second_t period) {
+  // See
+  // https://en.wikipedia.org/wiki/Finite_difference_coefficient#Arbitrary_stencil_points
+  //
+  // For a given list of stencil points s of length n and the order of
+  // derivative d < n, the finite difference coefficients can be obtained by
+  // solving the following linear system for the vector a.
+  //
+  // [s₁⁰   ⋯  sₙ⁰ ][a₁]      [ δ₀,d ]
+  // [ ⋮    ⋱  ⋮   ][⋮ ] = d! [  ⋮   ]
+  // [s₁ⁿ⁻¹ ⋯ sₙⁿ⁻¹][aₙ]      [δₙ₋₁,d]
+  //
+  // where δᵢ,ⱼ are the Kronecker delta. The FIR gains are the elements of the
+  // vector a in reverse order divided by hᵈ.
+  //
+  // The order of accuracy of the approximation is of the form O(hⁿ⁻ᵈ).
+
+  static_assert(Derivative >= 1,
+                "Order of derivative must be greater than or equal to one.");
+  static_assert(Samples > 0, "Number of samples must be greater than zero.");
+  static_assert(Derivative < Samples,
+                "Order of derivative must be less than number of samples.");
+
+  Matrixd<Samples, Samples> S;
+  for (int row = 0; row < Samples; ++row) {
+    for (int col = 0; col < Samples; ++col) {
+      S(row, col) = std::pow(stencil[col], row);
+    }
+  }
+
+  // Fill in Kronecker deltas: https://en.wikipedia.org/wiki/Kronecker_delta
+  Vectord<Samples> d;
+  for (int i = 0; i < Samples; ++i) {
+    d(i) = (i == Derivative) ? Factorial(Derivative) : 0.0;
+  }
+
+  Vectord<Samples> a =
+      S.householderQr().solve(d) / std::pow(period.value(), Derivative);
+
+  // Reverse gains list
+  wpi::array<double, Samples> ffGains{wpi::empty_array};
+  for (int i = 0; i < Samples; ++i) {
+    ffGains[i] = a(Samples - 1 - i);
+  }
+
+  return ffGains;
+}
+
+}  // namespace detail
+
 /**
  * This class implements a linear, digital filter. All types of FIR and IIR
  * filters are supported. Static factory methods are provided to create commonly
@@ -188,51 +267,9 @@ class LinearFilter {
   template <int Derivative, int Samples>
   static LinearFilter<T> FiniteDifference(
       const wpi::array<int, Samples> stencil, units::second_t period) {
-    // See
-    // https://en.wikipedia.org/wiki/Finite_difference_coefficient#Arbitrary_stencil_points
-    //
-    // For a given list of stencil points s of length n and the order of
-    // derivative d < n, the finite difference coefficients can be obtained by
-    // solving the following linear system for the vector a.
-    //
-    // [s₁⁰   ⋯  sₙ⁰ ][a₁]      [ δ₀,d ]
-    // [ ⋮    ⋱  ⋮   ][⋮ ] = d! [  ⋮   ]
-    // [s₁ⁿ⁻¹ ⋯ sₙⁿ⁻¹][aₙ]      [δₙ₋₁,d]
-    //
-    // where δᵢ,ⱼ are the Kronecker delta. The FIR gains are the elements of the
-    // vector a in reverse order divided by hᵈ.
-    //
-    // The order of accuracy of the approximation is of the form O(hⁿ⁻ᵈ).
-
-    static_assert(Derivative >= 1,
-                  "Order of derivative must be greater than or equal to one.");
-    static_assert(Samples > 0, "Number of samples must be greater than zero.");
-    static_assert(Derivative < Samples,
-                  "Order of derivative must be less than number of samples.");
-
-    Matrixd<Samples, Samples> S;
-    for (int row = 0; row < Samples; ++row) {
-      for (int col = 0; col < Samples; ++col) {
-        S(row, col) = std::pow(stencil[col], row);
-      }
-    }
-
-    // Fill in Kronecker deltas: https://en.wikipedia.org/wiki/Kronecker_delta
-    Vectord<Samples> d;
-    for (int i = 0; i < Samples; ++i) {
-      d(i) = (i == Derivative) ? Factorial(Derivative) : 0.0;
-    }
-
-    Vectord<Samples> a =
-        S.householderQr().solve(d) / std::pow(period.value(), Derivative);
-
-    // Reverse gains list
-    std::vector<double> ffGains;
-    for (int i = Samples - 1; i >= 0; --i) {
-      ffGains.push_back(a(i));
-    }
-
-    return LinearFilter(ffGains, {});
+    auto gains = detail::FiniteDifferenceGains<Derivative, Samples>(stencil,
+                                                                    period);
+    return LinearFilter(gains, {});
   }
 
   /**
@@ -307,19 +344,6 @@ class LinearFilter {
   wpi::circular_buffer<T> m_outputs;
   std::vector<double> m_inputGains;
   std::vector<double> m_outputGains;
-
-  /**
-   * Factorial of n.
-   *
-   * @param n Argument of which to take factorial.
-   */
-  static constexpr int Factorial(int n) {
-    if (n < 2) {
-      return 1;
-    } else {
-      return n * Factorial(n - 1);
-    }
-  }
 };
 
 }  // namespace frc
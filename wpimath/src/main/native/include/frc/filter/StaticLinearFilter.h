@@ -0,0 +1,205 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+#include <cmath>
+
+#include <wpi/array.h>
+
+#include "frc/filter/LinearFilter.h"
+#include "units/time.h"
+#include "wpimath/MathShared.h"
+
+namespace frc {
+
+/**
+ * A linear, digital filter with a number of taps fixed at compile time. See
+ * LinearFilter for the filter form and usage notes.
+ *
+ * Unlike LinearFilter, this class doesn't allocate. The gains and the input
+ * and output histories are stored inline, and the histories are kept in delay
+ * lines that store each sample twice, so the most recent samples are always
+ * contiguous in memory. Calculate() then runs fixed-length loops over
+ * contiguous arrays that the compiler can fully unroll. The terms are summed in
+ * the same order as LinearFilter, so both classes produce identical outputs for
+ * the same gains.
+ *
+ * @tparam T      The type of the input and output values.
+ * @tparam FFTaps The number of "feedforward" or FIR gains.
+ * @tparam FBTaps The number of "feedback" or IIR gains.
+ */
+template <class T, size_t FFTaps, size_t FBTaps>
+class StaticLinearFilter {
+ public:
+  /**
+   * Create a linear FIR or IIR filter.
+   *
+   * @param ffGains The "feedforward" or FIR gains.
+   * @param fbGains The "feedback" or IIR gains.
+   */
+  StaticLinearFilter(const wpi::array<double, FFTaps>& ffGains,
+                     const wpi::array<double, FBTaps>& fbGains)
+      : m_inputGains(ffGains), m_outputGains(fbGains) {
+    Reset();
+
+    static int instances = 0;
+    instances++;
+    wpi::math::MathSharedStore::ReportUsage(
+        wpi::math::MathUsageId::kFilter_Linear, instances);
+  }
+
+  // Static methods to create commonly used filters
+  /**
+   * Creates a one-pole IIR low-pass filter. See LinearFilter::SinglePoleIIR().
+   *
+   * @param timeConstant The discrete-time time constant in seconds.
+   * @param period       The period in seconds between samples taken by the
+   *                     user.
+   */
+  static StaticLinearFilter SinglePoleIIR(double timeConstant,
+                                          units::second_t period)
+    requires(FFTaps == 1 && FBTaps == 1)
+  {
+    double gain = std::exp(-period.value() / timeConstant);
+    return StaticLinearFilter({1.0 - gain}, {-gain});
+  }
+
+  /**
+   * Creates a first-order high-pass filter. See LinearFilter::HighPass().
+   *
+   * @param timeConstant The discrete-time time constant in seconds.
+   * @param period       The period in seconds between samples taken by the
+   *                     user.
+   */
+  static StaticLinearFilter HighPass(double timeConstant,
+                                     units::second_t period)
+    requires(FFTaps == 2 && FBTaps == 1)
+  {
+    double gain = std::exp(-period.value() / timeConstant);
+    return StaticLinearFilter({gain, -gain}, {-gain});
+  }
+
+  /**
+   * Creates an FFTaps-tap FIR moving average filter. See
+   * LinearFilter::MovingAverage().
+   */
+  static StaticLinearFilter MovingAverage()
+    requires(FFTaps > 0 && FBTaps == 0)
+  {
+    wpi::array<double, FFTaps> gains{wpi::empty_array};
+    gains.fill(1.0 / FFTaps);
+    return StaticLinearFilter(gains, wpi::array<double, 0>{wpi::empty_array});
+  }
+
+  /**
+   * Creates a finite difference filter that computes the nth derivative of the
+   * input given the specified stencil points. The number of stencil points is
+   * FFTaps. See LinearFilter::FiniteDifference().
+   *
+   * @tparam Derivative The order of the derivative to compute.
+   * @param stencil     List of stencil points.
+   * @param period      The period in seconds between samples taken by the user.
+   */
+  template <int Derivative>
+  static StaticLinearFilter FiniteDifference(
+      const wpi::array<int, FFTaps>& stencil, units::second_t period)
+    requires(FBTaps == 0)
+  {
+    return StaticLinearFilter(
+        detail::FiniteDifferenceGains<Derivative, FFTaps>(stencil, period),
+        wpi::array<double, 0>{wpi::empty_array});
+  }
+
+  /**
+   * Creates a backward finite difference filter that computes the nth
+   * derivative of the input using FFTaps samples. See
+   * LinearFilter::BackwardFiniteDifference().
+   *
+   * For example, a first derivative filter that uses two samples and a sample
+   * period of 20 ms would be
+   *
+   * <pre><code>
+   * StaticLinearFilter<double, 2, 0>::BackwardFiniteDifference<1>(20_ms);
+   * </code></pre>
+   *
+   * @tparam Derivative The order of the derivative to compute.
+   * @param period      The period in seconds between samples taken by the user.
+   */
+  template <int Derivative>
+  static StaticLinearFilter BackwardFiniteDifference(units::second_t period)
+    requires(FBTaps == 0)
+  {
+    // Generate stencil points from -(samples - 1) to 0
+    wpi::array<int, FFTaps> stencil{wpi::empty_array};
+    for (size_t i = 0; i < FFTaps; ++i) {
+      stencil[i] = -static_cast<int>(FFTaps - 1) + static_cast<int>(i);
+    }
+
+    return FiniteDifference<Derivative>(stencil, period);
+  }
+
+  /**
+   * Reset the filter state.
+   */
+  void Reset() {
+    m_inputs.fill(T{0.0});
+    m_outputs.fill(T{0.0});
+    m_inputFront = 0;
+    m_outputFront = 0;
+  }
+
+  /**
+   * Calculates the next value of the filter.
+   *
+   * @param input Current input value.
+   *
+   * @return The filtered value at this step
+   */
+  T Calculate(T input) {
+    T retVal{0.0};
+
+    // Rotate the inputs
+    if constexpr (FFTaps > 0) {
+      m_inputFront = m_inputFront == 0 ? FFTaps - 1 : m_inputFront - 1;
+      m_inputs[m_inputFront] = input;
+      m_inputs[m_inputFront + FFTaps] = input;
+    }
+
+    // Calculate the new value
+    const T* inputs = m_inputs.data() + m_inputFront;
+    for (size_t i = 0; i < FFTaps; ++i) {
+      retVal += inputs[i] * m_inputGains[i];
+    }
+    const T* outputs = m_outputs.data() + m_outputFront;
+    for (size_t i = 0; i < FBTaps; ++i) {
+      retVal -= outputs[i] * m_outputGains[i];
+    }
+
+    // Rotate the outputs
+    if constexpr (FBTaps > 0) {
+      m_outputFront = m_outputFront == 0 ? FBTaps - 1 : m_outputFront - 1;
+      m_outputs[m_outputFront] = retVal;
+      m_outputs[m_outputFront + FBTaps] = retVal;
+    }
+
+    return retVal;
+  }
+
+ private:
+  // Delay lines. Every sample is stored at both index j and j + Taps, so the
+  // Taps samples starting at the front index are contiguous, newest first.
+  std::array<T, 2 * FFTaps> m_inputs;
+  std::array<T, 2 * FBTaps> m_outputs;
+  size_t m_inputFront = 0;
+  size_t m_outputFront = 0;
+
+  wpi::array<double, FFTaps> m_inputGains;
+  wpi::array<double, FBTaps> m_outputGains;
+};
+
+}  // namespace frc
@@ -0,0 +1,86 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+
+#include <wpi/static_circular_buffer.h>
+
+namespace frc {
+
+/**
+ * A moving-window median filter with a window size fixed at compile time. See
+ * MedianFilter.
+ *
+ * Unlike MedianFilter, this class doesn't allocate. The window is stored
+ * inline, and each sample updates the sorted window in place with one shifting
+ * pass to remove the oldest value and one insertion sort step to add the new
+ * value. For the small windows typically used to reject sensor outliers, this
+ * is faster than sorting the window every sample or maintaining two heaps.
+ *
+ * @tparam T    The type of the input and output values.
+ * @tparam Size The number of samples in the moving window.
+ */
+template <class T, size_t Size>
+class StaticMedianFilter {
+ public:
+  static_assert(Size > 0, "Window size must be greater than zero.");
+
+  /**
+   * Calculates the moving-window median for the next value of the input stream.
+   *
+   * @param next The next input value.
+   * @return The median of the moving window, updated to include the next value.
+   */
+  T Calculate(T next) {
+    size_t curSize = m_valueBuffer.size();
+
+    // If buffer is at max size, remove the oldest value from the ordered list
+    if (curSize == Size) {
+      T oldest = m_valueBuffer.pop_back();
+      size_t i = 0;
+      while (i + 1 < curSize && !(m_orderedValues[i] == oldest)) {
+        ++i;
+      }
+      for (; i + 1 < curSize; ++i) {
+        m_orderedValues[i] = m_orderedValues[i + 1];
+      }
+      --curSize;
+    }
+
+    // Insert next value at proper point in sorted array
+    size_t i = curSize;
+    for (; i > 0 && next < m_orderedValues[i - 1]; --i) {
+      m_orderedValues[i] = m_orderedValues[i - 1];
+    }
+    m_orderedValues[i] = next;
+    ++curSize;
+
+    // Add next value to circular buffer
+    m_valueBuffer.push_front(next);
+
+    if (curSize % 2 != 0) {
+      // If size is odd, return middle element of sorted list
+      return m_orderedValues[curSize / 2];
+    } else {
+      // If size is even, return average of middle elements
+      return (m_orderedValues[curSize / 2 - 1] + m_orderedValues[curSize / 2]) /
+             2.0;
+    }
+  }
+
+  /**
+   * Resets the filter, clearing the window of all elements.
+   */
+  void Reset() { m_valueBuffer.reset(); }
+
+ private:
+  wpi::static_circular_buffer<T, Size> m_valueBuffer;
+  std::array<T, Size> m_orderedValues;
+};
+
+}  // namespace frc
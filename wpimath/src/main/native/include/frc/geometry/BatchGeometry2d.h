@@ -0,0 +1,100 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <span>
+
+#include <wpi/SymbolExports.h>
+
+#include "frc/geometry/Pose2d.h"
+#include "frc/geometry/Translation2d.h"
+#include "frc/geometry/Twist2d.h"
+
+// Batch versions of the 2D geometry operations. Each function reads the sine
+// and cosine of the shared pose once and skips the intermediate Rotation2d
+// normalizations and trig calls the scalar versions make per element. The
+// translation kernels are branch-free arithmetic the compiler can vectorize,
+// especially the structure-of-arrays overload.
+//
+// Each output must be the same size as the input, and may be the same span as
+// the input to operate in place.
+
+namespace frc {
+
+/**
+ * Transforms translations from a pose's coordinate frame into the frame the
+ * pose is in. For example, this transforms robot-relative points into
+ * field-relative points given the robot's field-relative pose.
+ *
+ * Each output is the translation of pose.TransformBy(Transform2d{input, {}}).
+ *
+ * @param pose         The pose whose coordinate frame the translations are in.
+ * @param translations The translations to transform.
+ * @param out          The transformed translations.
+ * @throws std::invalid_argument if the sizes don't match.
+ */
+WPILIB_DLLEXPORT
+void BatchTransformTranslations(const Pose2d& pose,
+                                std::span<const Translation2d> translations,
+                                std::span<Translation2d> out);
+
+/**
+ * Transforms translations stored as separate x and y arrays from a pose's
+ * coordinate frame into the frame the pose is in.
+ *
+ * @param pose The pose whose coordinate frame the translations are in.
+ * @param x    The x components of the translations in meters.
+ * @param y    The y components of the translations in meters.
+ * @param outX The x components of the transformed translations in meters.
+ * @param outY The y components of the transformed translations in meters.
+ * @throws std::invalid_argument if the sizes don't match.
+ */
+WPILIB_DLLEXPORT
+void BatchTransformTranslations(const Pose2d& pose, std::span<const double> x,
+                                std::span<const double> y,
+                                std::span<double> outX,
+                                std::span<double> outY);
+
+/**
+ * Returns each pose relative to the given origin pose, as in
+ * Pose2d::RelativeTo().
+ *
+ * @param poses  The poses to convert.
+ * @param origin The pose that is the origin of the new coordinate frame.
+ * @param out    The poses relative to the origin.
+ * @throws std::invalid_argument if the sizes don't match.
+ */
+WPILIB_DLLEXPORT
+void BatchRelativeTo(std::span<const Pose2d> poses, const Pose2d& origin,
+                     std::span<Pose2d> out);
+
+/**
+ * Applies each twist to the same starting pose, as in Pose2d::Exp(). This is
+ * useful for generating candidate poses; to chain twists, call Pose2d::Exp()
+ * in a loop instead.
+ *
+ * @param start  The starting pose.
+ * @param twists The twists to apply to the starting pose.
+ * @param out    The pose produced by each twist.
+ * @throws std::invalid_argument if the sizes don't match.
+ */
+WPILIB_DLLEXPORT
+void BatchExp(const Pose2d& start, std::span<const Twist2d> twists,
+              std::span<Pose2d> out);
+
+/**
+ * Returns the twist that maps the starting pose to each end pose, as in
+ * Pose2d::Log().
+ *
+ * @param start The starting pose.
+ * @param ends  The end poses.
+ * @param out   The twist that maps the starting pose to each end pose.
+ * @throws std::invalid_argument if the sizes don't match.
+ */
+WPILIB_DLLEXPORT
+void BatchLog(const Pose2d& start, std::span<const Pose2d> ends,
+              std::span<Twist2d> out);
+
+}  // namespace frc
@@ -5,15 +5,13 @@
 #pragma once
 
 #include <algorithm>
-#include <array>
 #include <functional>
-#include <map>
 #include <optional>
 #include <utility>
-#include <vector>
 
 #include <wpi/MathExtras.h>
 #include <wpi/SymbolExports.h>
+#include <wpi/circular_buffer.h>
 
 #include "frc/geometry/Pose2d.h"
 #include "units/time.h"
@@ -30,7 +28,7 @@ namespace frc {
  * When sampling this buffer, a user-provided function or wpi::Lerp can be
  * used. For Pose2ds, we use Twists.
  *
- * @tparam T The type stored in this buffer.
+ * @tparam T The type stored in this buffer. It must be default-constructible.
  */
 template <typename T>
 class TimeInterpolatableBuffer {
@@ -64,38 +62,33 @@ class TimeInterpolatableBuffer {
    * @param sample The sample object.
    */
   void AddSample(units::second_t time, T sample) {
-    // Add the new state into the vector.
+    // Add the new state into the buffer.
     if (m_pastSnapshots.size() == 0 || time > m_pastSnapshots.back().first) {
-      m_pastSnapshots.emplace_back(time, sample);
+      PushBack(time, std::move(sample));
     } else {
-      auto first_after = std::upper_bound(
-          m_pastSnapshots.begin(), m_pastSnapshots.end(), time,
-          [](auto t, const auto& pair) { return t < pair.first; });
+      size_t first_after = UpperBound(time);
 
-      // Don't access this before ensuring first_after isn't first.
-      auto last_not_greater_than = first_after - 1;
-
-      if (first_after == m_pastSnapshots.begin() ||
-          last_not_greater_than == m_pastSnapshots.begin() ||
-          last_not_greater_than->first < time) {
+      if (first_after == 0 || first_after == 1 ||
+          m_pastSnapshots[first_after - 1].first < time) {
         // Two cases handled together:
         // 1. All entries come after the sample
         // 2. Some entries come before the sample, but none are recorded with
         // the same time
-        m_pastSnapshots.insert(first_after, std::pair(time, sample));
+        Insert(first_after, time, std::move(sample));
       } else {
         // Final case:
         // 3. An entry exists with the same recorded time.
-        last_not_greater_than->second = sample;
+        m_pastSnapshots[first_after - 1].second = std::move(sample);
       }
     }
-    while (time - m_pastSnapshots[0].first > m_historySize) {
-      m_pastSnapshots.erase(m_pastSnapshots.begin());
+    // Evict old samples; this only moves the front index.
+    while (time - m_pastSnapshots.front().first > m_historySize) {
+      m_pastSnapshots.pop_front();
     }
   }
 
   /** Clear all old samples. */
-  void Clear() { m_pastSnapshots.clear(); }
+  void Clear() { m_pastSnapshots.reset(); }
 
   /**
    * Sample the buffer at the given time. If the buffer is empty, an empty
@@ -104,12 +97,12 @@ class TimeInterpolatableBuffer {
    * @param time The time at which to sample the buffer.
    */
   std::optional<T> Sample(units::second_t time) {
-    if (m_pastSnapshots.empty()) {
+    if (m_pastSnapshots.size() == 0) {
       return {};
     }
 
     // We will perform a binary search to find the index of the element in the
-    // vector that has a timestamp that is equal to or greater than the vision
+    // buffer that has a timestamp that is equal to or greater than the vision
     // measurement timestamp.
 
     if (time <= m_pastSnapshots.front().first) {
@@ -122,34 +115,136 @@ class TimeInterpolatableBuffer {
       return m_pastSnapshots[0].second;
     }
 
-    // Get the iterator which has a key no less than the requested key.
-    auto upper_bound = std::lower_bound(
-        m_pastSnapshots.begin(), m_pastSnapshots.end(), time,
-        [](const auto& pair, auto t) { return t > pair.first; });
+    // Get the index which has a key no less than the requested key.
+    size_t upper_bound = LowerBound(time);
 
-    if (upper_bound == m_pastSnapshots.begin()) {
-      return upper_bound->second;
+    if (upper_bound == 0) {
+      return m_pastSnapshots[upper_bound].second;
     }
 
-    auto lower_bound = upper_bound - 1;
+    const auto& lower = m_pastSnapshots[upper_bound - 1];
+    const auto& upper = m_pastSnapshots[upper_bound];
+
+    double t = ((time - lower.first) / (upper.first - lower.first));
 
-    double t = ((time - lower_bound->first) /
-                (upper_bound->first - lower_bound->first));
+    return m_interpolatingFunc(lower.second, upper.second, t);
+  }
 
-    return m_interpolatingFunc(lower_bound->second, upper_bound->second, t);
+  /**
+   * Returns the timestamp of the oldest sample in the buffer. If the buffer is
+   * empty, an empty optional is returned.
+   */
+  std::optional<units::second_t> GetOldestTime() const {
+    if (m_pastSnapshots.size() == 0) {
+      return {};
+    }
+    return m_pastSnapshots.front().first;
   }
 
   /**
-   * Grant access to the internal sample buffer. Used in Pose Estimation to
+   * Calls a function on each sample recorded at or after the given time,
+   * oldest first. The function is called with the timestamp and a reference
+   * to the sample, which it may modify in place. Used in Pose Estimation to
    * replay odometry inputs stored within this buffer.
+   *
+   * The function must not add samples to or clear this buffer.
+   *
+   * @param time The time of the first sample to replay.
+   * @param func The function, called as func(units::second_t, T&).
+   */
+  template <typename F>
+  void Replay(units::second_t time, F&& func) {
+    for (size_t i = LowerBound(time); i < m_pastSnapshots.size(); ++i) {
+      auto& entry = m_pastSnapshots[i];
+      func(entry.first, entry.second);
+    }
+  }
+
+  /**
+   * Like Replay(time, func), but stops after the first sample recorded at or
+   * after end. This is the last sample that Sample(end) depends on.
+   *
+   * @param start The time of the first sample to replay.
+   * @param end The time after which to stop replaying.
+   * @param func The function, called as func(units::second_t, T&).
+   */
+  template <typename F>
+  void Replay(units::second_t start, units::second_t end, F&& func) {
+    size_t last = (std::min)(LowerBound(end) + 1, m_pastSnapshots.size());
+    for (size_t i = LowerBound(start); i < last; ++i) {
+      auto& entry = m_pastSnapshots[i];
+      func(entry.first, entry.second);
+    }
+  }
+
+  /**
+   * Grant access to the internal sample buffer.
+   *
+   * @deprecated Use Replay() to visit the samples instead. The samples are
+   * stored in a wpi::circular_buffer rather than a std::vector.
    */
-  std::vector<std::pair<units::second_t, T>>& GetInternalBuffer() {
+  [[deprecated("Use Replay() to visit the samples instead")]]
+  wpi::circular_buffer<std::pair<units::second_t, T>>& GetInternalBuffer() {
     return m_pastSnapshots;
   }
 
  private:
+  // Samples are stored in time order in a ring buffer, so evicting the oldest
+  // sample is O(1).
+  static constexpr size_t kInitialCapacity = 8;
+
+  // Returns the index of the first sample with a timestamp not less than time.
+  size_t LowerBound(units::second_t time) const {
+    size_t first = 0;
+    size_t count = m_pastSnapshots.size();
+    while (count > 0) {
+      size_t step = count / 2;
+      if (m_pastSnapshots[first + step].first < time) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+  // Returns the index of the first sample with a timestamp greater than time.
+  size_t UpperBound(units::second_t time) const {
+    size_t first = 0;
+    size_t count = m_pastSnapshots.size();
+    while (count > 0) {
+      size_t step = count / 2;
+      if (!(time < m_pastSnapshots[first + step].first)) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+  void PushBack(units::second_t time, T&& sample) {
+    // The ring buffer overwrites its front when full, so grow it first.
+    if (m_pastSnapshots.size() == m_capacity) {
+      m_capacity *= 2;
+      m_pastSnapshots.resize(m_capacity);
+    }
+    m_pastSnapshots.push_back({time, std::move(sample)});
+  }
+
+  void Insert(size_t index, units::second_t time, T&& sample) {
+    PushBack(time, std::move(sample));
+    for (size_t i = m_pastSnapshots.size() - 1; i > index; --i) {
+      std::swap(m_pastSnapshots[i], m_pastSnapshots[i - 1]);
+    }
+  }
+
   units::second_t m_historySize;
-  std::vector<std::pair<units::second_t, T>> m_pastSnapshots;
+  size_t m_capacity = kInitialCapacity;
+  wpi::circular_buffer<std::pair<units::second_t, T>> m_pastSnapshots{
+      kInitialCapacity};
   std::function<T(const T&, const T&, double)> m_interpolatingFunc;
 };
 
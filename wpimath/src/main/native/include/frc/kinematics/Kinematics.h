@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <span>
+#include <stdexcept>
+
 #include <wpi/SymbolExports.h>
 
 #include "frc/geometry/Twist2d.h"
@@ -58,5 +61,34 @@ class WPILIB_DLLEXPORT Kinematics {
    */
   virtual Twist2d ToTwist2d(const WheelPositions& start,
                             const WheelPositions& end) const = 0;
+
+  /**
+   * Performs forward kinematics on a sequence of wheel positions. twists[0] is
+   * the twist from start to ends[0], and twists[i] is the twist from
+   * ends[i - 1] to ends[i]. This is used to replay recorded odometry.
+   *
+   * The default implementation calls ToTwist2d() for each sample. Subclasses
+   * may override it with a faster batched version.
+   *
+   * @param start The starting distances driven by the wheels.
+   * @param ends The distances driven by the wheels at each sample.
+   * @param twists The resulting Twist2d of each sample. Must be the same size
+   * as ends.
+   * @throws std::invalid_argument if the sizes don't match.
+   */
+  virtual void ToTwist2ds(const WheelPositions& start,
+                          std::span<const WheelPositions> ends,
+                          std::span<Twist2d> twists) const {
+    if (ends.size() != twists.size()) {
+      throw std::invalid_argument(
+          "Number of twists must match number of wheel position samples.");
+    }
+
+    const WheelPositions* previous = &start;
+    for (size_t i = 0; i < ends.size(); ++i) {
+      twists[i] = ToTwist2d(*previous, ends[i]);
+      previous = &ends[i];
+    }
+  }
 };
 }  // namespace frc
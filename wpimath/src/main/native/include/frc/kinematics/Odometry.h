@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <span>
+
 #include <wpi/SymbolExports.h>
 
 #include "frc/geometry/Pose2d.h"
@@ -75,6 +77,22 @@ class WPILIB_DLLEXPORT Odometry {
   const Pose2d& Update(const Rotation2d& gyroAngle,
                        const WheelPositions& wheelPositions);
 
+  /**
+   * Updates the robot's position on the field with a sequence of samples, as
+   * if Update() were called for each one. The forward kinematics for the
+   * samples are computed in batches, which is faster when replaying recorded
+   * odometry. This doesn't allocate.
+   *
+   * @param gyroAngles The angle reported by the gyroscope at each sample.
+   * @param wheelPositions The distances measured by each wheel at each sample.
+   * @param poses The pose of the robot after each sample. Must be the same
+   * size as gyroAngles and wheelPositions.
+   * @throws std::invalid_argument if the sizes don't match.
+   */
+  void UpdateBatch(std::span<const Rotation2d> gyroAngles,
+                   std::span<const WheelPositions> wheelPositions,
+                   std::span<Pose2d> poses);
+
  private:
   const Kinematics<WheelSpeeds, WheelPositions>& m_kinematics;
   Pose2d m_pose;
@@ -6,6 +6,7 @@
 
 #include <concepts>
 #include <cstddef>
+#include <span>
 
 #include <Eigen/QR>
 #include <wpi/SymbolExports.h>
@@ -45,7 +46,9 @@ using SwerveDriveWheelSpeeds = wpi::array<SwerveModuleState, NumModules>;
  *
  * The inverse kinematics: [moduleStates] = [moduleLocations] * [chassisSpeeds]
  * We take the Moore-Penrose pseudoinverse of [moduleLocations] and then
- * multiply by [moduleStates] to get our chassis speeds.
+ * multiply by [moduleStates] to get our chassis speeds. The pseudoinverse is
+ * computed once at construction, so forward kinematics is a single
+ * matrix-vector product.
  *
  * Forward kinematics is also used for odometry -- determining the position of
  * the robot on the field using encoders and a gyro.
@@ -78,7 +81,8 @@ class SwerveDriveKinematics
       // clang-format on
     }
 
-    m_forwardKinematics = m_inverseKinematics.householderQr();
+    m_forwardKinematics = m_inverseKinematics.householderQr().solve(
+        Matrixd<NumModules * 2, NumModules * 2>::Identity());
 
     wpi::math::MathSharedStore::ReportUsage(
         wpi::math::MathUsageId::kKinematics_SwerveDrive, 1);
@@ -95,7 +99,8 @@ class SwerveDriveKinematics
       // clang-format on
     }
 
-    m_forwardKinematics = m_inverseKinematics.householderQr();
+    m_forwardKinematics = m_inverseKinematics.householderQr().solve(
+        Matrixd<NumModules * 2, NumModules * 2>::Identity());
 
     wpi::math::MathSharedStore::ReportUsage(
         wpi::math::MathUsageId::kKinematics_SwerveDrive, 1);
@@ -197,6 +202,21 @@ class SwerveDriveKinematics
   ChassisSpeeds ToChassisSpeeds(const wpi::array<SwerveModuleState, NumModules>&
                                     moduleStates) const override;
 
+  /**
+   * Performs forward kinematics on a batch of module state samples. This
+   * doesn't allocate.
+   *
+   * @param moduleStates The module states of each sample. The order of the
+   * swerve module states should be same as passed into the constructor of this
+   * class.
+   * @param chassisSpeeds The resulting chassis speed of each sample. Must be
+   * the same size as moduleStates.
+   * @throws std::invalid_argument if the sizes don't match.
+   */
+  void ToChassisSpeeds(
+      std::span<const wpi::array<SwerveModuleState, NumModules>> moduleStates,
+      std::span<ChassisSpeeds> chassisSpeeds) const;
+
   /**
    * Performs forward kinematics to return the resulting Twist2d from the
    * given module position deltas. This method is often used for odometry --
@@ -235,16 +255,11 @@ class SwerveDriveKinematics
 
   Twist2d ToTwist2d(
       const SwerveDriveWheelPositions<NumModules>& start,
-      const SwerveDriveWheelPositions<NumModules>& end) const override {
-    auto result =
-        wpi::array<SwerveModulePosition, NumModules>(wpi::empty_array);
-    for (size_t i = 0; i < NumModules; i++) {
-      auto startModule = start.positions[i];
-      auto endModule = end.positions[i];
-      result[i] = {endModule.distance - startModule.distance, endModule.angle};
-    }
-    return ToTwist2d(result);
-  }
+      const SwerveDriveWheelPositions<NumModules>& end) const override;
+
+  void ToTwist2ds(const SwerveDriveWheelPositions<NumModules>& start,
+                  std::span<const SwerveDriveWheelPositions<NumModules>> ends,
+                  std::span<Twist2d> twists) const override;
 
   /**
    * Renormalizes the wheel speeds if any individual speed is above the
@@ -295,7 +310,7 @@ class SwerveDriveKinematics
 
  private:
   mutable Matrixd<NumModules * 2, 3> m_inverseKinematics;
-  Eigen::HouseholderQR<Matrixd<NumModules * 2, 3>> m_forwardKinematics;
+  Matrixd<3, NumModules * 2> m_forwardKinematics;
   wpi::array<Translation2d, NumModules> m_modules;
   mutable wpi::array<Rotation2d, NumModules> m_moduleHeadings;
 
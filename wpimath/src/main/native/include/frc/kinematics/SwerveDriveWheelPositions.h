@@ -19,7 +19,7 @@ struct WPILIB_DLLEXPORT SwerveDriveWheelPositions {
   /**
    * The distances driven by the wheels.
    */
-  wpi::array<SwerveModulePosition, NumModules> positions;
+  wpi::array<SwerveModulePosition, NumModules> positions{wpi::empty_array};
 
   /**
    * Checks equality between this SwerveDriveWheelPositions and another object.
@@ -0,0 +1,156 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <wpi/SymbolExports.h>
+
+#include "frc/trajectory/Trajectory.h"
+#include "units/time.h"
+
+namespace frc {
+
+/**
+ * A trajectory resampled at a fixed time step for fast sampling.
+ *
+ * Trajectory::Sample() binary searches the trajectory's states and then
+ * interpolates along the path. This class instead samples the trajectory once
+ * at a fixed time step and stores each field in its own contiguous array, so
+ * sampling is O(1) and scanning ahead (e.g., for lookahead points) walks
+ * sequential memory.
+ *
+ * Samples at the grid points match Trajectory::Sample() exactly. Between grid
+ * points, the acceleration is held from the previous sample, the heading's
+ * cosine and sine are interpolated and renormalized, and the other fields are
+ * interpolated linearly. With the default 5 ms time step, positions are within
+ * about a millimeter of Trajectory::Sample(). Where the acceleration changes
+ * between two grid points, the velocity and acceleration lag the original
+ * trajectory by up to one time step.
+ */
+class WPILIB_DLLEXPORT ResampledTrajectory {
+ public:
+  /**
+   * Resamples a trajectory at a fixed time step. The last sample is always
+   * at the end of the trajectory, so the last interval may be shorter than
+   * the time step.
+   *
+   * @param trajectory The trajectory to resample.
+   * @param dt         The time step between samples.
+   * @throws std::invalid_argument if dt isn't positive.
+   */
+  explicit ResampledTrajectory(const Trajectory& trajectory,
+                               units::second_t dt = 5_ms);
+
+  /**
+   * Returns the time step between samples.
+   *
+   * @return The time step between samples.
+   */
+  units::second_t Dt() const { return units::second_t{m_dt}; }
+
+  /**
+   * Returns the overall duration of the trajectory.
+   *
+   * @return The duration of the trajectory.
+   */
+  units::second_t TotalTime() const { return units::second_t{m_t.back()}; }
+
+  /**
+   * Returns the number of samples.
+   *
+   * @return The number of samples.
+   */
+  size_t Size() const { return m_t.size(); }
+
+  /**
+   * Returns the index of the last sample at or before the given time. Times
+   * outside the trajectory are clamped to the first or last sample, and NaN is
+   * treated as the start of the trajectory.
+   *
+   * @param t The point in time since the beginning of the trajectory.
+   * @return The sample index.
+   */
+  size_t Index(units::second_t t) const;
+
+  /**
+   * Returns the state at a sample index.
+   *
+   * @param index The sample index. Must be less than Size().
+   * @return The state at that index.
+   */
+  Trajectory::State GetState(size_t index) const;
+
+  /**
+   * Sample the trajectory at a point in time in constant time. Times outside
+   * the trajectory are clamped to its ends, and NaN is treated as the start.
+   *
+   * @param t The point in time since the beginning of the trajectory to sample.
+   * @return The state at that point in time.
+   */
+  Trajectory::State Sample(units::second_t t) const;
+
+  /**
+   * Converts the samples back into a Trajectory.
+   *
+   * @return A trajectory with one state per sample.
+   */
+  Trajectory ToTrajectory() const;
+
+  /**
+   * Returns the time of each sample in seconds.
+   */
+  std::span<const double> Times() const { return m_t; }
+
+  /**
+   * Returns the x position of each sample in meters.
+   */
+  std::span<const double> X() const { return m_x; }
+
+  /**
+   * Returns the y position of each sample in meters.
+   */
+  std::span<const double> Y() const { return m_y; }
+
+  /**
+   * Returns the cosine of the heading of each sample.
+   */
+  std::span<const double> Cos() const { return m_cos; }
+
+  /**
+   * Returns the sine of the heading of each sample.
+   */
+  std::span<const double> Sin() const { return m_sin; }
+
+  /**
+   * Returns the velocity of each sample in meters per second.
+   */
+  std::span<const double> Velocity() const { return m_velocity; }
+
+  /**
+   * Returns the acceleration of each sample in meters per second squared.
+   */
+  std::span<const double> Acceleration() const { return m_acceleration; }
+
+  /**
+   * Returns the curvature of each sample in radians per meter.
+   */
+  std::span<const double> Curvature() const { return m_curvature; }
+
+ private:
+  double m_dt;
+  std::vector<double> m_t;
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  std::vector<double> m_cos;
+  std::vector<double> m_sin;
+  std::vector<double> m_velocity;
+  std::vector<double> m_acceleration;
+  std::vector<double> m_curvature;
+};
+
+}  // namespace frc
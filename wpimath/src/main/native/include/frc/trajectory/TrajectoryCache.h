@@ -0,0 +1,88 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <wpi/SymbolExports.h>
+
+#include "frc/geometry/Pose2d.h"
+#include "frc/trajectory/Trajectory.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+
+namespace frc {
+
+/**
+ * An on-disk cache of generated trajectories. Trajectories are keyed by their
+ * waypoints, the config's velocity and acceleration limits, whether the config
+ * is reversed, the types and parameters of the config's constraints, the
+ * generator version, and a user-provided version string. On a hit, the
+ * trajectory is loaded from disk instead of being regenerated, which makes
+ * robot startup with many pregenerated paths much faster after the first boot.
+ *
+ * Only configs whose constraints are all MaxVelocityConstraint,
+ * CentripetalAccelerationConstraint, DifferentialDriveKinematicsConstraint, or
+ * DifferentialDriveVoltageConstraint are cached, since the cache can't read
+ * the parameters of other constraints. Trajectories with any other constraint
+ * are always generated.
+ *
+ * The cache is best-effort: if a file can't be read or written, the trajectory
+ * is generated as usual.
+ */
+class WPILIB_DLLEXPORT TrajectoryCache {
+ public:
+  /**
+   * Constructs a trajectory cache.
+   *
+   * @param directory The directory to store cached trajectories in. It's
+   *                  created if it doesn't exist.
+   * @param version   A version string that's part of every key. Change it to
+   *                  discard trajectories cached with an older version.
+   */
+  explicit TrajectoryCache(std::string_view directory,
+                           std::string_view version = "");
+
+  /**
+   * Loads a trajectory from the cache, or generates it with
+   * TrajectoryGenerator::GenerateTrajectory() and stores it if it isn't
+   * cached.
+   *
+   * @param waypoints List of waypoints.
+   * @param config    The configuration for the trajectory.
+   * @return The trajectory.
+   */
+  Trajectory GenerateTrajectory(const std::vector<Pose2d>& waypoints,
+                                const TrajectoryConfig& config) const;
+
+  /**
+   * Loads trajectories from the cache. The ones that aren't cached are
+   * generated in parallel with TrajectoryGenerator::GenerateTrajectories()
+   * and stored.
+   *
+   * @param waypoints List of waypoint lists, one for each trajectory.
+   * @param config    The configuration for the trajectories.
+   * @return The trajectories, in the same order as the waypoints.
+   */
+  std::vector<Trajectory> GenerateTrajectories(
+      std::span<const std::vector<Pose2d>> waypoints,
+      const TrajectoryConfig& config) const;
+
+ private:
+  static bool IsCacheable(const TrajectoryConfig& config);
+  std::optional<std::string> MakeKey(const std::vector<Pose2d>& waypoints,
+                                     const TrajectoryConfig& config) const;
+  std::string MakePath(std::string_view key) const;
+  std::optional<Trajectory> Load(std::string_view key) const;
+  void Store(std::string_view key, const Trajectory& trajectory) const;
+
+  std::string m_directory;
+  std::string m_version;
+};
+
+}  // namespace frc
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -84,6 +85,25 @@ class WPILIB_DLLEXPORT TrajectoryGenerator {
   static Trajectory GenerateTrajectory(const std::vector<Pose2d>& waypoints,
                                        const TrajectoryConfig& config);
 
+  /**
+   * Generates one trajectory for each list of waypoints using the same config.
+   * The trajectories are generated in parallel across the available hardware
+   * threads, and each one is identical to what GenerateTrajectory() would
+   * return for the same waypoints.
+   *
+   * The config's constraints are shared between threads, so they must be safe
+   * to call concurrently. All of the constraints in this library are. The
+   * error handler may be called from a worker thread, but never from two
+   * threads at once.
+   *
+   * @param waypoints List of waypoint lists, one for each trajectory.
+   * @param config    The configuration for the trajectories.
+   * @return The generated trajectories, in the same order as the waypoints.
+   */
+  static std::vector<Trajectory> GenerateTrajectories(
+      std::span<const std::vector<Pose2d>> waypoints,
+      const TrajectoryConfig& config);
+
   /**
    * Generate spline points from a vector of splines by parameterizing the
    * splines.
@@ -117,6 +137,9 @@ class WPILIB_DLLEXPORT TrajectoryGenerator {
   /**
    * Set error reporting function. By default, it is output to stderr.
    *
+   * Calls to the function are serialized, but they may come from
+   * GenerateTrajectories() worker threads.
+   *
    * @param func Error reporting function.
    */
   static void SetErrorHandler(std::function<void(const char*)> func);
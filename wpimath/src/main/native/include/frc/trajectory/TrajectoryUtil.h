@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <wpi/SymbolExports.h>
 
@@ -50,5 +54,29 @@ class WPILIB_DLLEXPORT TrajectoryUtil {
    * @return the trajectory represented by the JSON
    */
   static Trajectory DeserializeTrajectory(std::string_view jsonStr);
+
+  /**
+   * Serializes a Trajectory to a compact binary format. The format is a
+   * little-endian uint32 state count followed by, for each state, the time,
+   * velocity, acceleration, x, y, heading in radians, and curvature as
+   * little-endian doubles.
+   *
+   * @param trajectory the trajectory to serialize
+   *
+   * @return the serialized bytes
+   */
+  static std::vector<uint8_t> SerializeTrajectoryBinary(
+      const Trajectory& trajectory);
+
+  /**
+   * Deserializes a Trajectory from the format written by
+   * SerializeTrajectoryBinary().
+   *
+   * @param data the serialized bytes
+   *
+   * @return the trajectory represented by the bytes
+   * @throws std::runtime_error if the data is malformed
+   */
+  static Trajectory DeserializeTrajectoryBinary(std::span<const uint8_t> data);
 };
 }  // namespace frc
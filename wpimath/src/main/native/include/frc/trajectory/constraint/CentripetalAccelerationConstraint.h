@@ -35,6 +35,15 @@ class WPILIB_DLLEXPORT CentripetalAccelerationConstraint
   MinMax MinMaxAcceleration(const Pose2d& pose, units::curvature_t curvature,
                             units::meters_per_second_t speed) const override;
 
+  /**
+   * Returns the max centripetal acceleration.
+   *
+   * @return The max centripetal acceleration.
+   */
+  units::meters_per_second_squared_t GetMaxCentripetalAcceleration() const {
+    return m_maxCentripetalAcceleration;
+  }
+
  private:
   units::meters_per_second_squared_t m_maxCentripetalAcceleration;
 };
@@ -30,6 +30,22 @@ class WPILIB_DLLEXPORT DifferentialDriveKinematicsConstraint
   MinMax MinMaxAcceleration(const Pose2d& pose, units::curvature_t curvature,
                             units::meters_per_second_t speed) const override;
 
+  /**
+   * Returns the drive kinematics.
+   *
+   * @return The drive kinematics.
+   */
+  const DifferentialDriveKinematics& GetKinematics() const {
+    return m_kinematics;
+  }
+
+  /**
+   * Returns the max wheel speed.
+   *
+   * @return The max wheel speed.
+   */
+  units::meters_per_second_t GetMaxSpeed() const { return m_maxSpeed; }
+
  private:
   DifferentialDriveKinematics m_kinematics;
   units::meters_per_second_t m_maxSpeed;
@@ -43,6 +43,31 @@ class WPILIB_DLLEXPORT DifferentialDriveVoltageConstraint
   MinMax MinMaxAcceleration(const Pose2d& pose, units::curvature_t curvature,
                             units::meters_per_second_t speed) const override;
 
+  /**
+   * Returns the drive feedforward.
+   *
+   * @return The drive feedforward.
+   */
+  const SimpleMotorFeedforward<units::meter>& GetFeedforward() const {
+    return m_feedforward;
+  }
+
+  /**
+   * Returns the drive kinematics.
+   *
+   * @return The drive kinematics.
+   */
+  const DifferentialDriveKinematics& GetKinematics() const {
+    return m_kinematics;
+  }
+
+  /**
+   * Returns the maximum voltage available to the motors.
+   *
+   * @return The maximum voltage.
+   */
+  units::volt_t GetMaxVoltage() const { return m_maxVoltage; }
+
  private:
   SimpleMotorFeedforward<units::meter> m_feedforward;
   DifferentialDriveKinematics m_kinematics;
@@ -32,6 +32,13 @@ class WPILIB_DLLEXPORT MaxVelocityConstraint : public TrajectoryConstraint {
   MinMax MinMaxAcceleration(const Pose2d& pose, units::curvature_t curvature,
                             units::meters_per_second_t speed) const override;
 
+  /**
+   * Returns the max velocity.
+   *
+   * @return The max velocity.
+   */
+  units::meters_per_second_t GetMaxVelocity() const { return m_maxVelocity; }
+
  private:
   units::meters_per_second_t m_maxVelocity;
 };
@@ -40,4 +40,29 @@ class MerweScaledSigmaPointsTest {
                 .fill(1.0, 1.00173205, 1.0, 0.99826795, 1.0, 2.0, 2.0, 2.00547723, 2.0, 1.99452277),
             1E-6));
   }
+
+  @Test
+  void testNonDiagonalSquareRootPoints() {
+    // S is upper triangular with P = SᵀS, so the points are spread along the columns of Sᵀ
+    var merweScaledSigmaPoints = new MerweScaledSigmaPoints<>(Nat.N2());
+    var points =
+        merweScaledSigmaPoints.squareRootSigmaPoints(
+            VecBuilder.fill(0, 0), Matrix.mat(Nat.N2(), Nat.N2()).fill(1, 2, 0, 3));
+
+    assertTrue(
+        points.isEqual(
+            Matrix.mat(Nat.N2(), Nat.N5())
+                .fill(
+                    0.0,
+                    0.00173205,
+                    0.0,
+                    -0.00173205,
+                    0.0,
+                    0.0,
+                    0.00346410,
+                    0.00519615,
+                    -0.00346410,
+                    -0.00519615),
+            1E-6));
+  }
 }
@@ -27,6 +27,7 @@ import edu.wpi.first.math.trajectory.TrajectoryConfig;
 import edu.wpi.first.math.trajectory.TrajectoryGenerator;
 import java.util.Arrays;
 import java.util.List;
+import java.util.function.BiFunction;
 import org.junit.jupiter.api.Test;
 
 class UnscentedKalmanFilterTest {
@@ -269,4 +270,59 @@ class UnscentedKalmanFilterTest {
 
     assertTrue(observer.getP().isEqual(P, 1e-9));
   }
+
+  @Test
+  void testLinearMatchesEKF() {
+    // For a linear model the UKF is exact, so it must track the EKF step for step
+    final var dt = 0.020;
+    final var A =
+        Matrix.mat(Nat.N3(), Nat.N3()).fill(0.0, 1.0, 0.0, -2.0, -0.5, 1.0, 0.3, 0.0, -3.0);
+    final var B = VecBuilder.fill(0.0, 1.0, 0.5);
+    final var C = Matrix.mat(Nat.N2(), Nat.N3()).fill(1.0, 0.5, 0.0, 0.0, 1.0, -1.0);
+
+    BiFunction<Matrix<N3, N1>, Matrix<N1, N1>, Matrix<N3, N1>> f =
+        (x, u) -> A.times(x).plus(B.times(u));
+    BiFunction<Matrix<N3, N1>, Matrix<N1, N1>, Matrix<N2, N1>> h = (x, u) -> C.times(x);
+
+    var ukf =
+        new UnscentedKalmanFilter<>(
+            Nat.N3(),
+            Nat.N2(),
+            f,
+            h,
+            VecBuilder.fill(0.5, 0.2, 0.3),
+            VecBuilder.fill(0.1, 0.4),
+            dt);
+    var ekf =
+        new ExtendedKalmanFilter<>(
+            Nat.N3(),
+            Nat.N1(),
+            Nat.N2(),
+            f,
+            h,
+            VecBuilder.fill(0.5, 0.2, 0.3),
+            VecBuilder.fill(0.1, 0.4),
+            dt);
+
+    var P = Matrix.mat(Nat.N3(), Nat.N3()).fill(2.0, 0.5, 0.1, 0.5, 1.0, -0.3, 0.1, -0.3, 0.7);
+    ukf.setP(P);
+    ekf.setP(P);
+
+    Matrix<N3, N1> x = VecBuilder.fill(1.0, -1.0, 0.5);
+    for (int i = 0; i < 100; ++i) {
+      var u = VecBuilder.fill(Math.sin(i * 0.1));
+      x = NumericalIntegration.rk4(f, x, u, dt);
+      var y = h.apply(x, u).plus(VecBuilder.fill(0.05, -0.02));
+
+      ukf.predict(u, dt);
+      ekf.predict(u, dt);
+      assertTrue(ukf.getXhat().isEqual(ekf.getXhat(), 1e-6));
+      assertTrue(ukf.getP().isEqual(ekf.getP(), 1e-6));
+
+      ukf.correct(u, y);
+      ekf.correct(u, y);
+      assertTrue(ukf.getXhat().isEqual(ekf.getXhat(), 1e-6));
+      assertTrue(ukf.getP().isEqual(ekf.getP(), 1e-6));
+    }
+  }
 }
@@ -0,0 +1,75 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "frc/controller/GainTable.h"
+#include "frc/controller/LinearQuadraticRegulator.h"
+
+TEST(GainTableTest, GridPoints) {
+  frc::GainTable<2, 1> table{-1.0, 1.0, 5};
+
+  EXPECT_EQ(5u, table.Size());
+  EXPECT_DOUBLE_EQ(-1.0, table.Point(0));
+  EXPECT_DOUBLE_EQ(-0.5, table.Point(1));
+  EXPECT_DOUBLE_EQ(0.0, table.Point(2));
+  EXPECT_DOUBLE_EQ(0.5, table.Point(3));
+  EXPECT_EQ(1.0, table.Point(4));
+}
+
+TEST(GainTableTest, Interpolation) {
+  frc::GainTable<2, 1> table{0.0, 2.0, 3, [](double x) {
+                               return frc::Matrixd<1, 2>{{x, -2.0 * x}};
+                             }};
+
+  // Grid points
+  EXPECT_DOUBLE_EQ(1.0, table(1.0)(0, 0));
+  EXPECT_DOUBLE_EQ(-2.0, table(1.0)(0, 1));
+
+  // Between grid points
+  EXPECT_DOUBLE_EQ(0.25, table(0.25)(0, 0));
+  EXPECT_DOUBLE_EQ(-3.5, table(1.75)(0, 1));
+
+  // Outside the grid
+  EXPECT_DOUBLE_EQ(0.0, table(-5.0)(0, 0));
+  EXPECT_DOUBLE_EQ(2.0, table(5.0)(0, 0));
+  EXPECT_DOUBLE_EQ(2.0, table(2.0)(0, 0));
+}
+
+TEST(GainTableTest, Set) {
+  frc::GainTable<1, 1> table{0.0, 1.0, 2};
+  EXPECT_DOUBLE_EQ(0.0, table(0.5)(0, 0));
+
+  table.Set(1, frc::Matrixd<1, 1>{{4.0}});
+  EXPECT_DOUBLE_EQ(4.0, table.At(1)(0, 0));
+  EXPECT_DOUBLE_EQ(2.0, table(0.5)(0, 0));
+}
+
+TEST(GainTableTest, MatchesLQR) {
+  constexpr auto kDt = 5_ms;
+  frc::Matrixd<2, 1> B{{0.0}, {1.0}};
+  auto makeLQR = [&](double velocity) {
+    frc::Matrixd<2, 2> A{{0.0, velocity}, {0.0, -1.0}};
+    return frc::LinearQuadraticRegulator<2, 1>{A, B, {0.1, 1.0}, {12.0}, kDt};
+  };
+
+  frc::GainTable<2, 1> table{
+      0.5, 3.0, 26, [&](double velocity) { return makeLQR(velocity).K(); }};
+
+  for (size_t i = 0; i < table.Size(); ++i) {
+    EXPECT_TRUE(table.At(i).isApprox(makeLQR(table.Point(i)).K()));
+  }
+
+  // The gains are smooth in the velocity, so interpolating between grid
+  // points is close to the exact gain
+  EXPECT_TRUE(table(1.234).isApprox(makeLQR(1.234).K(), 1e-3));
+}
+
+TEST(GainTableTest, InvalidGrid) {
+  EXPECT_THROW((frc::GainTable<1, 1>{0.0, 1.0, 1}), std::invalid_argument);
+  EXPECT_THROW((frc::GainTable<1, 1>{1.0, 1.0, 2}), std::invalid_argument);
+  EXPECT_THROW((frc::GainTable<1, 1>{2.0, 1.0, 2}), std::invalid_argument);
+}
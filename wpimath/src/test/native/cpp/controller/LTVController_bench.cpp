@@ -0,0 +1,88 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <vector>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+#include <wpi/interpolating_map.h>
+
+#include "frc/controller/GainTable.h"
+#include "frc/controller/LTVDifferentialDriveController.h"
+#include "frc/controller/LTVUnicycleController.h"
+#include "frc/system/plant/LinearSystemId.h"
+
+namespace {
+constexpr int kConstructions = 20;
+constexpr int kLookups = 1000000;
+}  // namespace
+
+TEST(LTVControllerBenchmark, Construction) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < kConstructions; ++i) {
+    frc::LTVUnicycleController controller{20_ms};
+  }
+  auto unicycleTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  auto plant = frc::LinearSystemId::IdentifyDrivetrainSystem(
+      3.02_V / 1_mps, 0.642_V / 1_mps_sq, 1.382_V / 1_mps,
+      0.08495_V / 1_mps_sq);
+  start = high_resolution_clock::now();
+  for (int i = 0; i < kConstructions; ++i) {
+    frc::LTVDifferentialDriveController controller{
+        plant, 0.9_m, {0.0625, 0.125, 2.0, 0.95, 0.95}, {12.0, 12.0}, 20_ms};
+  }
+  auto diffDriveTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  fmt::print(
+      "LTVUnicycleController: {} us LTVDifferentialDriveController: {} us\n",
+      unicycleTime.count() / kConstructions,
+      diffDriveTime.count() / kConstructions);
+}
+
+TEST(LTVControllerBenchmark, GainLookup) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  // Same grid as LTVDifferentialDriveController
+  auto gain = [](double velocity) {
+    return frc::Matrixd<2, 5>::Constant(velocity);
+  };
+  wpi::interpolating_map<double, frc::Matrixd<2, 5>> map;
+  for (int i = -390; i <= 390; ++i) {
+    map.insert(i * 0.01, gain(i * 0.01));
+  }
+  frc::GainTable<5, 2> table{-3.9, 3.9, 781, gain};
+
+  std::vector<double> velocities;
+  for (int i = 0; i < 1000; ++i) {
+    velocities.push_back(-4.0 + 0.008 * i);
+  }
+  double sum = 0.0;
+
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < kLookups; ++i) {
+    sum += map[velocities[i % velocities.size()]](1, 4);
+  }
+  auto mapTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  start = high_resolution_clock::now();
+  for (int i = 0; i < kLookups; ++i) {
+    sum += table(velocities[i % velocities.size()])(1, 4);
+  }
+  auto tableTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  fmt::print("interpolating_map: {} us GainTable: {} us ({})\n",
+             mapTime.count(), tableTime.count(), sum);
+}
@@ -0,0 +1,153 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "frc/EigenCore.h"
+#include "frc/StateSpaceUtil.h"
+#include "frc/estimator/ExtendedKalmanFilter.h"
+#include "frc/estimator/KalmanFilter.h"
+#include "frc/estimator/KalmanFilterLatencyCompensator.h"
+#include "frc/estimator/UnscentedKalmanFilter.h"
+#include "frc/system/LinearSystem.h"
+#include "units/time.h"
+
+namespace {
+
+// Position and velocity of a damped mass driven by a force
+frc::Vectord<2> Dynamics(const frc::Vectord<2>& x, const frc::Vectord<1>& u) {
+  return frc::Vectord<2>{x(1), -x(1) + u(0)};
+}
+
+frc::Vectord<1> LocalMeasurementModel(const frc::Vectord<2>& x,
+                                      const frc::Vectord<1>& u) {
+  static_cast<void>(u);
+  return frc::Vectord<1>{x(1)};
+}
+
+frc::Vectord<2> GlobalMeasurementModel(const frc::Vectord<2>& x,
+                                       const frc::Vectord<1>& u) {
+  static_cast<void>(u);
+  return x;
+}
+
+constexpr auto kDt = 5_ms;
+
+}  // namespace
+
+TEST(KalmanFilterLatencyCompensatorTest, IgnoresMeasurementsOutsideHistory) {
+  frc::LinearSystem<2, 1, 1> plant{
+      frc::Matrixd<2, 2>{{0.0, 1.0}, {0.0, -1.0}}, frc::Matrixd<2, 1>{0.0, 1.0},
+      frc::Matrixd<1, 2>{1.0, 0.0}, frc::Matrixd<1, 1>{0.0}};
+  frc::KalmanFilter<2, 1, 1> observer{plant, {0.1, 0.1}, {0.01}, kDt};
+  frc::KalmanFilterLatencyCompensator<2, 1, 1, frc::KalmanFilter<2, 1, 1>>
+      compensator;
+
+  frc::Vectord<1> u{1.0};
+  int corrections = 0;
+  auto globalCorrect = [&](const frc::Vectord<1>&, const frc::Vectord<2>& y) {
+    observer.SetXhat(y);
+    ++corrections;
+  };
+
+  // No snapshots yet
+  compensator.ApplyPastGlobalMeasurement<2>(&observer, kDt, frc::Vectord<2>{},
+                                            globalCorrect, 0_s);
+  EXPECT_EQ(corrections, 0);
+
+  // Wrap the snapshot buffer around several times; only the newest 300
+  // snapshots (from 3.5 s on) are kept
+  for (int i = 0; i < 1000; ++i) {
+    observer.Predict(u, kDt);
+    observer.Correct(u, frc::Vectord<1>{1.0});
+    compensator.AddObserverState(observer, u, frc::Vectord<1>{1.0}, i * kDt);
+  }
+
+  frc::Vectord<2> xHat = observer.Xhat();
+  compensator.ApplyPastGlobalMeasurement<2>(
+      &observer, kDt, frc::Vectord<2>{10.0, 1.0}, globalCorrect, 3.4_s);
+  EXPECT_EQ(corrections, 0);
+  EXPECT_EQ(observer.Xhat(), xHat);
+
+  compensator.ApplyPastGlobalMeasurement<2>(
+      &observer, kDt, frc::Vectord<2>{10.0, 1.0}, globalCorrect, 4.9_s);
+  EXPECT_EQ(corrections, 1);
+  EXPECT_NE(observer.Xhat(), xHat);
+
+  compensator.Reset();
+  compensator.ApplyPastGlobalMeasurement<2>(
+      &observer, kDt, frc::Vectord<2>{10.0, 1.0}, globalCorrect, 4.9_s);
+  EXPECT_EQ(corrections, 1);
+}
+
+TEST(KalmanFilterLatencyCompensatorTest, RestoresCovariance) {
+  frc::ExtendedKalmanFilter<2, 1, 1> ekf{
+      Dynamics, LocalMeasurementModel, {0.1, 0.1}, {0.01}, kDt};
+  frc::UnscentedKalmanFilter<2, 1, 1> ukf{
+      Dynamics, LocalMeasurementModel, {0.1, 0.1}, {0.01}, kDt};
+  frc::KalmanFilterLatencyCompensator<2, 1, 1,
+                                      frc::ExtendedKalmanFilter<2, 1, 1>>
+      ekfCompensator;
+  frc::KalmanFilterLatencyCompensator<2, 1, 1,
+                                      frc::UnscentedKalmanFilter<2, 1, 1>>
+      ukfCompensator;
+
+  frc::Vectord<1> u{1.0};
+  for (int i = 0; i < 100; ++i) {
+    ekf.Predict(u, kDt);
+    ekf.Correct(u, frc::Vectord<1>{1.0});
+    ekfCompensator.AddObserverState(ekf, u, frc::Vectord<1>{1.0}, i * kDt);
+    ukf.Predict(u, kDt);
+    ukf.Correct(u, frc::Vectord<1>{1.0});
+    ukfCompensator.AddObserverState(ukf, u, frc::Vectord<1>{1.0}, i * kDt);
+  }
+
+  // Position is unobservable from the local measurements, so its variance
+  // grows until the global measurement is applied
+  auto R = frc::MakeCovMatrix(0.01, 0.01);
+  double ekfPosition = ekf.Xhat(0);
+  double ukfPosition = ukf.Xhat(0);
+  double ekfVariance = ekf.P(0, 0);
+  double ukfVariance = ukf.P()(0, 0);
+  ekf.SetP(frc::Matrixd<2, 2>::Identity() * 1e6);
+  ukf.SetP(frc::Matrixd<2, 2>::Identity() * 1e6);
+
+  ekfCompensator.ApplyPastGlobalMeasurement<2>(
+      &ekf, kDt, frc::Vectord<2>{5.0, 1.0},
+      [&](const frc::Vectord<1>& u, const frc::Vectord<2>& y) {
+        ekf.Correct<2>(u, y, GlobalMeasurementModel, R);
+      },
+      250_ms);
+  ukfCompensator.ApplyPastGlobalMeasurement<2>(
+      &ukf, kDt, frc::Vectord<2>{5.0, 1.0},
+      [&](const frc::Vectord<1>& u, const frc::Vectord<2>& y) {
+        ukf.Correct<2>(u, y, GlobalMeasurementModel, R);
+      },
+      250_ms);
+
+  // The covariance was restored from the snapshot rather than left at the
+  // value set above, and the global measurement reduced it and moved the
+  // position estimate towards the measurement
+  EXPECT_LT(ekf.P(0, 0), ekfVariance);
+  EXPECT_LT(ukf.P()(0, 0), ukfVariance);
+  EXPECT_GT(ekf.Xhat(0), ekfPosition);
+  EXPECT_GT(ukf.Xhat(0), ukfPosition);
+  EXPECT_LT(ekf.Xhat(0), 5.0 + 0.25);
+  EXPECT_LT(ukf.Xhat(0), 5.0 + 0.25);
+}
+
+TEST(KalmanFilterLatencyCompensatorTest, SnapshotStoresSquareRootCovariance) {
+  frc::UnscentedKalmanFilter<2, 1, 1> ukf{
+      Dynamics, LocalMeasurementModel, {0.1, 0.1}, {0.01}, kDt};
+  ukf.SetP(frc::Matrixd<2, 2>{{2.0, 0.5}, {0.5, 1.0}});
+
+  using Compensator =
+      frc::KalmanFilterLatencyCompensator<2, 1, 1,
+                                          frc::UnscentedKalmanFilter<2, 1, 1>>;
+  Compensator::ObserverSnapshot snapshot{ukf, frc::Vectord<1>{1.0},
+                                         frc::Vectord<1>{1.0}};
+  EXPECT_EQ(ukf.S(), snapshot.squareRootErrorCovariances);
+}
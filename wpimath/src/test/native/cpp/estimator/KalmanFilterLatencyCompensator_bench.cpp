@@ -0,0 +1,96 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <string_view>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "frc/EigenCore.h"
+#include "frc/StateSpaceUtil.h"
+#include "frc/estimator/ExtendedKalmanFilter.h"
+#include "frc/estimator/KalmanFilter.h"
+#include "frc/estimator/KalmanFilterLatencyCompensator.h"
+#include "frc/estimator/UnscentedKalmanFilter.h"
+#include "frc/system/LinearSystem.h"
+#include "units/time.h"
+
+namespace {
+
+constexpr auto kDt = 5_ms;
+
+frc::Vectord<2> Dynamics(const frc::Vectord<2>& x, const frc::Vectord<1>& u) {
+  return frc::Vectord<2>{x(1), -x(1) + u(0)};
+}
+
+frc::Vectord<1> LocalMeasurementModel(const frc::Vectord<2>& x,
+                                      const frc::Vectord<1>& u) {
+  static_cast<void>(u);
+  return frc::Vectord<1>{x(0)};
+}
+
+// Records a full history, then repeatedly applies a 100 ms old global
+// measurement with one new observer state in between.
+template <typename Observer>
+void Benchmark(std::string_view name, Observer& observer) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  static constexpr int kNumMeasurements = 1000;
+
+  frc::KalmanFilterLatencyCompensator<2, 1, 1, Observer> compensator;
+  frc::Vectord<1> u{1.0};
+  units::second_t t = 0_s;
+  auto step = [&] {
+    observer.Predict(u, kDt);
+    observer.Correct(u, frc::Vectord<1>{t.value()});
+    compensator.AddObserverState(observer, u, frc::Vectord<1>{t.value()}, t);
+    t += kDt;
+  };
+  while (t < 2_s) {
+    step();
+  }
+
+  microseconds addTime{0};
+  microseconds applyTime{0};
+  for (int i = 0; i < kNumMeasurements; ++i) {
+    auto start = high_resolution_clock::now();
+    step();
+    addTime += duration_cast<microseconds>(high_resolution_clock::now() -
+                                           start);
+
+    start = high_resolution_clock::now();
+    compensator.template ApplyPastGlobalMeasurement<1>(
+        &observer, kDt, frc::Vectord<1>{t.value()},
+        [&](const frc::Vectord<1>& u, const frc::Vectord<1>& y) {
+          observer.Correct(u, y);
+        },
+        t - 100_ms);
+    applyTime += duration_cast<microseconds>(high_resolution_clock::now() -
+                                             start);
+  }
+
+  fmt::print("{}: add time: {} us apply time: {} us ({} measurements)\n", name,
+             addTime.count(), applyTime.count(), kNumMeasurements);
+}
+
+}  // namespace
+
+TEST(KalmanFilterLatencyCompensatorTest, Benchmark) {
+  frc::LinearSystem<2, 1, 1> plant{
+      frc::Matrixd<2, 2>{{0.0, 1.0}, {0.0, -1.0}}, frc::Matrixd<2, 1>{0.0, 1.0},
+      frc::Matrixd<1, 2>{1.0, 0.0}, frc::Matrixd<1, 1>{0.0}};
+  frc::KalmanFilter<2, 1, 1> kf{plant, {0.1, 0.1}, {0.01}, kDt};
+  Benchmark("KalmanFilter", kf);
+
+  frc::ExtendedKalmanFilter<2, 1, 1> ekf{
+      Dynamics, LocalMeasurementModel, {0.1, 0.1}, {0.01}, kDt};
+  Benchmark("ExtendedKalmanFilter", ekf);
+
+  frc::UnscentedKalmanFilter<2, 1, 1> ukf{
+      Dynamics, LocalMeasurementModel, {0.1, 0.1}, {0.01}, kDt};
+  Benchmark("UnscentedKalmanFilter", ukf);
+}
@@ -0,0 +1,114 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <optional>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "frc/estimator/SwerveDrivePoseEstimator.h"
+#include "frc/geometry/Pose2d.h"
+#include "frc/kinematics/SwerveDriveKinematics.h"
+
+// Measures the vision measurement fusion rate for a swerve pose estimator
+// with a full pose history, as a function of the odometry rate (and therefore
+// the number of samples in the 1.5 s history).
+TEST(PoseEstimatorTest, Benchmark) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  static constexpr int kNumMeasurements = 2000;
+
+  frc::SwerveDriveKinematics<4> kinematics{
+      frc::Translation2d{1_m, 1_m}, frc::Translation2d{1_m, -1_m},
+      frc::Translation2d{-1_m, -1_m}, frc::Translation2d{-1_m, 1_m}};
+
+  for (double rate : {50.0, 250.0, 1000.0}) {
+    units::second_t dt{1.0 / rate};
+    wpi::array<frc::SwerveModulePosition, 4> positions{wpi::empty_array};
+    frc::SwerveDrivePoseEstimator<4> estimator{
+        kinematics, frc::Rotation2d{}, positions, frc::Pose2d{},
+        {0.1, 0.1, 0.1}, {0.45, 0.45, 0.1}};
+
+    // fill the history
+    units::second_t t = 0_s;
+    auto step = [&] {
+      for (auto& position : positions) {
+        position.distance += 1_mps * dt;
+      }
+      estimator.UpdateWithTime(t, frc::Rotation2d{}, positions);
+      t += dt;
+    };
+    while (t < 2_s) {
+      step();
+    }
+
+    // each measurement is 100 ms old, with one odometry update in between
+    microseconds time{0};
+    for (int i = 0; i < kNumMeasurements; ++i) {
+      step();
+      auto start = high_resolution_clock::now();
+      estimator.AddVisionMeasurement(
+          frc::Pose2d{units::meter_t{t.value()}, 0_m, frc::Rotation2d{}},
+          t - 100_ms);
+      time += duration_cast<microseconds>(high_resolution_clock::now() -
+                                          start);
+    }
+
+    fmt::print("odometry rate: {} Hz history: {} measurements/s: {:.0f}\n",
+               rate, static_cast<int>(rate * 1.5),
+               kNumMeasurements / (time.count() / 1e6));
+  }
+
+  // four cameras with different latencies, applied one at a time or batched
+  using VisionMeasurement = frc::SwerveDrivePoseEstimator<4>::VisionMeasurement;
+  for (bool batch : {false, true}) {
+    units::second_t dt = 4_ms;
+    wpi::array<frc::SwerveModulePosition, 4> positions{wpi::empty_array};
+    frc::SwerveDrivePoseEstimator<4> estimator{
+        kinematics, frc::Rotation2d{}, positions, frc::Pose2d{},
+        {0.1, 0.1, 0.1}, {0.45, 0.45, 0.1}};
+
+    units::second_t t = 0_s;
+    auto step = [&] {
+      for (auto& position : positions) {
+        position.distance += 1_mps * dt;
+      }
+      estimator.UpdateWithTime(t, frc::Rotation2d{}, positions);
+      t += dt;
+    };
+    while (t < 2_s) {
+      step();
+    }
+
+    microseconds time{0};
+    for (int i = 0; i < kNumMeasurements / 4; ++i) {
+      for (int j = 0; j < 5; ++j) {
+        step();
+      }
+      frc::Pose2d pose{units::meter_t{t.value()}, 0_m, frc::Rotation2d{}};
+      VisionMeasurement measurements[] = {{pose, t - 30_ms, std::nullopt},
+                                          {pose, t - 45_ms, std::nullopt},
+                                          {pose, t - 60_ms, std::nullopt},
+                                          {pose, t - 100_ms, std::nullopt}};
+      auto start = high_resolution_clock::now();
+      if (batch) {
+        estimator.AddVisionMeasurements(measurements);
+      } else {
+        for (auto& measurement : measurements) {
+          estimator.AddVisionMeasurement(measurement.visionRobotPose,
+                                         measurement.timestamp);
+        }
+      }
+      time += duration_cast<microseconds>(high_resolution_clock::now() -
+                                          start);
+    }
+
+    fmt::print("4 cameras {}: measurements/s: {:.0f}\n",
+               batch ? "batched" : "sequential",
+               kNumMeasurements / (time.count() / 1e6));
+  }
+}
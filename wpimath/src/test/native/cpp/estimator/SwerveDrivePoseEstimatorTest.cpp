@@ -2,10 +2,13 @@
 // Open Source Software; you can modify and/or share it under the terms of
 // the WPILib BSD license file in the root directory of this project.
 
+#include <algorithm>
 #include <limits>
 #include <numbers>
+#include <optional>
 #include <random>
 #include <tuple>
+#include <vector>
 
 #include <fmt/format.h>
 #include <gtest/gtest.h>
@@ -311,3 +314,75 @@ TEST(SwerveDrivePoseEstimatorTest, TestDiscardStaleVisionMeasurements) {
               estimator.GetEstimatedPosition().Rotation().Radians().value(),
               1e-6);
 }
+
+TEST(SwerveDrivePoseEstimatorTest, BatchedVisionMeasurements) {
+  // A batch of measurements should give exactly the same result as applying
+  // them one at a time in timestamp order.
+  frc::SwerveDriveKinematics<4> kinematics{
+      frc::Translation2d{1_m, 1_m}, frc::Translation2d{1_m, -1_m},
+      frc::Translation2d{-1_m, -1_m}, frc::Translation2d{-1_m, 1_m}};
+
+  wpi::array<frc::SwerveModulePosition, 4> positions{wpi::empty_array};
+
+  frc::SwerveDrivePoseEstimator<4> sequential{
+      kinematics,    frc::Rotation2d{}, positions,
+      frc::Pose2d{}, {0.1, 0.1, 0.1},   {0.45, 0.45, 0.45}};
+  frc::SwerveDrivePoseEstimator<4> batched{
+      kinematics,    frc::Rotation2d{}, positions,
+      frc::Pose2d{}, {0.1, 0.1, 0.1},   {0.45, 0.45, 0.45}};
+
+  using VisionMeasurement =
+      frc::SwerveDrivePoseEstimator<4>::VisionMeasurement;
+
+  int step = 0;
+  for (auto time = 0.0_s; time < 4_s; time += 0.02_s, ++step) {
+    for (auto& position : positions) {
+      position.distance += 0.02_m;
+      position.angle = frc::Rotation2d{time * 0.5_rad_per_s};
+    }
+    frc::Rotation2d gyro{time * 0.1_rad_per_s};
+    sequential.UpdateWithTime(time, gyro, positions);
+    batched.UpdateWithTime(time, gyro, positions);
+
+    if ((step % 10) != 5) {
+      continue;
+    }
+
+    frc::Pose2d pose{units::meter_t{time.value()}, 0.5_m,
+                     frc::Rotation2d{0.2_rad}};
+    std::vector<VisionMeasurement> measurements{
+        {pose, time - 0.05_s, std::nullopt},
+        {pose + frc::Transform2d{0.1_m, 0_m, 0_rad}, time - 0.13_s,
+         wpi::array{0.2, 0.2, 0.5}},
+        {pose, time - 0.05_s, wpi::array{0.9, 0.9, 0.9}},
+        {pose, time - 3_s, std::nullopt},
+        {pose, time + 0.5_s, std::nullopt},
+        {pose + frc::Transform2d{0_m, 0.2_m, 0_rad}, time - 0.051_s,
+         std::nullopt},
+    };
+
+    auto sorted = measurements;
+    std::stable_sort(sorted.begin(), sorted.end(), [](auto& a, auto& b) {
+      return a.timestamp < b.timestamp;
+    });
+    for (auto& measurement : sorted) {
+      if (measurement.visionMeasurementStdDevs) {
+        sequential.AddVisionMeasurement(
+            measurement.visionRobotPose, measurement.timestamp,
+            *measurement.visionMeasurementStdDevs);
+      } else {
+        sequential.AddVisionMeasurement(measurement.visionRobotPose,
+                                        measurement.timestamp);
+      }
+    }
+    batched.AddVisionMeasurements(measurements);
+
+    auto expected = sequential.GetEstimatedPosition();
+    auto actual = batched.GetEstimatedPosition();
+    ASSERT_EQ(expected.X().value(), actual.X().value()) << time.value();
+    ASSERT_EQ(expected.Y().value(), actual.Y().value()) << time.value();
+    ASSERT_EQ(expected.Rotation().Radians().value(),
+              actual.Rotation().Radians().value())
+        << time.value();
+  }
+}
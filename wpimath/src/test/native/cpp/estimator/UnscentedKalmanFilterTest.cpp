@@ -11,6 +11,7 @@
 #include "frc/EigenCore.h"
 #include "frc/StateSpaceUtil.h"
 #include "frc/estimator/AngleStatistics.h"
+#include "frc/estimator/ExtendedKalmanFilter.h"
 #include "frc/estimator/UnscentedKalmanFilter.h"
 #include "frc/system/NumericalIntegration.h"
 #include "frc/system/NumericalJacobian.h"
@@ -185,3 +186,60 @@ TEST(UnscentedKalmanFilterTest, RoundTripP) {
 
   ASSERT_TRUE(observer.P().isApprox(P));
 }
+
+namespace {
+
+// For a linear model, the unscented transform is exact, so the UKF should
+// match the EKF (whose linearization is exact) to numerical precision.
+frc::Vectord<3> LinearDynamics(const frc::Vectord<3>& x,
+                               const frc::Vectord<1>& u) {
+  return frc::Matrixd<3, 3>{{0.0, 1.0, 0.0}, {-2.0, -0.5, 1.0},
+                            {0.3, 0.0, -3.0}} *
+             x +
+         frc::Vectord<3>{0.0, 1.0, 0.5} * u(0);
+}
+
+frc::Vectord<2> LinearMeasurementModel(const frc::Vectord<3>& x,
+                                       const frc::Vectord<1>& u) {
+  static_cast<void>(u);
+  return frc::Matrixd<2, 3>{{1.0, 0.5, 0.0}, {0.0, 1.0, -1.0}} * x;
+}
+
+}  // namespace
+
+TEST(UnscentedKalmanFilterTest, LinearMatchesEKF) {
+  constexpr auto dt = 20_ms;
+
+  frc::UnscentedKalmanFilter<3, 1, 2> ukf{LinearDynamics,
+                                          LinearMeasurementModel,
+                                          {0.5, 0.2, 0.3},
+                                          {0.1, 0.4},
+                                          dt};
+  frc::ExtendedKalmanFilter<3, 1, 2> ekf{LinearDynamics,
+                                         LinearMeasurementModel,
+                                         {0.5, 0.2, 0.3},
+                                         {0.1, 0.4},
+                                         dt};
+
+  frc::Matrixd<3, 3> P{{2.0, 0.5, 0.1}, {0.5, 1.0, -0.3}, {0.1, -0.3, 0.7}};
+  ukf.SetP(P);
+  ekf.SetP(P);
+
+  frc::Vectord<3> x{1.0, -1.0, 0.5};
+  for (int i = 0; i < 100; ++i) {
+    frc::Vectord<1> u{std::sin(i * 0.1)};
+    x = frc::RK4(LinearDynamics, x, u, dt);
+    frc::Vectord<2> noise{0.05, -0.02};
+    frc::Vectord<2> y = LinearMeasurementModel(x, u) + noise;
+
+    ukf.Predict(u, dt);
+    ekf.Predict(u, dt);
+    ASSERT_LT((ukf.Xhat() - ekf.Xhat()).norm(), 1e-6) << i;
+    ASSERT_LT((ukf.P() - ekf.P()).norm(), 1e-6) << i;
+
+    ukf.Correct(u, y);
+    ekf.Correct(u, y);
+    ASSERT_LT((ukf.Xhat() - ekf.Xhat()).norm(), 1e-6) << i;
+    ASSERT_LT((ukf.P() - ekf.P()).norm(), 1e-6) << i;
+  }
+}
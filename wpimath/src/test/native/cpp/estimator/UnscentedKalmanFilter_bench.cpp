@@ -0,0 +1,96 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <cmath>
+#include <string_view>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "frc/EigenCore.h"
+#include "frc/estimator/ExtendedKalmanFilter.h"
+#include "frc/estimator/UnscentedKalmanFilter.h"
+#include "frc/system/NumericalIntegration.h"
+#include "units/time.h"
+
+namespace {
+
+constexpr auto kDt = 5_ms;
+
+// Differential drive with states [x, y, heading, left velocity, right
+// velocity, left position, right position] and inputs [left voltage, right
+// voltage].
+frc::Vectord<7> Dynamics(const frc::Vectord<7>& x, const frc::Vectord<2>& u) {
+  constexpr double kTrackwidth = 0.8382;
+  constexpr double kV = 2.0;
+  constexpr double kA = 0.5;
+
+  double v = 0.5 * (x(3) + x(4));
+  return frc::Vectord<7>{v * std::cos(x(2)),
+                         v * std::sin(x(2)),
+                         (x(4) - x(3)) / kTrackwidth,
+                         (u(0) - kV * x(3)) / kA,
+                         (u(1) - kV * x(4)) / kA,
+                         x(3),
+                         x(4)};
+}
+
+// Measures heading and both encoder positions.
+frc::Vectord<3> LocalMeasurementModel(const frc::Vectord<7>& x,
+                                      const frc::Vectord<2>& u) {
+  static_cast<void>(u);
+  return frc::Vectord<3>{x(2), x(5), x(6)};
+}
+
+// Runs a predict/correct loop and reports the time spent in each step.
+template <typename Observer>
+void Benchmark(std::string_view name, Observer& observer) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  static constexpr int kNumSteps = 5000;
+
+  observer.SetP(frc::Matrixd<7, 7>::Identity() * 0.1);
+
+  frc::Vectord<7> x = frc::Vectord<7>::Zero();
+  microseconds predictTime{0};
+  microseconds correctTime{0};
+  for (int i = 0; i < kNumSteps; ++i) {
+    frc::Vectord<2> u{6.0 + std::sin(i * 0.01), 6.0 - std::sin(i * 0.01)};
+    x = frc::RK4(Dynamics, x, u, kDt);
+
+    auto start = high_resolution_clock::now();
+    observer.Predict(u, kDt);
+    predictTime += duration_cast<microseconds>(high_resolution_clock::now() -
+                                               start);
+
+    start = high_resolution_clock::now();
+    observer.Correct(u, LocalMeasurementModel(x, u));
+    correctTime += duration_cast<microseconds>(high_resolution_clock::now() -
+                                               start);
+  }
+
+  fmt::print("{}: predict time: {} us correct time: {} us ({} steps)\n", name,
+             predictTime.count(), correctTime.count(), kNumSteps);
+}
+
+}  // namespace
+
+TEST(UnscentedKalmanFilterTest, Benchmark) {
+  frc::ExtendedKalmanFilter<7, 2, 3> ekf{Dynamics,
+                                         LocalMeasurementModel,
+                                         {0.1, 0.1, 0.1, 1.0, 1.0, 0.1, 0.1},
+                                         {0.001, 0.01, 0.01},
+                                         kDt};
+  Benchmark("ExtendedKalmanFilter", ekf);
+
+  frc::UnscentedKalmanFilter<7, 2, 3> ukf{Dynamics,
+                                          LocalMeasurementModel,
+                                          {0.1, 0.1, 0.1, 1.0, 1.0, 0.1, 0.1},
+                                          {0.001, 0.01, 0.01},
+                                          kDt};
+  Benchmark("UnscentedKalmanFilter", ukf);
+}
@@ -0,0 +1,79 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "frc/filter/LinearFilter.h"
+#include "frc/filter/MedianFilter.h"
+#include "frc/filter/StaticLinearFilter.h"
+#include "frc/filter/StaticMedianFilter.h"
+
+namespace {
+// Dozens of sensors, each filtered every loop
+constexpr int kFilters = 48;
+constexpr int kSamples = 20000;
+
+template <typename Filter>
+std::chrono::microseconds RunFilters(std::vector<Filter>& filters,
+                                     const std::vector<double>& data,
+                                     double& sum) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < kSamples; ++i) {
+    for (auto& filter : filters) {
+      sum += filter.Calculate(data[i]);
+    }
+  }
+  return duration_cast<microseconds>(high_resolution_clock::now() - start);
+}
+
+std::vector<double> MakeData() {
+  std::mt19937 gen{42};
+  std::normal_distribution<double> dist{0.0, 1.0};
+  std::vector<double> data(kSamples);
+  for (auto& value : data) {
+    value = dist(gen);
+  }
+  return data;
+}
+}  // namespace
+
+TEST(StaticLinearFilterTest, Benchmark) {
+  auto data = MakeData();
+  double sum = 0.0;
+
+  std::vector<frc::LinearFilter<double>> dynamicFilters(
+      kFilters, frc::LinearFilter<double>::MovingAverage(8));
+  auto dynamicTime = RunFilters(dynamicFilters, data, sum);
+
+  std::vector<frc::StaticLinearFilter<double, 8, 0>> staticFilters(
+      kFilters, frc::StaticLinearFilter<double, 8, 0>::MovingAverage());
+  auto staticTime = RunFilters(staticFilters, data, sum);
+
+  fmt::print("LinearFilter: {} us StaticLinearFilter: {} us ({})\n",
+             dynamicTime.count(), staticTime.count(), sum);
+}
+
+TEST(StaticMedianFilterTest, Benchmark) {
+  auto data = MakeData();
+  double sum = 0.0;
+
+  std::vector<frc::MedianFilter<double>> dynamicFilters(
+      kFilters, frc::MedianFilter<double>{7});
+  auto dynamicTime = RunFilters(dynamicFilters, data, sum);
+
+  std::vector<frc::StaticMedianFilter<double, 7>> staticFilters(kFilters);
+  auto staticTime = RunFilters(staticFilters, data, sum);
+
+  fmt::print("MedianFilter: {} us StaticMedianFilter: {} us ({})\n",
+             dynamicTime.count(), staticTime.count(), sum);
+}
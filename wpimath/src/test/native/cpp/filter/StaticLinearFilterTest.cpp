@@ -0,0 +1,74 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "frc/filter/StaticLinearFilter.h"  // NOLINT(build/include_order)
+
+#include <cmath>
+#include <numbers>
+
+#include <gtest/gtest.h>
+
+#include "frc/filter/LinearFilter.h"
+#include "units/length.h"
+#include "units/time.h"
+
+static double GetData(double t) {
+  return 100.0 * std::sin(2.0 * std::numbers::pi * t) +
+         20.0 * std::cos(50.0 * std::numbers::pi * t);
+}
+
+template <size_t FFTaps, size_t FBTaps>
+static void ExpectSameOutput(frc::LinearFilter<double> expected,
+                             frc::StaticLinearFilter<double, FFTaps, FBTaps>
+                                 actual) {
+  for (int i = 0; i < 400; ++i) {
+    double input = GetData(i * 0.005);
+    EXPECT_EQ(expected.Calculate(input), actual.Calculate(input));
+  }
+}
+
+TEST(StaticLinearFilterTest, SinglePoleIIR) {
+  ExpectSameOutput(
+      frc::LinearFilter<double>::SinglePoleIIR(0.015915, 5_ms),
+      frc::StaticLinearFilter<double, 1, 1>::SinglePoleIIR(0.015915, 5_ms));
+}
+
+TEST(StaticLinearFilterTest, HighPass) {
+  ExpectSameOutput(
+      frc::LinearFilter<double>::HighPass(0.006631, 5_ms),
+      frc::StaticLinearFilter<double, 2, 1>::HighPass(0.006631, 5_ms));
+}
+
+TEST(StaticLinearFilterTest, MovingAverage) {
+  ExpectSameOutput(frc::LinearFilter<double>::MovingAverage(6),
+                   frc::StaticLinearFilter<double, 6, 0>::MovingAverage());
+}
+
+TEST(StaticLinearFilterTest, BackwardFiniteDifference) {
+  ExpectSameOutput(
+      frc::LinearFilter<double>::BackwardFiniteDifference<2, 5>(5_ms),
+      frc::StaticLinearFilter<double, 5, 0>::BackwardFiniteDifference<2>(
+          5_ms));
+}
+
+TEST(StaticLinearFilterTest, ArbitraryGains) {
+  ExpectSameOutput(frc::LinearFilter<double>({0.2, 0.3, -0.1}, {-0.5, 0.1}),
+                   frc::StaticLinearFilter<double, 3, 2>({0.2, 0.3, -0.1},
+                                                         {-0.5, 0.1}));
+}
+
+TEST(StaticLinearFilterTest, Reset) {
+  auto filter = frc::StaticLinearFilter<double, 3, 0>::MovingAverage();
+  filter.Calculate(3.0);
+  filter.Calculate(6.0);
+
+  filter.Reset();
+  EXPECT_DOUBLE_EQ(filter.Calculate(3.0), 1.0);
+}
+
+TEST(StaticLinearFilterTest, Units) {
+  auto filter = frc::StaticLinearFilter<units::meter_t, 2, 0>::MovingAverage();
+  filter.Calculate(1_m);
+  EXPECT_EQ(filter.Calculate(3_m), 2_m);
+}
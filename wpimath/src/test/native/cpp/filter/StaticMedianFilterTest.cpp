@@ -0,0 +1,79 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "frc/filter/MedianFilter.h"
+#include "frc/filter/StaticMedianFilter.h"
+
+TEST(StaticMedianFilterTest, NotFullEven) {
+  frc::StaticMedianFilter<double, 10> filter;
+
+  filter.Calculate(3);
+  filter.Calculate(0);
+  filter.Calculate(4);
+
+  EXPECT_EQ(filter.Calculate(1000), 3.5);
+}
+
+TEST(StaticMedianFilterTest, NotFullOdd) {
+  frc::StaticMedianFilter<double, 10> filter;
+
+  filter.Calculate(3);
+  filter.Calculate(0);
+  filter.Calculate(4);
+  filter.Calculate(7);
+
+  EXPECT_EQ(filter.Calculate(1000), 4);
+}
+
+TEST(StaticMedianFilterTest, FullEven) {
+  frc::StaticMedianFilter<double, 6> filter;
+
+  filter.Calculate(3);
+  filter.Calculate(0);
+  filter.Calculate(0);
+  filter.Calculate(5);
+  filter.Calculate(4);
+  filter.Calculate(1000);
+
+  EXPECT_EQ(filter.Calculate(99), 4.5);
+}
+
+TEST(StaticMedianFilterTest, FullOdd) {
+  frc::StaticMedianFilter<double, 5> filter;
+
+  filter.Calculate(3);
+  filter.Calculate(0);
+  filter.Calculate(5);
+  filter.Calculate(4);
+  filter.Calculate(1000);
+
+  EXPECT_EQ(filter.Calculate(99), 5);
+}
+
+TEST(StaticMedianFilterTest, Reset) {
+  frc::StaticMedianFilter<double, 3> filter;
+
+  filter.Calculate(10);
+  filter.Calculate(20);
+  filter.Reset();
+
+  EXPECT_EQ(filter.Calculate(1), 1);
+}
+
+TEST(StaticMedianFilterTest, MatchesMedianFilter) {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> dist{0, 20};
+
+  frc::MedianFilter<double> expected{7};
+  frc::StaticMedianFilter<double, 7> actual;
+  for (int i = 0; i < 1000; ++i) {
+    // Small integers so the window often holds duplicates
+    double value = dist(gen);
+    EXPECT_EQ(expected.Calculate(value), actual.Calculate(value));
+  }
+}
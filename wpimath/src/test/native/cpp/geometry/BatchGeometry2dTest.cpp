@@ -0,0 +1,126 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "frc/geometry/BatchGeometry2d.h"
+
+using namespace frc;
+
+namespace {
+std::vector<Pose2d> MakePoses(int count) {
+  std::mt19937 gen{42};
+  std::uniform_real_distribution<double> position{-8.0, 8.0};
+  std::uniform_real_distribution<double> angle{-std::numbers::pi,
+                                               std::numbers::pi};
+
+  std::vector<Pose2d> poses;
+  for (int i = 0; i < count; ++i) {
+    poses.emplace_back(units::meter_t{position(gen)},
+                       units::meter_t{position(gen)},
+                       units::radian_t{angle(gen)});
+  }
+
+  // Exercise the small-angle and half-turn branches
+  poses.emplace_back(1_m, 2_m, 30_deg);
+  poses.emplace_back(1_m, 2_m, 210_deg);
+  return poses;
+}
+
+void ExpectNear(const Translation2d& expected, const Translation2d& actual) {
+  EXPECT_NEAR(expected.X().value(), actual.X().value(), 1e-9);
+  EXPECT_NEAR(expected.Y().value(), actual.Y().value(), 1e-9);
+}
+
+void ExpectNear(const Pose2d& expected, const Pose2d& actual) {
+  ExpectNear(expected.Translation(), actual.Translation());
+  EXPECT_NEAR(expected.Rotation().Cos(), actual.Rotation().Cos(), 1e-9);
+  EXPECT_NEAR(expected.Rotation().Sin(), actual.Rotation().Sin(), 1e-9);
+}
+}  // namespace
+
+TEST(BatchGeometry2dTest, TransformTranslations) {
+  const Pose2d pose{1_m, 2_m, 30_deg};
+  auto poses = MakePoses(100);
+
+  std::vector<Translation2d> translations;
+  std::vector<double> x;
+  std::vector<double> y;
+  for (const auto& p : poses) {
+    translations.emplace_back(p.Translation());
+    x.emplace_back(p.X().value());
+    y.emplace_back(p.Y().value());
+  }
+
+  std::vector<Translation2d> out(translations.size());
+  BatchTransformTranslations(pose, translations, out);
+
+  // Structure-of-arrays version, in place
+  BatchTransformTranslations(pose, x, y, x, y);
+
+  for (size_t i = 0; i < translations.size(); ++i) {
+    auto expected = pose.TransformBy(Transform2d{translations[i], {}});
+    ExpectNear(expected.Translation(), out[i]);
+    ExpectNear(expected.Translation(),
+               Translation2d{units::meter_t{x[i]}, units::meter_t{y[i]}});
+  }
+}
+
+TEST(BatchGeometry2dTest, RelativeTo) {
+  const Pose2d origin{1_m, 2_m, 30_deg};
+  auto poses = MakePoses(100);
+
+  std::vector<Pose2d> out(poses.size());
+  BatchRelativeTo(poses, origin, out);
+
+  for (size_t i = 0; i < poses.size(); ++i) {
+    ExpectNear(poses[i].RelativeTo(origin), out[i]);
+  }
+}
+
+TEST(BatchGeometry2dTest, Exp) {
+  const Pose2d start{1_m, 2_m, 30_deg};
+
+  std::vector<Twist2d> twists{{0_m, 0_m, 0_rad}, {1_m, 0_m, 0_rad}};
+  for (const auto& p : MakePoses(100)) {
+    twists.emplace_back(p.X(), p.Y(), p.Rotation().Radians());
+  }
+
+  std::vector<Pose2d> out(twists.size());
+  BatchExp(start, twists, out);
+
+  for (size_t i = 0; i < twists.size(); ++i) {
+    ExpectNear(start.Exp(twists[i]), out[i]);
+  }
+}
+
+TEST(BatchGeometry2dTest, Log) {
+  const Pose2d start{1_m, 2_m, 30_deg};
+
+  std::vector<Pose2d> ends{start, Pose2d{3_m, 2_m, 30_deg}};
+  for (const auto& p : MakePoses(100)) {
+    ends.emplace_back(p);
+  }
+
+  std::vector<Twist2d> out(ends.size());
+  BatchLog(start, ends, out);
+
+  for (size_t i = 0; i < ends.size(); ++i) {
+    auto expected = start.Log(ends[i]);
+    EXPECT_NEAR(expected.dx.value(), out[i].dx.value(), 1e-9);
+    EXPECT_NEAR(expected.dy.value(), out[i].dy.value(), 1e-9);
+    EXPECT_NEAR(expected.dtheta.value(), out[i].dtheta.value(), 1e-9);
+  }
+}
+
+TEST(BatchGeometry2dTest, SizeMismatch) {
+  std::vector<Pose2d> poses(3);
+  std::vector<Pose2d> out(2);
+  EXPECT_THROW(BatchRelativeTo(poses, Pose2d{}, out), std::invalid_argument);
+}
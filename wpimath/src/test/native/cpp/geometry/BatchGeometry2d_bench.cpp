@@ -0,0 +1,126 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "frc/geometry/BatchGeometry2d.h"
+
+using namespace frc;
+
+namespace {
+// Corner points and candidate poses processed per vision frame
+constexpr int kCount = 512;
+constexpr int kFrames = 2000;
+
+std::vector<Pose2d> MakePoses() {
+  std::mt19937 gen{42};
+  std::uniform_real_distribution<double> dist{-3.0, 3.0};
+  std::vector<Pose2d> poses;
+  for (int i = 0; i < kCount; ++i) {
+    poses.emplace_back(units::meter_t{dist(gen)}, units::meter_t{dist(gen)},
+                       units::radian_t{dist(gen)});
+  }
+  return poses;
+}
+
+template <typename F>
+std::chrono::microseconds Time(F&& f) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  auto start = high_resolution_clock::now();
+  for (int frame = 0; frame < kFrames; ++frame) {
+    f();
+  }
+  return duration_cast<microseconds>(high_resolution_clock::now() - start);
+}
+}  // namespace
+
+TEST(BatchGeometry2dTest, Benchmark) {
+  const Pose2d robot{2_m, 3_m, 40_deg};
+  auto poses = MakePoses();
+
+  std::vector<Translation2d> translations;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<Twist2d> twists;
+  for (const auto& pose : poses) {
+    translations.emplace_back(pose.Translation());
+    x.emplace_back(pose.X().value());
+    y.emplace_back(pose.Y().value());
+    twists.emplace_back(pose.X(), pose.Y(), pose.Rotation().Radians());
+  }
+
+  std::vector<Translation2d> outTranslations(kCount);
+  std::vector<double> outX(kCount);
+  std::vector<double> outY(kCount);
+  std::vector<Pose2d> outPoses(kCount);
+  std::vector<Twist2d> outTwists(kCount);
+  double sum = 0.0;
+
+  auto scalarTransform = Time([&] {
+    for (int i = 0; i < kCount; ++i) {
+      outTranslations[i] =
+          robot.TransformBy(Transform2d{translations[i], {}}).Translation();
+    }
+    sum += outTranslations[kCount / 2].X().value();
+  });
+  auto batchTransform = Time([&] {
+    BatchTransformTranslations(robot, translations, outTranslations);
+    sum += outTranslations[kCount / 2].X().value();
+  });
+  auto soaTransform = Time([&] {
+    BatchTransformTranslations(robot, x, y, outX, outY);
+    sum += outX[kCount / 2];
+  });
+
+  auto scalarRelativeTo = Time([&] {
+    for (int i = 0; i < kCount; ++i) {
+      outPoses[i] = poses[i].RelativeTo(robot);
+    }
+    sum += outPoses[kCount / 2].X().value();
+  });
+  auto batchRelativeTo = Time([&] {
+    BatchRelativeTo(poses, robot, outPoses);
+    sum += outPoses[kCount / 2].X().value();
+  });
+
+  auto scalarExp = Time([&] {
+    for (int i = 0; i < kCount; ++i) {
+      outPoses[i] = robot.Exp(twists[i]);
+    }
+    sum += outPoses[kCount / 2].X().value();
+  });
+  auto batchExp = Time([&] {
+    BatchExp(robot, twists, outPoses);
+    sum += outPoses[kCount / 2].X().value();
+  });
+
+  auto scalarLog = Time([&] {
+    for (int i = 0; i < kCount; ++i) {
+      outTwists[i] = robot.Log(poses[i]);
+    }
+    sum += outTwists[kCount / 2].dx.value();
+  });
+  auto batchLog = Time([&] {
+    BatchLog(robot, poses, outTwists);
+    sum += outTwists[kCount / 2].dx.value();
+  });
+
+  fmt::print("Transform: scalar {} us batch {} us SoA {} us\n",
+             scalarTransform.count(), batchTransform.count(),
+             soaTransform.count());
+  fmt::print("RelativeTo: scalar {} us batch {} us\n", scalarRelativeTo.count(),
+             batchRelativeTo.count());
+  fmt::print("Exp: scalar {} us batch {} us\n", scalarExp.count(),
+             batchExp.count());
+  fmt::print("Log: scalar {} us batch {} us ({})\n", scalarLog.count(),
+             batchLog.count(), sum);
+}
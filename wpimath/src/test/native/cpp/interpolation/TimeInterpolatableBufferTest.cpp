@@ -3,8 +3,10 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <cmath>
+#include <vector>
 
 #include <gtest/gtest.h>
+#include <wpi/deprecated.h>
 
 #include "frc/geometry/Pose2d.h"
 #include "frc/geometry/Rotation2d.h"
@@ -36,3 +38,80 @@ TEST(TimeInterpolatableBufferTest, Pose2d) {
   EXPECT_TRUE(std::abs(sample.Y().value() - (1 / std::sqrt(2))) < 0.01);
   EXPECT_TRUE(std::abs(sample.Rotation().Degrees().value() - 45) < 0.01);
 }
+
+TEST(TimeInterpolatableBufferTest, Eviction) {
+  frc::TimeInterpolatableBuffer<double> buffer{1_s};
+
+  // run long enough for the ring buffer to wrap around many times
+  for (int i = 0; i <= 1000; ++i) {
+    buffer.AddSample(i * 0.1_s, i);
+    EXPECT_DOUBLE_EQ(buffer.Sample(i * 0.1_s).value(), i);
+  }
+  EXPECT_NEAR(buffer.GetOldestTime().value().value(), 99.0, 1e-9);
+  EXPECT_DOUBLE_EQ(buffer.Sample(0_s).value(), 990);
+  EXPECT_NEAR(buffer.Sample(99.55_s).value(), 995.5, 1e-6);
+  EXPECT_DOUBLE_EQ(buffer.Sample(200_s).value(), 1000);
+
+  buffer.Clear();
+  EXPECT_FALSE(buffer.GetOldestTime());
+  EXPECT_FALSE(buffer.Sample(0_s));
+}
+
+TEST(TimeInterpolatableBufferTest, OutOfOrder) {
+  frc::TimeInterpolatableBuffer<double> buffer{10_s};
+
+  // wrap the ring buffer before inserting out of order
+  for (int i = 0; i < 30; ++i) {
+    buffer.AddSample(i * 1_s, i);
+  }
+  buffer.AddSample(25.5_s, 100);
+  buffer.AddSample(27_s, 200);
+  EXPECT_DOUBLE_EQ(buffer.Sample(25.5_s).value(), 100);
+  EXPECT_DOUBLE_EQ(buffer.Sample(25.25_s).value(), 62.5);
+  EXPECT_DOUBLE_EQ(buffer.Sample(26_s).value(), 26);
+  EXPECT_DOUBLE_EQ(buffer.Sample(27_s).value(), 200);
+  EXPECT_DOUBLE_EQ(buffer.Sample(28_s).value(), 28);
+}
+
+TEST(TimeInterpolatableBufferTest, Replay) {
+  frc::TimeInterpolatableBuffer<double> buffer{10_s};
+  for (int i = 0; i < 30; ++i) {
+    buffer.AddSample(i * 1_s, i);
+  }
+
+  std::vector<units::second_t> times;
+  buffer.Replay(25_s, [&](units::second_t time, double& sample) {
+    times.emplace_back(time);
+    sample *= 2;
+  });
+  EXPECT_EQ(times, (std::vector<units::second_t>{25_s, 26_s, 27_s, 28_s,
+                                                  29_s}));
+  EXPECT_DOUBLE_EQ(buffer.Sample(24_s).value(), 24);
+  EXPECT_DOUBLE_EQ(buffer.Sample(25_s).value(), 50);
+  EXPECT_DOUBLE_EQ(buffer.Sample(29_s).value(), 58);
+}
+
+TEST(TimeInterpolatableBufferTest, GetInternalBuffer) {
+  frc::TimeInterpolatableBuffer<double> buffer{10_s};
+
+  // wrap the ring buffer, then fill it with out of order samples so it grows
+  // while wrapped
+  for (int i = 0; i < 30; ++i) {
+    buffer.AddSample(i * 1_s, i);
+  }
+  for (int i = 20; i < 26; ++i) {
+    buffer.AddSample(i * 1_s + 0.5_s, 100 + i);
+  }
+
+  WPI_IGNORE_DEPRECATED
+  auto& samples = buffer.GetInternalBuffer();
+  WPI_UNIGNORE_DEPRECATED
+  ASSERT_EQ(17u, samples.size());
+  for (size_t i = 1; i < samples.size(); ++i) {
+    EXPECT_LT(samples[i - 1].first, samples[i].first);
+  }
+  EXPECT_EQ(19_s, samples[0].first);
+  EXPECT_EQ(20.5_s, samples[2].first);
+  EXPECT_DOUBLE_EQ(120, samples[2].second);
+  EXPECT_DOUBLE_EQ(29, samples[16].second);
+}
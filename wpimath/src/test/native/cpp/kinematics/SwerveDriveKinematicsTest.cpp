@@ -3,6 +3,8 @@
 // the WPILib BSD license file in the root directory of this project.
 
 #include <numbers>
+#include <stdexcept>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -309,3 +311,55 @@ TEST_F(SwerveDriveKinematicsTest, DesaturateNegativeSpeed) {
   EXPECT_NEAR(arr[2].speed.value(), -1.0, kEpsilon);
   EXPECT_NEAR(arr[3].speed.value(), -1.0, kEpsilon);
 }
+
+TEST_F(SwerveDriveKinematicsTest, BatchForwardKinematics) {
+  std::vector<wpi::array<SwerveModuleState, 4>> moduleStates;
+  for (int i = 0; i < 10; ++i) {
+    moduleStates.push_back(m_kinematics.ToSwerveModuleStates(
+        ChassisSpeeds{units::meters_per_second_t{0.5 * i}, 1_mps,
+                      units::radians_per_second_t{0.1 * i}}));
+  }
+
+  std::vector<ChassisSpeeds> chassisSpeeds(moduleStates.size());
+  m_kinematics.ToChassisSpeeds(moduleStates, chassisSpeeds);
+
+  for (size_t i = 0; i < moduleStates.size(); ++i) {
+    auto expected = m_kinematics.ToChassisSpeeds(moduleStates[i]);
+    EXPECT_DOUBLE_EQ(expected.vx.value(), chassisSpeeds[i].vx.value());
+    EXPECT_DOUBLE_EQ(expected.vy.value(), chassisSpeeds[i].vy.value());
+    EXPECT_DOUBLE_EQ(expected.omega.value(), chassisSpeeds[i].omega.value());
+    EXPECT_NEAR(0.5 * i, chassisSpeeds[i].vx.value(), 1e-9);
+    EXPECT_NEAR(1.0, chassisSpeeds[i].vy.value(), 1e-9);
+    EXPECT_NEAR(0.1 * i, chassisSpeeds[i].omega.value(), 1e-9);
+  }
+}
+
+TEST_F(SwerveDriveKinematicsTest, BatchTwist2ds) {
+  SwerveDriveWheelPositions<4> start{
+      {SwerveModulePosition{}, SwerveModulePosition{}, SwerveModulePosition{},
+       SwerveModulePosition{}}};
+
+  std::vector<SwerveDriveWheelPositions<4>> ends;
+  for (int i = 1; i <= 5; ++i) {
+    auto distance = units::meter_t{0.1 * i};
+    ends.push_back({{SwerveModulePosition{distance, 0_deg},
+                     SwerveModulePosition{distance, 10_deg},
+                     SwerveModulePosition{1.1 * distance, 0_deg},
+                     SwerveModulePosition{distance, -5_deg}}});
+  }
+
+  std::vector<Twist2d> twists(ends.size());
+  m_kinematics.ToTwist2ds(start, ends, twists);
+
+  for (size_t i = 0; i < ends.size(); ++i) {
+    auto expected = m_kinematics.ToTwist2d(i == 0 ? start : ends[i - 1],
+                                           ends[i]);
+    EXPECT_DOUBLE_EQ(expected.dx.value(), twists[i].dx.value());
+    EXPECT_DOUBLE_EQ(expected.dy.value(), twists[i].dy.value());
+    EXPECT_DOUBLE_EQ(expected.dtheta.value(), twists[i].dtheta.value());
+  }
+
+  std::vector<Twist2d> tooShort(ends.size() - 1);
+  EXPECT_THROW(m_kinematics.ToTwist2ds(start, ends, tooShort),
+               std::invalid_argument);
+}
@@ -4,6 +4,7 @@
 
 #include <limits>
 #include <random>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -197,3 +198,33 @@ TEST_F(SwerveDriveOdometryTest, AccuracyFacingXAxis) {
   EXPECT_LT(errorSum / (trajectory.TotalTime().value() / dt.value()), 0.06);
   EXPECT_LT(maxError, 0.125);
 }
+
+TEST_F(SwerveDriveOdometryTest, UpdateBatchMatchesUpdate) {
+  std::default_random_engine generator;
+  std::normal_distribution<double> distribution(0.0, 1.0);
+
+  // More samples than UpdateBatch() processes per chunk
+  std::vector<Rotation2d> gyroAngles;
+  std::vector<SwerveDriveWheelPositions<4>> wheelPositions;
+  SwerveDriveWheelPositions<4> positions{{zero, zero, zero, zero}};
+  for (int i = 0; i < 40; ++i) {
+    for (auto& module : positions.positions) {
+      module.distance += units::meter_t{0.1 + 0.01 * distribution(generator)};
+      module.angle = units::radian_t{0.3 + 0.1 * distribution(generator)};
+    }
+    gyroAngles.emplace_back(units::radian_t{0.02 * i});
+    wheelPositions.push_back(positions);
+  }
+
+  SwerveDriveOdometry<4> batchOdometry{
+      m_kinematics, 0_rad, {zero, zero, zero, zero}};
+  std::vector<Pose2d> poses(gyroAngles.size());
+  batchOdometry.UpdateBatch(gyroAngles, wheelPositions, poses);
+
+  for (size_t i = 0; i < gyroAngles.size(); ++i) {
+    auto expected =
+        m_odometry.Update(gyroAngles[i], wheelPositions[i].positions);
+    EXPECT_EQ(expected, poses[i]);
+  }
+  EXPECT_EQ(m_odometry.GetPose(), batchOdometry.GetPose());
+}
@@ -0,0 +1,137 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <vector>
+
+#include <Eigen/QR>
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "frc/EigenCore.h"
+#include "frc/kinematics/SwerveDriveKinematics.h"
+#include "frc/kinematics/SwerveDriveOdometry.h"
+
+namespace {
+// 1.5 s of pose history at 250 Hz, like a pose estimator replays
+constexpr int kSamples = 375;
+constexpr int kReplays = 2000;
+
+frc::SwerveDriveKinematics<4> MakeKinematics() {
+  return frc::SwerveDriveKinematics<4>{
+      frc::Translation2d{0.3_m, 0.3_m}, frc::Translation2d{0.3_m, -0.3_m},
+      frc::Translation2d{-0.3_m, 0.3_m}, frc::Translation2d{-0.3_m, -0.3_m}};
+}
+}  // namespace
+
+TEST(SwerveDriveKinematicsBenchmark, ForwardKinematics) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  auto kinematics = MakeKinematics();
+
+  std::vector<wpi::array<frc::SwerveModuleState, 4>> moduleStates;
+  for (int i = 0; i < kSamples; ++i) {
+    moduleStates.push_back(kinematics.ToSwerveModuleStates(frc::ChassisSpeeds{
+        units::meters_per_second_t{0.01 * i}, 1_mps,
+        units::radians_per_second_t{0.002 * i}}));
+  }
+  std::vector<frc::ChassisSpeeds> chassisSpeeds(kSamples);
+  double sum = 0.0;
+
+  // The previous implementation solved with a Householder QR decomposition on
+  // every call
+  frc::Matrixd<8, 3> inverseKinematics;
+  const frc::Translation2d modules[] = {{0.3_m, 0.3_m},
+                                        {0.3_m, -0.3_m},
+                                        {-0.3_m, 0.3_m},
+                                        {-0.3_m, -0.3_m}};
+  for (int i = 0; i < 4; ++i) {
+    inverseKinematics.block<2, 3>(i * 2, 0) << 1, 0, -modules[i].Y().value(),
+        0, 1, modules[i].X().value();
+  }
+  Eigen::HouseholderQR<frc::Matrixd<8, 3>> qr =
+      inverseKinematics.householderQr();
+
+  auto start = high_resolution_clock::now();
+  for (int replay = 0; replay < kReplays; ++replay) {
+    for (const auto& states : moduleStates) {
+      frc::Vectord<8> moduleStateVector;
+      for (int i = 0; i < 4; ++i) {
+        moduleStateVector(i * 2) =
+            states[i].speed.value() * states[i].angle.Cos();
+        moduleStateVector(i * 2 + 1) =
+            states[i].speed.value() * states[i].angle.Sin();
+      }
+      Eigen::Vector3d speeds = qr.solve(moduleStateVector);
+      sum += speeds(2);
+    }
+  }
+  auto qrTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  start = high_resolution_clock::now();
+  for (int replay = 0; replay < kReplays; ++replay) {
+    kinematics.ToChassisSpeeds(moduleStates, chassisSpeeds);
+    sum += chassisSpeeds[kSamples / 2].omega.value();
+  }
+  auto batchTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  fmt::print("QR solve: {} us batched pseudoinverse: {} us ({})\n",
+             qrTime.count(), batchTime.count(), sum);
+}
+
+TEST(SwerveDriveOdometryBenchmark, Replay) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  auto kinematics = MakeKinematics();
+
+  std::vector<frc::Rotation2d> gyroAngles;
+  std::vector<frc::SwerveDriveWheelPositions<4>> wheelPositions;
+  frc::SwerveDriveWheelPositions<4> positions{
+      {frc::SwerveModulePosition{}, frc::SwerveModulePosition{},
+       frc::SwerveModulePosition{}, frc::SwerveModulePosition{}}};
+  for (int i = 0; i < kSamples; ++i) {
+    for (auto& module : positions.positions) {
+      module.distance += 4_mm;
+      module.angle = units::radian_t{0.001 * i};
+    }
+    gyroAngles.emplace_back(units::radian_t{0.002 * i});
+    wheelPositions.push_back(positions);
+  }
+  std::vector<frc::Pose2d> poses(kSamples);
+  double sum = 0.0;
+
+  frc::SwerveDriveOdometry<4> odometry{
+      kinematics, frc::Rotation2d{}, wheelPositions.front().positions};
+
+  auto start = high_resolution_clock::now();
+  for (int replay = 0; replay < kReplays; ++replay) {
+    odometry.ResetPosition(frc::Rotation2d{}, wheelPositions.front().positions,
+                           frc::Pose2d{});
+    for (int i = 0; i < kSamples; ++i) {
+      poses[i] = odometry.Update(gyroAngles[i], wheelPositions[i].positions);
+    }
+    sum += poses.back().X().value();
+  }
+  auto updateTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  start = high_resolution_clock::now();
+  for (int replay = 0; replay < kReplays; ++replay) {
+    odometry.ResetPosition(frc::Rotation2d{}, wheelPositions.front().positions,
+                           frc::Pose2d{});
+    odometry.UpdateBatch(gyroAngles, wheelPositions, poses);
+    sum += poses.back().X().value();
+  }
+  auto batchTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  fmt::print("Update: {} us UpdateBatch: {} us ({})\n", updateTime.count(),
+             batchTime.count(), sum);
+}
@@ -0,0 +1,123 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <limits>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "frc/trajectory/ResampledTrajectory.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "trajectory/TestTrajectory.h"
+
+using namespace frc;
+
+namespace {
+
+void ExpectStateNear(const Trajectory::State& expected,
+                     const Trajectory::State& actual, double tolerance) {
+  EXPECT_NEAR(expected.t.value(), actual.t.value(), 1e-9);
+  EXPECT_NEAR(expected.velocity.value(), actual.velocity.value(),
+              10 * tolerance);
+  EXPECT_NEAR(expected.pose.X().value(), actual.pose.X().value(), tolerance);
+  EXPECT_NEAR(expected.pose.Y().value(), actual.pose.Y().value(), tolerance);
+  EXPECT_NEAR(
+      (expected.pose.Rotation() - actual.pose.Rotation()).Radians().value(),
+      0.0, tolerance);
+  EXPECT_NEAR(expected.curvature.value(), actual.curvature.value(),
+              10 * tolerance);
+}
+
+}  // namespace
+
+TEST(ResampledTrajectoryTest, GridPointsMatchTrajectory) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+  ResampledTrajectory resampled{trajectory, 20_ms};
+
+  EXPECT_EQ(trajectory.TotalTime(), resampled.TotalTime());
+  EXPECT_EQ(resampled.Size(), resampled.Times().size());
+  EXPECT_EQ(resampled.Size(), resampled.X().size());
+  for (size_t i = 0; i < resampled.Size(); ++i) {
+    auto state = resampled.GetState(i);
+    ExpectStateNear(trajectory.Sample(state.t), state, 1e-9);
+    EXPECT_EQ(trajectory.Sample(state.t).acceleration, state.acceleration);
+  }
+
+  // The last interval may be shorter than the time step
+  auto times = resampled.Times();
+  EXPECT_NEAR(0.02, times[1] - times[0], 1e-12);
+  EXPECT_LE(times[times.size() - 1] - times[times.size() - 2], 0.02 + 1e-12);
+  EXPECT_GT(times[times.size() - 1] - times[times.size() - 2], 0.0);
+}
+
+TEST(ResampledTrajectoryTest, SampleMatchesTrajectory) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+  ResampledTrajectory resampled{trajectory};
+
+  for (auto t = 0_s; t < trajectory.TotalTime(); t += 3_ms) {
+    auto state = resampled.Sample(t);
+    ExpectStateNear(trajectory.Sample(t), state, 1e-3);
+
+    // Acceleration is held from the previous sample
+    EXPECT_EQ(resampled.GetState(resampled.Index(t)).acceleration,
+              state.acceleration);
+  }
+}
+
+TEST(ResampledTrajectoryTest, SampleClampsToEnds) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+  ResampledTrajectory resampled{trajectory};
+
+  EXPECT_EQ(0u, resampled.Index(-1_s));
+  EXPECT_EQ(resampled.Size() - 1, resampled.Index(trajectory.TotalTime()));
+  EXPECT_EQ(resampled.Size() - 1,
+            resampled.Index(trajectory.TotalTime() + 1_s));
+
+  EXPECT_EQ(trajectory.States().front(), resampled.Sample(-1_s));
+  EXPECT_EQ(trajectory.States().back(),
+            resampled.Sample(trajectory.TotalTime() + 1_s));
+}
+
+TEST(ResampledTrajectoryTest, SampleNaNReturnsStart) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+  ResampledTrajectory resampled{trajectory};
+
+  units::second_t nan{std::numeric_limits<double>::quiet_NaN()};
+  EXPECT_EQ(0u, resampled.Index(nan));
+  EXPECT_EQ(trajectory.States().front(), resampled.Sample(nan));
+}
+
+TEST(ResampledTrajectoryTest, ToTrajectory) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+  ResampledTrajectory resampled{trajectory};
+
+  auto converted = resampled.ToTrajectory();
+  EXPECT_EQ(resampled.Size(), converted.States().size());
+  EXPECT_EQ(trajectory.TotalTime(), converted.TotalTime());
+  for (size_t i = 0; i < resampled.Size(); ++i) {
+    EXPECT_EQ(resampled.GetState(i), converted.States()[i]);
+  }
+}
+
+TEST(ResampledTrajectoryTest, SingleState) {
+  Trajectory trajectory{{Trajectory::State{}}};
+  ResampledTrajectory resampled{trajectory};
+
+  EXPECT_EQ(1u, resampled.Size());
+  EXPECT_EQ(Trajectory::State{}, resampled.Sample(0_s));
+  EXPECT_EQ(Trajectory::State{}, resampled.Sample(1_s));
+}
+
+TEST(ResampledTrajectoryTest, RejectsNonpositiveTimeStep) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  EXPECT_THROW(ResampledTrajectory(trajectory, 0_s), std::invalid_argument);
+  EXPECT_THROW(ResampledTrajectory(trajectory, -5_ms), std::invalid_argument);
+}
@@ -0,0 +1,60 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "frc/trajectory/ResampledTrajectory.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "trajectory/TestTrajectory.h"
+
+TEST(ResampledTrajectoryTest, Benchmark) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  // A 250 Hz follower that also scans 0.5 s ahead for a lookahead point
+  constexpr auto kDt = 4_ms;
+  constexpr auto kLookahead = 0.5_s;
+
+  frc::TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = frc::TestTrajectory::GetTrajectory(config);
+  frc::ResampledTrajectory resampled{trajectory};
+
+  double sum = 0.0;
+
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < 10; ++i) {
+    for (auto t = 0_s; t < trajectory.TotalTime(); t += kDt) {
+      sum += trajectory.Sample(t).pose.X().value();
+      for (auto ahead = t; ahead < t + kLookahead; ahead += 20_ms) {
+        sum += trajectory.Sample(ahead).curvature.value();
+      }
+    }
+  }
+  auto trajectoryTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  start = high_resolution_clock::now();
+  for (int i = 0; i < 10; ++i) {
+    auto curvature = resampled.Curvature();
+    size_t lookaheadSamples =
+        static_cast<size_t>(kLookahead / resampled.Dt());
+    for (auto t = 0_s; t < trajectory.TotalTime(); t += kDt) {
+      sum += resampled.Sample(t).pose.X().value();
+      size_t index = resampled.Index(t);
+      size_t end = std::min(index + lookaheadSamples, curvature.size());
+      for (size_t j = index; j < end; j += 4) {
+        sum += curvature[j];
+      }
+    }
+  }
+  auto resampledTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  fmt::print("Trajectory: {} us ResampledTrajectory: {} us ({})\n",
+             trajectoryTime.count(), resampledTime.count(), sum);
+}
@@ -0,0 +1,231 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "frc/trajectory/TrajectoryCache.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/TrajectoryUtil.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+#include "frc/trajectory/constraint/DifferentialDriveVoltageConstraint.h"
+#include "frc/trajectory/constraint/MaxVelocityConstraint.h"
+#include "frc/trajectory/constraint/RectangularRegionConstraint.h"
+#include "trajectory/TestTrajectory.h"
+
+using namespace frc;
+
+namespace {
+
+class TrajectoryCacheTest : public ::testing::Test {
+ protected:
+  TrajectoryCacheTest() {
+    m_directory = (std::filesystem::temp_directory_path() /
+                   fmt::format("TrajectoryCacheTest-{}",
+                               ::testing::UnitTest::GetInstance()
+                                   ->current_test_info()
+                                   ->name()))
+                      .string();
+    std::filesystem::remove_all(m_directory);
+  }
+
+  ~TrajectoryCacheTest() override {
+    std::filesystem::remove_all(m_directory);
+  }
+
+  size_t NumCachedFiles() const {
+    size_t count = 0;
+    for ([[maybe_unused]] auto& entry :
+         std::filesystem::directory_iterator{m_directory}) {
+      ++count;
+    }
+    return count;
+  }
+
+  std::string m_directory;
+  std::vector<Pose2d> m_waypoints{Pose2d{0_m, 0_m, 0_deg},
+                                  Pose2d{3_m, 1_m, 45_deg},
+                                  Pose2d{5_m, 3_m, 90_deg}};
+};
+
+}  // namespace
+
+TEST(TrajectoryBinaryTest, DeserializeMatches) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto trajectory = TestTrajectory::GetTrajectory(config);
+
+  auto data = TrajectoryUtil::SerializeTrajectoryBinary(trajectory);
+  EXPECT_EQ(4 + trajectory.States().size() * 7 * sizeof(double), data.size());
+
+  Trajectory deserialized;
+  EXPECT_NO_THROW(deserialized =
+                      TrajectoryUtil::DeserializeTrajectoryBinary(data));
+  EXPECT_EQ(trajectory, deserialized);
+}
+
+TEST(TrajectoryBinaryTest, RejectsMalformed) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  auto data = TrajectoryUtil::SerializeTrajectoryBinary(
+      TestTrajectory::GetTrajectory(config));
+
+  EXPECT_THROW(TrajectoryUtil::DeserializeTrajectoryBinary(
+                   std::span{data}.subspan(0, data.size() - 1)),
+               std::runtime_error);
+  data.push_back(0);
+  EXPECT_THROW(TrajectoryUtil::DeserializeTrajectoryBinary(data),
+               std::runtime_error);
+  EXPECT_THROW(TrajectoryUtil::DeserializeTrajectoryBinary(
+                   std::vector<uint8_t>{0, 0, 0, 0}),
+               std::runtime_error);
+  EXPECT_THROW(TrajectoryUtil::DeserializeTrajectoryBinary({}),
+               std::runtime_error);
+}
+
+TEST_F(TrajectoryCacheTest, LoadsCachedTrajectory) {
+  TrajectoryConfig config{3_mps, 2_mps_sq};
+  config.AddConstraint(CentripetalAccelerationConstraint{1_mps_sq});
+  auto expected = TrajectoryGenerator::GenerateTrajectory(m_waypoints, config);
+
+  TrajectoryCache cache{m_directory};
+  EXPECT_EQ(expected, cache.GenerateTrajectory(m_waypoints, config));
+  ASSERT_EQ(1u, NumCachedFiles());
+  auto path = std::filesystem::directory_iterator{m_directory}->path();
+  auto writeTime = std::filesystem::last_write_time(path);
+
+  // A new cache in the same directory loads the stored trajectory instead of
+  // generating and storing it again
+  TrajectoryCache reloaded{m_directory};
+  EXPECT_EQ(expected, reloaded.GenerateTrajectory(m_waypoints, config));
+  EXPECT_EQ(1u, NumCachedFiles());
+  EXPECT_EQ(writeTime, std::filesystem::last_write_time(path));
+}
+
+TEST_F(TrajectoryCacheTest, KeyChanges) {
+  TrajectoryCache cache{m_directory};
+
+  TrajectoryConfig config{3_mps, 2_mps_sq};
+  cache.GenerateTrajectory(m_waypoints, config);
+  EXPECT_EQ(1u, NumCachedFiles());
+
+  // Different waypoints
+  auto waypoints = m_waypoints;
+  waypoints.back() = Pose2d{5_m, 3.5_m, 90_deg};
+  cache.GenerateTrajectory(waypoints, config);
+  EXPECT_EQ(2u, NumCachedFiles());
+
+  // Different limits
+  TrajectoryConfig slowConfig{2_mps, 2_mps_sq};
+  auto slow = cache.GenerateTrajectory(m_waypoints, slowConfig);
+  EXPECT_EQ(3u, NumCachedFiles());
+  EXPECT_EQ(TrajectoryGenerator::GenerateTrajectory(m_waypoints, slowConfig),
+            slow);
+
+  // Different constraint types
+  TrajectoryConfig constrainedConfig{3_mps, 2_mps_sq};
+  constrainedConfig.AddConstraint(MaxVelocityConstraint{1_mps});
+  auto constrained = cache.GenerateTrajectory(m_waypoints, constrainedConfig);
+  EXPECT_EQ(4u, NumCachedFiles());
+  EXPECT_EQ(
+      TrajectoryGenerator::GenerateTrajectory(m_waypoints, constrainedConfig),
+      constrained);
+
+  // Different constraint parameters
+  TrajectoryConfig slowerConfig{3_mps, 2_mps_sq};
+  slowerConfig.AddConstraint(MaxVelocityConstraint{0.5_mps});
+  auto slower = cache.GenerateTrajectory(m_waypoints, slowerConfig);
+  EXPECT_EQ(5u, NumCachedFiles());
+  EXPECT_EQ(TrajectoryGenerator::GenerateTrajectory(m_waypoints, slowerConfig),
+            slower);
+
+  TrajectoryConfig voltageConfig{3_mps, 2_mps_sq};
+  voltageConfig.AddConstraint(DifferentialDriveVoltageConstraint{
+      SimpleMotorFeedforward<units::meter>{1_V, 1_V / 1_mps,
+                                           3_V / 1_mps_sq},
+      DifferentialDriveKinematics{0.6_m}, 10_V});
+  cache.GenerateTrajectory(m_waypoints, voltageConfig);
+  EXPECT_EQ(6u, NumCachedFiles());
+
+  TrajectoryConfig widerConfig{3_mps, 2_mps_sq};
+  widerConfig.AddConstraint(DifferentialDriveVoltageConstraint{
+      SimpleMotorFeedforward<units::meter>{1_V, 1_V / 1_mps,
+                                           3_V / 1_mps_sq},
+      DifferentialDriveKinematics{0.7_m}, 10_V});
+  auto wider = cache.GenerateTrajectory(m_waypoints, widerConfig);
+  EXPECT_EQ(7u, NumCachedFiles());
+  EXPECT_EQ(TrajectoryGenerator::GenerateTrajectory(m_waypoints, widerConfig),
+            wider);
+
+  // Different version
+  TrajectoryCache versionedCache{m_directory, "v2"};
+  versionedCache.GenerateTrajectory(m_waypoints, config);
+  EXPECT_EQ(8u, NumCachedFiles());
+}
+
+TEST_F(TrajectoryCacheTest, DoesNotCacheUnsupportedConstraint) {
+  // The cache can't read a region constraint's parameters
+  TrajectoryConfig config{3_mps, 2_mps_sq};
+  config.AddConstraint(RectangularRegionConstraint{
+      Translation2d{1_m, 0_m}, Translation2d{4_m, 2_m},
+      MaxVelocityConstraint{1_mps}});
+  auto expected = TrajectoryGenerator::GenerateTrajectory(m_waypoints, config);
+
+  TrajectoryCache cache{m_directory};
+  EXPECT_EQ(expected, cache.GenerateTrajectory(m_waypoints, config));
+  std::vector<std::vector<Pose2d>> waypoints{m_waypoints};
+  auto trajectories = cache.GenerateTrajectories(waypoints, config);
+  ASSERT_EQ(1u, trajectories.size());
+  EXPECT_EQ(expected, trajectories[0]);
+  EXPECT_EQ(0u, NumCachedFiles());
+}
+
+TEST_F(TrajectoryCacheTest, DoesNotCacheMalformed) {
+  TrajectoryCache cache{m_directory};
+  auto trajectory = cache.GenerateTrajectory(
+      {Pose2d{0_m, 0_m, 0_deg}, Pose2d{1_m, 0_m, 180_deg}},
+      TrajectoryConfig{3_mps, 2_mps_sq});
+  EXPECT_EQ(1u, trajectory.States().size());
+  EXPECT_EQ(0u, NumCachedFiles());
+}
+
+TEST_F(TrajectoryCacheTest, GenerateTrajectories) {
+  TrajectoryConfig config{3_mps, 2_mps_sq};
+  std::vector<std::vector<Pose2d>> waypoints;
+  for (int i = 0; i < 8; ++i) {
+    waypoints.push_back({Pose2d{0_m, 0_m, 0_deg},
+                         Pose2d{3_m + 0.25_m * i, 1_m, 45_deg}});
+  }
+
+  TrajectoryCache cache{m_directory};
+
+  // Cache half of the trajectories first
+  std::vector<std::vector<Pose2d>> half{waypoints.begin(),
+                                        waypoints.begin() + 4};
+  cache.GenerateTrajectories(half, config);
+  EXPECT_EQ(4u, NumCachedFiles());
+
+  auto trajectories = cache.GenerateTrajectories(waypoints, config);
+  EXPECT_EQ(8u, NumCachedFiles());
+  ASSERT_EQ(waypoints.size(), trajectories.size());
+  for (size_t i = 0; i < waypoints.size(); ++i) {
+    EXPECT_EQ(TrajectoryGenerator::GenerateTrajectory(waypoints[i], config),
+              trajectories[i]);
+  }
+}
+
+TEST_F(TrajectoryCacheTest, IgnoresCorruptFile) {
+  TrajectoryConfig config{3_mps, 2_mps_sq};
+  TrajectoryCache cache{m_directory};
+  auto expected = cache.GenerateTrajectory(m_waypoints, config);
+
+  for (auto& entry : std::filesystem::directory_iterator{m_directory}) {
+    std::filesystem::resize_file(entry.path(), 20);
+  }
+
+  EXPECT_EQ(expected, cache.GenerateTrajectory(m_waypoints, config));
+}
@@ -41,3 +41,26 @@ TEST(TrajectoryGenertionTest, ReturnsEmptyOnMalformed) {
   ASSERT_EQ(t.States().size(), 1u);
   ASSERT_EQ(t.TotalTime(), 0_s);
 }
+
+TEST(TrajectoryGenerationTest, GenerateTrajectoriesMatchesSerial) {
+  TrajectoryConfig config{12_fps, 12_fps_sq};
+  config.AddConstraint(CentripetalAccelerationConstraint{5_mps_sq});
+
+  std::vector<std::vector<Pose2d>> waypoints;
+  for (int i = 0; i < 10; ++i) {
+    waypoints.push_back({Pose2d{0_m, 0_m, 0_deg},
+                         Pose2d{3_m + 0.25_m * i, 1_m, 45_deg},
+                         Pose2d{5_m, 3_m + 0.1_m * i, 90_deg}});
+  }
+  // Malformed waypoints still produce the do-nothing trajectory
+  waypoints.push_back({Pose2d{0_m, 0_m, 0_deg}, Pose2d{1_m, 0_m, 180_deg}});
+
+  auto trajectories =
+      TrajectoryGenerator::GenerateTrajectories(waypoints, config);
+  ASSERT_EQ(waypoints.size(), trajectories.size());
+  for (size_t i = 0; i < waypoints.size(); ++i) {
+    EXPECT_EQ(TrajectoryGenerator::GenerateTrajectory(waypoints[i], config),
+              trajectories[i]);
+  }
+  EXPECT_EQ(1u, trajectories.back().States().size());
+}
@@ -0,0 +1,72 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "frc/trajectory/TrajectoryCache.h"
+#include "frc/trajectory/TrajectoryConfig.h"
+#include "frc/trajectory/TrajectoryGenerator.h"
+#include "frc/trajectory/constraint/CentripetalAccelerationConstraint.h"
+
+TEST(TrajectoryGenerationTest, Benchmark) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  // Roughly the size of an autonomous chooser's path library
+  static constexpr int kNumTrajectories = 80;
+
+  frc::TrajectoryConfig config{4_mps, 3_mps_sq};
+  config.AddConstraint(frc::CentripetalAccelerationConstraint{2_mps_sq});
+
+  std::vector<std::vector<frc::Pose2d>> waypoints;
+  for (int i = 0; i < kNumTrajectories; ++i) {
+    waypoints.push_back(
+        {frc::Pose2d{0_m, 0_m, 0_deg},
+         frc::Pose2d{3_m + 0.05_m * i, 1_m, 45_deg},
+         frc::Pose2d{5_m, 3_m + 0.02_m * i, 90_deg},
+         frc::Pose2d{2_m + 0.03_m * i, 6_m, 180_deg}});
+  }
+
+  auto start = high_resolution_clock::now();
+  for (const auto& trajectoryWaypoints : waypoints) {
+    frc::TrajectoryGenerator::GenerateTrajectory(trajectoryWaypoints, config);
+  }
+  auto serialTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  start = high_resolution_clock::now();
+  frc::TrajectoryGenerator::GenerateTrajectories(waypoints, config);
+  auto batchTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  auto directory = (std::filesystem::temp_directory_path() /
+                    "TrajectoryGenerationTest-Benchmark")
+                       .string();
+  std::filesystem::remove_all(directory);
+  frc::TrajectoryCache cache{directory};
+
+  start = high_resolution_clock::now();
+  cache.GenerateTrajectories(waypoints, config);
+  auto coldTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  start = high_resolution_clock::now();
+  cache.GenerateTrajectories(waypoints, config);
+  auto warmTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  std::filesystem::remove_all(directory);
+
+  fmt::print(
+      "serial: {} us batch: {} us cold cache: {} us warm cache: {} us ({} "
+      "trajectories)\n",
+      serialTime.count(), batchTime.count(), coldTime.count(),
+      warmTime.count(), kNumTrajectories);
+}
@@ -12,9 +12,14 @@
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <sys/socket.h>
 #include <unistd.h>
+
+#include <cerrno>
 #endif
 
+#include <algorithm>
+
 #include <wpi/Logger.h>
 #include <wpi/SmallString.h>
 
@@ -22,6 +27,11 @@
 
 using namespace wpi;
 
+#ifdef __linux__
+// Maximum datagrams per sendmmsg/recvmmsg call
+static constexpr size_t kMaxBatch = 64;
+#endif
+
 UDPClient::UDPClient(Logger& logger) : UDPClient("", logger) {}
 
 UDPClient::UDPClient(std::string_view address, Logger& logger)
@@ -134,28 +144,36 @@ void UDPClient::shutdown() {
   }
 }
 
-int UDPClient::send(std::span<const uint8_t> data, std::string_view server,
-                    int port) {
-  // server must be a resolvable IP address
-  struct sockaddr_in addr;
-  std::memset(&addr, 0, sizeof(addr));
-  addr.sin_family = AF_INET;
+// server must be a resolvable IP address
+static bool ToServerAddr(Logger& logger, std::string_view server, int port,
+                         sockaddr_in* addr) {
+  std::memset(addr, 0, sizeof(*addr));
+  addr->sin_family = AF_INET;
   SmallString<128> remoteAddr{server};
   if (remoteAddr.empty()) {
-    WPI_ERROR(m_logger, "server must be passed");
-    return -1;
+    WPI_ERROR(logger, "server must be passed");
+    return false;
   }
 
 #ifdef _WIN32
-  int res = InetPton(AF_INET, remoteAddr.c_str(), &(addr.sin_addr));
+  int res = InetPton(AF_INET, remoteAddr.c_str(), &(addr->sin_addr));
 #else
-  int res = inet_pton(AF_INET, remoteAddr.c_str(), &(addr.sin_addr));
+  int res = inet_pton(AF_INET, remoteAddr.c_str(), &(addr->sin_addr));
 #endif
   if (res != 1) {
-    WPI_ERROR(m_logger, "could not resolve {} address", server);
+    WPI_ERROR(logger, "could not resolve {} address", server);
+    return false;
+  }
+  addr->sin_port = htons(port);
+  return true;
+}
+
+int UDPClient::send(std::span<const uint8_t> data, std::string_view server,
+                    int port) {
+  struct sockaddr_in addr;
+  if (!ToServerAddr(m_logger, server, port, &addr)) {
     return -1;
   }
-  addr.sin_port = htons(port);
 
   // sendto should not block
   int result =
@@ -165,33 +183,67 @@ int UDPClient::send(std::span<const uint8_t> data, std::string_view server,
 }
 
 int UDPClient::send(std::string_view data, std::string_view server, int port) {
-  // server must be a resolvable IP address
   struct sockaddr_in addr;
-  std::memset(&addr, 0, sizeof(addr));
-  addr.sin_family = AF_INET;
-  SmallString<128> remoteAddr{server};
-  if (remoteAddr.empty()) {
-    WPI_ERROR(m_logger, "server must be passed");
+  if (!ToServerAddr(m_logger, server, port, &addr)) {
     return -1;
   }
 
-#ifdef _WIN32
-  int res = InetPton(AF_INET, remoteAddr.c_str(), &(addr.sin_addr));
-#else
-  int res = inet_pton(AF_INET, remoteAddr.c_str(), &(addr.sin_addr));
-#endif
-  if (res != 1) {
-    WPI_ERROR(m_logger, "could not resolve {} address", server);
-    return -1;
-  }
-  addr.sin_port = htons(port);
-
   // sendto should not block
   int result = sendto(m_lsd, data.data(), data.size(), 0,
                       reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
   return result;
 }
 
+int UDPClient::send(std::span<const std::span<const uint8_t>> datagrams,
+                    std::string_view server, int port) {
+  struct sockaddr_in addr;
+  if (!ToServerAddr(m_logger, server, port, &addr)) {
+    return -1;
+  }
+
+  size_t sent = 0;
+#ifdef __linux__
+  // one sendmmsg call per kMaxBatch datagrams
+  mmsghdr msgs[kMaxBatch];
+  iovec iovs[kMaxBatch];
+  while (sent < datagrams.size()) {
+    size_t count = (std::min)(datagrams.size() - sent, kMaxBatch);
+    for (size_t i = 0; i < count; ++i) {
+      auto data = datagrams[sent + i];
+      iovs[i].iov_base = const_cast<uint8_t*>(data.data());
+      iovs[i].iov_len = data.size();
+      std::memset(&msgs[i], 0, sizeof(msgs[i]));
+      msgs[i].msg_hdr.msg_name = &addr;
+      msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int result;
+    do {
+      result = sendmmsg(m_lsd, msgs, count, 0);
+    } while (result < 0 && errno == EINTR);
+    if (result <= 0) {
+      break;
+    }
+    sent += result;
+  }
+#else
+  for (auto data : datagrams) {
+    int result =
+        sendto(m_lsd, reinterpret_cast<const char*>(data.data()), data.size(),
+               0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    if (result < 0) {
+      break;
+    }
+    ++sent;
+  }
+#endif
+  if (sent == 0 && !datagrams.empty()) {
+    return -1;
+  }
+  return sent;
+}
+
 int UDPClient::receive(uint8_t* data_received, int receive_len) {
   if (m_port == 0) {
     return -1;  // return if not receiving
@@ -232,6 +284,56 @@ int UDPClient::receive(uint8_t* data_received, int receive_len,
   return result;
 }
 
+int UDPClient::receive(std::span<const std::span<uint8_t>> buffers,
+                       std::span<int> lengths) {
+  if (m_port == 0) {
+    return -1;  // return if not receiving
+  }
+  size_t count = (std::min)(buffers.size(), lengths.size());
+  if (count == 0) {
+    return 0;
+  }
+
+#ifdef __linux__
+  // MSG_WAITFORONE blocks for the first datagram only
+  count = (std::min)(count, kMaxBatch);
+  mmsghdr msgs[kMaxBatch];
+  iovec iovs[kMaxBatch];
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = buffers[i].data();
+    iovs[i].iov_len = buffers[i].size();
+    std::memset(&msgs[i], 0, sizeof(msgs[i]));
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  int result = recvmmsg(m_lsd, msgs, count, MSG_WAITFORONE, nullptr);
+  for (int i = 0; i < result; ++i) {
+    lengths[i] = msgs[i].msg_len;
+  }
+  return result;
+#else
+  int result = recv(m_lsd, reinterpret_cast<char*>(buffers[0].data()),
+                    buffers[0].size(), 0);
+  if (result < 0) {
+    return -1;
+  }
+  lengths[0] = result;
+  size_t received = 1;
+#ifndef _WIN32
+  // drain whatever else is already queued without blocking
+  while (received < count) {
+    result = recv(m_lsd, buffers[received].data(), buffers[received].size(),
+                  MSG_DONTWAIT);
+    if (result < 0) {
+      break;
+    }
+    lengths[received++] = result;
+  }
+#endif
+  return received;
+#endif
+}
+
 int UDPClient::set_timeout(double timeout) {
   if (timeout < 0) {
     return -1;
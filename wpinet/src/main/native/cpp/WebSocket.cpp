@@ -4,6 +4,8 @@
 
 #include "wpinet/WebSocket.h"
 
+#include <algorithm>
+#include <array>
 #include <random>
 #include <span>
 #include <string>
@@ -18,9 +20,11 @@
 #include <wpi/sha1.h>
 
 #include "WebSocketDebug.h"
+#include "WebSocketDeflate.h"
 #include "WebSocketSerializer.h"
 #include "wpinet/HttpParser.h"
 #include "wpinet/raw_uv_ostream.h"
+#include "wpinet/uv/BufferPool.h"
 #include "wpinet/uv/Stream.h"
 
 using namespace wpi;
@@ -82,6 +86,10 @@ static constexpr uint8_t kFlagMasking = 0x80;
 static constexpr uint8_t kLenMask = 0x7f;
 static constexpr size_t kWriteAllocSize = 4096;
 
+static uv::Buffer AllocWriteBuf() {
+  return uv::BufferPool::Allocate(kWriteAllocSize);
+}
+
 class WebSocket::ClientHandshakeData {
  public:
   ClientHandshakeData() {
@@ -110,6 +118,7 @@ class WebSocket::ClientHandshakeData {
   bool hasConnection = false;
   bool hasAccept = false;
   bool hasProtocol = false;
+  bool offeredDeflate = false;
 
   std::weak_ptr<uv::Timer> timer;
 };
@@ -151,16 +160,19 @@ std::shared_ptr<WebSocket> WebSocket::CreateClient(
   return ws;
 }
 
-std::shared_ptr<WebSocket> WebSocket::CreateServer(uv::Stream& stream,
-                                                   std::string_view key,
-                                                   std::string_view version,
-                                                   std::string_view protocol) {
+std::shared_ptr<WebSocket> WebSocket::CreateServer(
+    uv::Stream& stream, std::string_view key, std::string_view version,
+    std::string_view protocol, std::string_view extensions) {
   auto ws = std::make_shared<WebSocket>(stream, true, private_init{});
   stream.SetData(ws);
-  ws->StartServer(key, version, protocol);
+  ws->StartServer(key, version, protocol, extensions);
   return ws;
 }
 
+bool WebSocket::IsDeflateAvailable() {
+  return detail::WebSocketDeflate::IsAvailable();
+}
+
 void WebSocket::Close(uint16_t code, std::string_view reason) {
   SendClose(code, reason);
   if (m_state != FAILED && m_state != CLOSED) {
@@ -193,7 +205,7 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
 
   // Build client request
   SmallVector<uv::Buffer, 4> bufs;
-  raw_uv_ostream os{bufs, kWriteAllocSize};
+  raw_uv_ostream os{bufs, AllocWriteBuf};
 
   os << "GET " << uri << " HTTP/1.1\r\n";
   os << "Host: " << host << "\r\n";
@@ -219,6 +231,13 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
     os << "\r\n";
   }
 
+  // extensions
+  if (options.deflate && detail::WebSocketDeflate::IsAvailable()) {
+    os << "Sec-WebSocket-Extensions: "
+       << detail::WebSocketDeflate::kClientOffer << "\r\n";
+    m_clientHandshake->offeredDeflate = true;
+  }
+
   // other headers
   for (auto&& header : options.extraHeaders) {
     os << header.first << ": " << header.second << "\r\n";
@@ -229,9 +248,7 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
 
   // Send client request
   m_stream.Write(bufs, [](auto bufs, uv::Error) {
-    for (auto& buf : bufs) {
-      buf.Deallocate();
-    }
+    uv::BufferPool::Release(bufs);
   });
 
   // Set up client response handling
@@ -262,8 +279,19 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
           }
           m_clientHandshake->hasAccept = true;
         } else if (equals_lower(name, "sec-websocket-extensions")) {
-          // No extensions are supported
-          if (!value.empty()) {
+          // Only permessage-deflate is supported, and only if offered
+          if (value.empty()) {
+            return;
+          }
+          if (!m_clientHandshake->offeredDeflate || m_deflate) {
+            return Terminate(1010, "unsupported extension");
+          }
+          auto params = detail::WebSocketDeflate::ParseResponse(value);
+          if (!params) {
+            return Terminate(1010, "invalid permessage-deflate response");
+          }
+          m_deflate = detail::WebSocketDeflate::Create(false, *params);
+          if (!m_deflate) {
             return Terminate(1010, "unsupported extension");
           }
         } else if (equals_lower(name, "sec-websocket-protocol")) {
@@ -307,12 +335,13 @@ void WebSocket::StartClient(std::string_view uri, std::string_view host,
 }
 
 void WebSocket::StartServer(std::string_view key, std::string_view version,
-                            std::string_view protocol) {
+                            std::string_view protocol,
+                            std::string_view extensions) {
   m_protocol = protocol;
 
   // Build server response
   SmallVector<uv::Buffer, 4> bufs;
-  raw_uv_ostream os{bufs, kWriteAllocSize};
+  raw_uv_ostream os{bufs, AllocWriteBuf};
 
   // Handle unsupported version
   if (version != "13") {
@@ -320,9 +349,7 @@ void WebSocket::StartServer(std::string_view key, std::string_view version,
     os << "Upgrade: WebSocket\r\n";
     os << "Sec-WebSocket-Version: 13\r\n\r\n";
     m_stream.Write(bufs, [this](auto bufs, uv::Error) {
-      for (auto& buf : bufs) {
-        buf.Deallocate();
-      }
+      uv::BufferPool::Release(bufs);
       // XXX: Should we support sending a new handshake on the same connection?
       // XXX: "this->" is required by GCC 5.5 (bug)
       this->Terminate(1003, "unsupported protocol version");
@@ -342,14 +369,24 @@ void WebSocket::StartServer(std::string_view key, std::string_view version,
     os << "Sec-WebSocket-Protocol: " << protocol << "\r\n";
   }
 
+  // accept permessage-deflate if offered
+  if (!extensions.empty()) {
+    if (auto params = detail::WebSocketDeflate::ParseOffer(extensions)) {
+      m_deflate = detail::WebSocketDeflate::Create(true, *params);
+      if (m_deflate) {
+        os << "Sec-WebSocket-Extensions: ";
+        detail::WebSocketDeflate::PrintResponse(os, *params);
+        os << "\r\n";
+      }
+    }
+  }
+
   // end headers
   os << "\r\n";
 
   // Send server response
   m_stream.Write(bufs, [this](auto bufs, uv::Error) {
-    for (auto& buf : bufs) {
-      buf.Deallocate();
-    }
+    uv::BufferPool::Release(bufs);
     if (m_state == CONNECTING) {
       m_state = OPEN;
       open(m_protocol);
@@ -360,16 +397,14 @@ void WebSocket::StartServer(std::string_view key, std::string_view version,
 void WebSocket::SendClose(uint16_t code, std::string_view reason) {
   SmallVector<uv::Buffer, 4> bufs;
   if (code != 1005) {
-    raw_uv_ostream os{bufs, kWriteAllocSize};
+    raw_uv_ostream os{bufs, AllocWriteBuf};
     const uint8_t codeMsb[] = {static_cast<uint8_t>((code >> 8) & 0xff),
                                static_cast<uint8_t>(code & 0xff)};
     os << std::span{codeMsb};
     os << reason;
   }
   SendControl(kFlagFin | kOpClose, bufs, [](auto bufs, uv::Error) {
-    for (auto&& buf : bufs) {
-      buf.Deallocate();
-    }
+    uv::BufferPool::Release(bufs);
   });
 }
 
@@ -385,17 +420,6 @@ void WebSocket::Shutdown() {
   m_stream.Shutdown([this] { m_stream.Close(); });
 }
 
-static inline void Unmask(std::span<uint8_t> data,
-                          std::span<const uint8_t, 4> key) {
-  int n = 0;
-  for (uint8_t& ch : data) {
-    ch ^= key[n++];
-    if (n >= 4) {
-      n = 0;
-    }
-  }
-}
-
 void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
   // ignore incoming data if we're failed or closed
   if (m_state == FAILED || m_state == CLOSED) {
@@ -437,8 +461,15 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
           return;  // need more data
         }
 
-        // Validate RSV bits are zero
-        if ((m_header[0] & 0x70) != 0) {
+        // Validate RSV bits are zero, except for RSV1 on the first frame of
+        // a compressed message
+        uint8_t rsv = m_header[0] & 0x70;
+        if (rsv == detail::WebSocketDeflate::kFlagCompressed && m_deflate &&
+            (m_header[0] & kFlagControl) == 0 &&
+            (m_header[0] & kOpMask) != kOpCont) {
+          rsv = 0;
+        }
+        if (rsv != 0) {
           return Fail(1002, "nonzero RSV");
         }
       }
@@ -506,52 +537,93 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
 
     if (m_frameSize != UINT64_MAX) {
       bool control = (m_header[0] & kFlagControl) != 0;
+      bool fin = (m_header[0] & kFlagFin) != 0;
+      std::span<uint8_t> payload;
+      std::span<uint8_t> framePayload;
       size_t need;
-      if (control) {
-        need = m_frameSize - m_controlPayload.size();
-      } else {
-        need = m_frameStart + m_frameSize - m_payload.size();
-      }
-      size_t toCopy = (std::min)(need, data.size());
-      if (control) {
-        m_controlPayload.append(data.data(), data.data() + toCopy);
+      if (!control && fin && m_payload.empty() && data.size() >= m_frameSize) {
+        // The whole message is in this read buffer, so deliver it from there
+        // instead of copying it into m_payload
+        payload = {reinterpret_cast<uint8_t*>(buf.base) +
+                       (data.data() - buf.base),
+                   static_cast<size_t>(m_frameSize)};
+        framePayload = payload;
+        data.remove_prefix(m_frameSize);
+        need = 0;
       } else {
-        m_payload.append(data.data(), data.data() + toCopy);
+        if (control) {
+          need = m_frameSize - m_controlPayload.size();
+        } else {
+          need = m_frameStart + m_frameSize - m_payload.size();
+        }
+        size_t toCopy = (std::min)(need, data.size());
+        if (control) {
+          m_controlPayload.append(data.data(), data.data() + toCopy);
+        } else {
+          m_payload.append(data.data(), data.data() + toCopy);
+        }
+        data.remove_prefix(toCopy);
+        need -= toCopy;
+        if (control) {
+          payload = m_controlPayload;
+          framePayload = payload;
+        } else {
+          payload = m_payload;
+          framePayload = payload.subspan(m_frameStart);
+        }
       }
-      data.remove_prefix(toCopy);
-      need -= toCopy;
       if (need == 0) {
         // We have a complete frame
         // If the message had masking, unmask it
         if ((m_header[1] & kFlagMasking) != 0) {
-          Unmask(control ? std::span{m_controlPayload}
-                         : std::span{m_payload}.subspan(m_frameStart),
-                 std::span<const uint8_t, 4>{&m_header[m_headerSize - 4], 4});
+          std::array<uint8_t, 4> key;
+          std::copy_n(&m_header[m_headerSize - 4], 4, key.begin());
+          detail::MaskData(framePayload, framePayload.data(), key);
+        }
+
+        // If the message is compressed, decompress it
+        if (!control) {
+          if ((m_header[0] & kOpMask) != kOpCont) {
+            m_compressedMessage =
+                (m_header[0] & detail::WebSocketDeflate::kFlagCompressed) != 0;
+          }
+          if (m_compressedMessage) {
+            if (!m_combineFragments) {
+              m_inflatedPayload.clear();
+            }
+            if (!m_deflate->Decompress(framePayload, fin, m_inflatedPayload,
+                                       m_maxMessageSize)) {
+              return Fail(1007, "invalid compressed data");
+            }
+            if (m_inflatedPayload.size() > m_maxMessageSize) {
+              return Fail(1009, "message too large");
+            }
+            payload = m_inflatedPayload;
+          }
         }
 
         // Handle message
-        bool fin = (m_header[0] & kFlagFin) != 0;
         uint8_t opcode = m_header[0] & kOpMask;
         switch (opcode) {
           case kOpCont:
-            WS_DEBUG("WS Fragment {} [{}]\n", m_payload.size(),
-                     DebugBinary(m_payload));
+            WS_DEBUG("WS Fragment {} [{}]\n", payload.size(),
+                     DebugBinary(payload));
             switch (m_fragmentOpcode) {
               case kOpText:
                 if (!m_combineFragments || fin) {
                   std::string_view content{
-                      reinterpret_cast<char*>(m_payload.data()),
-                      m_payload.size()};
-                  WS_DEBUG("WS RecvText(Defrag) {} ({})\n", m_payload.size(),
+                      reinterpret_cast<char*>(payload.data()),
+                      payload.size()};
+                  WS_DEBUG("WS RecvText(Defrag) {} ({})\n", payload.size(),
                            DebugText(content));
                   text(content, fin);
                 }
                 break;
               case kOpBinary:
                 if (!m_combineFragments || fin) {
-                  WS_DEBUG("WS RecvBinary(Defrag) {} ({})\n", m_payload.size(),
-                           DebugBinary(m_payload));
-                  binary(m_payload, fin);
+                  WS_DEBUG("WS RecvBinary(Defrag) {} ({})\n", payload.size(),
+                           DebugBinary(payload));
+                  binary(payload, fin);
                 }
                 break;
               default:
@@ -563,20 +635,20 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
             }
             break;
           case kOpText: {
-            std::string_view content{reinterpret_cast<char*>(m_payload.data()),
-                                     m_payload.size()};
+            std::string_view content{reinterpret_cast<char*>(payload.data()),
+                                     payload.size()};
             if (m_fragmentOpcode != 0) {
               WS_DEBUG("WS RecvText {} ({}) -> INCOMPLETE FRAGMENT\n",
-                       m_payload.size(), DebugText(content));
+                       payload.size(), DebugText(content));
               return Fail(1002, "incomplete fragment");
             }
             if (!m_combineFragments || fin) {
-              WS_DEBUG("WS RecvText {} ({})\n", m_payload.size(),
+              WS_DEBUG("WS RecvText {} ({})\n", payload.size(),
                        DebugText(content));
               text(content, fin);
             }
             if (!fin) {
-              WS_DEBUG("WS RecvText {} StartFrag\n", m_payload.size());
+              WS_DEBUG("WS RecvText {} StartFrag\n", payload.size());
               m_fragmentOpcode = opcode;
             }
             break;
@@ -584,16 +656,16 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
           case kOpBinary:
             if (m_fragmentOpcode != 0) {
               WS_DEBUG("WS RecvBinary {} ({}) -> INCOMPLETE FRAGMENT\n",
-                       m_payload.size(), DebugBinary(m_payload));
+                       payload.size(), DebugBinary(payload));
               return Fail(1002, "incomplete fragment");
             }
             if (!m_combineFragments || fin) {
-              WS_DEBUG("WS RecvBinary {} ({})\n", m_payload.size(),
-                       DebugBinary(m_payload));
-              binary(m_payload, fin);
+              WS_DEBUG("WS RecvBinary {} ({})\n", payload.size(),
+                       DebugBinary(payload));
+              binary(payload, fin);
             }
             if (!fin) {
-              WS_DEBUG("WS RecvBinary {} StartFrag\n", m_payload.size());
+              WS_DEBUG("WS RecvBinary {} StartFrag\n", payload.size());
               m_fragmentOpcode = opcode;
             }
             break;
@@ -632,13 +704,11 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
             if (m_state == OPEN) {
               SmallVector<uv::Buffer, 4> bufs;
               {
-                raw_uv_ostream os{bufs, kWriteAllocSize};
+                raw_uv_ostream os{bufs, AllocWriteBuf};
                 os << m_controlPayload;
               }
               SendPong(bufs, [](auto bufs, uv::Error) {
-                for (auto&& buf : bufs) {
-                  buf.Deallocate();
-                }
+                uv::BufferPool::Release(bufs);
               });
             }
             WS_DEBUG("WS RecvPing() {} ({})\n", m_controlPayload.size(),
@@ -665,6 +735,7 @@ void WebSocket::HandleIncoming(uv::Buffer& buf, size_t size) {
             m_controlPayload.clear();
           } else {
             m_payload.clear();
+            m_inflatedPayload.clear();
           }
         }
         m_frameStart = m_payload.size();
@@ -724,7 +795,7 @@ void WebSocket::SendFrames(
                                         std::move(callback));
   for (auto&& frame : frames) {
     VerboseDebug(frame);
-    req->m_frames.AddFrame(frame, m_server);
+    req->m_frames.AddFrame(frame, m_server, m_deflate.get());
     req->m_userBufs.append(frame.data.begin(), frame.data.end());
   }
   req->m_continueBufPos = req->m_frames.m_bufs.size();
@@ -754,6 +825,25 @@ std::span<const WebSocket::Frame> WebSocket::TrySendFrames(
     return frames;
   }
 
+  // Compressed frames depend on all of the frames compressed before them, so
+  // frames can't be compressed and then returned unsent. Queue all of them as
+  // a single write instead.
+  if (m_deflate) {
+    auto req =
+        std::make_shared<WriteReq>(weak_from_this(), std::move(callback));
+    for (auto&& frame : frames) {
+      VerboseDebug(frame);
+      req->m_frames.AddFrame(frame, m_server, m_deflate.get());
+      req->m_userBufs.append(frame.data.begin(), frame.data.end());
+    }
+    req->m_continueBufPos = req->m_frames.m_bufs.size();
+    m_writeInProgress = true;
+    m_writeReq = req;
+    WS_DEBUG("Write({})\n", req->m_frames.m_bufs.size());
+    m_stream.Write(req->m_frames.m_bufs, req);
+    return {};
+  }
+
   return detail::TrySendFrames(
       m_server, m_stream, frames,
       [this](std::function<void(std::span<uv::Buffer>, uv::Error)>&& cb) {
@@ -0,0 +1,314 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "WebSocketDeflate.h"
+
+#include <tuple>
+#include <utility>
+
+#include <fmt/format.h>
+#include <wpi/StringExtras.h>
+#include <wpi/raw_ostream.h>
+
+#ifdef WPINET_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace wpi::detail;
+
+static constexpr std::string_view kExtensionName = "permessage-deflate";
+
+// Output chunk size when (de)compressing
+static constexpr size_t kChunkSize = 1024;
+
+// Faster levels compress repetitive messages nearly as well
+static constexpr int kCompressionLevel = 3;
+
+// Every compressed message ends with the empty stored block produced by a sync
+// flush, which is removed before sending (RFC 7692 section 7.2.1)
+static constexpr uint8_t kTail[] = {0x00, 0x00, 0xff, 0xff};
+
+struct WebSocketDeflate::Streams {
+#ifdef WPINET_HAVE_ZLIB
+  Streams() = default;
+  Streams(const Streams&) = delete;
+  Streams& operator=(const Streams&) = delete;
+  ~Streams() {
+    if (deflateInit) {
+      deflateEnd(&deflate);
+    }
+    if (inflateInit) {
+      inflateEnd(&inflate);
+    }
+  }
+
+  z_stream deflate{};
+  z_stream inflate{};
+  bool deflateInit = false;
+  bool inflateInit = false;
+#endif
+};
+
+static std::optional<int> ParseWindowBits(std::string_view value) {
+  // values may be quoted
+  if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+    value = value.substr(1, value.size() - 2);
+  }
+  auto bits = wpi::parse_integer<int>(value, 10);
+  if (!bits || *bits < 8 || *bits > 15) {
+    return std::nullopt;
+  }
+  return bits;
+}
+
+// Parses the parameters of a single permessage-deflate offer or response
+static bool ParseParams(std::string_view params, bool offer,
+                        DeflateParams* out) {
+  enum {
+    kServerNoContext = 1,
+    kClientNoContext = 2,
+    kServerBits = 4,
+    kClientBits = 8
+  };
+  unsigned int seen = 0;
+  while (!params.empty()) {
+    std::string_view param;
+    std::tie(param, params) = wpi::split(params, ';');
+    auto [name, value] = wpi::split(param, '=');
+    bool hasValue = param.find('=') != std::string_view::npos;
+    name = wpi::trim(name);
+    value = wpi::trim(value);
+
+    unsigned int flag;
+    if (name == "server_no_context_takeover") {
+      flag = kServerNoContext;
+      if (hasValue) {
+        return false;
+      }
+      out->serverNoContextTakeover = true;
+    } else if (name == "client_no_context_takeover") {
+      flag = kClientNoContext;
+      if (hasValue) {
+        return false;
+      }
+      out->clientNoContextTakeover = true;
+    } else if (name == "server_max_window_bits") {
+      flag = kServerBits;
+      auto bits = ParseWindowBits(value);
+      if (!bits) {
+        return false;
+      }
+      out->serverMaxWindowBits = *bits;
+    } else if (name == "client_max_window_bits") {
+      flag = kClientBits;
+      // the value is optional in an offer
+      if (hasValue || !offer) {
+        auto bits = ParseWindowBits(value);
+        if (!bits) {
+          return false;
+        }
+        // an offered value only limits the client's window, and inflating
+        // with the maximum window handles any window size
+        if (!offer) {
+          out->clientMaxWindowBits = *bits;
+        }
+      }
+    } else {
+      return false;
+    }
+
+    // parameters may not be repeated
+    if ((seen & flag) != 0) {
+      return false;
+    }
+    seen |= flag;
+  }
+  return true;
+}
+
+bool WebSocketDeflate::IsAvailable() {
+#ifdef WPINET_HAVE_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::optional<DeflateParams> WebSocketDeflate::ParseOffer(
+    std::string_view extensions) {
+  while (!extensions.empty()) {
+    std::string_view extension;
+    std::tie(extension, extensions) = split(extensions, ',');
+    auto [name, params] = split(extension, ';');
+    if (trim(name) != kExtensionName) {
+      continue;
+    }
+    DeflateParams result;
+    if (ParseParams(params, true, &result)) {
+      return result;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<DeflateParams> WebSocketDeflate::ParseResponse(
+    std::string_view extensions) {
+  // a single extension is offered, so a single extension may be accepted
+  auto [name, params] = split(extensions, ';');
+  if (trim(name) != kExtensionName) {
+    return std::nullopt;
+  }
+  DeflateParams result;
+  if (!ParseParams(params, false, &result)) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+void WebSocketDeflate::PrintResponse(raw_ostream& os,
+                                     const DeflateParams& params) {
+  os << kExtensionName;
+  if (params.serverNoContextTakeover) {
+    os << "; server_no_context_takeover";
+  }
+  if (params.clientNoContextTakeover) {
+    os << "; client_no_context_takeover";
+  }
+  if (params.serverMaxWindowBits != 0) {
+    os << fmt::format("; server_max_window_bits={}",
+                      params.serverMaxWindowBits);
+  }
+}
+
+std::unique_ptr<WebSocketDeflate> WebSocketDeflate::Create(
+    bool server, const DeflateParams& params) {
+#ifdef WPINET_HAVE_ZLIB
+  int windowBits =
+      server ? params.serverMaxWindowBits : params.clientMaxWindowBits;
+  if (windowBits == 0) {
+    windowBits = 15;
+  }
+  // zlib doesn't support an 8 bit window for raw deflate. Huffman-only
+  // compression never refers back into the window, so it's valid for any
+  // window size.
+  int strategy = Z_DEFAULT_STRATEGY;
+  if (windowBits < 9) {
+    windowBits = 9;
+    strategy = Z_HUFFMAN_ONLY;
+  }
+
+  auto streams = std::make_unique<Streams>();
+  if (deflateInit2(&streams->deflate, kCompressionLevel, Z_DEFLATED,
+                   -windowBits, 8, strategy) != Z_OK) {
+    return nullptr;
+  }
+  streams->deflateInit = true;
+  // the maximum window can inflate data compressed with any window size
+  if (inflateInit2(&streams->inflate, -15) != Z_OK) {
+    return nullptr;
+  }
+  streams->inflateInit = true;
+
+  return std::unique_ptr<WebSocketDeflate>{new WebSocketDeflate{
+      std::move(streams), server ? params.serverNoContextTakeover
+                                 : params.clientNoContextTakeover}};
+#else
+  return nullptr;
+#endif
+}
+
+WebSocketDeflate::WebSocketDeflate(std::unique_ptr<Streams> streams,
+                                   bool noContextTakeover)
+    : m_streams{std::move(streams)}, m_noContextTakeover{noContextTakeover} {}
+
+WebSocketDeflate::~WebSocketDeflate() = default;
+
+std::optional<std::span<const uint8_t>> WebSocketDeflate::Compress(
+    const WebSocket::Frame& frame) {
+#ifdef WPINET_HAVE_ZLIB
+  bool fin = (frame.opcode & WebSocket::kFlagFin) != 0;
+
+  // decide whether to compress at the first frame of each message
+  if ((frame.opcode & WebSocket::kOpMask) != WebSocket::kOpCont) {
+    size_t size = 0;
+    for (auto&& buf : frame.data) {
+      size += buf.len;
+    }
+    m_compressMessage = !fin || size >= kMinCompressSize;
+  }
+  if (!m_compressMessage) {
+    return std::nullopt;
+  }
+
+  z_stream& strm = m_streams->deflate;
+  m_out.clear();
+  for (size_t i = 0, n = frame.data.size(); i <= n; ++i) {
+    // the final pass (with no input) flushes the output to a byte boundary
+    if (i < n) {
+      strm.next_in = reinterpret_cast<Bytef*>(frame.data[i].base);
+      strm.avail_in = frame.data[i].len;
+    } else {
+      strm.next_in = nullptr;
+      strm.avail_in = 0;
+    }
+    int flush = i < n ? Z_NO_FLUSH : Z_SYNC_FLUSH;
+    do {
+      size_t pos = m_out.size();
+      m_out.resize_for_overwrite(pos + kChunkSize);
+      strm.next_out = m_out.data() + pos;
+      strm.avail_out = kChunkSize;
+      deflate(&strm, flush);
+      m_out.resize(pos + kChunkSize - strm.avail_out);
+    } while (strm.avail_out == 0);
+  }
+
+  if (fin) {
+    if (m_out.size() >= sizeof(kTail)) {
+      m_out.resize(m_out.size() - sizeof(kTail));
+    }
+    if (m_noContextTakeover) {
+      deflateReset(&strm);
+    }
+  }
+  return m_out;
+#else
+  return std::nullopt;
+#endif
+}
+
+bool WebSocketDeflate::Decompress(std::span<const uint8_t> in, bool fin,
+                                  SmallVectorImpl<uint8_t>& out,
+                                  size_t maxSize) {
+#ifdef WPINET_HAVE_ZLIB
+  z_stream& strm = m_streams->inflate;
+  for (int pass = 0; pass < (fin ? 2 : 1); ++pass) {
+    // the final frame is followed by the tail removed by the sender
+    std::span<const uint8_t> data = pass == 0 ? in : std::span{kTail};
+    strm.next_in = const_cast<Bytef*>(data.data());
+    strm.avail_in = data.size();
+    do {
+      size_t pos = out.size();
+      out.resize_for_overwrite(pos + kChunkSize);
+      strm.next_out = out.data() + pos;
+      strm.avail_out = kChunkSize;
+      int result = inflate(&strm, Z_SYNC_FLUSH);
+      out.resize(pos + kChunkSize - strm.avail_out);
+      if (result == Z_STREAM_END) {
+        // the sender ended the deflate stream; anything after it is ignored
+        inflateReset(&strm);
+        return true;
+      }
+      if (result != Z_OK && result != Z_BUF_ERROR) {
+        return false;
+      }
+      if (out.size() > maxSize) {
+        return true;
+      }
+    } while (strm.avail_out == 0);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
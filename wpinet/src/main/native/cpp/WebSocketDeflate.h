@@ -0,0 +1,143 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include <wpi/SmallVector.h>
+
+#include "wpinet/WebSocket.h"
+
+namespace wpi {
+class raw_ostream;
+}  // namespace wpi
+
+namespace wpi::detail {
+
+/**
+ * Parameters of the permessage-deflate extension (RFC 7692).
+ */
+struct DeflateParams {
+  /** Server resets its compression context after every message */
+  bool serverNoContextTakeover = false;
+  /** Client resets its compression context after every message */
+  bool clientNoContextTakeover = false;
+  /** Server compression window bits (8-15), or 0 if not negotiated (15) */
+  int serverMaxWindowBits = 0;
+  /** Client compression window bits (8-15), or 0 if not negotiated (15) */
+  int clientMaxWindowBits = 0;
+};
+
+/**
+ * Compression state of a WebSocket connection that negotiated the
+ * permessage-deflate extension (RFC 7692). Contexts are kept across messages
+ * unless no_context_takeover was negotiated, so repetitive messages compress
+ * to a few bytes each.
+ *
+ * Every data frame sent on the connection must be passed through Compress()
+ * in the order it is written to the wire, and every data frame of a compressed
+ * message received must be passed through Decompress() in order.
+ */
+class WebSocketDeflate {
+ public:
+  /** Frame header flag (RSV1) marking a compressed message */
+  static constexpr uint8_t kFlagCompressed = 0x40;
+
+  /**
+   * Single frame messages smaller than this many bytes are sent uncompressed,
+   * as the deflate block overhead outweighs any savings.
+   */
+  static constexpr size_t kMinCompressSize = 32;
+
+  /** Extension offer sent by clients */
+  static constexpr std::string_view kClientOffer =
+      "permessage-deflate; client_max_window_bits";
+
+  /**
+   * Returns true if wpinet was built with compression support.
+   */
+  static bool IsAvailable();
+
+  /**
+   * Selects the first acceptable permessage-deflate offer in a client's
+   * Sec-WebSocket-Extensions header value.
+   *
+   * @param extensions header value
+   * @return Accepted parameters, or empty if no offer was acceptable
+   */
+  static std::optional<DeflateParams> ParseOffer(std::string_view extensions);
+
+  /**
+   * Parses a server's Sec-WebSocket-Extensions response to kClientOffer.
+   *
+   * @param extensions header value
+   * @return Negotiated parameters, or empty if the response is invalid
+   */
+  static std::optional<DeflateParams> ParseResponse(
+      std::string_view extensions);
+
+  /**
+   * Writes the Sec-WebSocket-Extensions value accepting an offer.
+   *
+   * @param os output stream
+   * @param params parameters returned by ParseOffer()
+   */
+  static void PrintResponse(raw_ostream& os, const DeflateParams& params);
+
+  /**
+   * Creates compression state for one end of a connection.
+   *
+   * @param server true for the server end, false for the client end
+   * @param params negotiated parameters
+   * @return Compression state, or nullptr if compression is not available
+   */
+  static std::unique_ptr<WebSocketDeflate> Create(bool server,
+                                                  const DeflateParams& params);
+
+  WebSocketDeflate(const WebSocketDeflate&) = delete;
+  WebSocketDeflate& operator=(const WebSocketDeflate&) = delete;
+  ~WebSocketDeflate();
+
+  /**
+   * Compresses the payload of an outgoing data frame.
+   *
+   * @param frame frame
+   * @return Compressed payload, valid until the next call, or empty if the
+   *         frame's message is sent uncompressed
+   */
+  std::optional<std::span<const uint8_t>> Compress(
+      const WebSocket::Frame& frame);
+
+  /**
+   * Decompresses the payload of an incoming data frame of a compressed
+   * message, appending the result to out. Decompression stops once out is
+   * larger than maxSize.
+   *
+   * @param in compressed payload
+   * @param fin true if this is the final frame of the message
+   * @param out decompressed output
+   * @param maxSize maximum output size
+   * @return False if the payload is not valid compressed data
+   */
+  bool Decompress(std::span<const uint8_t> in, bool fin,
+                  SmallVectorImpl<uint8_t>& out, size_t maxSize);
+
+ private:
+  struct Streams;
+
+  WebSocketDeflate(std::unique_ptr<Streams> streams, bool noContextTakeover);
+
+  std::unique_ptr<Streams> m_streams;
+  bool m_noContextTakeover;
+  bool m_compressMessage = false;
+  SmallVector<uint8_t, 0> m_out;
+};
+
+}  // namespace wpi::detail
@@ -4,13 +4,44 @@
 
 #include "WebSocketSerializer.h"
 
+#include <algorithm>
+#include <cstring>
 #include <random>
 
+#include "WebSocketDeflate.h"
+
 using namespace wpi::detail;
 
 static constexpr uint8_t kFlagMasking = 0x80;
 static constexpr size_t kWriteAllocSize = 4096;
 
+std::array<uint8_t, 4> wpi::detail::MaskData(std::span<const uint8_t> in,
+                                             uint8_t* out,
+                                             std::array<uint8_t, 4> key) {
+  const uint8_t* src = in.data();
+  size_t size = in.size();
+
+  // Since 8 is a multiple of the key length, every word starts with key[0]
+  uint8_t key8[8] = {key[0], key[1], key[2], key[3],
+                     key[0], key[1], key[2], key[3]};
+  uint64_t key64;
+  std::memcpy(&key64, key8, sizeof(key64));
+
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, src + i, sizeof(word));
+    word ^= key64;
+    std::memcpy(out + i, &word, sizeof(word));
+  }
+  for (; i < size; ++i) {
+    out[i] = src[i] ^ key[i % 4];
+  }
+
+  return {key[size % 4], key[(size + 1) % 4], key[(size + 2) % 4],
+          key[(size + 3) % 4]};
+}
+
 static std::span<uint8_t> BuildHeader(std::span<uint8_t, 10> header,
                                       bool server,
                                       const wpi::WebSocket::Frame& frame) {
@@ -53,7 +84,7 @@ size_t SerializedFrames::AddClientFrame(const WebSocket::Frame& frame) {
   for (auto&& buf : frame.data) {
     size += buf.len;
   }
-  m_allocBufs.emplace_back(uv::Buffer::Allocate(size));
+  m_allocBufs.emplace_back(uv::BufferPool::Allocate(size));
   m_bufs.emplace_back(m_allocBufs.back());
 
   char* internalBuf = m_allocBufs.back().data().data();
@@ -64,22 +95,17 @@ size_t SerializedFrames::AddClientFrame(const WebSocket::Frame& frame) {
   static std::random_device rd;
   static std::default_random_engine gen{rd()};
   std::uniform_int_distribution<unsigned int> dist(0, 255);
-  uint8_t key[4];
+  std::array<uint8_t, 4> key;
   for (uint8_t& v : key) {
     v = dist(gen);
   }
-  std::memcpy(internalBuf, key, 4);
+  std::memcpy(internalBuf, key.data(), 4);
   internalBuf += 4;
 
   // copy and mask data
-  int n = 0;
   for (auto&& buf : frame.data) {
-    for (auto&& ch : buf.data()) {
-      *internalBuf++ = static_cast<uint8_t>(ch) ^ key[n++];
-      if (n >= 4) {
-        n = 0;
-      }
-    }
+    key = MaskData(buf.bytes(), reinterpret_cast<uint8_t*>(internalBuf), key);
+    internalBuf += buf.len;
   }
   return size;
 }
@@ -88,16 +114,9 @@ size_t SerializedFrames::AddServerFrame(const WebSocket::Frame& frame) {
   uint8_t headerBuf[10];
   auto header = BuildHeader(headerBuf, true, frame);
 
-  // manage allocBufs to efficiently store header
-  if (m_allocBufs.empty() ||
-      (m_allocBufPos + header.size()) > kWriteAllocSize) {
-    m_allocBufs.emplace_back(uv::Buffer::Allocate(kWriteAllocSize));
-    m_allocBufPos = 0;
-  }
-  char* internalBuf = m_allocBufs.back().data().data() + m_allocBufPos;
+  char* internalBuf = Allocate(header.size());
   std::memcpy(internalBuf, header.data(), header.size());
   m_bufs.emplace_back(internalBuf, header.size());
-  m_allocBufPos += header.size();
   // servers can just send the buffers directly without masking
   m_bufs.append(frame.data.begin(), frame.data.end());
   size_t sent = header.size();
@@ -106,3 +125,46 @@ size_t SerializedFrames::AddServerFrame(const WebSocket::Frame& frame) {
   }
   return sent;
 }
+
+size_t SerializedFrames::AddCompressedFrame(const WebSocket::Frame& frame,
+                                            bool server,
+                                            WebSocketDeflate& deflate) {
+  auto payload = deflate.Compress(frame);
+  if (!payload) {
+    return AddFrame(frame, server);
+  }
+
+  uint8_t opcode = frame.opcode;
+  if ((opcode & WebSocket::kOpMask) != WebSocket::kOpCont) {
+    opcode |= WebSocketDeflate::kFlagCompressed;
+  }
+  uv::Buffer buf{*payload};
+  WebSocket::Frame compressed{opcode, {&buf, 1}};
+  if (!server) {
+    // client frames are always copied for masking
+    return AddClientFrame(compressed);
+  }
+
+  // the payload is only valid until the next Compress(), so copy it after
+  // the header
+  uint8_t headerBuf[10];
+  auto header = BuildHeader(headerBuf, true, compressed);
+  size_t size = header.size() + buf.len;
+  char* internalBuf = Allocate(size);
+  std::memcpy(internalBuf, header.data(), header.size());
+  std::memcpy(internalBuf + header.size(), buf.base, buf.len);
+  m_bufs.emplace_back(internalBuf, size);
+  return size;
+}
+
+char* SerializedFrames::Allocate(size_t size) {
+  // manage allocBufs to efficiently store small allocations
+  if (m_allocBufs.empty() || (m_allocBufPos + size) > m_allocBufs.back().len) {
+    m_allocBufs.emplace_back(
+        uv::BufferPool::Allocate((std::max)(size, kWriteAllocSize)));
+    m_allocBufPos = 0;
+  }
+  char* buf = m_allocBufs.back().base + m_allocBufPos;
+  m_allocBufPos += size;
+  return buf;
+}
@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <array>
 #include <functional>
 #include <memory>
+#include <span>
 #include <utility>
 
 #include <wpi/SmallVector.h>
@@ -14,9 +18,26 @@
 #include "WebSocketDebug.h"
 #include "wpinet/WebSocket.h"
 #include "wpinet/uv/Buffer.h"
+#include "wpinet/uv/BufferPool.h"
 
 namespace wpi::detail {
 
+/**
+ * XORs data with a WebSocket masking key. Masking and unmasking are the same
+ * operation. The data is processed 8 bytes at a time with the key repeated
+ * twice, which the compiler can further vectorize.
+ *
+ * @param in input data
+ * @param out output data; may be the same as in
+ * @param key masking key, rotated so key[0] applies to in[0]
+ * @return Masking key rotated to apply to the byte following in; pass this to
+ *         the next call to continue masking the same frame
+ */
+std::array<uint8_t, 4> MaskData(std::span<const uint8_t> in, uint8_t* out,
+                                std::array<uint8_t, 4> key);
+
+class WebSocketDeflate;
+
 class SerializedFrames {
  public:
   SerializedFrames() = default;
@@ -24,7 +45,11 @@ class SerializedFrames {
   SerializedFrames& operator=(const SerializedFrames&) = delete;
   ~SerializedFrames() { ReleaseBufs(); }
 
-  size_t AddFrame(const WebSocket::Frame& frame, bool server) {
+  size_t AddFrame(const WebSocket::Frame& frame, bool server,
+                  WebSocketDeflate* deflate = nullptr) {
+    if (deflate && (frame.opcode & WebSocket::kFlagControl) == 0) {
+      return AddCompressedFrame(frame, server, *deflate);
+    }
     if (server) {
       return AddServerFrame(frame);
     } else {
@@ -34,17 +59,20 @@ class SerializedFrames {
 
   size_t AddClientFrame(const WebSocket::Frame& frame);
   size_t AddServerFrame(const WebSocket::Frame& frame);
+  size_t AddCompressedFrame(const WebSocket::Frame& frame, bool server,
+                            WebSocketDeflate& deflate);
 
   void ReleaseBufs() {
-    for (auto&& buf : m_allocBufs) {
-      buf.Deallocate();
-    }
+    uv::BufferPool::Release(m_allocBufs);
     m_allocBufs.clear();
   }
 
   SmallVector<uv::Buffer, 4> m_allocBufs;
   SmallVector<uv::Buffer, 4> m_bufs;
   size_t m_allocBufPos = 0;
+
+ private:
+  char* Allocate(size_t size);
 };
 
 class WebSocketWriteReqBase {
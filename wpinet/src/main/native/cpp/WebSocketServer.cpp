@@ -37,6 +37,15 @@ WebSocketServerHelper::WebSocketServerHelper(HttpParser& req) {
           m_protocols.emplace_back(protocol);
         }
       }
+    } else if (equals_lower(name, "sec-websocket-extensions")) {
+      // Extensions are comma delimited, repeated headers add to list
+      value = trim(value);
+      if (!value.empty()) {
+        if (!m_extensions.empty()) {
+          m_extensions += ", ";
+        }
+        m_extensions += value;
+      }
     }
   });
   req.headersComplete.connect([&req, this](bool) {
@@ -111,7 +120,7 @@ WebSocketServer::WebSocketServer(uv::Stream& stream,
     auto self = shared_from_this();
 
     // Accept the upgrade
-    auto ws = m_helper.Accept(m_stream, protocol);
+    auto ws = m_helper.Accept(m_stream, protocol, m_options.deflate);
 
     // Connect the websocket open event to our connected event.
     ws->open.connect_extended(
@@ -0,0 +1,160 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/uv/BufferPool.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <new>
+
+using namespace wpi::uv;
+
+// Each buffer is preceded by a header recording its size class; the header
+// size keeps the buffer itself suitably aligned
+static constexpr size_t kHeaderSize = alignof(std::max_align_t);
+static constexpr int kMinShift = std::countr_zero(BufferPool::kMinSize);
+static constexpr int kMaxShift = std::countr_zero(BufferPool::kMaxSize);
+static constexpr int kNumClasses = kMaxShift - kMinShift + 1;
+static constexpr uint8_t kUnpooled = 0xff;
+
+static_assert(std::has_single_bit(BufferPool::kMinSize));
+static_assert(std::has_single_bit(BufferPool::kMaxSize));
+
+namespace {
+
+struct Header {
+  uint8_t sizeClass;
+};
+
+// Free blocks are linked through their first bytes
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct ThreadCache {
+  ThreadCache() = default;
+  ThreadCache(const ThreadCache&) = delete;
+  ThreadCache& operator=(const ThreadCache&) = delete;
+  ~ThreadCache();
+
+  void Clear();
+
+  std::array<FreeBlock*, kNumClasses> free{};
+  std::array<size_t, kNumClasses> count{};
+};
+
+std::atomic<uint64_t> gAllocations{0};
+std::atomic<uint64_t> gHeapAllocations{0};
+std::atomic<uint64_t> gReleases{0};
+std::atomic<uint64_t> gHeapFrees{0};
+
+// Buffers released while the thread is exiting bypass the cache
+thread_local bool gCacheDestroyed = false;
+
+}  // namespace
+
+static constexpr size_t ClassSize(int sizeClass) {
+  return size_t{1} << (sizeClass + kMinShift);
+}
+
+static constexpr size_t ClassMaxCount(int sizeClass) {
+  return BufferPool::kMaxCacheBytes / ClassSize(sizeClass);
+}
+
+static ThreadCache* GetCache() {
+  if (gCacheDestroyed) {
+    return nullptr;
+  }
+  thread_local ThreadCache cache;
+  return &cache;
+}
+
+static void FreeBlockToHeap(void* block) {
+  ::operator delete(block);
+  gHeapFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+ThreadCache::~ThreadCache() {
+  Clear();
+  gCacheDestroyed = true;
+}
+
+void ThreadCache::Clear() {
+  for (int i = 0; i < kNumClasses; ++i) {
+    while (FreeBlock* block = free[i]) {
+      free[i] = block->next;
+      FreeBlockToHeap(block);
+    }
+    count[i] = 0;
+  }
+}
+
+Buffer BufferPool::Allocate(size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+
+  uint8_t sizeClass = kUnpooled;
+  size_t allocSize = size;
+  if (size <= kMaxSize) {
+    sizeClass = size <= kMinSize ? 0 : std::bit_width(size - 1) - kMinShift;
+    allocSize = ClassSize(sizeClass);
+  }
+
+  void* block = nullptr;
+  if (sizeClass != kUnpooled) {
+    if (auto cache = GetCache(); cache && cache->free[sizeClass]) {
+      auto freeBlock = cache->free[sizeClass];
+      cache->free[sizeClass] = freeBlock->next;
+      --cache->count[sizeClass];
+      block = freeBlock;
+    }
+  }
+  if (!block) {
+    block = ::operator new(kHeaderSize + allocSize);
+    gHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static_cast<Header*>(block)->sizeClass = sizeClass;
+  return Buffer{static_cast<char*>(block) + kHeaderSize, size};
+}
+
+void BufferPool::Release(Buffer& buf) {
+  if (!buf.base) {
+    return;
+  }
+  gReleases.fetch_add(1, std::memory_order_relaxed);
+
+  void* block = buf.base - kHeaderSize;
+  buf.base = nullptr;
+  buf.len = 0;
+
+  uint8_t sizeClass = static_cast<Header*>(block)->sizeClass;
+  if (sizeClass != kUnpooled) {
+    auto cache = GetCache();
+    if (cache && cache->count[sizeClass] < ClassMaxCount(sizeClass)) {
+      auto freeBlock = static_cast<FreeBlock*>(block);
+      freeBlock->next = cache->free[sizeClass];
+      cache->free[sizeClass] = freeBlock;
+      ++cache->count[sizeClass];
+      return;
+    }
+  }
+  FreeBlockToHeap(block);
+}
+
+void BufferPool::Clear() {
+  if (auto cache = GetCache()) {
+    cache->Clear();
+  }
+}
+
+BufferPool::Stats BufferPool::GetStats() {
+  Stats stats;
+  stats.allocations = gAllocations.load(std::memory_order_relaxed);
+  stats.heapAllocations = gHeapAllocations.load(std::memory_order_relaxed);
+  stats.releases = gReleases.load(std::memory_order_relaxed);
+  stats.heapFrees = gHeapFrees.load(std::memory_order_relaxed);
+  return stats;
+}
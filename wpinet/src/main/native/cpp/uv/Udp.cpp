@@ -4,6 +4,12 @@
 
 #include "wpinet/uv/Udp.h"
 
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
 #include <cstring>
 
 #include <wpi/SmallString.h>
@@ -189,11 +195,80 @@ void Udp::Send(std::span<const Buffer> bufs,
   Send(bufs, std::make_shared<CallbackUdpSendReq>(bufs, std::move(callback)));
 }
 
+size_t Udp::TrySendBatchImpl(const sockaddr* addr,
+                              std::span<const Buffer> datagrams) {
+  if (datagrams.empty()) {
+    return 0;
+  }
+
+  // Send the first datagram through libuv; this binds the socket if needed
+  // and keeps ordering by refusing to send while sends are queued
+  int err = uv_udp_try_send(GetRaw(), datagrams.data(), 1, addr);
+  if (err < 0) {
+    if (err != UV_EAGAIN) {
+      ReportError(err);
+    }
+    return 0;
+  }
+  size_t sent = 1;
+
+#ifdef __linux__
+  constexpr size_t kMaxBatch = 64;
+  socklen_t addrLen = 0;
+  if (addr) {
+    addrLen = addr->sa_family == AF_INET6 ? sizeof(sockaddr_in6)
+                                          : sizeof(sockaddr_in);
+  }
+  mmsghdr msgs[kMaxBatch];
+  while (sent < datagrams.size()) {
+    size_t count = (std::min)(datagrams.size() - sent, kMaxBatch);
+    for (size_t i = 0; i < count; ++i) {
+      std::memset(&msgs[i], 0, sizeof(msgs[i]));
+      msgs[i].msg_hdr.msg_name = const_cast<sockaddr*>(addr);
+      msgs[i].msg_hdr.msg_namelen = addrLen;
+      // uv_buf_t is layout compatible with iovec on Unix
+      msgs[i].msg_hdr.msg_iov =
+          reinterpret_cast<iovec*>(const_cast<Buffer*>(&datagrams[sent + i]));
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int result;
+    do {
+      result = sendmmsg(GetRaw()->io_watcher.fd, msgs, count, 0);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOBUFS) {
+        ReportError(-errno);
+      }
+      break;
+    }
+    sent += result;
+  }
+#else
+  for (; sent < datagrams.size(); ++sent) {
+    err = uv_udp_try_send(GetRaw(), &datagrams[sent], 1, addr);
+    if (err < 0) {
+      if (err != UV_EAGAIN) {
+        ReportError(err);
+      }
+      break;
+    }
+  }
+#endif
+  return sent;
+}
+
 void Udp::StartRecv() {
   if (IsLoopClosing()) {
     return;
   }
-  Invoke(&uv_udp_recv_start, GetRaw(), &AllocBuf,
+  Invoke(&uv_udp_recv_start, GetRaw(),
+         [](uv_handle_t* handle, size_t size, uv_buf_t* buf) {
+           // recvmmsg fills one datagram per size bytes of the buffer
+           if (uv_udp_using_recvmmsg(reinterpret_cast<uv_udp_t*>(handle))) {
+             size *= kRecvmmsgDatagrams;
+           }
+           AllocBuf(handle, size, buf);
+         },
          [](uv_udp_t* handle, ssize_t nread, const uv_buf_t* buf,
             const sockaddr* addr, unsigned flags) {
            auto& h = *static_cast<Udp*>(handle->data);
@@ -206,8 +281,11 @@ void Udp::StartRecv() {
              h.ReportError(nread);
            }
 
-           // free the buffer
-           h.FreeBuf(data);
+           // free the buffer; recvmmsg chunks are slices of a buffer that is
+           // freed by a final UV_UDP_MMSG_FREE callback
+           if ((flags & UV_UDP_MMSG_CHUNK) == 0) {
+             h.FreeBuf(data);
+           }
          });
 }
 
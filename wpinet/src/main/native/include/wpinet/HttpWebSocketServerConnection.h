@@ -63,6 +63,14 @@ class HttpWebSocketServerConnection
    */
   virtual bool IsValidWsUpgrade(std::string_view protocol) { return true; }
 
+  /**
+   * Check whether to accept the permessage-deflate extension (RFC 7692) if
+   * the client offers it.  This is called prior to accepting the upgrade.
+   *
+   * @return True to compress messages if the client supports it
+   */
+  virtual bool AcceptDeflate() { return false; }
+
   /**
    * Process an incoming WebSocket upgrade.  This is called after the header
    * reader has been disconnected and the websocket has been accepted.
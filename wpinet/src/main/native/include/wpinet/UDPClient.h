@@ -38,9 +38,20 @@ class UDPClient {
   // The passed in address MUST be a resolved IP address.
   int send(std::span<const uint8_t> data, std::string_view server, int port);
   int send(std::string_view data, std::string_view server, int port);
+  // Sends each element of datagrams as a separate datagram, batching the
+  // system calls where the platform supports it.  Returns the number of
+  // datagrams sent, or -1 if none could be sent.
+  int send(std::span<const std::span<const uint8_t>> datagrams,
+           std::string_view server, int port);
   int receive(uint8_t* data_received, int receive_len);
   int receive(uint8_t* data_received, int receive_len,
               SmallVectorImpl<char>* addr_received, int* port_received);
+  // Waits for at least one datagram, then also receives datagrams that are
+  // already queued, one per buffer.  The size of each datagram is stored in
+  // the corresponding element of lengths.  Returns the number of datagrams
+  // received, or -1 on error.
+  int receive(std::span<const std::span<uint8_t>> buffers,
+              std::span<int> lengths);
   int set_timeout(double timeout);
 };
 
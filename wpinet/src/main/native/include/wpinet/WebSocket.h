@@ -28,6 +28,10 @@ namespace uv {
 class Stream;
 }  // namespace uv
 
+namespace detail {
+class WebSocketDeflate;
+}  // namespace detail
+
 /**
  * RFC 6455 compliant WebSocket client and server implementation.
  */
@@ -79,6 +83,12 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
 
     /** Additional headers to include in handshake. */
     std::span<const std::pair<std::string_view, std::string_view>> extraHeaders;
+
+    /**
+     * Offer the permessage-deflate extension (RFC 7692) to compress messages.
+     * Ignored if wpinet was built without compression support.
+     */
+    bool deflate = false;
   };
 
   /**
@@ -146,10 +156,20 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
    *                client request
    * @param protocol The subprotocol to send to the client (in the
    *                 Sec-WebSocket-Protocol header field).
+   * @param extensions The value of the Sec-WebSocket-Extensions header field in
+   *                   the client request. The permessage-deflate extension is
+   *                   accepted if offered; pass empty to not accept any
+   *                   extensions.
    */
   static std::shared_ptr<WebSocket> CreateServer(
       uv::Stream& stream, std::string_view key, std::string_view version,
-      std::string_view protocol = {});
+      std::string_view protocol = {}, std::string_view extensions = {});
+
+  /**
+   * Return if wpinet was built with permessage-deflate support (this requires
+   * zlib).  If not, deflate is never offered or accepted.
+   */
+  static bool IsDeflateAvailable();
 
   /**
    * Get connection state.
@@ -172,6 +192,12 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
    */
   std::string_view GetProtocol() const { return m_protocol; }
 
+  /**
+   * Return if messages are compressed with the permessage-deflate extension.
+   * Only valid in or after the open() event.
+   */
+  bool IsDeflateEnabled() const { return m_deflate != nullptr; }
+
   /**
    * Set the maximum message size.  Default is 128 KB.  If configured to combine
    * fragments this maximum applies to the entire message (all combined
@@ -410,6 +436,15 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
    * responsible for how to handle (e.g. re-send) those frames (e.g. when the
    * callback is called).
    *
+   * If permessage-deflate is enabled, every frame depends on the frames
+   * compressed before it, so a compressed frame can't be returned unsent.
+   * Instead, all frames are compressed and queued as a single write and an
+   * empty span is returned; the write may then stay partially queued in the
+   * stream until the network drains it. If a previous write is still in
+   * progress, nothing is compressed and all frames are returned as usual.
+   * Callers that use the returned frames for flow control should instead
+   * check IsWriteInProgress() before sending more.
+   *
    * @param frames Frame type/data pairs
    * @param callback Callback which is invoked when the write completes of the
    *                 last frame that is not returned.
@@ -528,6 +563,11 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
   uint64_t m_frameSize = UINT64_MAX;
   uint8_t m_fragmentOpcode = 0;
 
+  // permessage-deflate state, if negotiated
+  std::unique_ptr<detail::WebSocketDeflate> m_deflate;
+  SmallVector<uint8_t, 0> m_inflatedPayload;
+  bool m_compressedMessage = false;
+
   // temporary data used only during client handshake
   class ClientHandshakeData;
   std::unique_ptr<ClientHandshakeData> m_clientHandshake;
@@ -536,7 +576,7 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
                    std::span<const std::string_view> protocols,
                    const ClientOptions& options);
   void StartServer(std::string_view key, std::string_view version,
-                   std::string_view protocol);
+                   std::string_view protocol, std::string_view extensions);
   void SendClose(uint16_t code, std::string_view reason);
   void SetClosed(uint16_t code, std::string_view reason, bool failed = false);
   void HandleIncoming(uv::Buffer& buf, size_t size);
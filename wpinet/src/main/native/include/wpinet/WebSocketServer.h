@@ -75,10 +75,15 @@ class WebSocketServerHelper {
    * reader) before calling this.  See also WebSocket::CreateServer().
    * @param stream Connection stream
    * @param protocol The subprotocol to send to the client
+   * @param deflate Accept the permessage-deflate extension if the client
+   *                offered it
    */
   std::shared_ptr<WebSocket> Accept(uv::Stream& stream,
-                                    std::string_view protocol = {}) {
-    return WebSocket::CreateServer(stream, m_key, m_version, protocol);
+                                    std::string_view protocol = {},
+                                    bool deflate = false) {
+    return WebSocket::CreateServer(stream, m_key, m_version, protocol,
+                                   deflate ? std::string_view{m_extensions}
+                                           : std::string_view{});
   }
 
   bool IsUpgrade() const { return m_gotHost && m_websocket; }
@@ -94,6 +99,7 @@ class WebSocketServerHelper {
   SmallVector<std::string, 2> m_protocols;
   SmallString<64> m_key;
   SmallString<16> m_version;
+  SmallString<64> m_extensions;
 };
 
 /**
@@ -107,6 +113,8 @@ class WebSocketServer : public std::enable_shared_from_this<WebSocketServer> {
    * Server options.
    */
   struct ServerOptions {
+    ServerOptions() : deflate{false} {}
+
     /**
      * Checker for URL.  Return true if URL should be accepted.  By default all
      * URLs are accepted.
@@ -118,6 +126,12 @@ class WebSocketServer : public std::enable_shared_from_this<WebSocketServer> {
      * default all hosts are accepted.
      */
     std::function<bool(std::string_view)> checkHost;
+
+    /**
+     * Accept the permessage-deflate extension (RFC 7692) if the client offers
+     * it.  Ignored if wpinet was built without compression support.
+     */
+    bool deflate;  // NOLINT
   };
 
   /**
@@ -0,0 +1,102 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#ifndef WPINET_UV_BUFFERPOOL_H_
+#define WPINET_UV_BUFFERPOOL_H_
+
+#include <stdint.h>
+
+#include <span>
+
+#include "wpinet/uv/Buffer.h"
+
+namespace wpi::uv {
+
+/**
+ * A size-classed pool allocator for Buffers, shared by the write paths of
+ * wpinet.
+ *
+ * Requested sizes are rounded up to a power of two, and released buffers are
+ * kept in a per-size cache for reuse rather than returned to the heap.  Each
+ * thread has its own cache, so allocation and release don't lock.  Buffers
+ * may be released on any thread; they join the cache of the releasing thread.
+ *
+ * Buffers allocated by this pool must be released with Release(), never with
+ * Buffer::Deallocate().  Release() does not rely on the buffer length, so
+ * the length may be changed after allocation.
+ */
+class BufferPool {
+ public:
+  /**
+   * Allocation counters, summed across all threads.
+   */
+  struct Stats {
+    /** Number of buffers allocated. */
+    uint64_t allocations = 0;
+
+    /** Number of allocations not satisfied from a cache. */
+    uint64_t heapAllocations = 0;
+
+    /** Number of buffers released. */
+    uint64_t releases = 0;
+
+    /** Number of released buffers returned to the heap. */
+    uint64_t heapFrees = 0;
+  };
+
+  /** Smallest buffer allocation size. */
+  static constexpr size_t kMinSize = 64;
+
+  /** Largest cached buffer size; larger buffers always use the heap. */
+  static constexpr size_t kMaxSize = 65536;
+
+  /**
+   * Maximum number of bytes each thread caches for each buffer size.
+   */
+  static constexpr size_t kMaxCacheBytes = 256 * 1024;
+
+  BufferPool() = delete;
+
+  /**
+   * Allocate a buffer.
+   *
+   * @param size Size of the buffer
+   * @return Buffer with a length of size
+   */
+  static Buffer Allocate(size_t size);
+
+  /**
+   * Release a buffer allocated with Allocate() back into the pool.
+   *
+   * @param buf Buffer; set to empty on return
+   */
+  static void Release(Buffer& buf);
+
+  /**
+   * Release buffers allocated with Allocate() back into the pool.
+   *
+   * @param bufs Buffers; each is set to empty on return
+   */
+  static void Release(std::span<Buffer> bufs) {
+    for (auto&& buf : bufs) {
+      Release(buf);
+    }
+  }
+
+  /**
+   * Return all buffers cached by the calling thread to the heap.
+   */
+  static void Clear();
+
+  /**
+   * Get the allocation counters.
+   *
+   * @return Counters since program start
+   */
+  static Stats GetStats();
+};
+
+}  // namespace wpi::uv
+
+#endif  // WPINET_UV_BUFFERPOOL_H_
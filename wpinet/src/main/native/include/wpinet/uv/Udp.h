@@ -352,6 +352,45 @@ class Udp final : public HandleImpl<Udp, uv_udp_t> {
     return val;
   }
 
+  /**
+   * Sends a batch of datagrams to the same peer without queueing, batching the
+   * system calls where the platform supports it (sendmmsg on Linux).  Each
+   * buffer is sent as a separate datagram.  Unlike TrySend(), a full send
+   * buffer (UV_EAGAIN) is not reported as an error; the caller should queue
+   * the unsent datagrams with Send().
+   *
+   * @param addr sockaddr_in or sockaddr_in6 with the address and port of the
+   *             remote peer.
+   * @param datagrams The datagrams to be sent.
+   * @return Number of datagrams sent.
+   */
+  size_t TrySendBatch(const sockaddr& addr, std::span<const Buffer> datagrams) {
+    return TrySendBatchImpl(&addr, datagrams);
+  }
+
+  size_t TrySendBatch(const sockaddr_in& addr,
+                      std::span<const Buffer> datagrams) {
+    return TrySendBatchImpl(reinterpret_cast<const sockaddr*>(&addr),
+                            datagrams);
+  }
+
+  size_t TrySendBatch(const sockaddr_in6& addr,
+                      std::span<const Buffer> datagrams) {
+    return TrySendBatchImpl(reinterpret_cast<const sockaddr*>(&addr),
+                            datagrams);
+  }
+
+  /**
+   * Variant of TrySendBatch() for connected sockets.  Cannot be used with
+   * connectionless sockets.
+   *
+   * @param datagrams The datagrams to be sent.
+   * @return Number of datagrams sent.
+   */
+  size_t TrySendBatch(std::span<const Buffer> datagrams) {
+    return TrySendBatchImpl(nullptr, datagrams);
+  }
+
   /**
    * Prepare for receiving data.  If the socket has not previously been bound
    * with Bind() it is bound to 0.0.0.0 (the "all interfaces" IPv4 address) and
@@ -359,6 +398,12 @@ class Udp final : public HandleImpl<Udp, uv_udp_t> {
    *
    * A received signal will be emitted for each received data packet until
    * `StopRecv()` is called.
+   *
+   * If the handle was created with the UV_UDP_RECVMMSG flag, up to
+   * kRecvmmsgDatagrams datagrams are read per system call.  The allocator set
+   * with SetBufferAllocator() is then asked for room for all of them at once,
+   * and the buffer passed to the received signal is a slice of that
+   * allocation.
    */
   void StartRecv();
 
@@ -393,6 +438,15 @@ class Udp final : public HandleImpl<Udp, uv_udp_t> {
    * the number of bytes received, the address of the sender, and flags.
    */
   sig::Signal<Buffer&, size_t, const sockaddr&, unsigned> received;
+
+  /**
+   * Maximum number of datagrams read per system call when using recvmmsg.
+   */
+  static constexpr size_t kRecvmmsgDatagrams = 20;
+
+ private:
+  size_t TrySendBatchImpl(const sockaddr* addr,
+                          std::span<const Buffer> datagrams);
 };
 
 }  // namespace wpi::uv
@@ -0,0 +1,66 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/UDPClient.h"  // NOLINT(build/include_order)
+
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/Logger.h>
+
+namespace wpi {
+
+namespace {
+constexpr int kPort = 10060;
+constexpr size_t kDatagrams = 10;
+}  // namespace
+
+TEST(UDPClientTest, BatchSendReceive) {
+  Logger logger;
+  UDPClient server{"127.0.0.1", logger};
+  UDPClient client{logger};
+  ASSERT_EQ(server.start(kPort), 0);
+  ASSERT_EQ(client.start(), 0);
+  server.set_timeout(1.0);
+
+  std::vector<std::string> sent;
+  std::vector<std::span<const uint8_t>> datagrams;
+  for (size_t i = 0; i < kDatagrams; ++i) {
+    sent.emplace_back(i + 1, static_cast<char>('a' + i));
+  }
+  for (auto&& str : sent) {
+    datagrams.emplace_back(reinterpret_cast<const uint8_t*>(str.data()),
+                           str.size());
+  }
+  ASSERT_EQ(client.send(datagrams, "127.0.0.1", kPort),
+            static_cast<int>(kDatagrams));
+
+  std::array<std::array<uint8_t, 64>, kDatagrams> storage;
+  std::vector<std::span<uint8_t>> buffers(storage.begin(), storage.end());
+  std::array<int, kDatagrams> lengths;
+  std::vector<std::string> received;
+  while (received.size() < kDatagrams) {
+    int count = server.receive(buffers, lengths);
+    ASSERT_GT(count, 0);
+    for (int i = 0; i < count; ++i) {
+      received.emplace_back(reinterpret_cast<char*>(storage[i].data()),
+                            lengths[i]);
+    }
+  }
+  ASSERT_EQ(received, sent);
+}
+
+TEST(UDPClientTest, BatchSendBadAddress) {
+  Logger logger;
+  UDPClient client{logger};
+  ASSERT_EQ(client.start(), 0);
+  const uint8_t data[1] = {0};
+  std::span<const uint8_t> datagrams[1] = {data};
+  ASSERT_EQ(client.send(datagrams, "not an address", kPort), -1);
+}
+
+}  // namespace wpi
@@ -0,0 +1,82 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <array>
+#include <chrono>
+#include <span>
+#include <vector>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+#include <wpi/Logger.h>
+
+#include "wpinet/UDPClient.h"
+
+namespace wpi {
+
+namespace {
+// A typical DS control packet
+constexpr size_t kDatagramSize = 64;
+constexpr int kDatagrams = 200000;
+// Datagrams in flight at once; small enough to never overflow the socket
+constexpr size_t kBatch = 32;
+constexpr int kPort = 10061;
+}  // namespace
+
+TEST(UDPClientBenchmark, Loopback) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  Logger logger;
+  UDPClient server{"127.0.0.1", logger};
+  UDPClient client{logger};
+  ASSERT_EQ(server.start(kPort), 0);
+  ASSERT_EQ(client.start(), 0);
+  server.set_timeout(1.0);
+
+  std::array<uint8_t, kDatagramSize> payload{};
+  std::array<std::array<uint8_t, kDatagramSize>, kBatch> storage;
+  std::array<int, kBatch> lengths;
+  std::vector<std::span<const uint8_t>> datagrams(kBatch, payload);
+  std::vector<std::span<uint8_t>> buffers(storage.begin(), storage.end());
+
+  // one system call per datagram
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < kDatagrams; i += kBatch) {
+    for (size_t j = 0; j < kBatch; ++j) {
+      ASSERT_EQ(client.send(payload, "127.0.0.1", kPort),
+                static_cast<int>(kDatagramSize));
+    }
+    for (size_t j = 0; j < kBatch; ++j) {
+      ASSERT_EQ(server.receive(storage[j].data(), kDatagramSize),
+                static_cast<int>(kDatagramSize));
+    }
+  }
+  auto single =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  // batched
+  start = high_resolution_clock::now();
+  for (int i = 0; i < kDatagrams; i += kBatch) {
+    ASSERT_EQ(client.send(datagrams, "127.0.0.1", kPort),
+              static_cast<int>(kBatch));
+    for (size_t received = 0; received < kBatch;) {
+      int count =
+          server.receive(std::span{buffers}.subspan(received), lengths);
+      ASSERT_GT(count, 0);
+      received += count;
+    }
+  }
+  auto batch =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  fmt::print(
+      "UDP loopback {} datagrams: single {} us ({:.0f} datagrams/s), "
+      "batch {} us ({:.0f} datagrams/s)\n",
+      kDatagrams, single.count(), kDatagrams * 1e6 / single.count(),
+      batch.count(), kDatagrams * 1e6 / batch.count());
+}
+
+}  // namespace wpi
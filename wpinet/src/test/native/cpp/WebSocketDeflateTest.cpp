@@ -0,0 +1,225 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "WebSocketDeflate.h"  // NOLINT(build/include_order)
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <wpi/SmallString.h>
+#include <wpi/raw_ostream.h>
+
+namespace wpi::detail {
+
+TEST(WebSocketDeflateTest, ParseOfferDefault) {
+  auto params = WebSocketDeflate::ParseOffer("permessage-deflate");
+  ASSERT_TRUE(params);
+  ASSERT_FALSE(params->serverNoContextTakeover);
+  ASSERT_FALSE(params->clientNoContextTakeover);
+  ASSERT_EQ(params->serverMaxWindowBits, 0);
+  ASSERT_EQ(params->clientMaxWindowBits, 0);
+}
+
+TEST(WebSocketDeflateTest, ParseOfferParams) {
+  auto params = WebSocketDeflate::ParseOffer(
+      "permessage-deflate; server_no_context_takeover; "
+      "client_no_context_takeover; server_max_window_bits=\"10\"; "
+      "client_max_window_bits");
+  ASSERT_TRUE(params);
+  ASSERT_TRUE(params->serverNoContextTakeover);
+  ASSERT_TRUE(params->clientNoContextTakeover);
+  ASSERT_EQ(params->serverMaxWindowBits, 10);
+  ASSERT_EQ(params->clientMaxWindowBits, 0);
+}
+
+TEST(WebSocketDeflateTest, ParseOfferFallback) {
+  // first acceptable offer wins
+  auto params = WebSocketDeflate::ParseOffer(
+      "x-webkit-deflate-frame, permessage-deflate; server_max_window_bits=16, "
+      "permessage-deflate; server_max_window_bits=12, permessage-deflate");
+  ASSERT_TRUE(params);
+  ASSERT_EQ(params->serverMaxWindowBits, 12);
+}
+
+TEST(WebSocketDeflateTest, ParseOfferInvalid) {
+  ASSERT_FALSE(WebSocketDeflate::ParseOffer(""));
+  ASSERT_FALSE(WebSocketDeflate::ParseOffer("x-webkit-deflate-frame"));
+  ASSERT_FALSE(WebSocketDeflate::ParseOffer("permessage-deflate; foo"));
+  ASSERT_FALSE(WebSocketDeflate::ParseOffer(
+      "permessage-deflate; server_max_window_bits"));
+  ASSERT_FALSE(WebSocketDeflate::ParseOffer(
+      "permessage-deflate; server_no_context_takeover=1"));
+  ASSERT_FALSE(WebSocketDeflate::ParseOffer(
+      "permessage-deflate; client_max_window_bits=7"));
+  ASSERT_FALSE(WebSocketDeflate::ParseOffer(
+      "permessage-deflate; server_no_context_takeover; "
+      "server_no_context_takeover"));
+}
+
+TEST(WebSocketDeflateTest, ParseResponse) {
+  auto params = WebSocketDeflate::ParseResponse(
+      "permessage-deflate; client_max_window_bits=9; "
+      "server_no_context_takeover");
+  ASSERT_TRUE(params);
+  ASSERT_TRUE(params->serverNoContextTakeover);
+  ASSERT_EQ(params->clientMaxWindowBits, 9);
+
+  // client_max_window_bits must have a value in a response
+  ASSERT_FALSE(WebSocketDeflate::ParseResponse(
+      "permessage-deflate; client_max_window_bits"));
+  ASSERT_FALSE(WebSocketDeflate::ParseResponse("x-webkit-deflate-frame"));
+}
+
+TEST(WebSocketDeflateTest, PrintResponse) {
+  SmallString<64> str;
+  raw_svector_ostream os{str};
+  DeflateParams params;
+  WebSocketDeflate::PrintResponse(os, params);
+  ASSERT_EQ(str.str(), "permessage-deflate");
+
+  str.clear();
+  params.serverNoContextTakeover = true;
+  params.serverMaxWindowBits = 11;
+  WebSocketDeflate::PrintResponse(os, params);
+  ASSERT_EQ(str.str(),
+            "permessage-deflate; server_no_context_takeover; "
+            "server_max_window_bits=11");
+
+  // the response is a valid response
+  auto parsed = WebSocketDeflate::ParseResponse(str.str());
+  ASSERT_TRUE(parsed);
+  ASSERT_TRUE(parsed->serverNoContextTakeover);
+  ASSERT_EQ(parsed->serverMaxWindowBits, 11);
+}
+
+class WebSocketDeflateRoundTripTest
+    : public ::testing::TestWithParam<DeflateParams> {
+ public:
+  void SetUp() override {
+    server = WebSocketDeflate::Create(true, GetParam());
+    client = WebSocketDeflate::Create(false, GetParam());
+    if (!server || !client) {
+      GTEST_SKIP() << "built without compression support";
+    }
+  }
+
+  // Sends a message from the client to the server in frames of fragmentSize
+  std::string SendMessage(std::string_view message, size_t fragmentSize,
+                          size_t* wireSize = nullptr) {
+    SmallVector<uint8_t, 64> out;
+    bool first = true;
+    bool compressed = false;
+    do {
+      std::string_view fragment = message.substr(0, fragmentSize);
+      message.remove_prefix(fragment.size());
+      bool fin = message.empty();
+      uint8_t opcode = (first ? WebSocket::kOpText : WebSocket::kOpCont) |
+                       (fin ? WebSocket::kFlagFin : 0);
+      uv::Buffer buf{fragment};
+      auto payload = client->Compress({opcode, {&buf, 1}});
+      if (first) {
+        compressed = payload.has_value();
+      }
+      EXPECT_EQ(payload.has_value(), compressed);
+      if (!payload) {
+        out.append(fragment.begin(), fragment.end());
+      } else {
+        if (wireSize) {
+          *wireSize += payload->size();
+        }
+        EXPECT_TRUE(server->Decompress(*payload, fin, out, 1 << 20));
+      }
+      first = false;
+    } while (!message.empty());
+    return {out.begin(), out.end()};
+  }
+
+  std::unique_ptr<WebSocketDeflate> server;
+  std::unique_ptr<WebSocketDeflate> client;
+};
+
+TEST_P(WebSocketDeflateRoundTripTest, Messages) {
+  std::string message =
+      R"({"method":"announce","params":{"name":"/SmartDashboard/Value",)"
+      R"("id":1,"type":"double","pubuid":1,"properties":{}}})";
+  size_t firstSize = 0;
+  size_t secondSize = 0;
+  ASSERT_EQ(SendMessage(message, message.size(), &firstSize), message);
+  ASSERT_EQ(SendMessage(message, message.size(), &secondSize), message);
+  // an 8 bit window only allows Huffman coding
+  if (GetParam().clientMaxWindowBits != 8) {
+    ASSERT_LT(firstSize, message.size());
+    if (!GetParam().clientNoContextTakeover) {
+      // the second copy refers back to the first
+      ASSERT_LT(secondSize, firstSize / 2);
+    }
+  }
+
+  // small messages aren't compressed
+  ASSERT_EQ(SendMessage("hi", 2), "hi");
+  ASSERT_EQ(SendMessage(message, message.size()), message);
+}
+
+TEST_P(WebSocketDeflateRoundTripTest, Fragmented) {
+  std::string message;
+  for (int i = 0; i < 500; ++i) {
+    message += std::to_string(i * i);
+  }
+  ASSERT_EQ(SendMessage(message, 100), message);
+  ASSERT_EQ(SendMessage(message, 7), message);
+  // even small fragmented messages are compressed
+  ASSERT_EQ(SendMessage("abc", 1), "abc");
+}
+
+TEST_P(WebSocketDeflateRoundTripTest, Empty) {
+  auto payload = client->Compress({WebSocket::Frame::kTextFragment, {}});
+  ASSERT_TRUE(payload);
+  SmallVector<uint8_t, 16> out;
+  ASSERT_TRUE(server->Decompress(*payload, false, out, 100));
+  payload = client->Compress({WebSocket::Frame::kFinalFragment, {}});
+  ASSERT_TRUE(payload);
+  ASSERT_TRUE(server->Decompress(*payload, true, out, 100));
+  ASSERT_TRUE(out.empty());
+}
+
+TEST_P(WebSocketDeflateRoundTripTest, MaxSize) {
+  std::string message(10000, 'a');
+  uv::Buffer buf{message};
+  auto payload = client->Compress({WebSocket::Frame::kText, {&buf, 1}});
+  ASSERT_TRUE(payload);
+  // decompression stops early
+  SmallVector<uint8_t, 16> out;
+  ASSERT_TRUE(server->Decompress(*payload, true, out, 1000));
+  ASSERT_GT(out.size(), 1000u);
+  ASSERT_LT(out.size(), message.size());
+}
+
+TEST_P(WebSocketDeflateRoundTripTest, Invalid) {
+  const uint8_t data[] = {0xff, 0xff, 0xff, 0xff};
+  SmallVector<uint8_t, 16> out;
+  ASSERT_FALSE(server->Decompress(data, true, out, 1000));
+}
+
+static DeflateParams NoContextTakeover() {
+  DeflateParams params;
+  params.serverNoContextTakeover = true;
+  params.clientNoContextTakeover = true;
+  return params;
+}
+
+static DeflateParams WindowBits(int bits) {
+  DeflateParams params;
+  params.serverMaxWindowBits = bits;
+  params.clientMaxWindowBits = bits;
+  return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(WebSocketDeflateRoundTripTests,
+                         WebSocketDeflateRoundTripTest,
+                         ::testing::Values(DeflateParams{}, NoContextTakeover(),
+                                           WindowBits(8), WindowBits(9)));
+
+}  // namespace wpi::detail
@@ -4,8 +4,12 @@
 
 #include "wpinet/WebSocketServer.h"  // NOLINT(build/include_order)
 
+#include <string>
+#include <vector>
+
 #include <wpi/SmallString.h>
 
+#include "WebSocketDeflate.h"
 #include "WebSocketTest.h"
 #include "wpinet/HttpParser.h"
 
@@ -188,4 +192,106 @@ TEST_F(WebSocketIntegrationTest, ServerSendPing) {
   ASSERT_EQ(gotPong, 1);
 }
 
+TEST_F(WebSocketIntegrationTest, Deflate) {
+  if (!detail::WebSocketDeflate::IsAvailable()) {
+    GTEST_SKIP() << "built without compression support";
+  }
+  int gotServerData = 0;
+  int gotClientData = 0;
+  std::string message;
+  for (int i = 0; i < 100; ++i) {
+    message += "/SmartDashboard/Value" + std::to_string(i);
+  }
+
+  serverPipe->Listen([&]() {
+    auto conn = serverPipe->Accept();
+    WebSocketServer::ServerOptions options;
+    options.deflate = true;
+    auto server = WebSocketServer::Create(*conn, {}, options);
+    server->connected.connect([&](std::string_view, WebSocket& ws) {
+      ASSERT_TRUE(ws.IsDeflateEnabled());
+      ws.text.connect([&](std::string_view data, bool) {
+        ++gotServerData;
+        ASSERT_EQ(data, message);
+        // echo back twice; first with TrySendFrames, then with SendFrames
+        uv::Buffer buf{message};
+        WebSocket::Frame frame{WebSocket::Frame::kText, {&buf, 1}};
+        auto unsent = ws.TrySendFrames({{frame}}, [](auto, uv::Error) {});
+        ASSERT_TRUE(unsent.empty());
+        ws.SendFrames({{frame}}, [](auto, uv::Error) {});
+      });
+    });
+  });
+
+  clientPipe->Connect(pipeName, [&] {
+    WebSocket::ClientOptions options;
+    options.deflate = true;
+    auto ws =
+        WebSocket::CreateClient(*clientPipe, "/test", pipeName, {}, options);
+    ws->closed.connect([&](uint16_t code, std::string_view reason) {
+      Finish();
+      if (code != 1005 && code != 1006) {
+        FAIL() << "Code: " << code << " Reason: " << reason;
+      }
+    });
+    ws->open.connect([&, s = ws.get()](std::string_view) {
+      ASSERT_TRUE(s->IsDeflateEnabled());
+      // send as fragments
+      s->SendTextFragment({{std::string_view{message}.substr(0, 100)}},
+                          [](auto, uv::Error) {});
+      s->SendFragment({{std::string_view{message}.substr(100)}}, true,
+                      [](auto, uv::Error) {});
+    });
+    ws->text.connect([&, s = ws.get()](std::string_view data, bool) {
+      ASSERT_EQ(data, message);
+      if (++gotClientData == 2) {
+        s->Close();
+      }
+    });
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotServerData, 1);
+  ASSERT_EQ(gotClientData, 2);
+}
+
+TEST_F(WebSocketIntegrationTest, DeflateNotAccepted) {
+  int gotData = 0;
+
+  serverPipe->Listen([&]() {
+    auto conn = serverPipe->Accept();
+    auto server = WebSocketServer::Create(*conn);
+    server->connected.connect([&](std::string_view, WebSocket& ws) {
+      ASSERT_FALSE(ws.IsDeflateEnabled());
+      ws.text.connect([&](std::string_view data, bool) {
+        ++gotData;
+        ASSERT_EQ(data, "hello");
+      });
+    });
+  });
+
+  clientPipe->Connect(pipeName, [&] {
+    WebSocket::ClientOptions options;
+    options.deflate = true;
+    auto ws =
+        WebSocket::CreateClient(*clientPipe, "/test", pipeName, {}, options);
+    ws->closed.connect([&](uint16_t code, std::string_view reason) {
+      Finish();
+      if (code != 1005 && code != 1006) {
+        FAIL() << "Code: " << code << " Reason: " << reason;
+      }
+    });
+    ws->open.connect([&, s = ws.get()](std::string_view) {
+      ASSERT_FALSE(s->IsDeflateEnabled());
+      s->SendText({{"hello"}}, [&](auto, uv::Error) {});
+      s->Close();
+    });
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotData, 1);
+}
+
 }  // namespace wpi
@@ -8,6 +8,7 @@
 #include <array>
 #include <ostream>
 #include <span>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <wpi/SpanMatcher.h>
@@ -46,6 +47,45 @@ inline void PrintTo(const WebSocket::Frame& frame, ::std::ostream* os) {
 
 namespace wpi::detail {
 
+TEST(WebSocketMaskTest, MaskData) {
+  const std::array<uint8_t, 4> key{0x11, 0x22, 0x33, 0x44};
+  std::vector<uint8_t> in(37);
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  // Every length exercises a different mix of word and byte masking
+  for (size_t len = 0; len <= in.size(); ++len) {
+    std::vector<uint8_t> out(len);
+    auto nextKey = MaskData(std::span{in}.subspan(0, len), out.data(), key);
+    for (size_t i = 0; i < len; ++i) {
+      ASSERT_EQ(out[i], in[i] ^ key[i % 4]) << "len " << len << " i " << i;
+    }
+    ASSERT_EQ(nextKey[0], key[len % 4]);
+  }
+}
+
+TEST(WebSocketMaskTest, MaskDataContinued) {
+  const std::array<uint8_t, 4> key{0x11, 0x22, 0x33, 0x44};
+  std::vector<uint8_t> in(37);
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<uint8_t>(i * 7);
+  }
+  std::vector<uint8_t> expected(in.size());
+  MaskData(in, expected.data(), key);
+
+  // Masking in pieces matches masking all at once
+  std::vector<uint8_t> out(in.size());
+  auto nextKey = MaskData(std::span{in}.subspan(0, 3), out.data(), key);
+  nextKey = MaskData(std::span{in}.subspan(3, 21), out.data() + 3, nextKey);
+  MaskData(std::span{in}.subspan(24), out.data() + 24, nextKey);
+  ASSERT_EQ(expected, out);
+
+  // Unmasking in place restores the input
+  MaskData(out, out.data(), key);
+  ASSERT_EQ(in, out);
+}
+
 class MockWebSocketWriteReq
     : public std::enable_shared_from_this<MockWebSocketWriteReq>,
       public detail::WebSocketWriteReqBase {
@@ -4,10 +4,14 @@
 
 #include "wpinet/WebSocket.h"  // NOLINT(build/include_order)
 
+#include <string>
+
 #include <wpi/Base64.h>
 #include <wpi/SmallString.h>
+#include <wpi/StringExtras.h>
 #include <wpi/sha1.h>
 
+#include "WebSocketDeflate.h"
 #include "WebSocketTest.h"
 #include "wpinet/HttpParser.h"
 #include "wpinet/raw_uv_ostream.h"
@@ -21,7 +25,7 @@ class WebSocketServerTest : public WebSocketTest {
 
     serverPipe->Listen([this]() {
       auto conn = serverPipe->Accept();
-      ws = WebSocket::CreateServer(*conn, "foo", "13");
+      ws = WebSocket::CreateServer(*conn, "foo", "13", {}, extensions);
       if (setupWebSocket) {
         setupWebSocket();
       }
@@ -50,6 +54,7 @@ class WebSocketServerTest : public WebSocketTest {
     });
   }
 
+  std::string_view extensions;
   std::function<void()> setupWebSocket;
   std::function<void(std::string_view)> handleData;
   std::vector<uint8_t> wireData;
@@ -429,6 +434,48 @@ TEST_F(WebSocketServerTest, ReceiveFragment) {
   ASSERT_EQ(gotCallback, 1);
 }
 
+// Multiple messages in one read are each delivered in full
+TEST_F(WebSocketServerTest, ReceiveMultiple) {
+  int gotCallback = 0;
+
+  std::vector<uint8_t> data(13, 0x03);
+  std::vector<uint8_t> data2(300, 0x04);
+  std::vector<uint8_t> data3(5, 0x05);
+
+  setupWebSocket = [&] {
+    ws->binary.connect([&](auto inData, bool fin) {
+      ++gotCallback;
+      ASSERT_TRUE(fin);
+      std::vector<uint8_t> recvData{inData.begin(), inData.end()};
+      if (gotCallback == 1) {
+        ASSERT_EQ(data, recvData);
+      } else if (gotCallback == 2) {
+        ASSERT_EQ(data2, recvData);
+      }
+    });
+    ws->text.connect([&](std::string_view inData, bool fin) {
+      ++gotCallback;
+      ws->Terminate();
+      ASSERT_TRUE(fin);
+      std::vector<uint8_t> recvData{inData.begin(), inData.end()};
+      ASSERT_EQ(data3, recvData);
+    });
+  };
+
+  auto message = BuildMessage(0x02, true, true, data);
+  auto message2 = BuildMessage(0x02, true, true, data2);
+  auto message3 = BuildMessage(0x01, true, true, data3);
+  message.insert(message.end(), message2.begin(), message2.end());
+  message.insert(message.end(), message3.begin(), message3.end());
+  resp.headersComplete.connect([&](bool) {
+    clientPipe->Write({{message}}, [&](auto bufs, uv::Error) {});
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotCallback, 3);
+}
+
 // But can be configured for multiple callbacks
 TEST_F(WebSocketServerTest, ReceiveFragmentSeparate) {
   int gotCallback = 0;
@@ -583,6 +630,73 @@ TEST_F(WebSocketServerTest, ReceiveTooLargeFragmented) {
   ASSERT_EQ(gotCallback, 1);
 }
 
+//
+// permessage-deflate compressed messages.
+//
+
+// Compressed "Hello" twice, sharing the compression context (RFC 7692 section
+// 7.2.3.2)
+static const uint8_t kCompressedHello[] = {0xf2, 0x48, 0xcd, 0xc9,
+                                           0xc9, 0x07, 0x00};
+static const uint8_t kCompressedHello2[] = {0xf2, 0x00, 0x11, 0x00, 0x00};
+
+TEST_F(WebSocketServerTest, ReceiveCompressed) {
+  if (!detail::WebSocketDeflate::IsAvailable()) {
+    GTEST_SKIP() << "built without compression support";
+  }
+  int gotCallback = 0;
+  std::string gotExtensions;
+  extensions = "permessage-deflate; client_max_window_bits";
+  setupWebSocket = [&] {
+    ws->text.connect([&](std::string_view data, bool fin) {
+      ++gotCallback;
+      ASSERT_TRUE(fin);
+      ASSERT_EQ(data, "Hello");
+      if (gotCallback == 2) {
+        ws->Terminate();
+      }
+    });
+  };
+  resp.header.connect([&](std::string_view name, std::string_view value) {
+    if (equals_lower(name, "sec-websocket-extensions")) {
+      gotExtensions = value;
+    }
+  });
+  // RSV1 marks the message as compressed
+  auto message = BuildMessage(0x41, true, true, kCompressedHello);
+  auto message2 = BuildMessage(0x41, true, true, kCompressedHello2);
+  resp.headersComplete.connect([&](bool) {
+    clientPipe->Write({{message}, {message2}}, [&](auto bufs, uv::Error) {});
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotExtensions, "permessage-deflate");
+  ASSERT_EQ(gotCallback, 2);
+}
+
+TEST_F(WebSocketServerTest, ReceiveCompressedNotNegotiated) {
+  int gotCallback = 0;
+  setupWebSocket = [&] {
+    ws->text.connect([&](std::string_view, bool) {
+      ws->Terminate();
+      FAIL() << "Should not have gotten compressed message";
+    });
+    ws->closed.connect([&](uint16_t code, std::string_view reason) {
+      ++gotCallback;
+      ASSERT_EQ(code, 1002) << "reason: " << reason;
+    });
+  };
+  auto message = BuildMessage(0x41, true, true, kCompressedHello);
+  resp.headersComplete.connect([&](bool) {
+    clientPipe->Write({{message}}, [&](auto bufs, uv::Error) {});
+  });
+
+  loop->Run();
+
+  ASSERT_EQ(gotCallback, 1);
+}
+
 //
 // Send and receive data.
 //
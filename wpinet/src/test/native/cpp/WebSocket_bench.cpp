@@ -0,0 +1,236 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "WebSocketDeflate.h"
+#include "WebSocketSerializer.h"
+#include "WebSocketTest.h"
+#include "wpinet/WebSocket.h"
+
+namespace wpi {
+
+namespace {
+// A typical NT4 client publish: a small MessagePack value update
+constexpr size_t kMessageSize = 64;
+constexpr int kMessages = 20000;
+}  // namespace
+
+TEST(WebSocketBenchmark, Mask) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  const std::array<uint8_t, 4> key{0x11, 0x22, 0x33, 0x44};
+  std::vector<uint8_t> data(kMessageSize * kMessages, 0x5a);
+
+  // The previous implementation masked one byte at a time
+  auto start = high_resolution_clock::now();
+  for (int rep = 0; rep < 10; ++rep) {
+    int n = 0;
+    for (uint8_t& ch : data) {
+      ch ^= key[n++];
+      if (n >= 4) {
+        n = 0;
+      }
+    }
+  }
+  auto byteTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  start = high_resolution_clock::now();
+  for (int rep = 0; rep < 10; ++rep) {
+    detail::MaskData(data, data.data(), key);
+  }
+  auto wordTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  fmt::print("Mask {} MB: byte loop {} us MaskData {} us ({})\n",
+             data.size() * 10 / 1000000, byteTime.count(), wordTime.count(),
+             data[kMessageSize]);
+}
+
+TEST(WebSocketBenchmark, SerializeClient) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  std::vector<uint8_t> data(kMessageSize, 0x5a);
+  uv::Buffer buf{data};
+  WebSocket::Frame frame{WebSocket::Frame::kBinary, {&buf, 1}};
+  size_t size = 0;
+
+  auto start = high_resolution_clock::now();
+  for (int i = 0; i < kMessages; ++i) {
+    detail::SerializedFrames frames;
+    size += frames.AddClientFrame(frame);
+  }
+  auto time =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  fmt::print("Serialize {} client frames: {} us ({})\n", kMessages,
+             time.count(), size);
+}
+
+// NT4 topic announcements when a client connects to a robot publishing many
+// topics, batched into text frames the way ntcore does
+static std::vector<std::string> AnnounceStorm() {
+  constexpr int kTopics = 2000;
+  constexpr size_t kFrameSize = 1400;
+  static constexpr const char* kTypes[] = {"double", "boolean", "string",
+                                           "double[]"};
+  std::vector<std::string> frames;
+  std::string frame;
+  for (int i = 0; i < kTopics; ++i) {
+    std::string msg = fmt::format(
+        R"({{"method":"announce","params":{{"id":{},)"
+        R"("name":"/SmartDashboard/Subsystem{}/Module{}/Value{}",)"
+        R"("properties":{},"type":"{}"}}}})",
+        i, i / 100, (i / 10) % 10, i % 10,
+        i % 7 == 0 ? R"({"persistent":true})" : "{}", kTypes[i % 4]);
+    if (frame.size() + msg.size() + 2 > kFrameSize) {
+      frames.emplace_back(frame + "]");
+      frame.clear();
+    }
+    frame += frame.empty() ? "[" : ",";
+    frame += msg;
+  }
+  frames.emplace_back(frame + "]");
+  return frames;
+}
+
+TEST(WebSocketBenchmark, DeflateAnnounceStorm) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  auto frames = AnnounceStorm();
+  size_t payloadSize = 0;
+  for (auto&& frame : frames) {
+    payloadSize += frame.size();
+  }
+
+  // server frames are unmasked; all of these are shorter than 64 KiB
+  auto wireSize = [](size_t size) { return (size < 126 ? 2 : 4) + size; };
+
+  auto start = high_resolution_clock::now();
+  size_t plainSize = 0;
+  {
+    detail::SerializedFrames serialized;
+    for (auto&& frame : frames) {
+      uv::Buffer buf{frame};
+      plainSize += serialized.AddFrame({WebSocket::Frame::kText, {&buf, 1}},
+                                       true);
+    }
+  }
+  auto plainTime =
+      duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+  fmt::print("Announce storm: {} frames, {} bytes\n", frames.size(),
+             payloadSize);
+  fmt::print("  uncompressed: {} bytes on wire, serialize {} us\n", plainSize,
+             plainTime.count());
+
+  for (bool contextTakeover : {true, false}) {
+    detail::DeflateParams params;
+    params.serverNoContextTakeover = !contextTakeover;
+    auto server = detail::WebSocketDeflate::Create(true, params);
+    auto client = detail::WebSocketDeflate::Create(false, params);
+    if (!server || !client) {
+      GTEST_SKIP() << "built without compression support";
+    }
+
+    std::vector<std::vector<uint8_t>> payloads;
+    payloads.reserve(frames.size());
+    size_t compressedSize = 0;
+    start = high_resolution_clock::now();
+    for (auto&& frame : frames) {
+      uv::Buffer buf{frame};
+      auto payload = server->Compress({WebSocket::Frame::kText, {&buf, 1}});
+      payloads.emplace_back(payload->begin(), payload->end());
+      compressedSize += wireSize(payload->size());
+    }
+    auto compressTime =
+        duration_cast<microseconds>(high_resolution_clock::now() - start);
+
+    SmallVector<uint8_t, 0> out;
+    size_t inflatedSize = 0;
+    start = high_resolution_clock::now();
+    for (auto&& payload : payloads) {
+      out.clear();
+      ASSERT_TRUE(client->Decompress(payload, true, out, SIZE_MAX));
+      inflatedSize += out.size();
+    }
+    auto decompressTime =
+        duration_cast<microseconds>(high_resolution_clock::now() - start);
+    ASSERT_EQ(inflatedSize, payloadSize);
+
+    fmt::print(
+        "  deflate ({}): {} bytes on wire ({:.1f}%), compress {} us, "
+        "decompress {} us\n",
+        contextTakeover ? "context takeover" : "no context takeover",
+        compressedSize, 100.0 * compressedSize / plainSize,
+        compressTime.count(), decompressTime.count());
+  }
+}
+
+class WebSocketParseBenchmark : public WebSocketTest {
+ public:
+  WebSocketParseBenchmark() {
+    serverPipe->Listen([this]() {
+      auto conn = serverPipe->Accept();
+      ws = WebSocket::CreateServer(*conn, "foo", "13");
+      ws->binary.connect([this](auto data, bool) {
+        if (++received == kMessages) {
+          parseTime = std::chrono::high_resolution_clock::now() - start;
+          ws->Terminate();
+        }
+      });
+    });
+    clientPipe->Connect(pipeName, [this]() {
+      // Skip the server handshake response and send all the messages at once
+      clientPipe->StartRead();
+      clientPipe->data.connect([this](uv::Buffer&, size_t) {
+        if (sent) {
+          return;
+        }
+        sent = true;
+        start = std::chrono::high_resolution_clock::now();
+        clientPipe->Write({{messages}}, [](auto, uv::Error) {});
+      });
+      clientPipe->end.connect([this]() { Finish(); });
+    });
+
+    std::vector<uint8_t> data(kMessageSize, 0x5a);
+    for (int i = 0; i < kMessages; ++i) {
+      auto message = BuildMessage(0x02, true, true, data);
+      messages.insert(messages.end(), message.begin(), message.end());
+    }
+  }
+
+  std::shared_ptr<WebSocket> ws;
+  std::vector<uint8_t> messages;
+  bool sent = false;
+  int received = 0;
+  std::chrono::high_resolution_clock::time_point start;
+  std::chrono::high_resolution_clock::duration parseTime{};
+};
+
+TEST_F(WebSocketParseBenchmark, Receive) {
+  loop->Run();
+
+  ASSERT_EQ(received, kMessages);
+  fmt::print("Receive {} masked messages: {} us\n", kMessages,
+             std::chrono::duration_cast<std::chrono::microseconds>(parseTime)
+                 .count());
+}
+
+}  // namespace wpi
@@ -0,0 +1,97 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/uv/BufferPool.h"  // NOLINT(build/include_order)
+
+#include <cstring>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace wpi::uv {
+
+class UvBufferPoolTest : public ::testing::Test {
+ public:
+  UvBufferPoolTest() { BufferPool::Clear(); }
+  ~UvBufferPoolTest() override { BufferPool::Clear(); }
+};
+
+TEST_F(UvBufferPoolTest, Allocate) {
+  auto buf = BufferPool::Allocate(100);
+  ASSERT_NE(buf.base, nullptr);
+  ASSERT_EQ(buf.len, 100u);  // NOLINT
+  std::memset(buf.base, 0x5a, buf.len);
+  BufferPool::Release(buf);
+  ASSERT_EQ(buf.base, nullptr);
+  ASSERT_EQ(buf.len, 0u);  // NOLINT
+}
+
+TEST_F(UvBufferPoolTest, ReleaseReuse) {
+  auto buf1 = BufferPool::Allocate(1000);
+  auto base = buf1.base;
+  // release doesn't depend on the length
+  buf1.len = 8;
+  BufferPool::Release(buf1);
+
+  // any size in the same size class reuses the buffer
+  auto stats = BufferPool::GetStats();
+  auto buf2 = BufferPool::Allocate(600);
+  ASSERT_EQ(buf2.base, base);
+  ASSERT_EQ(buf2.len, 600u);  // NOLINT
+  ASSERT_EQ(BufferPool::GetStats().heapAllocations, stats.heapAllocations);
+
+  // but not a different size class
+  auto buf3 = BufferPool::Allocate(2000);
+  ASSERT_NE(buf3.base, base);
+  ASSERT_EQ(BufferPool::GetStats().heapAllocations, stats.heapAllocations + 1);
+
+  BufferPool::Release(buf2);
+  BufferPool::Release(buf3);
+}
+
+TEST_F(UvBufferPoolTest, ReleaseSpan) {
+  Buffer bufs[3] = {BufferPool::Allocate(10), BufferPool::Allocate(5000),
+                    BufferPool::Allocate(BufferPool::kMaxSize + 1)};
+  auto stats = BufferPool::GetStats();
+  BufferPool::Release(bufs);
+  for (auto&& buf : bufs) {
+    ASSERT_EQ(buf.base, nullptr);
+  }
+  auto after = BufferPool::GetStats();
+  ASSERT_EQ(after.releases, stats.releases + 3);
+  // oversized buffers are never cached
+  ASSERT_EQ(after.heapFrees, stats.heapFrees + 1);
+}
+
+TEST_F(UvBufferPoolTest, CacheLimit) {
+  constexpr size_t kSize = BufferPool::kMaxSize;
+  constexpr size_t kMaxCached = BufferPool::kMaxCacheBytes / kSize;
+  Buffer bufs[kMaxCached + 2];
+  for (auto&& buf : bufs) {
+    buf = BufferPool::Allocate(kSize);
+  }
+  auto stats = BufferPool::GetStats();
+  BufferPool::Release(bufs);
+  ASSERT_EQ(BufferPool::GetStats().heapFrees, stats.heapFrees + 2);
+
+  stats = BufferPool::GetStats();
+  BufferPool::Clear();
+  ASSERT_EQ(BufferPool::GetStats().heapFrees, stats.heapFrees + kMaxCached);
+}
+
+TEST_F(UvBufferPoolTest, ReleaseOtherThread) {
+  auto buf = BufferPool::Allocate(300);
+  auto base = buf.base;
+  std::thread thr{[&] {
+    BufferPool::Release(buf);
+    // the buffer joins this thread's cache
+    auto buf2 = BufferPool::Allocate(300);
+    EXPECT_EQ(buf2.base, base);
+    BufferPool::Release(buf2);
+  }};
+  thr.join();
+  ASSERT_EQ(buf.base, nullptr);
+}
+
+}  // namespace wpi::uv
@@ -0,0 +1,73 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpinet/uv/Udp.h"  // NOLINT(build/include_order)
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wpinet/uv/Timer.h"
+
+namespace wpi::uv {
+
+namespace {
+constexpr size_t kDatagrams = 100;
+
+class UvUdpTest : public ::testing::TestWithParam<unsigned int> {};
+}  // namespace
+
+TEST_P(UvUdpTest, TrySendBatch) {
+  auto loop = Loop::Create();
+  auto server = Udp::Create(loop, AF_INET | GetParam());
+  auto client = Udp::Create(loop, AF_INET);
+  auto failTimer = Timer::Create(loop);
+  server->error.connect([](Error err) { FAIL() << err.str(); });
+  client->error.connect([](Error err) { FAIL() << err.str(); });
+  failTimer->timeout.connect([&] {
+    loop->Stop();
+    FAIL() << "loop failed to terminate";
+  });
+  failTimer->Start(Timer::Time{1000});
+  failTimer->Unreference();
+
+  server->Bind("127.0.0.1", 0);
+  sockaddr_storage serverAddr = server->GetSock();
+
+  std::vector<std::string> received;
+  server->received.connect(
+      [&](Buffer& buf, size_t len, const sockaddr&, unsigned) {
+        received.emplace_back(buf.base, len);
+        if (received.size() == kDatagrams) {
+          loop->Walk([](Handle& h) { h.Close(); });
+        }
+      });
+  server->StartRecv();
+#ifdef __linux__
+  ASSERT_EQ(server->IsUsingRecvmmsg(), GetParam() != 0);
+#endif
+
+  std::vector<std::string> sent;
+  std::vector<Buffer> datagrams;
+  for (size_t i = 0; i < kDatagrams; ++i) {
+    sent.emplace_back(std::to_string(i * 1000));
+  }
+  for (auto&& str : sent) {
+    datagrams.emplace_back(str);
+  }
+  ASSERT_EQ(client->TrySendBatch(reinterpret_cast<sockaddr&>(serverAddr),
+                                 datagrams),
+            kDatagrams);
+
+  loop->Run();
+
+  ASSERT_EQ(received, sent);
+}
+
+INSTANTIATE_TEST_SUITE_P(UvUdpTests, UvUdpTest,
+                         ::testing::Values(0, UV_UDP_RECVMMSG));
+
+}  // namespace wpi::uv
@@ -19,6 +19,7 @@
 
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <cstdio>
 #include <cstdlib>
@@ -28,6 +29,7 @@
 
 #include <fmt/format.h>
 
+#include "wpi/DataLogCompression.h"
 #include "wpi/Endian.h"
 #include "wpi/Logger.h"
 #include "wpi/MathExtras.h"
@@ -41,6 +43,7 @@ static constexpr size_t kMaxBufferCount = 1024 * 1024 / kBlockSize;
 static constexpr size_t kMaxFreeCount = 256 * 1024 / kBlockSize;
 static constexpr size_t kRecordMaxHeaderSize = 17;
 static constexpr uintmax_t kMinFreeSpace = 5 * 1024 * 1024;
+static constexpr size_t kNumShards = 8;
 
 static std::string FormatBytesSize(uintmax_t value) {
   static constexpr uintmax_t kKiB = 1024;
@@ -128,15 +131,30 @@ class DataLog::Buffer {
 
   size_t GetRemaining() const { return m_maxLen - m_len; }
 
+  size_t GetCapacity() const { return m_maxLen; }
+
   std::span<uint8_t> GetData() { return {m_buf, m_len}; }
   std::span<const uint8_t> GetData() const { return {m_buf, m_len}; }
 
+  // link for the outgoing stack
+  Buffer* next = nullptr;
+
  private:
   uint8_t* m_buf;
   size_t m_len = 0;
   size_t m_maxLen;
 };
 
+// Append staging area.  Threads are assigned to shards round-robin, so with
+// up to kNumShards logging threads the shard mutex is only contended when the
+// writer thread or a control record collects the partially filled buffer.
+// This is a wpi::mutex rather than a spinlock so a low priority thread holding
+// it gets priority inheritance on the roboRIO.
+struct alignas(64) DataLog::Shard {
+  wpi::mutex mutex;
+  std::unique_ptr<Buffer> buf;
+};
+
 static void DefaultLog(unsigned int level, const char* file, unsigned int line,
                        const char* msg) {
   if (level > wpi::WPI_LOG_INFO) {
@@ -149,28 +167,34 @@ static void DefaultLog(unsigned int level, const char* file, unsigned int line,
 static wpi::Logger defaultMessageLog{DefaultLog};
 
 DataLog::DataLog(std::string_view dir, std::string_view filename, double period,
-                 std::string_view extraHeader)
-    : DataLog{defaultMessageLog, dir, filename, period, extraHeader} {}
+                 std::string_view extraHeader, bool compress)
+    : DataLog{defaultMessageLog, dir, filename, period, extraHeader,
+              compress} {}
 
 DataLog::DataLog(wpi::Logger& msglog, std::string_view dir,
                  std::string_view filename, double period,
-                 std::string_view extraHeader)
+                 std::string_view extraHeader, bool compress)
     : m_msglog{msglog},
       m_period{period},
+      m_compress{compress},
       m_extraHeader{extraHeader},
       m_newFilename{filename},
+      m_shards{new Shard[kNumShards]},
       m_thread{[this, dir = std::string{dir}] { WriterThreadMain(dir); }} {}
 
 DataLog::DataLog(std::function<void(std::span<const uint8_t> data)> write,
-                 double period, std::string_view extraHeader)
-    : DataLog{defaultMessageLog, std::move(write), period, extraHeader} {}
+                 double period, std::string_view extraHeader, bool compress)
+    : DataLog{defaultMessageLog, std::move(write), period, extraHeader,
+              compress} {}
 
 DataLog::DataLog(wpi::Logger& msglog,
                  std::function<void(std::span<const uint8_t> data)> write,
-                 double period, std::string_view extraHeader)
+                 double period, std::string_view extraHeader, bool compress)
     : m_msglog{msglog},
       m_period{period},
+      m_compress{compress},
       m_extraHeader{extraHeader},
+      m_shards{new Shard[kNumShards]},
       m_thread{[this, write = std::move(write)] {
         WriterThreadMain(std::move(write));
       }} {}
@@ -241,7 +265,7 @@ static void WriteToFile(fs::file_t f, std::span<const uint8_t> data,
   } while (data.size() > 0);
 }
 
-static std::string MakeRandomFilename() {
+static std::string MakeRandomFilename(bool compress) {
   // build random filename
   static std::random_device dev;
   static std::mt19937 rng(dev());
@@ -251,7 +275,9 @@ static std::string MakeRandomFilename() {
   for (int i = 0; i < 16; i++) {
     filename += v[dist(rng)];
   }
-  filename += ".wpilog";
+  // compressed logs can't be read by existing WPILOG readers, so give them
+  // their own extension
+  filename += compress ? ".wpilogz" : ".wpilog";
   return filename;
 }
 
@@ -269,7 +295,7 @@ void DataLog::WriterThreadMain(std::string_view dir) {
   }
 
   if (filename.empty()) {
-    filename = MakeRandomFilename();
+    filename = MakeRandomFilename(m_compress);
   }
 
   fs::file_t f = fs::kInvalidFile;
@@ -296,7 +322,7 @@ void DataLog::WriterThreadMain(std::string_view dir) {
         WPI_ERROR(m_msglog, "Could not open log file '{}': {}",
                   (dirPath / filename).string(), ec.message());
         // try again with random filename
-        filename = MakeRandomFilename();
+        filename = MakeRandomFilename(m_compress);
       } else {
         break;
       }
@@ -310,22 +336,42 @@ void DataLog::WriterThreadMain(std::string_view dir) {
     }
   }
 
+  // when compressing, each flush is written as one or more complete frames
+  DataLogFrameWriter frameWriter;
+  std::vector<uint8_t> compressed;
+  auto writeData = [&](std::span<const uint8_t> data) {
+    if (m_compress) {
+      frameWriter.Append(data, &compressed);
+    } else {
+      WriteToFile(f, data, filename, m_msglog);
+    }
+  };
+  auto finishWrite = [&] {
+    if (m_compress) {
+      frameWriter.Finish(&compressed);
+      WriteToFile(f, compressed, filename, m_msglog);
+      compressed.clear();
+    }
+  };
+
   // write header (version 1.0)
   if (f != fs::kInvalidFile) {
+    if (m_compress) {
+      DataLogFrameWriter::WriteHeader(&compressed);
+    }
     const uint8_t header[] = {'W', 'P', 'I', 'L', 'O', 'G', 0, 1};
-    WriteToFile(f, header, filename, m_msglog);
+    writeData(header);
     uint8_t extraLen[4];
     support::endian::write32le(extraLen, m_extraHeader.size());
-    WriteToFile(f, extraLen, filename, m_msglog);
+    writeData(extraLen);
     if (m_extraHeader.size() > 0) {
-      WriteToFile(f,
-                  {reinterpret_cast<const uint8_t*>(m_extraHeader.data()),
-                   m_extraHeader.size()},
-                  filename, m_msglog);
+      writeData({reinterpret_cast<const uint8_t*>(m_extraHeader.data()),
+                 m_extraHeader.size()});
     }
+    finishWrite();
   }
 
-  std::vector<Buffer> toWrite;
+  std::vector<std::unique_ptr<Buffer>> toWrite;
   int freeSpaceCount = 0;
   bool blocked = false;
 
@@ -359,11 +405,10 @@ void DataLog::WriterThreadMain(std::string_view dir) {
     if (doFlush || m_doFlush) {
       // flush to file
       m_doFlush = false;
-      if (m_outgoing.empty()) {
+      TakeOutgoing(toWrite);
+      if (toWrite.empty()) {
         continue;
       }
-      // swap outgoing with empty vector
-      toWrite.swap(m_outgoing);
 
       if (f != fs::kInvalidFile && !blocked) {
         lock.unlock();
@@ -377,7 +422,7 @@ void DataLog::WriterThreadMain(std::string_view dir) {
         // write buffers to file
         for (auto&& buf : toWrite) {
           // stop writing when we go below the minimum free space
-          freeSpace -= buf.GetData().size();
+          freeSpace -= buf->GetData().size();
           if (freeSpace < kMinFreeSpace) {
             [[unlikely]] WPI_ERROR(
                 m_msglog,
@@ -386,8 +431,9 @@ void DataLog::WriterThreadMain(std::string_view dir) {
             blocked = true;
             break;
           }
-          WriteToFile(f, buf.GetData(), filename, m_msglog);
+          writeData(buf->GetData());
         }
+        finishWrite();
 
         // sync to storage
 #if defined(__linux__)
@@ -402,39 +448,70 @@ void DataLog::WriterThreadMain(std::string_view dir) {
       }
 
       // release buffers back to free list
-      for (auto&& buf : toWrite) {
-        buf.Clear();
-        if (m_free.size() < kMaxFreeCount) {
-          [[likely]] m_free.emplace_back(std::move(buf));
-        }
-      }
-      toWrite.resize(0);
+      ReleaseBuffers(toWrite);
     }
   }
 
+  // write anything still outstanding (e.g. if the log was destroyed before
+  // this thread started waiting)
+  TakeOutgoing(toWrite);
+  lock.unlock();
   if (f != fs::kInvalidFile) {
+    for (auto&& buf : toWrite) {
+      if (blocked || freeSpace < kMinFreeSpace + buf->GetData().size()) {
+        break;
+      }
+      freeSpace -= buf->GetData().size();
+      writeData(buf->GetData());
+    }
+    finishWrite();
     fs::CloseFile(f);
   }
+  ReleaseBuffers(toWrite);
 }
 
 void DataLog::WriterThreadMain(
     std::function<void(std::span<const uint8_t> data)> write) {
   std::chrono::duration<double> periodTime{m_period};
 
+  // when compressing, each flush is written as one or more complete frames
+  DataLogFrameWriter frameWriter;
+  std::vector<uint8_t> compressed;
+  auto writeData = [&](std::span<const uint8_t> data) {
+    if (m_compress) {
+      frameWriter.Append(data, &compressed);
+    } else {
+      write(data);
+    }
+  };
+  auto finishWrite = [&] {
+    if (m_compress) {
+      frameWriter.Finish(&compressed);
+      if (!compressed.empty()) {
+        write(compressed);
+      }
+      compressed.clear();
+    }
+  };
+
   // write header (version 1.0)
   {
+    if (m_compress) {
+      DataLogFrameWriter::WriteHeader(&compressed);
+    }
     const uint8_t header[] = {'W', 'P', 'I', 'L', 'O', 'G', 0, 1};
-    write(header);
+    writeData(header);
     uint8_t extraLen[4];
     support::endian::write32le(extraLen, m_extraHeader.size());
-    write(extraLen);
+    writeData(extraLen);
     if (m_extraHeader.size() > 0) {
-      write({reinterpret_cast<const uint8_t*>(m_extraHeader.data()),
-             m_extraHeader.size()});
+      writeData({reinterpret_cast<const uint8_t*>(m_extraHeader.data()),
+                 m_extraHeader.size()});
     }
+    finishWrite();
   }
 
-  std::vector<Buffer> toWrite;
+  std::vector<std::unique_ptr<Buffer>> toWrite;
 
   std::unique_lock lock{m_mutex};
   while (m_active) {
@@ -447,35 +524,166 @@ void DataLog::WriterThreadMain(
     if (doFlush || m_doFlush) {
       // flush to file
       m_doFlush = false;
-      if (m_outgoing.empty()) {
+      TakeOutgoing(toWrite);
+      if (toWrite.empty()) {
         continue;
       }
-      // swap outgoing with empty vector
-      toWrite.swap(m_outgoing);
 
       lock.unlock();
       // write buffers
       for (auto&& buf : toWrite) {
-        if (!buf.GetData().empty()) {
-          write(buf.GetData());
+        if (!buf->GetData().empty()) {
+          writeData(buf->GetData());
         }
       }
-      lock.lock();
+      finishWrite();
 
       // release buffers back to free list
-      for (auto&& buf : toWrite) {
-        buf.Clear();
-        if (m_free.size() < kMaxFreeCount) {
-          [[likely]] m_free.emplace_back(std::move(buf));
-        }
-      }
-      toWrite.resize(0);
+      ReleaseBuffers(toWrite);
+      lock.lock();
+    }
+  }
+
+  // write anything still outstanding (e.g. if the log was destroyed before
+  // this thread started waiting)
+  TakeOutgoing(toWrite);
+  lock.unlock();
+  for (auto&& buf : toWrite) {
+    if (!buf->GetData().empty()) {
+      writeData(buf->GetData());
     }
   }
+  finishWrite();
+  ReleaseBuffers(toWrite);
 
   write({});  // indicate EOF
 }
 
+DataLog::Shard& DataLog::GetShard() {
+  static std::atomic<unsigned int> nextShard{0};
+  thread_local unsigned int shard =
+      nextShard.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+  return m_shards[shard];
+}
+
+std::unique_ptr<DataLog::Buffer> DataLog::GetFreeBuffer(size_t size) {
+  if (size > kBlockSize) {
+    return std::make_unique<Buffer>(size);
+  }
+  {
+    std::scoped_lock lock{m_freeMutex};
+    if (!m_free.empty()) {
+      auto buf = std::move(m_free.back());
+      m_free.pop_back();
+      return buf;
+    }
+  }
+  return std::make_unique<Buffer>();
+}
+
+void DataLog::PushOutgoing(std::unique_ptr<Buffer> buf) {
+  size_t size = buf->GetData().size();
+  if (m_outgoingSize.fetch_add(size, std::memory_order_relaxed) + size >
+          kMaxBufferCount * kBlockSize &&
+      !m_paused.exchange(true)) {
+    [[unlikely]] WPI_ERROR(
+        m_msglog,
+        "outgoing buffers exceeded threshold, pausing logging--"
+        "consider flushing to disk more frequently (smaller period)");
+  }
+  Buffer* node = buf.release();
+  node->next = m_outgoing.load(std::memory_order_relaxed);
+  while (!m_outgoing.compare_exchange_weak(node->next, node,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+  }
+}
+
+void DataLog::TakeOutgoing(std::vector<std::unique_ptr<Buffer>>& bufs) {
+  // hand off partially filled shard buffers
+  for (size_t i = 0; i < kNumShards; ++i) {
+    auto& shard = m_shards[i];
+    std::scoped_lock lock{shard.mutex};
+    if (shard.buf && !shard.buf->GetData().empty()) {
+      PushOutgoing(std::move(shard.buf));
+    }
+  }
+
+  // take the whole stack and put it back in push order
+  Buffer* buf = m_outgoing.exchange(nullptr, std::memory_order_acquire);
+  size_t start = bufs.size();
+  while (buf) {
+    Buffer* next = buf->next;
+    bufs.emplace_back(buf);
+    buf = next;
+  }
+  std::reverse(bufs.begin() + start, bufs.end());
+}
+
+void DataLog::ReleaseBuffers(std::vector<std::unique_ptr<Buffer>>& bufs) {
+  std::scoped_lock lock{m_freeMutex};
+  for (auto&& buf : bufs) {
+    m_outgoingSize.fetch_sub(buf->GetData().size(), std::memory_order_relaxed);
+    buf->Clear();
+    if (buf->GetCapacity() == kBlockSize && m_free.size() < kMaxFreeCount) {
+      [[likely]] m_free.emplace_back(std::move(buf));
+    }
+  }
+  bufs.clear();
+}
+
+uint8_t* DataLog::StartRecord(Shard& shard, uint32_t entry, uint64_t timestamp,
+                              uint32_t payloadSize) {
+  // records are never split across buffers, as buffers from different shards
+  // may be interleaved
+  size_t size = kRecordMaxHeaderSize + payloadSize;
+  if (!shard.buf || size > shard.buf->GetRemaining()) {
+    if (shard.buf && !shard.buf->GetData().empty()) {
+      PushOutgoing(std::move(shard.buf));
+    }
+    shard.buf = GetFreeBuffer(size);
+  }
+  uint8_t* buf = shard.buf->Reserve(size);
+  auto headerLen = WriteRecordHeader(buf, entry, timestamp, payloadSize);
+  shard.buf->Unreserve(kRecordMaxHeaderSize - headerLen);
+  return buf + headerLen;
+}
+
+uint8_t* DataLog::StartControlRecord(uint64_t timestamp,
+                                     uint32_t payloadSize) {
+  // gather everything appended so far (by any thread) ahead of the control
+  // record, so e.g. a finish record follows all data records for the entry
+  m_control.clear();
+  for (size_t i = 0; i < kNumShards; ++i) {
+    auto& shard = m_shards[i];
+    std::scoped_lock lock{shard.mutex};
+    if (shard.buf) {
+      auto data = shard.buf->GetData();
+      m_control.insert(m_control.end(), data.begin(), data.end());
+      shard.buf->Clear();
+    }
+  }
+  size_t pos = m_control.size();
+  m_control.resize(pos + kRecordMaxHeaderSize + payloadSize);
+  auto headerLen =
+      WriteRecordHeader(&m_control[pos], 0, timestamp, payloadSize);
+  m_control.resize(pos + headerLen + payloadSize);
+  return &m_control[pos + headerLen];
+}
+
+void DataLog::FinishControlRecord() {
+  auto buf = std::make_unique<Buffer>(m_control.size());
+  std::memcpy(buf->Reserve(m_control.size()), m_control.data(),
+              m_control.size());
+  PushOutgoing(std::move(buf));
+}
+
+static uint8_t* WriteString(uint8_t* buf, std::string_view str) {
+  wpi::support::endian::write32le(buf, str.size());
+  std::memcpy(buf + 4, str.data(), str.size());
+  return buf + 4 + str.size();
+}
+
 // Control records use the following format:
 // 1-byte type
 // 4-byte entry
@@ -501,12 +709,13 @@ int DataLog::Start(std::string_view name, std::string_view type,
   }
   entryInfo.type = type;
   size_t strsize = name.size() + type.size() + metadata.size();
-  uint8_t* buf = StartRecord(0, timestamp, 5 + 12 + strsize, 5);
+  uint8_t* buf = StartControlRecord(timestamp, 5 + 12 + strsize);
   *buf++ = impl::kControlStart;
   wpi::support::endian::write32le(buf, entryInfo.id);
-  AppendStringImpl(name);
-  AppendStringImpl(type);
-  AppendStringImpl(metadata);
+  buf = WriteString(buf + 4, name);
+  buf = WriteString(buf, type);
+  WriteString(buf, metadata);
+  FinishControlRecord();
 
   return entryInfo.id;
 }
@@ -525,9 +734,10 @@ void DataLog::Finish(int entry, int64_t timestamp) {
     return;
   }
   m_entryCounts.erase(entry);
-  uint8_t* buf = StartRecord(0, timestamp, 5, 5);
+  uint8_t* buf = StartControlRecord(timestamp, 5);
   *buf++ = impl::kControlFinish;
   wpi::support::endian::write32le(buf, entry);
+  FinishControlRecord();
 }
 
 void DataLog::SetMetadata(int entry, std::string_view metadata,
@@ -536,123 +746,70 @@ void DataLog::SetMetadata(int entry, std::string_view metadata,
     return;
   }
   std::scoped_lock lock{m_mutex};
-  uint8_t* buf = StartRecord(0, timestamp, 5 + 4 + metadata.size(), 5);
+  uint8_t* buf = StartControlRecord(timestamp, 5 + 4 + metadata.size());
   *buf++ = impl::kControlSetMetadata;
   wpi::support::endian::write32le(buf, entry);
-  AppendStringImpl(metadata);
-}
-
-uint8_t* DataLog::Reserve(size_t size) {
-  assert(size <= kBlockSize);
-  if (m_outgoing.empty() || size > m_outgoing.back().GetRemaining()) {
-    if (m_free.empty()) {
-      if (m_outgoing.size() >= kMaxBufferCount) {
-        [[unlikely]] WPI_ERROR(
-            m_msglog,
-            "outgoing buffers exceeded threshold, pausing logging--"
-            "consider flushing to disk more frequently (smaller period)");
-        m_paused = true;
-      }
-      m_outgoing.emplace_back();
-    } else {
-      m_outgoing.emplace_back(std::move(m_free.back()));
-      m_free.pop_back();
-    }
-  }
-  return m_outgoing.back().Reserve(size);
-}
-
-uint8_t* DataLog::StartRecord(uint32_t entry, uint64_t timestamp,
-                              uint32_t payloadSize, size_t reserveSize) {
-  uint8_t* buf = Reserve(kRecordMaxHeaderSize + reserveSize);
-  auto headerLen = WriteRecordHeader(buf, entry, timestamp, payloadSize);
-  m_outgoing.back().Unreserve(kRecordMaxHeaderSize - headerLen);
-  buf += headerLen;
-  return buf;
-}
-
-void DataLog::AppendImpl(std::span<const uint8_t> data) {
-  while (data.size() > kBlockSize) {
-    uint8_t* buf = Reserve(kBlockSize);
-    std::memcpy(buf, data.data(), kBlockSize);
-    data = data.subspan(kBlockSize);
-  }
-  uint8_t* buf = Reserve(data.size());
-  std::memcpy(buf, data.data(), data.size());
-}
-
-void DataLog::AppendStringImpl(std::string_view str) {
-  uint8_t* buf = Reserve(4);
-  wpi::support::endian::write32le(buf, str.size());
-  AppendImpl({reinterpret_cast<const uint8_t*>(str.data()), str.size()});
+  WriteString(buf + 4, metadata);
+  FinishControlRecord();
 }
 
 void DataLog::AppendRaw(int entry, std::span<const uint8_t> data,
                         int64_t timestamp) {
-  if (entry <= 0) {
+  if (entry <= 0 || m_paused) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
-    return;
-  }
-  StartRecord(entry, timestamp, data.size(), 0);
-  AppendImpl(data);
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, data.size());
+  std::memcpy(buf, data.data(), data.size());
 }
 
 void DataLog::AppendRaw2(int entry,
                          std::span<const std::span<const uint8_t>> data,
                          int64_t timestamp) {
-  if (entry <= 0) {
-    return;
-  }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (entry <= 0 || m_paused) {
     return;
   }
   size_t size = 0;
   for (auto&& chunk : data) {
     size += chunk.size();
   }
-  StartRecord(entry, timestamp, size, 0);
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, size);
   for (auto chunk : data) {
-    AppendImpl(chunk);
+    std::memcpy(buf, chunk.data(), chunk.size());
+    buf += chunk.size();
   }
 }
 
 void DataLog::AppendBoolean(int entry, bool value, int64_t timestamp) {
-  if (entry <= 0) {
+  if (entry <= 0 || m_paused) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
-    return;
-  }
-  uint8_t* buf = StartRecord(entry, timestamp, 1, 1);
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, 1);
   buf[0] = value ? 1 : 0;
 }
 
 void DataLog::AppendInteger(int entry, int64_t value, int64_t timestamp) {
-  if (entry <= 0) {
+  if (entry <= 0 || m_paused) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
-    return;
-  }
-  uint8_t* buf = StartRecord(entry, timestamp, 8, 8);
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, 8);
   wpi::support::endian::write64le(buf, value);
 }
 
 void DataLog::AppendFloat(int entry, float value, int64_t timestamp) {
-  if (entry <= 0) {
-    return;
-  }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
+  if (entry <= 0 || m_paused) {
     return;
   }
-  uint8_t* buf = StartRecord(entry, timestamp, 4, 4);
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, 4);
   if constexpr (wpi::support::endian::system_endianness() ==
                 wpi::support::little) {
     std::memcpy(buf, &value, 4);
@@ -662,14 +819,12 @@ void DataLog::AppendFloat(int entry, float value, int64_t timestamp) {
 }
 
 void DataLog::AppendDouble(int entry, double value, int64_t timestamp) {
-  if (entry <= 0) {
+  if (entry <= 0 || m_paused) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
-    return;
-  }
-  uint8_t* buf = StartRecord(entry, timestamp, 8, 8);
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, 8);
   if constexpr (wpi::support::endian::system_endianness() ==
                 wpi::support::little) {
     std::memcpy(buf, &value, 8);
@@ -687,23 +842,12 @@ void DataLog::AppendString(int entry, std::string_view value,
 
 void DataLog::AppendBooleanArray(int entry, std::span<const bool> arr,
                                  int64_t timestamp) {
-  if (entry <= 0) {
+  if (entry <= 0 || m_paused) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
-    return;
-  }
-  StartRecord(entry, timestamp, arr.size(), 0);
-  uint8_t* buf;
-  while (arr.size() > kBlockSize) {
-    buf = Reserve(kBlockSize);
-    for (auto val : arr.subspan(0, kBlockSize)) {
-      *buf++ = val ? 1 : 0;
-    }
-    arr = arr.subspan(kBlockSize);
-  }
-  buf = Reserve(arr.size());
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, arr.size());
   for (auto val : arr) {
     *buf++ = val ? 1 : 0;
   }
@@ -711,23 +855,12 @@ void DataLog::AppendBooleanArray(int entry, std::span<const bool> arr,
 
 void DataLog::AppendBooleanArray(int entry, std::span<const int> arr,
                                  int64_t timestamp) {
-  if (entry <= 0) {
+  if (entry <= 0 || m_paused) {
     return;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
-    return;
-  }
-  StartRecord(entry, timestamp, arr.size(), 0);
-  uint8_t* buf;
-  while (arr.size() > kBlockSize) {
-    buf = Reserve(kBlockSize);
-    for (auto val : arr.subspan(0, kBlockSize)) {
-      *buf++ = val & 1;
-    }
-    arr = arr.subspan(kBlockSize);
-  }
-  buf = Reserve(arr.size());
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, arr.size());
   for (auto val : arr) {
     *buf++ = val & 1;
   }
@@ -746,24 +879,12 @@ void DataLog::AppendIntegerArray(int entry, std::span<const int64_t> arr,
               {reinterpret_cast<const uint8_t*>(arr.data()), arr.size() * 8},
               timestamp);
   } else {
-    if (entry <= 0) {
+    if (entry <= 0 || m_paused) {
       return;
     }
-    std::scoped_lock lock{m_mutex};
-    if (m_paused) {
-      return;
-    }
-    StartRecord(entry, timestamp, arr.size() * 8, 0);
-    uint8_t* buf;
-    while ((arr.size() * 8) > kBlockSize) {
-      buf = Reserve(kBlockSize);
-      for (auto val : arr.subspan(0, kBlockSize / 8)) {
-        wpi::support::endian::write64le(buf, val);
-        buf += 8;
-      }
-      arr = arr.subspan(kBlockSize / 8);
-    }
-    buf = Reserve(arr.size() * 8);
+    auto& shard = GetShard();
+    std::scoped_lock lock{shard.mutex};
+    uint8_t* buf = StartRecord(shard, entry, timestamp, arr.size() * 8);
     for (auto val : arr) {
       wpi::support::endian::write64le(buf, val);
       buf += 8;
@@ -779,24 +900,12 @@ void DataLog::AppendFloatArray(int entry, std::span<const float> arr,
               {reinterpret_cast<const uint8_t*>(arr.data()), arr.size() * 4},
               timestamp);
   } else {
-    if (entry <= 0) {
+    if (entry <= 0 || m_paused) {
       return;
     }
-    std::scoped_lock lock{m_mutex};
-    if (m_paused) {
-      return;
-    }
-    StartRecord(entry, timestamp, arr.size() * 4, 0);
-    uint8_t* buf;
-    while ((arr.size() * 4) > kBlockSize) {
-      buf = Reserve(kBlockSize);
-      for (auto val : arr.subspan(0, kBlockSize / 4)) {
-        wpi::support::endian::write32le(buf, wpi::bit_cast<uint32_t>(val));
-        buf += 4;
-      }
-      arr = arr.subspan(kBlockSize / 4);
-    }
-    buf = Reserve(arr.size() * 4);
+    auto& shard = GetShard();
+    std::scoped_lock lock{shard.mutex};
+    uint8_t* buf = StartRecord(shard, entry, timestamp, arr.size() * 4);
     for (auto val : arr) {
       wpi::support::endian::write32le(buf, wpi::bit_cast<uint32_t>(val));
       buf += 4;
@@ -812,24 +921,12 @@ void DataLog::AppendDoubleArray(int entry, std::span<const double> arr,
               {reinterpret_cast<const uint8_t*>(arr.data()), arr.size() * 8},
               timestamp);
   } else {
-    if (entry <= 0) {
+    if (entry <= 0 || m_paused) {
       return;
     }
-    std::scoped_lock lock{m_mutex};
-    if (m_paused) {
-      return;
-    }
-    StartRecord(entry, timestamp, arr.size() * 8, 0);
-    uint8_t* buf;
-    while ((arr.size() * 8) > kBlockSize) {
-      buf = Reserve(kBlockSize);
-      for (auto val : arr.subspan(0, kBlockSize / 8)) {
-        wpi::support::endian::write64le(buf, wpi::bit_cast<uint64_t>(val));
-        buf += 8;
-      }
-      arr = arr.subspan(kBlockSize / 8);
-    }
-    buf = Reserve(arr.size() * 8);
+    auto& shard = GetShard();
+    std::scoped_lock lock{shard.mutex};
+    uint8_t* buf = StartRecord(shard, entry, timestamp, arr.size() * 8);
     for (auto val : arr) {
       wpi::support::endian::write64le(buf, wpi::bit_cast<uint64_t>(val));
       buf += 8;
@@ -839,7 +936,7 @@ void DataLog::AppendDoubleArray(int entry, std::span<const double> arr,
 
 void DataLog::AppendStringArray(int entry, std::span<const std::string> arr,
                                 int64_t timestamp) {
-  if (entry <= 0) {
+  if (entry <= 0 || m_paused) {
     return;
   }
   // storage: 4-byte array length, each string prefixed by 4-byte length
@@ -848,21 +945,20 @@ void DataLog::AppendStringArray(int entry, std::span<const std::string> arr,
   for (auto&& str : arr) {
     size += 4 + str.size();
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
-    return;
-  }
-  uint8_t* buf = StartRecord(entry, timestamp, size, 4);
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, size);
   wpi::support::endian::write32le(buf, arr.size());
+  buf += 4;
   for (auto&& str : arr) {
-    AppendStringImpl(str);
+    buf = WriteString(buf, str);
   }
 }
 
 void DataLog::AppendStringArray(int entry,
                                 std::span<const std::string_view> arr,
                                 int64_t timestamp) {
-  if (entry <= 0) {
+  if (entry <= 0 || m_paused) {
     return;
   }
   // storage: 4-byte array length, each string prefixed by 4-byte length
@@ -871,21 +967,20 @@ void DataLog::AppendStringArray(int entry,
   for (auto&& str : arr) {
     size += 4 + str.size();
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
-    return;
-  }
-  uint8_t* buf = StartRecord(entry, timestamp, size, 4);
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, size);
   wpi::support::endian::write32le(buf, arr.size());
+  buf += 4;
   for (auto&& sv : arr) {
-    AppendStringImpl(sv);
+    buf = WriteString(buf, sv);
   }
 }
 
 void DataLog::AppendStringArray(int entry,
                                 std::span<const WPI_DataLog_String> arr,
                                 int64_t timestamp) {
-  if (entry <= 0) {
+  if (entry <= 0 || m_paused) {
     return;
   }
   // storage: 4-byte array length, each string prefixed by 4-byte length
@@ -894,14 +989,13 @@ void DataLog::AppendStringArray(int entry,
   for (auto&& str : arr) {
     size += 4 + str.len;
   }
-  std::scoped_lock lock{m_mutex};
-  if (m_paused) {
-    return;
-  }
-  uint8_t* buf = StartRecord(entry, timestamp, size, 4);
+  auto& shard = GetShard();
+  std::scoped_lock lock{shard.mutex};
+  uint8_t* buf = StartRecord(shard, entry, timestamp, size);
   wpi::support::endian::write32le(buf, arr.size());
+  buf += 4;
   for (auto&& sv : arr) {
-    AppendStringImpl(sv.str);
+    buf = WriteString(buf, {sv.str, sv.len});
   }
 }
 
@@ -0,0 +1,277 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLogCompression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "wpi/Endian.h"
+#include "wpi/MemoryBuffer.h"
+
+using namespace wpi::log;
+
+// The compressed format is the LZ4 block format: a sequence of
+// (literals, match) pairs, each starting with a token byte whose high nibble
+// is the literal length and low nibble is the match length minus 4 (15 in
+// either means more length bytes follow, each adding up to 255), followed by
+// the literals and a 2-byte little endian match offset.  The final sequence
+// has only literals.
+static constexpr int kHashBits = 12;
+static constexpr size_t kMinMatch = 4;
+static constexpr size_t kLastLiterals = 5;
+static constexpr size_t kMatchFindLimit = 12;
+static constexpr size_t kMaxOffset = 65535;
+static constexpr uint32_t kEmpty = UINT32_MAX;
+static constexpr size_t kFrameHeaderSize = 8;
+
+static uint32_t Read32(const uint8_t* buf) {
+  uint32_t val;
+  std::memcpy(&val, buf, 4);
+  return val;
+}
+
+static uint32_t Hash(uint32_t val) {
+  return (val * 2654435761u) >> (32 - kHashBits);
+}
+
+static void WriteLength(std::vector<uint8_t>* out, size_t len) {
+  for (; len >= 255; len -= 255) {
+    out->push_back(255);
+  }
+  out->push_back(len);
+}
+
+static void WriteSequence(std::vector<uint8_t>* out,
+                          std::span<const uint8_t> literals, size_t matchLen,
+                          size_t offset) {
+  size_t litToken = (std::min)(literals.size(), size_t{15});
+  size_t matchToken =
+      matchLen == 0 ? 0 : (std::min)(matchLen - kMinMatch, size_t{15});
+  out->push_back((litToken << 4) | matchToken);
+  if (litToken == 15) {
+    WriteLength(out, literals.size() - 15);
+  }
+  out->insert(out->end(), literals.begin(), literals.end());
+  if (matchLen == 0) {
+    return;  // last sequence
+  }
+  out->push_back(offset & 0xff);
+  out->push_back(offset >> 8);
+  if (matchToken == 15) {
+    WriteLength(out, matchLen - kMinMatch - 15);
+  }
+}
+
+static void Compress(std::span<const uint8_t> in, std::vector<uint8_t>* out) {
+  uint32_t table[1 << kHashBits];
+  std::fill(std::begin(table), std::end(table), kEmpty);
+
+  const uint8_t* base = in.data();
+  size_t anchor = 0;
+  size_t pos = 0;
+  if (in.size() > kMatchFindLimit) {
+    size_t limit = in.size() - kMatchFindLimit;
+    size_t matchLimit = in.size() - kLastLiterals;
+    while (pos < limit) {
+      uint32_t seq = Read32(base + pos);
+      uint32_t& entry = table[Hash(seq)];
+      size_t candidate = entry;
+      entry = pos;
+      if (candidate == kEmpty || (pos - candidate) > kMaxOffset ||
+          Read32(base + candidate) != seq) {
+        ++pos;
+        continue;
+      }
+
+      // extend the match forwards, then backwards over pending literals
+      size_t end = pos + kMinMatch;
+      while (end < matchLimit && base[end] == base[candidate + end - pos]) {
+        ++end;
+      }
+      while (pos > anchor && candidate > 0 &&
+             base[pos - 1] == base[candidate - 1]) {
+        --pos;
+        --candidate;
+      }
+
+      WriteSequence(out, in.subspan(anchor, pos - anchor), end - pos,
+                    pos - candidate);
+      pos = end;
+      anchor = pos;
+    }
+  }
+  WriteSequence(out, in.subspan(anchor), 0, 0);
+}
+
+static bool ReadLength(std::span<const uint8_t> in, size_t* pos,
+                       size_t* len) {
+  uint8_t val;
+  do {
+    if (*pos >= in.size()) {
+      return false;
+    }
+    val = in[(*pos)++];
+    *len += val;
+  } while (val == 255);
+  return true;
+}
+
+static bool Decompress(std::span<const uint8_t> in, std::span<uint8_t> out) {
+  size_t ip = 0;
+  size_t op = 0;
+  while (ip < in.size()) {
+    uint8_t token = in[ip++];
+
+    size_t litLen = token >> 4;
+    if (litLen == 15 && !ReadLength(in, &ip, &litLen)) {
+      return false;
+    }
+    if (litLen > (in.size() - ip) || litLen > (out.size() - op)) {
+      return false;
+    }
+    std::memcpy(out.data() + op, in.data() + ip, litLen);
+    ip += litLen;
+    op += litLen;
+    if (ip == in.size()) {
+      break;  // last sequence
+    }
+
+    if ((in.size() - ip) < 2) {
+      return false;
+    }
+    size_t offset = in[ip] | (in[ip + 1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > op) {
+      return false;
+    }
+    size_t matchLen = token & 0xf;
+    if (matchLen == 15 && !ReadLength(in, &ip, &matchLen)) {
+      return false;
+    }
+    matchLen += kMinMatch;
+    if (matchLen > (out.size() - op)) {
+      return false;
+    }
+    // matches may overlap the output, so copy a byte at a time
+    uint8_t* dst = out.data() + op;
+    const uint8_t* src = dst - offset;
+    for (size_t i = 0; i < matchLen; ++i) {
+      dst[i] = src[i];
+    }
+    op += matchLen;
+  }
+  return op == out.size();
+}
+
+void DataLogFrameWriter::WriteHeader(std::vector<uint8_t>* out) {
+  out->insert(out->end(), kCompressedHeader.begin(), kCompressedHeader.end());
+}
+
+void DataLogFrameWriter::Append(std::span<const uint8_t> data,
+                                std::vector<uint8_t>* out) {
+  while (!data.empty()) {
+    size_t toCopy = (std::min)(data.size(), kMaxFrameSize - m_frame.size());
+    m_frame.insert(m_frame.end(), data.begin(), data.begin() + toCopy);
+    data = data.subspan(toCopy);
+    if (m_frame.size() == kMaxFrameSize) {
+      Finish(out);
+    }
+  }
+}
+
+void DataLogFrameWriter::Finish(std::vector<uint8_t>* out) {
+  if (m_frame.empty()) {
+    return;
+  }
+  m_compressed.clear();
+  Compress(m_frame, &m_compressed);
+  // store uncompressed if compression didn't help
+  std::span<const uint8_t> stored = m_compressed;
+  if (stored.size() >= m_frame.size()) {
+    stored = m_frame;
+  }
+
+  size_t pos = out->size();
+  out->resize(pos + kFrameHeaderSize);
+  wpi::support::endian::write32le(out->data() + pos, m_frame.size());
+  wpi::support::endian::write32le(out->data() + pos + 4, stored.size());
+  out->insert(out->end(), stored.begin(), stored.end());
+  m_frame.clear();
+}
+
+bool wpi::log::IsCompressedDataLog(std::span<const uint8_t> data) {
+  return data.size() >= kCompressedHeader.size() &&
+         std::memcmp(data.data(), kCompressedHeader.data(),
+                     kCompressedHeader.size()) == 0;
+}
+
+std::vector<DataLogFrame> wpi::log::GetDataLogFrames(
+    std::span<const uint8_t> data) {
+  std::vector<DataLogFrame> frames;
+  if (!IsCompressedDataLog(data)) {
+    return frames;
+  }
+  size_t pos = kCompressedHeader.size();
+  size_t uncompressedOffset = 0;
+  while ((data.size() - pos) >= kFrameHeaderSize) {
+    size_t uncompressedSize = wpi::support::endian::read32le(&data[pos]);
+    size_t storedSize = wpi::support::endian::read32le(&data[pos + 4]);
+    pos += kFrameHeaderSize;
+    // the writer never produces empty or oversized frames; rejecting them also
+    // bounds the total uncompressed size
+    if (uncompressedSize == 0 ||
+        uncompressedSize > DataLogFrameWriter::kMaxFrameSize ||
+        storedSize > (data.size() - pos) || storedSize > uncompressedSize ||
+        uncompressedSize > (SIZE_MAX - uncompressedOffset)) {
+      break;
+    }
+    frames.push_back({pos, storedSize, uncompressedOffset, uncompressedSize});
+    pos += storedSize;
+    uncompressedOffset += uncompressedSize;
+  }
+  return frames;
+}
+
+bool wpi::log::DecompressDataLogFrame(std::span<const uint8_t> data,
+                                      const DataLogFrame& frame,
+                                      std::span<uint8_t> out) {
+  if (frame.offset > data.size() ||
+      frame.storedSize > (data.size() - frame.offset) ||
+      out.size() != frame.uncompressedSize) {
+    return false;
+  }
+  auto stored = data.subspan(frame.offset, frame.storedSize);
+  if (frame.storedSize == frame.uncompressedSize) {
+    std::memcpy(out.data(), stored.data(), stored.size());
+    return true;
+  }
+  return Decompress(stored, out);
+}
+
+std::unique_ptr<wpi::MemoryBuffer> wpi::log::DecompressDataLog(
+    std::unique_ptr<MemoryBuffer> buffer) {
+  auto data = buffer->GetBuffer();
+  auto frames = GetDataLogFrames(data);
+  size_t size = frames.empty() ? 0
+                               : frames.back().uncompressedOffset +
+                                     frames.back().uncompressedSize;
+  std::string identifier{buffer->GetBufferIdentifier()};
+  auto out = WritableMemoryBuffer::GetNewUninitMemBuffer(size, identifier);
+  if (!out) {
+    return nullptr;
+  }
+  for (auto&& frame : frames) {
+    if (!DecompressDataLogFrame(
+            data, frame,
+            out->GetBuffer().subspan(frame.uncompressedOffset,
+                                     frame.uncompressedSize))) {
+      // keep the frames before the corrupt one
+      return MemoryBuffer::GetMemBufferCopy(
+          out->GetBuffer().subspan(0, frame.uncompressedOffset), identifier);
+    }
+  }
+  return out;
+}
@@ -0,0 +1,151 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLogIndex.h"
+
+#include <algorithm>
+
+#include "wpi/DenseMap.h"
+
+using namespace wpi::log;
+
+DataLogIndex::DataLogIndex(const DataLogReader& reader, size_t timeInterval,
+                           ControlErrorHandler onError,
+                           ProgressHandler onProgress)
+    : m_reader{&reader} {
+  if (timeInterval == 0) {
+    timeInterval = 1;
+  }
+  auto error = [&](ControlError err, size_t pos) {
+    if (onError) {
+      onError(err, pos);
+    }
+  };
+
+  // index into m_entries of each active entry ID
+  wpi::DenseMap<int, size_t> active;
+
+  int64_t maxTimestamp = INT64_MIN;
+  size_t pos = reader.begin().m_pos;
+  size_t recordPos = pos;
+  DataLogRecord record;
+  while (reader.GetRecord(&pos, &record)) {
+    if ((m_numRecords % timeInterval) == 0) {
+      m_timeIndex.push_back({maxTimestamp, recordPos});
+    }
+    ++m_numRecords;
+    maxTimestamp = (std::max)(maxTimestamp, record.GetTimestamp());
+    const Entry* changed = nullptr;
+
+    if (!record.IsControl()) {
+      auto it = active.find(record.GetEntry());
+      if (it != active.end()) {
+        m_entries[it->second].records.emplace_back(recordPos);
+      }
+    } else if (record.IsStart()) {
+      StartRecordData data;
+      if (record.GetStartData(&data)) {
+        // a duplicate start replaces the previous entry with that ID
+        auto [it, isNew] = active.try_emplace(data.entry, m_entries.size());
+        if (!isNew) {
+          error(ControlError::kDuplicateEntry, recordPos);
+          it->second = m_entries.size();
+        }
+        auto& entry = m_entries.emplace_back();
+        entry.start = data;
+        entry.metadata = data.metadata;
+        entry.startPos = recordPos;
+        changed = &entry;
+      } else {
+        error(ControlError::kInvalidStart, recordPos);
+      }
+    } else if (record.IsFinish()) {
+      int id;
+      if (record.GetFinishEntry(&id)) {
+        auto it = active.find(id);
+        if (it != active.end()) {
+          m_entries[it->second].finishPos = recordPos;
+          active.erase(it);
+        } else {
+          error(ControlError::kEntryNotFound, recordPos);
+        }
+      } else {
+        error(ControlError::kInvalidFinish, recordPos);
+      }
+    } else if (record.IsSetMetadata()) {
+      MetadataRecordData data;
+      if (record.GetSetMetadataData(&data)) {
+        auto it = active.find(data.entry);
+        if (it != active.end()) {
+          m_entries[it->second].metadata = data.metadata;
+          changed = &m_entries[it->second];
+        } else {
+          error(ControlError::kEntryNotFound, recordPos);
+        }
+      } else {
+        error(ControlError::kInvalidSetMetadata, recordPos);
+      }
+    } else {
+      error(ControlError::kUnrecognized, recordPos);
+    }
+    recordPos = pos;
+    if (onProgress && !onProgress(m_numRecords, record, changed)) {
+      break;
+    }
+  }
+}
+
+std::vector<const DataLogIndex::Entry*> DataLogIndex::FindEntries(
+    std::string_view name) const {
+  std::vector<const Entry*> rv;
+  for (auto&& entry : m_entries) {
+    if (entry.start.name == name) {
+      rv.emplace_back(&entry);
+    }
+  }
+  return rv;
+}
+
+DataLogRecord DataLogIndex::GetRecord(size_t pos) const {
+  DataLogRecord record;
+  m_reader->GetRecord(&pos, &record);
+  return record;
+}
+
+DataLogIterator DataLogIndex::SeekTime(int64_t timestamp) const {
+  // find the last index point with all earlier records before timestamp
+  auto it = std::partition_point(
+      m_timeIndex.begin(), m_timeIndex.end(),
+      [&](const TimePoint& point) { return point.maxBefore < timestamp; });
+  if (it == m_timeIndex.begin()) {
+    // only possible for INT64_MIN, which all records match
+    return m_timeIndex.empty() ? m_reader->end() : At(it->pos);
+  }
+  --it;
+
+  // scan forward for the first record at or after timestamp; this is always
+  // before the next index point
+  size_t pos = it->pos;
+  size_t recordPos = pos;
+  DataLogRecord record;
+  while (m_reader->GetRecord(&pos, &record)) {
+    if (record.GetTimestamp() >= timestamp) {
+      return At(recordPos);
+    }
+    recordPos = pos;
+  }
+  return m_reader->end();
+}
+
+size_t DataLogIndex::LowerBoundTime(const Entry& entry,
+                                    int64_t timestamp) const {
+  return std::partition_point(
+             entry.records.begin(), entry.records.end(),
+             [&](size_t pos) { return GetTimestamp(pos) < timestamp; }) -
+         entry.records.begin();
+}
+
+int64_t DataLogIndex::GetTimestamp(size_t pos) const {
+  return GetRecord(pos).GetTimestamp();
+}
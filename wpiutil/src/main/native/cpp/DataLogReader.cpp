@@ -4,9 +4,15 @@
 
 #include "wpi/DataLogReader.h"
 
+#include <algorithm>
+#include <atomic>
+#include <string>
+
 #include "wpi/DataLog.h"
+#include "wpi/DataLogCompression.h"
 #include "wpi/Endian.h"
 #include "wpi/MathExtras.h"
+#include "wpi/mutex.h"
 
 using namespace wpi::log;
 
@@ -187,14 +193,94 @@ bool DataLogRecord::GetStringArray(std::vector<std::string_view>* arr) const {
   return true;
 }
 
+// maximum length of a record header
+static constexpr size_t kMaxHeaderLen = 1 + 4 + 4 + 8;
+
+struct DataLogReader::CompressedFrames {
+  std::vector<DataLogFrame> frames;
+  std::unique_ptr<std::atomic_bool[]> decompressed;
+  std::unique_ptr<WritableMemoryBuffer> data;
+  // shrinks to the start of the first corrupt frame
+  std::atomic<size_t> size;
+  wpi::mutex mutex;
+};
+
 DataLogReader::DataLogReader(std::unique_ptr<MemoryBuffer> buffer)
-    : m_buf{std::move(buffer)} {}
+    : m_buf{std::move(buffer)} {
+  if (!m_buf || !IsCompressedDataLog(m_buf->GetBuffer())) {
+    return;
+  }
+  auto frames = GetDataLogFrames(m_buf->GetBuffer());
+  size_t size = frames.empty() ? 0
+                               : frames.back().uncompressedOffset +
+                                     frames.back().uncompressedSize;
+  auto data = WritableMemoryBuffer::GetNewUninitMemBuffer(
+      size, m_buf->GetBufferIdentifier());
+  if (!data) {
+    m_buf.reset();
+    return;
+  }
+  m_compressed = std::make_unique<CompressedFrames>();
+  m_compressed->decompressed =
+      std::make_unique<std::atomic_bool[]>(frames.size());
+  m_compressed->frames = std::move(frames);
+  m_compressed->data = std::move(data);
+  m_compressed->size = size;
+}
+
+DataLogReader::DataLogReader(DataLogReader&&) = default;
+DataLogReader& DataLogReader::operator=(DataLogReader&&) = default;
+DataLogReader::~DataLogReader() = default;
+
+std::span<const uint8_t> DataLogReader::GetBuffer(size_t pos,
+                                                  size_t len) const {
+  if (!m_buf) {
+    return {};
+  }
+  if (!m_compressed) {
+    return m_buf->GetBuffer();
+  }
+
+  // decompress the frames overlapping [pos, pos + len)
+  auto& c = *m_compressed;
+  size_t size = c.size.load(std::memory_order_acquire);
+  if (pos < size) {
+    size_t end = len < (size - pos) ? pos + len : size;
+    auto it = std::upper_bound(
+        c.frames.begin(), c.frames.end(), pos,
+        [](size_t offset, const auto& frame) {
+          return offset < frame.uncompressedOffset;
+        });
+    for (size_t i = it - c.frames.begin() - 1;
+         i < c.frames.size() && c.frames[i].uncompressedOffset < end; ++i) {
+      if (c.decompressed[i].load(std::memory_order_acquire)) {
+        continue;
+      }
+      std::scoped_lock lock{c.mutex};
+      if (c.decompressed[i].load(std::memory_order_relaxed)) {
+        continue;
+      }
+      auto& frame = c.frames[i];
+      if (!DecompressDataLogFrame(
+              m_buf->GetBuffer(), frame,
+              c.data->GetBuffer().subspan(frame.uncompressedOffset,
+                                          frame.uncompressedSize))) {
+        // the log ends before the corrupt frame
+        c.size.store(frame.uncompressedOffset, std::memory_order_release);
+        break;
+      }
+      c.decompressed[i].store(true, std::memory_order_release);
+    }
+  }
+  return std::span<const uint8_t>{c.data->GetBuffer()}.subspan(
+      0, c.size.load(std::memory_order_acquire));
+}
 
 bool DataLogReader::IsValid() const {
   if (!m_buf) {
     return false;
   }
-  auto buf = m_buf->GetBuffer();
+  auto buf = GetBuffer(0, 12);
   return buf.size() >= 12 &&
          std::string_view{reinterpret_cast<const char*>(buf.data()), 6} ==
              "WPILOG" &&
@@ -205,7 +291,7 @@ uint16_t DataLogReader::GetVersion() const {
   if (!m_buf) {
     return 0;
   }
-  auto buf = m_buf->GetBuffer();
+  auto buf = GetBuffer(0, 12);
   if (buf.size() < 12) {
     return 0;
   }
@@ -216,10 +302,11 @@ std::string_view DataLogReader::GetExtraHeader() const {
   if (!m_buf) {
     return {};
   }
-  auto buf = m_buf->GetBuffer();
-  if (buf.size() < 8) {
+  auto buf = GetBuffer(0, 12);
+  if (buf.size() < 12) {
     return {};
   }
+  buf = GetBuffer(0, 12 + wpi::support::endian::read32le(&buf[8]));
   std::string_view rv;
   buf = buf.subspan(8);
   ReadString(&buf, &rv);
@@ -230,7 +317,7 @@ DataLogReader::iterator DataLogReader::begin() const {
   if (!m_buf) {
     return end();
   }
-  auto buf = m_buf->GetBuffer();
+  auto buf = GetBuffer(0, 12);
   if (buf.size() < 12) {
     return end();
   }
@@ -255,7 +342,7 @@ bool DataLogReader::GetRecord(size_t* pos, DataLogRecord* out) const {
   if (!m_buf) {
     return false;
   }
-  auto buf = m_buf->GetBuffer();
+  auto buf = GetBuffer(*pos, kMaxHeaderLen);
   if (*pos >= buf.size()) {
     return false;
   }
@@ -275,6 +362,15 @@ bool DataLogReader::GetRecord(size_t* pos, DataLogRecord* out) const {
   if (size > (buf.size() - headerLen)) {
     return false;
   }
+  if (m_compressed) {
+    buf = GetBuffer(*pos + headerLen, size);
+    // check this way as a corrupt frame may have shortened the log
+    if (buf.size() < (*pos + headerLen) ||
+        size > (buf.size() - *pos - headerLen)) {
+      return false;
+    }
+    buf = buf.subspan(*pos);
+  }
   int64_t timestamp =
       ReadVarInt(buf.subspan(1 + entryLen + sizeLen, timestampLen));
   *out = DataLogRecord{entry, timestamp, buf.subspan(headerLen, size)};
@@ -282,26 +378,46 @@ bool DataLogReader::GetRecord(size_t* pos, DataLogRecord* out) const {
   return true;
 }
 
+// gets the total length of the record at pos; false if it is incomplete
+static bool GetRecordLength(std::span<const uint8_t> buf, size_t pos,
+                            size_t* len) {
+  if (pos >= buf.size() || (buf.size() - pos) < 4) {  // minimum header length
+    return false;
+  }
+  unsigned int entryLen = (buf[pos] & 0x3) + 1;
+  unsigned int sizeLen = ((buf[pos] >> 2) & 0x3) + 1;
+  unsigned int timestampLen = ((buf[pos] >> 4) & 0x7) + 1;
+  unsigned int headerLen = 1 + entryLen + sizeLen + timestampLen;
+  if ((buf.size() - pos) < headerLen) {
+    return false;
+  }
+  uint32_t size = ReadVarInt(buf.subspan(pos + 1 + entryLen, sizeLen));
+  // check this way to avoid overflow
+  if (size > (buf.size() - pos - headerLen)) {
+    return false;
+  }
+  *len = headerLen + size;
+  return true;
+}
+
 bool DataLogReader::GetNextRecord(size_t* pos) const {
   if (!m_buf) {
     return false;
   }
-  auto buf = m_buf->GetBuffer();
-  if (buf.size() < (*pos + 4)) {  // minimum header length
+  size_t len;
+  if (!GetRecordLength(GetBuffer(*pos, kMaxHeaderLen), *pos, &len)) {
     return false;
   }
-  unsigned int entryLen = (buf[*pos] & 0x3) + 1;
-  unsigned int sizeLen = ((buf[*pos] >> 2) & 0x3) + 1;
-  unsigned int timestampLen = ((buf[*pos] >> 4) & 0x7) + 1;
-  unsigned int headerLen = 1 + entryLen + sizeLen + timestampLen;
-  if (buf.size() < (*pos + headerLen)) {
+  // a truncated final record (e.g. from a log that was cut short) ends the
+  // iteration rather than being returned
+  size_t next = *pos + len;
+  if (!GetRecordLength(GetBuffer(next, kMaxHeaderLen), next, &len)) {
     return false;
   }
-  uint32_t size = ReadVarInt(buf.subspan(*pos + 1 + entryLen, sizeLen));
-  // check this way to avoid overflow
-  if (size >= (buf.size() - *pos - headerLen)) {
+  // decompress the whole record, which may end the log early
+  if (m_compressed && !GetRecordLength(GetBuffer(next, len), next, &len)) {
     return false;
   }
-  *pos += headerLen + size;
+  *pos = next;
   return true;
 }
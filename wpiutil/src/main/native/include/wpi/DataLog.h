@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 #ifdef __cplusplus
+#include <atomic>
 #include <functional>
 #include <initializer_list>
 #include <memory>
@@ -71,12 +72,16 @@ enum ControlRecordType {
  * good idea to call Finish() from destructors for this reason.
  *
  * DataLog calls are thread safe.  DataLog uses a typical multiple-supplier,
- * single-consumer setup.  Writes to the log are atomic, but there is no
- * guaranteed order in the log when multiple threads are writing to it;
- * whichever thread grabs the write mutex first will get written first.
- * For this reason (as well as the fact that timestamps can be set to
- * arbitrary values), records in the log are not guaranteed to be sorted by
- * timestamp.
+ * single-consumer setup.  Append() calls write into a per-thread staging
+ * buffer, and filled buffers are handed off to the writer thread without
+ * locking; this avoids contention between threads that are logging at high
+ * rates.  Writes to the log are atomic, and records appended by a single
+ * thread are written in order, but records from different threads may be
+ * interleaved in blocks.  Start(), Finish(), and SetMetadata() are ordered
+ * with respect to all records appended (by any thread) before the call and
+ * after it returns.  For this reason (as well as the fact that timestamps can
+ * be set to arbitrary values), records in the log are not guaranteed to be
+ * sorted by timestamp.
  */
 class DataLog final {
  public:
@@ -86,13 +91,19 @@ class DataLog final {
    *
    * @param dir directory to store the log
    * @param filename filename to use; if none provided, a random filename is
-   *                 generated of the form "wpilog_{}.wpilog"
+   *                 generated of the form "wpilog_{}.wpilog" (or
+   *                 "wpilog_{}.wpilogz" if compress is true)
    * @param period time between automatic flushes to disk, in seconds;
    *               this is a time/storage tradeoff
    * @param extraHeader extra header data
+   * @param compress if true, write a compressed log (see
+   *                 DataLogCompression.h); DataLogReader reads these
+   *                 transparently, but other WPILOG readers (e.g. the Java
+   *                 DataLogReader or AdvantageScope) can't read them
    */
   explicit DataLog(std::string_view dir = "", std::string_view filename = "",
-                   double period = 0.25, std::string_view extraHeader = "");
+                   double period = 0.25, std::string_view extraHeader = "",
+                   bool compress = false);
 
   /**
    * Construct a new Data Log.  The log will be initially created with a
@@ -101,14 +112,19 @@ class DataLog final {
    * @param msglog message logger (will be called from separate thread)
    * @param dir directory to store the log
    * @param filename filename to use; if none provided, a random filename is
-   *                 generated of the form "wpilog_{}.wpilog"
+   *                 generated of the form "wpilog_{}.wpilog" (or
+   *                 "wpilog_{}.wpilogz" if compress is true)
    * @param period time between automatic flushes to disk, in seconds;
    *               this is a time/storage tradeoff
    * @param extraHeader extra header data
+   * @param compress if true, write a compressed log (see
+   *                 DataLogCompression.h); DataLogReader reads these
+   *                 transparently, but other WPILOG readers (e.g. the Java
+   *                 DataLogReader or AdvantageScope) can't read them
    */
   explicit DataLog(wpi::Logger& msglog, std::string_view dir = "",
                    std::string_view filename = "", double period = 0.25,
-                   std::string_view extraHeader = "");
+                   std::string_view extraHeader = "", bool compress = false);
 
   /**
    * Construct a new Data Log that passes its output to the provided function
@@ -120,9 +136,14 @@ class DataLog final {
    * @param period time between automatic calls to write, in seconds;
    *               this is a time/storage tradeoff
    * @param extraHeader extra header data
+   * @param compress if true, write a compressed log (see
+   *                 DataLogCompression.h); DataLogReader reads these
+   *                 transparently, but other WPILOG readers (e.g. the Java
+   *                 DataLogReader or AdvantageScope) can't read them
    */
   explicit DataLog(std::function<void(std::span<const uint8_t> data)> write,
-                   double period = 0.25, std::string_view extraHeader = "");
+                   double period = 0.25, std::string_view extraHeader = "",
+                   bool compress = false);
 
   /**
    * Construct a new Data Log that passes its output to the provided function
@@ -135,10 +156,15 @@ class DataLog final {
    * @param period time between automatic calls to write, in seconds;
    *               this is a time/storage tradeoff
    * @param extraHeader extra header data
+   * @param compress if true, write a compressed log (see
+   *                 DataLogCompression.h); DataLogReader reads these
+   *                 transparently, but other WPILOG readers (e.g. the Java
+   *                 DataLogReader or AdvantageScope) can't read them
    */
   explicit DataLog(wpi::Logger& msglog,
                    std::function<void(std::span<const uint8_t> data)> write,
-                   double period = 0.25, std::string_view extraHeader = "");
+                   double period = 0.25, std::string_view extraHeader = "",
+                   bool compress = false);
 
   ~DataLog();
   DataLog(const DataLog&) = delete;
@@ -359,29 +385,48 @@ class DataLog final {
                          int64_t timestamp);
 
  private:
+  class Buffer;
+  struct Shard;
+
   void WriterThreadMain(std::string_view dir);
   void WriterThreadMain(
       std::function<void(std::span<const uint8_t> data)> write);
 
+  Shard& GetShard();
+
+  // must be called with the shard mutex held; reserves space for the whole
+  // record in the shard's buffer and returns a pointer to the payload
+  uint8_t* StartRecord(Shard& shard, uint32_t entry, uint64_t timestamp,
+                       uint32_t payloadSize);
+
   // must be called with m_mutex held
-  uint8_t* StartRecord(uint32_t entry, uint64_t timestamp, uint32_t payloadSize,
-                       size_t reserveSize);
-  uint8_t* Reserve(size_t size);
-  void AppendImpl(std::span<const uint8_t> data);
-  void AppendStringImpl(std::string_view str);
+  uint8_t* StartControlRecord(uint64_t timestamp, uint32_t payloadSize);
+  void FinishControlRecord();
+
+  std::unique_ptr<Buffer> GetFreeBuffer(size_t size);
+  void PushOutgoing(std::unique_ptr<Buffer> buf);
+  void ReleaseBuffers(std::vector<std::unique_ptr<Buffer>>& bufs);
+
+  // must be called with m_mutex held; returns buffers in log order
+  void TakeOutgoing(std::vector<std::unique_ptr<Buffer>>& bufs);
 
   wpi::Logger& m_msglog;
   mutable wpi::mutex m_mutex;
   wpi::condition_variable m_cond;
   bool m_active{true};
   bool m_doFlush{false};
-  bool m_paused{false};
+  std::atomic_bool m_paused{false};
   double m_period;
+  bool m_compress;
   std::string m_extraHeader;
   std::string m_newFilename;
-  class Buffer;
-  std::vector<Buffer> m_free;
-  std::vector<Buffer> m_outgoing;
+  std::unique_ptr<Shard[]> m_shards;
+  std::vector<uint8_t> m_control;
+  wpi::mutex m_freeMutex;
+  std::vector<std::unique_ptr<Buffer>> m_free;
+  // lock-free stack of buffers waiting for the writer thread, newest first
+  std::atomic<Buffer*> m_outgoing{nullptr};
+  std::atomic<size_t> m_outgoingSize{0};
   struct EntryInfo {
     std::string type;
     int id{0};
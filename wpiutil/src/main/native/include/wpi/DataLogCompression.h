@@ -0,0 +1,132 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace wpi {
+class MemoryBuffer;
+}  // namespace wpi
+
+namespace wpi::log {
+
+/**
+ * Compressed data log container.
+ *
+ * The container starts with an 8-byte header ("WPIZLOG" followed by a version
+ * byte of 1), followed by a sequence of frames.  The header deliberately does
+ * not start with "WPILOG", so existing WPILOG readers reject compressed logs
+ * instead of misreading them; compressed log files use the ".wpilogz"
+ * extension.  Each frame is independently
+ * compressed and consists of:
+ *
+ * - 4-byte (32-bit little endian) uncompressed size
+ * - 4-byte (32-bit little endian) stored size
+ * - stored data: compressed with a LZ4 block compatible format, or
+ *   uncompressed if the stored size equals the uncompressed size
+ *
+ * Concatenating the uncompressed contents of all frames results in a normal
+ * data log.  As frame headers can be walked without decompressing the frame
+ * data, a frame index can be built cheaply, and a log that was cut short
+ * (e.g. by a power loss) can be read up to the last complete frame.
+ */
+inline constexpr std::string_view kCompressedHeader{"WPIZLOG\x01", 8};
+
+/** Location of a compressed data log frame. */
+struct DataLogFrame {
+  /** Offset of the frame data in the compressed log. */
+  size_t offset;
+
+  /** Size of the frame data in the compressed log. */
+  size_t storedSize;
+
+  /** Offset of the frame contents in the uncompressed log. */
+  size_t uncompressedOffset;
+
+  /** Size of the frame contents in the uncompressed log. */
+  size_t uncompressedSize;
+};
+
+/**
+ * Accumulates data log contents into compressed frames.
+ */
+class DataLogFrameWriter {
+ public:
+  /** Maximum amount of uncompressed data in a single frame. */
+  static constexpr size_t kMaxFrameSize = 128 * 1024;
+
+  /**
+   * Appends the container header to out.
+   *
+   * @param out output
+   */
+  static void WriteHeader(std::vector<uint8_t>* out);
+
+  /**
+   * Adds data to the current frame.  If the frame is full, it is compressed
+   * and appended to out.
+   *
+   * @param data data
+   * @param out output
+   */
+  void Append(std::span<const uint8_t> data, std::vector<uint8_t>* out);
+
+  /**
+   * Compresses the current frame (if not empty) and appends it to out.
+   *
+   * @param out output
+   */
+  void Finish(std::vector<uint8_t>* out);
+
+ private:
+  std::vector<uint8_t> m_frame;
+  std::vector<uint8_t> m_compressed;
+};
+
+/**
+ * Returns true if data starts with the compressed data log header.
+ *
+ * @param data data
+ * @return True if compressed
+ */
+bool IsCompressedDataLog(std::span<const uint8_t> data);
+
+/**
+ * Builds the frame index for a compressed data log by walking the frame
+ * headers.  An incomplete final frame is not included.
+ *
+ * @param data compressed data log
+ * @return frames
+ */
+std::vector<DataLogFrame> GetDataLogFrames(std::span<const uint8_t> data);
+
+/**
+ * Decompresses a single frame.
+ *
+ * @param data compressed data log
+ * @param frame frame
+ * @param out output; must be frame.uncompressedSize bytes long
+ * @return False if the frame data is corrupt
+ */
+bool DecompressDataLogFrame(std::span<const uint8_t> data,
+                            const DataLogFrame& frame, std::span<uint8_t> out);
+
+/**
+ * Decompresses a compressed data log.  If a frame is corrupt, the result
+ * contains the frames before it.
+ *
+ * @param buffer compressed data log
+ * @return Uncompressed data log, with the same buffer identifier
+ */
+std::unique_ptr<MemoryBuffer> DecompressDataLog(
+    std::unique_ptr<MemoryBuffer> buffer);
+
+}  // namespace wpi::log
@@ -0,0 +1,182 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include "wpi/DataLogReader.h"
+
+namespace wpi::log {
+
+/**
+ * Random-access index for a data log. The index is built by a single pass
+ * over the record headers of the log (record data is not examined except for
+ * control records), and then allows iterating over the records of a single
+ * entry and seeking by timestamp without scanning the whole log.
+ *
+ * The index refers to the reader's buffer (which is memory-mapped when opened
+ * with MemoryBuffer::GetFile()), so the reader must outlive the index.
+ */
+class DataLogIndex {
+ public:
+  /** Default number of records between sparse timestamp index points. */
+  static constexpr size_t kDefaultTimeInterval = 256;
+
+  /**
+   * An entry, from its start record to its finish record. As entry IDs may be
+   * reused after an entry is finished, there may be multiple entries with
+   * the same ID (or the same name) in a log.
+   */
+  struct Entry {
+    /** Data from the start record. */
+    StartRecordData start;
+
+    /** Most recent metadata (from the start or a set metadata record). */
+    std::string_view metadata;
+
+    /** Position of the start record. */
+    size_t startPos;
+
+    /** Position of the finish record, or SIZE_MAX if not finished. */
+    size_t finishPos{SIZE_MAX};
+
+    /** Positions of the data records for this entry, in log order. */
+    std::vector<size_t> records;
+  };
+
+  /** A problem with a control record found while building the index. */
+  enum class ControlError {
+    /** A start record could not be decoded. */
+    kInvalidStart,
+    /** A start record reused an active entry ID; it replaces that entry. */
+    kDuplicateEntry,
+    /** A finish record could not be decoded. */
+    kInvalidFinish,
+    /** A finish or set metadata record referred to an inactive entry ID. */
+    kEntryNotFound,
+    /** A set metadata record could not be decoded. */
+    kInvalidSetMetadata,
+    /** A control record of an unknown type. */
+    kUnrecognized
+  };
+
+  /**
+   * Called for each control record problem, with the problem and the position
+   * of the record.
+   */
+  using ControlErrorHandler = std::function<void(ControlError, size_t)>;
+
+  /**
+   * Called after each record is indexed, with the number of records indexed so
+   * far, the record, and the entry a start or set metadata record applied to
+   * (nullptr for other records; only valid for the duration of the call).
+   * Returning false stops indexing; the index then only covers the records up
+   * to and including this one.
+   */
+  using ProgressHandler = std::function<bool(
+      size_t numRecords, const DataLogRecord& record, const Entry* entry)>;
+
+  /**
+   * Builds an index for a data log.
+   *
+   * @param reader data log reader
+   * @param timeInterval number of records between sparse timestamp index
+   *                     points; SeekTime() scans at most this many records
+   * @param onError called for each control record problem (optional)
+   * @param onProgress called after each record is indexed (optional); this
+   *                   allows showing entries while a large log is indexed, and
+   *                   cancelling indexing
+   */
+  explicit DataLogIndex(const DataLogReader& reader,
+                        size_t timeInterval = kDefaultTimeInterval,
+                        ControlErrorHandler onError = {},
+                        ProgressHandler onProgress = {});
+
+  /**
+   * Gets all entries in the log, in order of their start records.
+   *
+   * @return entries
+   */
+  const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+  /**
+   * Finds all entries with the given name.
+   *
+   * @param name entry name
+   * @return entries, in order of their start records
+   */
+  std::vector<const Entry*> FindEntries(std::string_view name) const;
+
+  /**
+   * Gets the total number of records (including control records) in the log.
+   *
+   * @return number of records
+   */
+  size_t GetNumRecords() const { return m_numRecords; }
+
+  /**
+   * Gets the record at a position (e.g. from Entry::records).
+   *
+   * @param pos record position
+   * @return record (with an entry ID of -1 if pos is past the end)
+   */
+  DataLogRecord GetRecord(size_t pos) const;
+
+  /**
+   * Gets an iterator over the log starting at a record position.
+   *
+   * @param pos record position
+   * @return iterator
+   */
+  DataLogIterator At(size_t pos) const {
+    return DataLogIterator{m_reader, pos};
+  }
+
+  /**
+   * Finds the position in the log of the first record with a timestamp
+   * greater than or equal to the given timestamp. All records before the
+   * returned position have earlier timestamps; as records are not required to
+   * be written in timestamp order, there may be later records with earlier
+   * timestamps.
+   *
+   * @param timestamp timestamp, in integer microseconds
+   * @return iterator (end if no record has a later timestamp)
+   */
+  DataLogIterator SeekTime(int64_t timestamp) const;
+
+  /**
+   * Finds the index into entry.records of the first record with a timestamp
+   * greater than or equal to the given timestamp, using binary search. This
+   * assumes the records of the entry are in timestamp order (which is the
+   * case when each entry is only written from a single thread).
+   *
+   * @param entry entry
+   * @param timestamp timestamp, in integer microseconds
+   * @return index into entry.records (entry.records.size() if none)
+   */
+  size_t LowerBoundTime(const Entry& entry, int64_t timestamp) const;
+
+ private:
+  int64_t GetTimestamp(size_t pos) const;
+
+  const DataLogReader* m_reader;
+  std::vector<Entry> m_entries;
+  size_t m_numRecords = 0;
+
+  // sparse timestamp index, one point every timeInterval records: record
+  // position and the maximum timestamp of all records before it
+  struct TimePoint {
+    int64_t maxBefore;
+    size_t pos;
+  };
+  std::vector<TimePoint> m_timeIndex;
+};
+
+}  // namespace wpi::log
@@ -245,6 +245,7 @@ class DataLogRecord {
   int m_entry{-1};
 };
 
+class DataLogIndex;
 class DataLogReader;
 
 /** DataLogReader iterator. */
@@ -289,6 +290,8 @@ class DataLogIterator {
   pointer operator->() const { return &this->operator*(); }
 
  private:
+  friend class DataLogIndex;
+
   const DataLogReader* m_reader;
   size_t m_pos;
   mutable bool m_valid = false;
@@ -297,14 +300,25 @@ class DataLogIterator {
 
 /** Data log reader (reads logs written by the DataLog class). */
 class DataLogReader {
+  friend class DataLogIndex;
   friend class DataLogIterator;
 
  public:
   using iterator = DataLogIterator;
 
-  /** Constructs from a memory buffer. */
+  /**
+   * Constructs from a memory buffer.  Compressed logs (see
+   * DataLogCompression.h) are decompressed a frame at a time as records are
+   * read.  If a frame is corrupt, the log ends before it.
+   *
+   * @param buffer memory buffer
+   */
   explicit DataLogReader(std::unique_ptr<MemoryBuffer> buffer);
 
+  DataLogReader(DataLogReader&&);
+  DataLogReader& operator=(DataLogReader&&);
+  ~DataLogReader();
+
   /** Returns true if the data log is valid (e.g. has a valid header). */
   explicit operator bool() const { return IsValid(); }
 
@@ -342,8 +356,13 @@ class DataLogReader {
   iterator end() const { return DataLogIterator{this, SIZE_MAX}; }
 
  private:
+  struct CompressedFrames;
+
   std::unique_ptr<MemoryBuffer> m_buf;
+  // decompression state; null if the log isn't compressed
+  std::unique_ptr<CompressedFrames> m_compressed;
 
+  std::span<const uint8_t> GetBuffer(size_t pos, size_t len) const;
   bool GetRecord(size_t* pos, DataLogRecord* out) const;
   bool GetNextRecord(size_t* pos) const;
 };
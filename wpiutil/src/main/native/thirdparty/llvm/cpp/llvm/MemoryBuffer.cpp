@@ -253,6 +253,7 @@ static std::unique_ptr<WritableMemoryBuffer> GetMemoryBufferForStream(
       return nullptr;
     }
 #endif
+    buffer.truncate(prevSize + readBytes);
   } while (readBytes != 0);
 
   return GetMemBufferCopyImpl(buffer, bufferName, ec);
@@ -370,7 +371,7 @@ static std::unique_ptr<WriteThroughMemoryBuffer> GetReadWriteFile(
 
       // If this not a file or a block device (e.g. it's a named pipe
       // or character device), we can't mmap it, so error out.
-      if (status.st_mode != S_IFREG && status.st_mode != S_IFBLK) {
+      if (!S_ISREG(status.st_mode) && !S_ISBLK(status.st_mode)) {
         ec = make_error_code(errc::invalid_argument);
         return nullptr;
       }
@@ -433,7 +434,7 @@ static std::unique_ptr<MB> GetOpenFileImpl(fs::file_t f,
       // If this not a file or a block device (e.g. it's a named pipe
       // or character device), we can't trust the size. Create the memory
       // buffer by copying off the stream.
-      if (status.st_mode != S_IFREG && status.st_mode != S_IFBLK) {
+      if (!S_ISREG(status.st_mode) && !S_ISBLK(status.st_mode)) {
         return GetMemoryBufferForStream(f, filename, ec);
       }
 
@@ -0,0 +1,245 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLogCompression.h"  // NOLINT(build/include_order)
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wpi/DataLog.h"
+#include "wpi/DataLogReader.h"
+#include "wpi/MemoryBuffer.h"
+
+static std::vector<uint8_t> RoundTrip(std::span<const uint8_t> data) {
+  std::vector<uint8_t> compressed;
+  wpi::log::DataLogFrameWriter::WriteHeader(&compressed);
+  wpi::log::DataLogFrameWriter writer;
+  writer.Append(data, &compressed);
+  writer.Finish(&compressed);
+
+  auto buf = wpi::log::DecompressDataLog(
+      wpi::MemoryBuffer::GetMemBufferCopy(compressed));
+  auto out = buf->GetBuffer();
+  return {out.begin(), out.end()};
+}
+
+TEST(DataLogCompressionTest, RoundTripCompressible) {
+  std::vector<uint8_t> data;
+  for (int i = 0; i < 100000; ++i) {
+    data.push_back(i % 7);
+    if ((i % 1000) == 0) {
+      data.insert(data.end(), 300, 'x');
+    }
+  }
+  EXPECT_EQ(RoundTrip(data), data);
+
+  std::vector<uint8_t> compressed;
+  wpi::log::DataLogFrameWriter writer;
+  writer.Append(data, &compressed);
+  writer.Finish(&compressed);
+  EXPECT_LT(compressed.size(), data.size() / 10);
+}
+
+TEST(DataLogCompressionTest, RoundTripRandom) {
+  std::mt19937 rng{1234};
+  std::vector<uint8_t> data;
+  for (int i = 0; i < 300000; ++i) {
+    data.push_back(rng());
+  }
+  EXPECT_EQ(RoundTrip(data), data);
+}
+
+TEST(DataLogCompressionTest, RoundTripSmall) {
+  for (size_t size = 0; size < 40; ++size) {
+    std::vector<uint8_t> data(size, 'a');
+    EXPECT_EQ(RoundTrip(data), data) << size;
+  }
+}
+
+TEST(DataLogCompressionTest, Frames) {
+  std::vector<uint8_t> data(wpi::log::DataLogFrameWriter::kMaxFrameSize * 2 +
+                                100,
+                            'a');
+  std::vector<uint8_t> compressed;
+  wpi::log::DataLogFrameWriter::WriteHeader(&compressed);
+  wpi::log::DataLogFrameWriter writer;
+  writer.Append(data, &compressed);
+  writer.Finish(&compressed);
+
+  ASSERT_TRUE(wpi::log::IsCompressedDataLog(compressed));
+  // existing WPILOG readers must not mistake this for a normal log
+  EXPECT_NE(std::string_view(reinterpret_cast<const char*>(compressed.data()),
+                             6),
+            "WPILOG");
+  auto frames = wpi::log::GetDataLogFrames(compressed);
+  ASSERT_EQ(frames.size(), 3u);
+  EXPECT_EQ(frames[0].offset, 16u);
+  EXPECT_EQ(frames[0].uncompressedOffset, 0u);
+  EXPECT_EQ(frames[1].offset, frames[0].offset + frames[0].storedSize + 8);
+  EXPECT_EQ(frames[1].uncompressedOffset,
+            wpi::log::DataLogFrameWriter::kMaxFrameSize);
+  EXPECT_EQ(frames[2].uncompressedSize, 100u);
+  EXPECT_EQ(frames[2].offset + frames[2].storedSize, compressed.size());
+
+  // random access to a single frame
+  std::vector<uint8_t> out(frames[1].uncompressedSize);
+  ASSERT_TRUE(wpi::log::DecompressDataLogFrame(compressed, frames[1], out));
+  EXPECT_EQ(out, std::vector<uint8_t>(out.size(), 'a'));
+}
+
+TEST(DataLogCompressionTest, Corrupt) {
+  std::vector<uint8_t> data(1000, 'a');
+  std::vector<uint8_t> compressed;
+  wpi::log::DataLogFrameWriter::WriteHeader(&compressed);
+  wpi::log::DataLogFrameWriter writer;
+  writer.Append(data, &compressed);
+  writer.Finish(&compressed);
+  writer.Append(data, &compressed);
+  writer.Finish(&compressed);
+
+  // corrupt the match offset in the second frame
+  auto frames = wpi::log::GetDataLogFrames(compressed);
+  ASSERT_EQ(frames.size(), 2u);
+  ASSERT_LT(frames[1].storedSize, frames[1].uncompressedSize);
+  compressed[frames[1].offset + 2] = 0xff;
+  compressed[frames[1].offset + 3] = 0xff;
+
+  auto buf = wpi::log::DecompressDataLog(
+      wpi::MemoryBuffer::GetMemBufferCopy(compressed));
+  EXPECT_EQ(buf->GetBuffer().size(), 1000u);
+}
+
+namespace {
+class DataLogCompressedLogTest : public ::testing::Test {
+ public:
+  DataLogCompressedLogTest() {
+    wpi::log::DataLog log{
+        [this](auto out) { data.insert(data.end(), out.begin(), out.end()); },
+        0.25, "extra", true};
+    int a = log.Start("a", "int64", "", 1);
+    int b = log.Start("b", "string", "", 1);
+    for (int64_t i = 0; i < 20000; ++i) {
+      log.AppendInteger(a, i, 10 + i);
+      if ((i % 100) == 0) {
+        log.AppendString(b, "value", 10 + i);
+        log.Flush();
+      }
+    }
+  }
+
+  std::vector<uint8_t> data;
+};
+}  // namespace
+
+TEST_F(DataLogCompressedLogTest, Read) {
+  ASSERT_TRUE(wpi::log::IsCompressedDataLog(data));
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBufferCopy(data)};
+  ASSERT_TRUE(reader.IsValid());
+  EXPECT_EQ(reader.GetExtraHeader(), "extra");
+
+  int64_t count = 0;
+  int strings = 0;
+  for (auto&& record : reader) {
+    if (record.IsStart()) {
+      continue;
+    }
+    int64_t value;
+    std::string_view str;
+    if (record.GetInteger(&value)) {
+      EXPECT_EQ(value, count);
+      EXPECT_EQ(record.GetTimestamp(), 10 + count);
+      ++count;
+    } else if (record.GetString(&str)) {
+      EXPECT_EQ(str, "value");
+      ++strings;
+    }
+  }
+  EXPECT_EQ(count, 20000);
+  EXPECT_EQ(strings, 200);
+}
+
+TEST_F(DataLogCompressedLogTest, Truncated) {
+  // keep the header frame and the first data frame, and cut into the next
+  auto frames = wpi::log::GetDataLogFrames(data);
+  ASSERT_GT(frames.size(), 2u);
+  auto& lastKept = frames[1];
+  data.resize(lastKept.offset + lastKept.storedSize + 10);
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBufferCopy(data)};
+  ASSERT_TRUE(reader.IsValid());
+  int64_t count = 0;
+  for (auto&& record : reader) {
+    int64_t value;
+    if (!record.IsControl() && record.GetInteger(&value)) {
+      EXPECT_EQ(value, count);
+      ++count;
+    }
+  }
+  EXPECT_GT(count, 0);
+  EXPECT_LT(count, 20000);
+}
+
+TEST_F(DataLogCompressedLogTest, CorruptFrame) {
+  // frames are decompressed as they are read, so the log ends at the first
+  // corrupt frame
+  auto frames = wpi::log::GetDataLogFrames(data);
+  ASSERT_GT(frames.size(), 2u);
+  auto& corrupt = frames[2];
+  ASSERT_LT(corrupt.storedSize, corrupt.uncompressedSize);
+  std::fill_n(data.begin() + corrupt.offset, corrupt.storedSize, 0xff);
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBufferCopy(data)};
+  ASSERT_TRUE(reader.IsValid());
+  int64_t count = 0;
+  size_t size = 0;
+  for (auto&& record : reader) {
+    int64_t value;
+    if (!record.IsControl() && record.GetInteger(&value)) {
+      EXPECT_EQ(value, count);
+      ++count;
+    }
+    size += record.GetSize();
+  }
+  EXPECT_GT(count, 0);
+  EXPECT_LT(count, 20000);
+  EXPECT_LT(size, corrupt.uncompressedOffset);
+}
+
+TEST_F(DataLogCompressedLogTest, OversizedFrame) {
+  // a frame header claiming a huge uncompressed size ends the log instead of
+  // being allocated
+  auto frames = wpi::log::GetDataLogFrames(data);
+  ASSERT_GT(frames.size(), 2u);
+  std::fill_n(data.begin() + frames[2].offset - 8, 4, 0xff);
+  EXPECT_EQ(wpi::log::GetDataLogFrames(data).size(), 2u);
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBufferCopy(data)};
+  ASSERT_TRUE(reader.IsValid());
+  int64_t count = 0;
+  size_t size = 0;
+  for (auto&& record : reader) {
+    int64_t value;
+    if (!record.IsControl() && record.GetInteger(&value)) {
+      EXPECT_EQ(value, count);
+      ++count;
+    }
+    size += record.GetSize();
+  }
+  EXPECT_GT(count, 0);
+  EXPECT_LT(size, frames[2].uncompressedOffset);
+}
+
+TEST(DataLogCompressionTest, EmptyFrame) {
+  std::vector<uint8_t> compressed;
+  wpi::log::DataLogFrameWriter::WriteHeader(&compressed);
+  compressed.insert(compressed.end(), 8, 0);
+  EXPECT_TRUE(wpi::log::GetDataLogFrames(compressed).empty());
+}
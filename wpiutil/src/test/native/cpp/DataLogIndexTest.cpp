@@ -0,0 +1,205 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLogIndex.h"  // NOLINT(build/include_order)
+
+#include <stdint.h>
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wpi/DataLog.h"
+#include "wpi/MemoryBuffer.h"
+
+namespace {
+class DataLogIndexTest : public ::testing::Test {
+ public:
+  DataLogIndexTest() {
+    {
+      wpi::log::DataLog log{[this](auto out) {
+        data.insert(data.end(), out.begin(), out.end());
+      }};
+      int a = log.Start("a", "int64", "meta1", 1);
+      int b = log.Start("b", "int64", "", 1);
+      for (int64_t i = 0; i < 100; ++i) {
+        log.AppendInteger(a, i, 10 + i * 10);
+        if ((i % 2) == 0) {
+          log.AppendInteger(b, i, 10 + i * 10);
+        }
+      }
+      log.SetMetadata(a, "meta2", 1010);
+      log.Finish(a, 1020);
+      // restarting reuses the same entry ID
+      a = log.Start("a", "int64", "meta3", 1030);
+      log.AppendInteger(a, 1000, 1040);
+    }
+    reader = std::make_unique<wpi::log::DataLogReader>(
+        wpi::MemoryBuffer::GetMemBufferCopy(data));
+  }
+
+  std::vector<uint8_t> data;
+  std::unique_ptr<wpi::log::DataLogReader> reader;
+};
+}  // namespace
+
+TEST_F(DataLogIndexTest, Entries) {
+  ASSERT_TRUE(reader->IsValid());
+  wpi::log::DataLogIndex index{*reader};
+
+  // 3 starts + 150 + 1 data + metadata + finish
+  EXPECT_EQ(index.GetNumRecords(), 156u);
+
+  auto& entries = index.GetEntries();
+  ASSERT_EQ(entries.size(), 3u);
+  EXPECT_EQ(entries[0].start.name, "a");
+  EXPECT_EQ(entries[0].metadata, "meta2");
+  EXPECT_EQ(entries[0].records.size(), 100u);
+  EXPECT_NE(entries[0].finishPos, SIZE_MAX);
+  EXPECT_EQ(entries[1].start.name, "b");
+  EXPECT_EQ(entries[1].records.size(), 50u);
+  EXPECT_EQ(entries[1].finishPos, SIZE_MAX);
+  EXPECT_EQ(entries[2].start.name, "a");
+  EXPECT_EQ(entries[2].start.entry, entries[0].start.entry);
+  EXPECT_EQ(entries[2].metadata, "meta3");
+  ASSERT_EQ(entries[2].records.size(), 1u);
+
+  auto found = index.FindEntries("a");
+  ASSERT_EQ(found.size(), 2u);
+  EXPECT_EQ(found[0], &entries[0]);
+  EXPECT_EQ(found[1], &entries[2]);
+  EXPECT_TRUE(index.FindEntries("c").empty());
+}
+
+TEST_F(DataLogIndexTest, GetRecord) {
+  wpi::log::DataLogIndex index{*reader};
+  auto& entry = index.GetEntries()[1];
+  for (size_t i = 0; i < entry.records.size(); ++i) {
+    auto record = index.GetRecord(entry.records[i]);
+    EXPECT_EQ(record.GetEntry(), entry.start.entry);
+    int64_t value;
+    ASSERT_TRUE(record.GetInteger(&value));
+    EXPECT_EQ(value, static_cast<int64_t>(i * 2));
+  }
+
+  auto record = index.GetRecord(index.GetEntries()[2].records[0]);
+  int64_t value;
+  ASSERT_TRUE(record.GetInteger(&value));
+  EXPECT_EQ(value, 1000);
+}
+
+TEST_F(DataLogIndexTest, SeekTime) {
+  // use a small interval to exercise the sparse index
+  wpi::log::DataLogIndex index{*reader, 8};
+
+  EXPECT_EQ(index.SeekTime(INT64_MIN), reader->begin());
+  EXPECT_EQ(index.SeekTime(0), reader->begin());
+  EXPECT_EQ(index.SeekTime(2000), reader->end());
+
+  for (int64_t ts : {5, 10, 15, 500, 995, 1000, 1001, 1040}) {
+    auto it = index.SeekTime(ts);
+    ASSERT_NE(it, reader->end()) << ts;
+    EXPECT_GE(it->GetTimestamp(), ts);
+    for (auto prev = reader->begin(); prev != it; ++prev) {
+      ASSERT_LT(prev->GetTimestamp(), ts);
+    }
+  }
+}
+
+TEST_F(DataLogIndexTest, LowerBoundTime) {
+  wpi::log::DataLogIndex index{*reader};
+  auto& entry = index.GetEntries()[0];
+  EXPECT_EQ(index.LowerBoundTime(entry, 0), 0u);
+  EXPECT_EQ(index.LowerBoundTime(entry, 10), 0u);
+  EXPECT_EQ(index.LowerBoundTime(entry, 11), 1u);
+  EXPECT_EQ(index.LowerBoundTime(entry, 500), 49u);
+  EXPECT_EQ(index.LowerBoundTime(entry, 1000), 99u);
+  EXPECT_EQ(index.LowerBoundTime(entry, 1001), 100u);
+}
+
+TEST_F(DataLogIndexTest, Progress) {
+  ASSERT_TRUE(reader->IsValid());
+  size_t lastNumRecords = 0;
+  using Change = std::pair<std::string, std::string>;
+  std::vector<Change> changes;
+  wpi::log::DataLogIndex index{
+      *reader, wpi::log::DataLogIndex::kDefaultTimeInterval, {},
+      [&](size_t numRecords, const wpi::log::DataLogRecord& record,
+          const wpi::log::DataLogIndex::Entry* entry) {
+        EXPECT_EQ(numRecords, lastNumRecords + 1);
+        lastNumRecords = numRecords;
+        EXPECT_EQ(entry != nullptr, record.IsStart() || record.IsSetMetadata());
+        if (entry) {
+          changes.emplace_back(entry->start.name, entry->metadata);
+        }
+        return true;
+      }};
+
+  EXPECT_EQ(lastNumRecords, index.GetNumRecords());
+  ASSERT_EQ(changes.size(), 4u);
+  EXPECT_EQ(changes[0], Change("a", "meta1"));
+  EXPECT_EQ(changes[1], Change("b", ""));
+  EXPECT_EQ(changes[2], Change("a", "meta2"));
+  EXPECT_EQ(changes[3], Change("a", "meta3"));
+}
+
+TEST_F(DataLogIndexTest, Cancel) {
+  ASSERT_TRUE(reader->IsValid());
+  wpi::log::DataLogIndex index{
+      *reader, wpi::log::DataLogIndex::kDefaultTimeInterval, {},
+      [](size_t numRecords, const auto&, const auto*) {
+        return numRecords < 10;
+      }};
+
+  EXPECT_EQ(index.GetNumRecords(), 10u);
+  ASSERT_EQ(index.GetEntries().size(), 2u);
+  // 2 starts, then a and b for even values and only a for odd values
+  EXPECT_EQ(index.GetEntries()[0].records.size(), 5u);
+  EXPECT_EQ(index.GetEntries()[1].records.size(), 3u);
+}
+
+TEST(DataLogIndexControlErrorTest, ReportsErrors) {
+  std::vector<uint8_t> data;
+  {
+    wpi::log::DataLog log{[&](auto out) {
+      data.insert(data.end(), out.begin(), out.end());
+    }};
+    log.Start("a", "int64", "", 1);
+  }
+  // raw control records with one-byte entry, size, and timestamp fields
+  std::vector<size_t> positions;
+  auto appendControl = [&](std::initializer_list<uint8_t> contents) {
+    positions.emplace_back(data.size());
+    data.insert(data.end(), {0, 0, static_cast<uint8_t>(contents.size()), 0});
+    data.insert(data.end(), contents);
+  };
+  // start of entry 1 again
+  appendControl({0, 1, 0, 0, 0, 1, 0, 0, 0, 'a', 5, 0, 0, 0, 'i', 'n', 't',
+                 '6', '4', 0, 0, 0, 0});
+  // finish of entry 9, which was never started
+  appendControl({1, 9, 0, 0, 0});
+  // set metadata with a string longer than the record
+  appendControl({2, 1, 0, 0, 0, 10, 0, 0, 0});
+  // unknown control record type
+  appendControl({7});
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBufferCopy(data)};
+  using ControlError = wpi::log::DataLogIndex::ControlError;
+  std::vector<std::pair<ControlError, size_t>> errors;
+  wpi::log::DataLogIndex index{
+      reader, wpi::log::DataLogIndex::kDefaultTimeInterval,
+      [&](ControlError error, size_t pos) { errors.emplace_back(error, pos); }};
+
+  ASSERT_EQ(errors.size(), 4u);
+  EXPECT_EQ(errors[0], std::pair(ControlError::kDuplicateEntry, positions[0]));
+  EXPECT_EQ(errors[1], std::pair(ControlError::kEntryNotFound, positions[1]));
+  EXPECT_EQ(errors[2],
+            std::pair(ControlError::kInvalidSetMetadata, positions[2]));
+  EXPECT_EQ(errors[3], std::pair(ControlError::kUnrecognized, positions[3]));
+  EXPECT_EQ(index.GetEntries().size(), 2u);
+}
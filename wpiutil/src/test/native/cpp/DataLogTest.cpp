@@ -0,0 +1,134 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLog.h"  // NOLINT(build/include_order)
+
+#include <stdint.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "wpi/DataLogReader.h"
+#include "wpi/DenseMap.h"
+#include "wpi/MemoryBuffer.h"
+
+namespace {
+// the log is destroyed right away, usually before the writer thread has
+// started waiting; tests repeat to make hitting that window likely
+constexpr int kRepeats = 100;
+
+void CheckOutstandingWritten(const std::vector<uint8_t>& data) {
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBufferCopy(data)};
+  ASSERT_TRUE(reader.IsValid());
+  int records = 0;
+  for (auto&& record : reader) {
+    if (!record.IsControl()) {
+      int64_t val;
+      ASSERT_TRUE(record.GetInteger(&val));
+      ASSERT_EQ(val, 5);
+    }
+    ++records;
+  }
+  ASSERT_EQ(records, 2);
+}
+}  // namespace
+
+TEST(DataLogTest, DestroyWritesOutstanding) {
+  for (int i = 0; i < kRepeats; ++i) {
+    std::vector<uint8_t> data;
+    {
+      wpi::log::DataLog log{
+          [&](auto out) { data.insert(data.end(), out.begin(), out.end()); }};
+      int entry = log.Start("a", "int64", "", 1);
+      log.AppendInteger(entry, 5, 2);
+    }
+    CheckOutstandingWritten(data);
+  }
+}
+
+TEST(DataLogTest, DestroyWritesOutstandingFile) {
+  auto dir = std::filesystem::temp_directory_path();
+  auto path = dir / "DataLogTest-outstanding.wpilog";
+  for (int i = 0; i < kRepeats; ++i) {
+    std::filesystem::remove(path);
+    {
+      wpi::log::DataLog log{dir.string(), path.filename().string()};
+      int entry = log.Start("a", "int64", "", 1);
+      log.AppendInteger(entry, 5, 2);
+    }
+    std::ifstream is{path, std::ios::binary};
+    CheckOutstandingWritten(std::vector<uint8_t>{
+        std::istreambuf_iterator<char>{is}, std::istreambuf_iterator<char>{}});
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(DataLogTest, MultiThreadedOrder) {
+  static constexpr int kNumThreads = 12;
+  static constexpr int64_t kNumAppends = 2000;
+
+  std::vector<uint8_t> data;
+  {
+    wpi::log::DataLog log{
+        [&](auto out) { data.insert(data.end(), out.begin(), out.end()); },
+        0.01};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+      threads.emplace_back([&, i] {
+        int entry = log.Start(fmt::format("/thread{}", i), "int64");
+        for (int64_t j = 0; j < kNumAppends; ++j) {
+          log.AppendInteger(entry, j, 0);
+          if ((j % 500) == 0) {
+            log.AppendString(entry, std::string(j, 'x'), 0);
+          }
+        }
+        log.Finish(entry);
+      });
+    }
+    for (auto&& thr : threads) {
+      thr.join();
+    }
+  }
+
+  wpi::log::DataLogReader reader{wpi::MemoryBuffer::GetMemBufferCopy(data)};
+  ASSERT_TRUE(reader.IsValid());
+
+  // each entry's records must be between its start and finish, in order
+  wpi::DenseMap<int, int64_t> next;
+  int numFinished = 0;
+  for (auto&& record : reader) {
+    if (record.IsStart()) {
+      wpi::log::StartRecordData start;
+      ASSERT_TRUE(record.GetStartData(&start));
+      ASSERT_EQ(next.count(start.entry), 0u);
+      next[start.entry] = 0;
+    } else if (record.IsFinish()) {
+      int entry;
+      ASSERT_TRUE(record.GetFinishEntry(&entry));
+      ASSERT_EQ(next.lookup(entry), kNumAppends);
+      ++numFinished;
+    } else if (!record.IsControl()) {
+      auto it = next.find(record.GetEntry());
+      ASSERT_NE(it, next.end());
+      int64_t value;
+      if (record.GetInteger(&value)) {
+        ASSERT_EQ(value, it->second);
+        ++it->second;
+      } else {
+        std::string_view str;
+        ASSERT_TRUE(record.GetString(&str));
+        ASSERT_EQ(str.size(), static_cast<size_t>(it->second - 1));
+      }
+    }
+  }
+  EXPECT_EQ(numFinished, kNumThreads);
+}
@@ -0,0 +1,80 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/MemoryBuffer.h"  // NOLINT(build/include_order)
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "wpi/raw_ostream.h"
+
+namespace {
+
+void TestFileSize(size_t size) {
+  auto path = (std::filesystem::temp_directory_path() /
+               ("MemoryBufferTest-" + std::to_string(size)))
+                  .string();
+
+  std::vector<uint8_t> contents(size);
+  for (size_t i = 0; i < size; ++i) {
+    contents[i] = i % 251;
+  }
+  {
+    std::error_code ec;
+    wpi::raw_fd_ostream os{path, ec};
+    ASSERT_FALSE(ec);
+    os << std::span<const uint8_t>{contents};
+  }
+
+  std::error_code ec;
+  auto buffer = wpi::MemoryBuffer::GetFile(path, ec);
+  ASSERT_FALSE(ec);
+  ASSERT_NE(nullptr, buffer);
+  EXPECT_EQ(size, buffer->size());
+  EXPECT_TRUE(std::equal(contents.begin(), contents.end(), buffer->begin(),
+                         buffer->end()));
+  buffer.reset();
+
+  // the stream path must return exactly the bytes read
+  buffer = wpi::MemoryBuffer::GetFileAsStream(path, ec);
+  ASSERT_FALSE(ec);
+  ASSERT_NE(nullptr, buffer);
+  EXPECT_EQ(size, buffer->size());
+  EXPECT_TRUE(std::equal(contents.begin(), contents.end(), buffer->begin(),
+                         buffer->end()));
+  buffer.reset();
+
+  // regular files must be accepted for write-through mapping
+  auto writeThrough = wpi::WriteThroughMemoryBuffer::GetFile(path, ec);
+  ASSERT_FALSE(ec);
+  ASSERT_NE(nullptr, writeThrough);
+  EXPECT_EQ(size, writeThrough->size());
+  writeThrough.reset();
+
+  std::filesystem::remove(path);
+}
+
+}  // namespace
+
+TEST(MemoryBufferTest, GetSmallFile) {
+  // Small files are read instead of mapped
+  TestFileSize(100);
+}
+
+TEST(MemoryBufferTest, GetFileAcrossReadChunks) {
+  TestFileSize(4096 * 4 + 100);
+}
+
+TEST(MemoryBufferTest, GetMappedFile) {
+  TestFileSize(4096 * 16);
+}
@@ -0,0 +1,53 @@
+// Copyright (c) FIRST and other WPILib contributors.
+// Open Source Software; you can modify and/or share it under the terms of
+// the WPILib BSD license file in the root directory of this project.
+
+#include "wpi/DataLog.h"  // NOLINT(build/include_order)
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+TEST(DataLogBenchmark, Append) {
+  using std::chrono::duration_cast;
+  using std::chrono::high_resolution_clock;
+  using std::chrono::microseconds;
+
+  // keep each run under the outgoing buffer limit so logging isn't paused
+  static constexpr int kTotalAppends = 60000;
+  static constexpr int kNumRuns = 3;
+
+  for (int numThreads : {1, 2, 4, 8}) {
+    std::atomic<size_t> written{0};
+    microseconds time{0};
+    for (int run = 0; run < kNumRuns; ++run) {
+      wpi::log::DataLog log{[&](auto data) { written += data.size(); }};
+      std::vector<int> entries;
+      for (int i = 0; i < numThreads; ++i) {
+        entries.emplace_back(
+            log.Start(fmt::format("/thread{}", i), "int64", "", 1));
+      }
+
+      std::vector<std::thread> threads;
+      auto start = high_resolution_clock::now();
+      for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&, entry = entries[i]] {
+          for (int64_t j = 0; j < kTotalAppends / numThreads; ++j) {
+            log.AppendInteger(entry, j, 1000 + j);
+          }
+        });
+      }
+      for (auto&& thr : threads) {
+        thr.join();
+      }
+      auto stop = high_resolution_clock::now();
+      time += duration_cast<microseconds>(stop - start);
+    }
+    fmt::print("threads: {} appends: {} time: {} written: {}\n", numThreads,
+               kTotalAppends * kNumRuns, time.count(), written.load());
+  }
+}